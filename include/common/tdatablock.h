@@ -245,6 +245,10 @@ double blockDataGetSerialRowSize(const SSDataBlock* pBlock);
 size_t blockDataGetSerialMetaSize(uint32_t numOfCols);
 
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo);
+/**
+ * @brief rearrange rows so that the j-th row of the block becomes the index[j]-th row of the original one
+ */
+int32_t blockDataReorder(SSDataBlock* pDataBlock, const int32_t* index);
 /**
  * @brief find how many rows already in order start from first row
  */
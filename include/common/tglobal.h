@@ -88,6 +88,8 @@ extern int8_t tsEnableTLS;
 extern int32_t tsMaxShellConns;
 extern int32_t tsShellActivityTimer;
 extern int32_t tsCompressMsgSize;
+extern int32_t tsCompressMsgAlgorithm;
+extern bool    tsRpcLocalSocket;
 extern int64_t tsTickPerMin[3];
 extern int64_t tsTickPerHour[3];
 extern int64_t tsSecTimes[3];
@@ -116,6 +118,8 @@ extern int32_t tsReadTimeout;
 extern int8_t  tsEnableIpv6;
 extern int32_t tsTimeToGetAvailableConn;
 extern int32_t tsNumOfCommitThreads;
+extern int32_t tsNumOfMergeThreads;
+extern int32_t tsNumOfScanDecodeThreads;
 extern int32_t tsNumOfTaskQueueThreads;
 extern int32_t tsNumOfMnodeQueryThreads;
 extern int32_t tsNumOfMnodeFetchThreads;
@@ -231,6 +235,7 @@ extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row lo
 
 // query client
 extern int32_t tsQueryPolicy;
+extern int32_t tsQueryMaxStaleness;  // ms, follower replicas may serve queries within this staleness, 0: leader only
 extern bool    tsQueryTbNotExistAsEmpty;
 extern int32_t tsQueryRspPolicy;
 extern int64_t tsQueryMaxConcurrentTables;
@@ -325,6 +330,15 @@ extern int32_t tsStreamBufferSize;
 extern int64_t tsStreamBufferSizeBytes;
 extern bool    tsFilterScalarMode;
 extern int32_t tsPQSortMemThreshold;
+extern int32_t tsGroupSpillMemThreshold;
+extern bool    tsTsdbBlockBloomFilter;
+extern bool    tsCacheLastWarmup;
+extern int32_t tsCacheLastWarmupRowsPerSec;
+extern int32_t tsTsdbColCacheSize;
+extern int32_t tsTsdbReadAheadPages;
+extern bool    tsWalGroupCommit;
+extern int32_t tsWalPreallocSize;
+extern int32_t tsSyncAppendBatchSize;
 extern int32_t tsStreamNotifyMessageSize;
 extern int32_t tsStreamNotifyFrameSize;
 extern bool    tsCompareAsStrInGreatest;
@@ -3341,10 +3341,12 @@ typedef struct SSubQueryMsg {
   char*    sql;
   uint32_t msgLen;
   char*    msg;
+  int32_t  maxStaleness;  // ms, a follower may run the task if its data is at most this stale, 0: leader only
 } SSubQueryMsg;
 
 int32_t tSerializeSSubQueryMsg(void* buf, int32_t bufLen, SSubQueryMsg* pReq);
 int32_t tDeserializeSSubQueryMsg(void* buf, int32_t bufLen, SSubQueryMsg* pReq);
+int32_t tDeserializeSSubQueryMsgAttr(void* buf, int32_t bufLen, SSubQueryMsg* pReq);
 void    tFreeSSubQueryMsg(SSubQueryMsg* pReq);
 
 typedef struct {
@@ -3514,6 +3516,7 @@ typedef struct {
 
 int32_t tSerializeSTaskDropReq(void* buf, int32_t bufLen, STaskDropReq* pReq);
 int32_t tDeserializeSTaskDropReq(void* buf, int32_t bufLen, STaskDropReq* pReq);
+int32_t tDeserializeSchTaskId(void* buf, int32_t bufLen, uint64_t* pQueryId, uint64_t* pTaskId);
 
 typedef enum {
   TASK_NOTIFY_FINISHED = 1,
@@ -182,6 +182,12 @@ typedef union {
 
 typedef void (*TsdReaderNotifyCbFn)(ETsdReaderNotifyType type, STsdReaderNotifyInfo* info, void* param);
 
+// candidate values of an equal/in condition, a block is skipped if none of them may exist in it
+typedef struct SBlockBloomProbe {
+  col_id_t colId;
+  SArray*  pHashes;  // SArray<uint64_t>, HASH_FUNCTION_1 and HASH_FUNCTION_2 of each value in pairs
+} SBlockBloomProbe;
+
 struct SFileSetReader;
 
 typedef struct TsdReader {
@@ -193,6 +199,8 @@ typedef struct TsdReader {
   int32_t      (*tsdNextDataBlock)(void* pReader, bool* hasNext);
 
   int32_t      (*tsdReaderRetrieveBlockSMAInfo)();
+  int32_t      (*tsdReaderCheckBlockBloomFilter)(void* pReader, SArray* pProbes, bool* keep);
+  // pIdList: SArray<col_id_t>, load only the given columns without consuming the block, NULL to load all columns
   int32_t      (*tsdReaderRetrieveDataBlock)(void* p, SSDataBlock** pBlock, SArray* pIdList);
 
   void         (*tsdReaderReleaseDataBlock)(void* pReader);
@@ -35,6 +35,13 @@ typedef struct {
   int64_t rpcQueueMemoryUsed;
   int64_t applyMemoryAllowed;
   int64_t applyMemoryUsed;
+  int64_t rpcCompRawBytes;
+  int64_t rpcCompBytes;
+  int64_t rpcCompCostUs;
+  int64_t rpcDecompCostUs;
+  int64_t rpcSendWrites;
+  int64_t rpcSendMsgs;
+  int64_t rpcSendBytes;
 } SRawDnodeMetrics;
 
 // Raw Write Metrics Structure (Input data)
@@ -48,6 +55,9 @@ typedef struct {
   int64_t preprocess_time;
   int64_t wal_write_bytes;
   int64_t wal_write_time;
+  int64_t wal_group_sync_count;
+  int64_t wal_group_sync_entries;
+  int64_t wal_group_sync_latency;
   int64_t apply_bytes;
   int64_t apply_time;
   int64_t commit_count;
@@ -57,8 +67,12 @@ typedef struct {
   int64_t blocked_commit_time;
   int64_t merge_count;
   int64_t merge_time;
+  int64_t merge_bytes;
   int64_t last_cache_commit_time;
   int64_t last_cache_commit_count;
+  int64_t col_cache_hit;
+  int64_t col_cache_miss;
+  int64_t col_cache_evict;
 } SRawWriteMetrics;
 
 // Public API functions
@@ -68,6 +68,7 @@ typedef struct SSchedulerReq {
   void**             pFetchRes;
   int8_t             source;
   void*              pWorkerCb;
+  int32_t            maxStaleness;  // ms, scan tasks may run on followers within this staleness, 0: leader only
 } SSchedulerReq;
 
 int32_t schedulerInit(void);
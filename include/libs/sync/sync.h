@@ -227,7 +227,9 @@ typedef struct SSyncLogStore {
   SyncIndex (*syncLogIndexRetention)(struct SSyncLogStore* pLogStore, int64_t bytes);
   SyncTerm (*syncLogLastTerm)(struct SSyncLogStore* pLogStore);
 
-  int32_t (*syncLogAppendEntry)(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forcSync);
+  int32_t (*syncLogAppendEntry)(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forcSync,
+                                bool deferSync);
+  int32_t (*syncLogGroupCommit)(struct SSyncLogStore* pLogStore);
   int32_t (*syncLogGetEntry)(struct SSyncLogStore* pLogStore, SyncIndex index, SSyncRaftEntry** ppEntry);
   int32_t (*syncLogTruncate)(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
 
@@ -285,6 +287,8 @@ int32_t   syncIsCatchUp(int64_t rid);
 ESyncRole syncGetRole(int64_t rid);
 int64_t   syncGetTerm(int64_t rid);
 int32_t   syncProcessMsg(int64_t rid, SRpcMsg* pMsg);
+void      syncBeginGroupCommit(int64_t rid);
+int32_t   syncEndGroupCommit(int64_t rid);
 int32_t   syncReconfig(int64_t rid, SSyncCfg* pCfg);
 int32_t   syncBeginSnapshot(int64_t rid, int64_t lastApplyIndex);
 int32_t   syncEndSnapshot(int64_t rid);
@@ -292,6 +296,7 @@ int32_t   syncLeaderTransfer(int64_t rid);
 int32_t   syncStepDown(int64_t rid, SyncTerm newTerm);
 void      syncResetMetrics(int64_t rid, const SSyncMetrics* pOldMetrics);
 bool      syncIsReadyForRead(int64_t rid);
+bool      syncIsReadyForFollowerRead(int64_t rid, int32_t maxStalenessMs);
 bool      syncSnapshotSending(int64_t rid);
 bool      syncSnapshotRecving(int64_t rid);
 int32_t   syncSendTimeoutRsp(int64_t rid, int64_t seq);
@@ -103,6 +103,8 @@ typedef struct SRpcInit {
   int32_t failFastInterval;
 
   int32_t compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t  compressAlgorithm;  // 0: lz4, 1: zstd, 2: zstd with dictionaries, if the peer is able to decompress it
+  int8_t  localSock;          // talk to local endpoints through unix domain socket instead of tcp
   int8_t  encryption;    // encrypt or not
 
   // the following is for client app ecurity only
@@ -198,6 +200,19 @@ int32_t rpcUtilSIpRangeToStr(SIpV4Range *pRange, char *buf);
 int32_t rpcUtilSWhiteListToStr(SIpWhiteListDual *pWhiteList, char **ppBuf);
 int32_t rpcCvtErrCode(int32_t code);
 
+// process wide transport counters, summed over all rpc instances
+typedef struct {
+  int64_t compRawBytes;  // bytes of the msgs compression was tried on
+  int64_t compBytes;     // bytes of these msgs once sent
+  int64_t compCostUs;
+  int64_t decompCostUs;
+  int64_t sendWrites;  // socket writes, each may carry several coalesced msgs
+  int64_t sendMsgs;
+  int64_t sendBytes;
+} SRpcStat;
+
+void rpcGetStat(SRpcStat *pStat);
+
 #else
 #include <stdbool.h>
 #include <stdint.h>
@@ -299,6 +314,8 @@ typedef struct SRpcInit {
   int32_t failFastInterval;
 
   int32_t compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t  compressAlgorithm;  // 0: lz4, 1: zstd, 2: zstd with dictionaries, if the peer is able to decompress it
+  int8_t  localSock;          // talk to local endpoints through unix domain socket instead of tcp
   int8_t  encryption;    // encrypt or not
 
   // the following is for client app ecurity only
@@ -388,6 +405,19 @@ int32_t rpcUtilSIpRangeToStr(SIpV4Range *pRange, char *buf);
 int32_t rpcUtilSWhiteListToStr(SIpWhiteList *pWhiteList, char **ppBuf);
 int32_t rpcCvtErrCode(int32_t code);
 
+// process wide transport counters, summed over all rpc instances
+typedef struct {
+  int64_t compRawBytes;  // bytes of the msgs compression was tried on
+  int64_t compBytes;     // bytes of these msgs once sent
+  int64_t compCostUs;
+  int64_t decompCostUs;
+  int64_t sendWrites;  // socket writes, each may carry several coalesced msgs
+  int64_t sendMsgs;
+  int64_t sendBytes;
+} SRpcStat;
+
+void rpcGetStat(SRpcStat *pStat);
+
 #endif
 
 #ifdef __cplusplus
@@ -98,6 +98,18 @@ typedef struct {
 } SWalCkHead;
 #pragma pack(pop)
 
+#define WAL_GROUP_COMMIT_HIST_SIZE 16
+
+// histograms of the shared fsyncs, bucket i counts values in [2^i, 2^(i+1)), the last one is open ended
+// the counters are reported to vnode metrics and reset, the histograms keep growing until the WAL closes
+typedef struct {
+  int64_t numOfSyncs;
+  int64_t numOfEntries;
+  int64_t latency;                                  // us, sum of the latencies below
+  int64_t batchHist[WAL_GROUP_COMMIT_HIST_SIZE];    // entries per fsync
+  int64_t latencyHist[WAL_GROUP_COMMIT_HIST_SIZE];  // us from the first pending append to the end of fsync
+} SWalGroupCommitStat;
+
 typedef void (*stopDnodeFn)();
 typedef struct SWal {
   // cfg
@@ -114,6 +126,7 @@ typedef struct SWal {
   // status
   int64_t totSize;
   int64_t lastRollSeq;
+  int64_t preallocEnd;  // end of the blocks reserved for the current log file
   // ctl
   int64_t        refId;
   TdThreadRwlock mutex;
@@ -126,6 +139,13 @@ typedef struct SWal {
 
   // reusable write head
   SWalCkHead writeHead;
+
+  // group commit
+  struct {
+    int64_t             syncedVer;  // last version made durable by fsync
+    int64_t             pendingTs;  // us, first append waiting for the shared fsync, 0 if none
+    SWalGroupCommitStat stat;
+  } group;
 } SWal;
 
 typedef struct {
@@ -145,6 +165,17 @@ typedef struct SWalReader {
   int64_t        capacity;
   TdThreadMutex  mutex;
   SWalCkHead    *pHead;
+  // read only mappings of the current log and idx file, committed entries are copied out without syscalls
+  struct {
+    uint8_t *pLog;
+    uint8_t *pIdx;
+    int64_t  logMapSize;  // mapped length, exceeds the file length for the active file
+    int64_t  idxMapSize;
+    int64_t  logSize;     // file length known to be readable
+    int64_t  idxSize;
+    int64_t  bodyOffset;  // body of the head fetched from the mapping, -1 if none
+    bool     posStale;    // file position not advanced by the mapped reads
+  } map;
 } SWalReader;
 
 // module initialization
@@ -162,6 +193,13 @@ void    walClose(SWal *);
 int32_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body, int32_t bodyLen,
                      const STraceId *trace);
 int32_t walFsync(SWal *, bool force);
+// leave the fsync walFsync would do to the next walGroupCommit, whether group commit is on or not. a forced fsync
+// is done at once.
+int32_t walDeferFsync(SWal *, bool force);
+// fsync once for all the entries appended since the last fsync when group commit is on
+int32_t walGroupCommit(SWal *);
+void    walGetGroupCommitStat(SWal *, SWalGroupCommitStat *pStat);
+void    walResetGroupCommitStat(SWal *, const SWalGroupCommitStat *pOldStat);
 
 // apis for lifecycle management
 int32_t walCommit(SWal *, int64_t ver);
@@ -94,6 +94,7 @@ int32_t taosUnLockFile(TdFilePtr pFile);
 int32_t taosUmaskFile(int32_t maskVal);
 
 int32_t taosStatFile(const char *path, int64_t *size, int64_t *mtime, int64_t *atime);
+int32_t taosLStatFileOwner(const char *path, uint32_t *mode, int64_t *uid);  // does not follow a symlink
 int32_t taosGetFileDiskID(const char *path, int64_t *diskid);
 bool    taosCheckFileDiskID(const char *path, int64_t *actDiskID, int64_t expDiskID);
 int32_t taosDevInoFile(TdFilePtr pFile, int64_t *stDev, int64_t *stIno);
@@ -103,6 +104,12 @@ bool    taosCheckExistFile(const char *pathname);
 int64_t taosLSeekFile(TdFilePtr pFile, int64_t offset, int32_t whence);
 int32_t taosFtruncateFile(TdFilePtr pFile, int64_t length);
 int32_t taosFsyncFile(TdFilePtr pFile);
+int32_t taosPrefetchFile(TdFilePtr pFile, int64_t offset, int64_t count);
+int32_t taosDropFileCache(TdFilePtr pFile, int64_t offset, int64_t count);
+int32_t taosFallocateFile(TdFilePtr pFile, int64_t offset, int64_t len);
+int32_t taosFdatasyncFile(TdFilePtr pFile);
+void   *taosMmapReadOnlyFile(TdFilePtr pFile, int64_t size);
+int32_t taosMunmapFile(void *ptr, int64_t size);
 
 int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
@@ -309,7 +309,16 @@ int32_t zlibCompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize
 int32_t zlibDecompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize);
 
 int32_t zstdCompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize);
+int32_t zstdCompressLevelImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize, int32_t level);
 int32_t zstdDecompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize);
+int32_t zstdTrainDictImpl(const void *samples, const size_t *sampleSizes, int32_t numOfSamples, void *dict,
+                          int32_t *dictSize);
+void   *zstdCreateCDictImpl(const void *dict, int32_t dictSize, int32_t level);
+void    zstdFreeCDictImpl(void *cdict);
+void   *zstdCreateDDictImpl(const void *dict, int32_t dictSize);
+void    zstdFreeDDictImpl(void *ddict);
+int32_t zstdCompressDictImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize, void *cdict);
+int32_t zstdDecompressDictImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize, void *ddict);
 
 int32_t xzCompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize);
 int32_t xzDecompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize);
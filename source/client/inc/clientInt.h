@@ -163,6 +163,7 @@ typedef struct {
   char          userApp[TSDB_APP_NAME_LEN];
   uint32_t      userIp;
   SIpRange      userDualIp;  // user ip range
+  int32_t       queryMaxStaleness;  // ms, overrides the queryMaxStaleness client option when not negative
 }SOptionInfo;
 
 typedef struct STscObj {
@@ -367,6 +367,8 @@ int32_t openTransporter(const char *user, const char *auth, int32_t numOfThread,
   rpcInit.user = (char *)user;
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlgorithm = tsCompressMsgAlgorithm;
+  rpcInit.localSock = tsRpcLocalSocket;
   rpcInit.dfp = destroyAhandle;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
@@ -512,6 +514,7 @@ int32_t createTscObj(const char *user, const char *auth, const char *db, int32_t
   }
 
   (*pObj)->connType = connType;
+  (*pObj)->optionInfo.queryMaxStaleness = -1;
   (*pObj)->pAppInfo = pAppInfo;
   (*pObj)->appHbMgrIdx = pAppInfo->pAppHbMgr->idx;
   tstrncpy((*pObj)->user, user, sizeof((*pObj)->user));
@@ -937,6 +937,12 @@ _return:
   return code;
 }
 
+// the connection option takes precedence over the client wide one
+static int32_t getQueryMaxStaleness(SRequestObj* pRequest) {
+  int32_t staleness = pRequest->pTscObj->optionInfo.queryMaxStaleness;
+  return staleness >= 0 ? staleness : tsQueryMaxStaleness;
+}
+
 int32_t scheduleQuery(SRequestObj* pRequest, SQueryPlan* pDag, SArray* pNodeList) {
   void* pTransporter = pRequest->pTscObj->pAppInfo->pTransporter;
 
@@ -959,6 +965,7 @@ int32_t scheduleQuery(SRequestObj* pRequest, SQueryPlan* pDag, SArray* pNodeList
          .pExecRes = &res,
          .source = pRequest->source,
          .pWorkerCb = getTaskPoolWorkerCb(),
+         .maxStaleness = getQueryMaxStaleness(pRequest),
   };
 
   int32_t code = schedulerExecJob(&req, &pRequest->body.queryJob);
@@ -1485,6 +1492,7 @@ static int32_t asyncExecSchQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaDat
            .pExecRes = NULL,
            .source = pRequest->source,
            .pWorkerCb = getTaskPoolWorkerCb(),
+           .maxStaleness = getQueryMaxStaleness(pRequest),
     };
     if (TSDB_CODE_SUCCESS == code) {
       code = schedulerExecJob(&req, &pRequest->body.queryJob);
@@ -2745,6 +2753,8 @@ TSDB_SERVER_STATUS taos_check_server_status(const char* fqdn, int port, char* de
   rpcInit.connType = TAOS_CONN_CLIENT;
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlgorithm = tsCompressMsgAlgorithm;
+  rpcInit.localSock = tsRpcLocalSocket;
   rpcInit.user = "_dnd";
 
   int32_t connLimitNum = tsNumOfRpcSessions / (tsNumOfRpcThreads * 3);
@@ -222,6 +222,20 @@ static int32_t setConnectionOption(TAOS *taos, TSDB_OPTION_CONNECTION option, co
     }
   }
 
+  if (option == TSDB_OPTION_CONNECTION_QUERY_MAX_STALENESS || option == TSDB_OPTION_CONNECTION_CLEAR) {
+    if (val != NULL) {
+      int32_t staleness = 0;
+      code = taosStr2int32(val, &staleness);
+      if (code != 0 || staleness < 0 || staleness > 3600000) {  // same range as the queryMaxStaleness option
+        code = TSDB_CODE_INVALID_PARA;
+        goto END;
+      }
+      pObj->optionInfo.queryMaxStaleness = staleness;
+    } else {
+      pObj->optionInfo.queryMaxStaleness = -1;
+    }
+  }
+
 END:
   releaseTscObj(*(int64_t *)taos);
   return terrno = code;
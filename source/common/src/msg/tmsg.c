@@ -10717,6 +10717,7 @@ int32_t tSerializeSSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq) {
   TAOS_CHECK_EXIT(tEncodeU32(&encoder, pReq->msgLen));
   TAOS_CHECK_EXIT(tEncodeBinary(&encoder, (uint8_t *)pReq->msg, pReq->msgLen));
   TAOS_CHECK_EXIT(tEncodeU64(&encoder, pReq->clientId));
+  TAOS_CHECK_EXIT(tEncodeI32(&encoder, pReq->maxStaleness));
 
   tEndEncode(&encoder);
 
@@ -10770,6 +10771,58 @@ int32_t tDeserializeSSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq)
   } else {
     pReq->clientId = 0;
   }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pReq->maxStaleness));
+  } else {
+    pReq->maxStaleness = 0;
+  }
+
+  tEndDecode(&decoder);
+
+_exit:
+  tDecoderClear(&decoder);
+  return code;
+}
+
+// decodes the attributes of a sub query msg without copying the sql and the plan, which are left NULL
+int32_t tDeserializeSSubQueryMsgAttr(void *buf, int32_t bufLen, SSubQueryMsg *pReq) {
+  int32_t  code = 0;
+  int32_t  lino;
+  int32_t  headLen = sizeof(SMsgHead);
+  char    *sql = NULL;
+  uint8_t *msg = NULL;
+
+  SDecoder decoder = {0};
+  tDecoderInit(&decoder, (char *)buf + headLen, bufLen - headLen);
+
+  TAOS_CHECK_EXIT(tStartDecode(&decoder));
+
+  TAOS_CHECK_EXIT(tDecodeU64(&decoder, &pReq->sId));
+  TAOS_CHECK_EXIT(tDecodeU64(&decoder, &pReq->queryId));
+  TAOS_CHECK_EXIT(tDecodeU64(&decoder, &pReq->taskId));
+  TAOS_CHECK_EXIT(tDecodeI64(&decoder, &pReq->refId));
+  TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pReq->execId));
+  TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pReq->msgMask));
+  TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->taskType));
+  TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->explain));
+  TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->needFetch));
+  TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->compress));
+  TAOS_CHECK_EXIT(tDecodeU32(&decoder, &pReq->sqlLen));
+  TAOS_CHECK_EXIT(tDecodeCStr(&decoder, &sql));
+  TAOS_CHECK_EXIT(tDecodeU32(&decoder, &pReq->msgLen));
+  TAOS_CHECK_EXIT(tDecodeBinary(&decoder, &msg, NULL));
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeU64(&decoder, &pReq->clientId));
+  } else {
+    pReq->clientId = 0;
+  }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pReq->maxStaleness));
+  } else {
+    pReq->maxStaleness = 0;
+  }
+  pReq->sql = NULL;
+  pReq->msg = NULL;
 
   tEndDecode(&decoder);
 
@@ -11194,6 +11247,26 @@ _exit:
   }
 }
 
+// decodes the ids leading the sub query, fetch and drop task msgs of the scheduler, without touching the msg
+int32_t tDeserializeSchTaskId(void *buf, int32_t bufLen, uint64_t *pQueryId, uint64_t *pTaskId) {
+  int32_t  code = 0;
+  int32_t  lino;
+  int32_t  headLen = sizeof(SMsgHead);
+  uint64_t sId = 0;
+
+  SDecoder decoder = {0};
+  tDecoderInit(&decoder, (char *)buf + headLen, bufLen - headLen);
+
+  TAOS_CHECK_EXIT(tStartDecode(&decoder));
+  TAOS_CHECK_EXIT(tDecodeU64(&decoder, &sId));
+  TAOS_CHECK_EXIT(tDecodeU64(&decoder, pQueryId));
+  TAOS_CHECK_EXIT(tDecodeU64(&decoder, pTaskId));
+
+_exit:
+  tDecoderClear(&decoder);
+  return code;
+}
+
 int32_t tDeserializeSTaskDropReq(void *buf, int32_t bufLen, STaskDropReq *pReq) {
   int32_t headLen = sizeof(SMsgHead);
   int32_t code = 0;
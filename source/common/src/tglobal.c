@@ -107,6 +107,8 @@ int8_t  tsEnableIpv6 = 0;
 
 int32_t tsNumOfQueryThreads = 0;
 int32_t tsNumOfCommitThreads = 2;
+int32_t tsNumOfMergeThreads = 2;
+int32_t tsNumOfScanDecodeThreads = 2;
 int32_t tsNumOfTaskQueueThreads = 16;
 int32_t tsNumOfMnodeQueryThreads = 16;
 int32_t tsNumOfMnodeFetchThreads = 1;
@@ -119,6 +121,7 @@ int32_t tsNumOfQnodeFetchThreads = 1;
 int32_t tsNumOfSnodeStreamThreads = 4;
 int32_t tsNumOfSnodeWriteThreads = 1;
 int32_t tsPQSortMemThreshold = 16;    // M
+int32_t tsGroupSpillMemThreshold = 0;  // KB, 0 for half of singleQueryMaxMemorySize or 1GB
 int32_t tsRetentionSpeedLimitMB = 0;  // unlimited
 int32_t tsNumOfMnodeStreamMgmtThreads = 2;
 int32_t tsNumOfStreamMgmtThreads = 2;
@@ -250,6 +253,7 @@ int32_t tmqMaxTopicNum = 20;
 int32_t tmqRowSize = 1000;
 // query
 int32_t tsQueryPolicy = 1;
+int32_t tsQueryMaxStaleness = 0;
 bool    tsQueryTbNotExistAsEmpty = false;
 int32_t tsQueryRspPolicy = 0;
 int64_t tsQueryMaxConcurrentTables = 200;  // unit is TSDB_TABLE_NUM_UNIT
@@ -285,6 +289,12 @@ bool    tsMultiResultFunctionStarReturnTags = false;
  */
 int32_t tsCompressMsgSize = -1;
 
+// algorithm used to compress rpc messages, 0: lz4, 1: zstd. zstd is only applied to peers able to decompress it
+int32_t tsCompressMsgAlgorithm = 0;
+
+// whether rpc between client and server on the same host goes through unix domain socket instead of tcp loopback
+bool tsRpcLocalSocket = true;
+
 // count/hyperloglog function always return values in case of all NULL data or Empty data set.
 int32_t tsCountAlwaysReturnValue = 1;
 
@@ -379,6 +389,14 @@ bool    tsDisableStream = false;
 int32_t tsStreamBufferSize = 0;       // MB
 int64_t tsStreamBufferSizeBytes = 0;  // bytes
 bool    tsFilterScalarMode = false;
+bool    tsTsdbBlockBloomFilter = false;           // write bloom filters of columns into data file blocks
+bool    tsCacheLastWarmup = false;                // load last cache from the newest file set when vnode opens
+int32_t tsCacheLastWarmupRowsPerSec = 1000000;    // 0 means unlimited
+int32_t tsTsdbColCacheSize = 0;                   // MB, decoded column cache of each vnode, 0 means disabled
+int32_t tsTsdbReadAheadPages = 64;                // max pages read ahead on sequential file access, 0 means disabled
+bool    tsWalGroupCommit = false;                 // share one wal fsync among the entries persisted together
+int32_t tsWalPreallocSize = 16;                  // MB, disk space reserved ahead of wal log writes, 0 means disabled
+int32_t tsSyncAppendBatchSize = 256;             // KB, raft entries packed in one append entries msg, 0 means one entry per msg
 
 bool tsUpdateCacheBatch = true;
 
@@ -610,8 +628,14 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
                                 CFG_CATEGORY_GLOBAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "compressMsgSize", tsCompressMsgSize, -1, 100000000, CFG_SCOPE_BOTH,
                                 CFG_DYN_BOTH_LAZY, CFG_CATEGORY_GLOBAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "compressMsgAlgorithm", tsCompressMsgAlgorithm, 0, 2, CFG_SCOPE_BOTH,
+                                CFG_DYN_NONE, CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(
+      cfgAddBool(pCfg, "rpcLocalSocket", tsRpcLocalSocket, CFG_SCOPE_BOTH, CFG_DYN_NONE, CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(
       cfgAddInt32(pCfg, "queryPolicy", tsQueryPolicy, 1, 4, CFG_SCOPE_CLIENT, CFG_DYN_ENT_CLIENT, CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryMaxStaleness", tsQueryMaxStaleness, 0, 3600000, CFG_SCOPE_CLIENT,
+                                CFG_DYN_CLIENT, CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "queryTableNotExistAsEmpty", tsQueryTbNotExistAsEmpty, CFG_SCOPE_CLIENT,
                                CFG_DYN_CLIENT, CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(
@@ -766,6 +790,12 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   tsNumOfCommitThreads = tsNumOfCores / 2;
   tsNumOfCommitThreads = TRANGE(tsNumOfCommitThreads, 2, 4);
 
+  tsNumOfMergeThreads = tsNumOfCores / 2;
+  tsNumOfMergeThreads = TRANGE(tsNumOfMergeThreads, 2, 4);
+
+  tsNumOfScanDecodeThreads = tsNumOfCores / 2;
+  tsNumOfScanDecodeThreads = TRANGE(tsNumOfScanDecodeThreads, 1, 8);
+
   tsNumOfSupportVnodes = tsNumOfCores * 2 + 5;
   tsNumOfSupportVnodes = TMAX(tsNumOfSupportVnodes, 2);
 
@@ -835,6 +865,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryBufferSize", tsQueryBufferSize, -1, 500000000000, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY, CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryRspPolicy", tsQueryRspPolicy, 0, 1, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_GLOBAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfCommitThreads", tsNumOfCommitThreads, 1, 1024, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfMergeThreads", tsNumOfMergeThreads, 1, 1024, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfScanDecodeThreads", tsNumOfScanDecodeThreads, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_SERVER_LAZY,CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfCompactThreads", tsNumOfCompactThreads, 1, 16, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "retentionSpeedLimitMB", tsRetentionSpeedLimitMB, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_GLOBAL));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "queryUseMemoryPool", tsQueryUseMemoryPool, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_LOCAL) != 0);
@@ -953,6 +985,15 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
 
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "filterScalarMode", tsFilterScalarMode, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_LOCAL));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "pqSortMemThreshold", tsPQSortMemThreshold, 1, 10240, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "groupSpillMemThreshold", tsGroupSpillMemThreshold, 0, 1048576, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "tsdbBlockBloomFilter", tsTsdbBlockBloomFilter, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "cacheLastWarmup", tsCacheLastWarmup, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "cacheLastWarmupRowsPerSec", tsCacheLastWarmupRowsPerSec, 0, INT32_MAX, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbColCacheSize", tsTsdbColCacheSize, 0, 65536, CFG_SCOPE_SERVER, CFG_DYN_NONE,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "tsdbReadAheadPages", tsTsdbReadAheadPages, 0, 4096, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "walGroupCommit", tsWalGroupCommit, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "walPreallocSize", tsWalPreallocSize, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "syncAppendBatchSize", tsSyncAppendBatchSize, 0, 16384, CFG_SCOPE_SERVER, CFG_DYN_SERVER,CFG_CATEGORY_LOCAL));
 
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "ssEnabled", tsSsEnabled, 0, 2, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER,CFG_CATEGORY_GLOBAL));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "ssAccessString", tsSsAccessString, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER_LAZY,CFG_CATEGORY_GLOBAL));
@@ -1038,6 +1079,22 @@ static int32_t taosUpdateServerCfg(SConfig *pCfg) {
     pItem->stype = stype;
   }
 
+  pItem = cfgGetItem(pCfg, "numOfMergeThreads");
+  if (pItem != NULL && pItem->stype == CFG_STYPE_DEFAULT) {
+    tsNumOfMergeThreads = numOfCores / 2;
+    tsNumOfMergeThreads = TRANGE(tsNumOfMergeThreads, 2, 4);
+    pItem->i32 = tsNumOfMergeThreads;
+    pItem->stype = stype;
+  }
+
+  pItem = cfgGetItem(pCfg, "numOfScanDecodeThreads");
+  if (pItem != NULL && pItem->stype == CFG_STYPE_DEFAULT) {
+    tsNumOfScanDecodeThreads = numOfCores / 2;
+    tsNumOfScanDecodeThreads = TRANGE(tsNumOfScanDecodeThreads, 1, 8);
+    pItem->i32 = tsNumOfScanDecodeThreads;
+    pItem->stype = stype;
+  }
+
   pItem = cfgGetItem(pCfg, "numOfCompactThreads");
   if (pItem != NULL && pItem->stype == CFG_STYPE_DEFAULT) {
     pItem->i32 = tsNumOfCompactThreads;
@@ -1381,12 +1438,21 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "compressMsgSize");
   tsCompressMsgSize = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "compressMsgAlgorithm");
+  tsCompressMsgAlgorithm = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "rpcLocalSocket");
+  tsRpcLocalSocket = pItem->bval;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfTaskQueueThreads");
   tsNumOfTaskQueueThreads = pItem->i32;
 
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryPolicy");
   tsQueryPolicy = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryMaxStaleness");
+  tsQueryMaxStaleness = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryTableNotExistAsEmpty");
   tsQueryTbNotExistAsEmpty = pItem->bval;
 
@@ -1593,6 +1659,12 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfCommitThreads");
   tsNumOfCommitThreads = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfMergeThreads");
+  tsNumOfMergeThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfScanDecodeThreads");
+  tsNumOfScanDecodeThreads = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfCompactThreads");
   tsNumOfCompactThreads = pItem->i32;
 
@@ -1905,6 +1977,33 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "pqSortMemThreshold");
   tsPQSortMemThreshold = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "groupSpillMemThreshold");
+  tsGroupSpillMemThreshold = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbBlockBloomFilter");
+  tsTsdbBlockBloomFilter = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "cacheLastWarmup");
+  tsCacheLastWarmup = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "cacheLastWarmupRowsPerSec");
+  tsCacheLastWarmupRowsPerSec = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbColCacheSize");
+  tsTsdbColCacheSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "tsdbReadAheadPages");
+  tsTsdbReadAheadPages = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "walGroupCommit");
+  tsWalGroupCommit = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "walPreallocSize");
+  tsWalPreallocSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "syncAppendBatchSize");
+  tsSyncAppendBatchSize = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "minDiskFreeSize");
   tsMinDiskFreeSize = pItem->i64;
 
@@ -2686,6 +2785,7 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, const char *name) {
                                          {"maxRange", &tsMaxRange},
                                          {"maxTsmaNum", &tsMaxTsmaNum},
                                          {"queryRsmaTolerance", &tsQueryRsmaTolerance},
+                                         {"groupSpillMemThreshold", &tsGroupSpillMemThreshold},
                                          {"uptimeInterval", &tsUptimeInterval},
 
                                          {"slowLogMaxLen", &tsSlowLogMaxLen},
@@ -2722,6 +2822,13 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, const char *name) {
 
                                          {"retentionSpeedLimitMB", &tsRetentionSpeedLimitMB},
                                          {"ttlChangeOnWrite", &tsTtlChangeOnWrite},
+                                         {"tsdbBlockBloomFilter", &tsTsdbBlockBloomFilter},
+                                         {"cacheLastWarmup", &tsCacheLastWarmup},
+                                         {"cacheLastWarmupRowsPerSec", &tsCacheLastWarmupRowsPerSec},
+                                         {"tsdbReadAheadPages", &tsTsdbReadAheadPages},
+                                         {"walGroupCommit", &tsWalGroupCommit},
+                                         {"walPreallocSize", &tsWalPreallocSize},
+                                         {"syncAppendBatchSize", &tsSyncAppendBatchSize},
 
                                          {"logKeepDays", &tsLogKeepDays},
                                          {"mqRebalanceInterval", &tsMqRebalanceInterval},
@@ -3003,6 +3110,7 @@ static int32_t taosCfgDynamicOptionsForClient(SConfig *pCfg, const char *name) {
                                          {"numOfLogLines", &tsNumOfLogLines},
                                          {"querySmaOptimize", &tsQuerySmaOptimize},
                                          {"queryPolicy", &tsQueryPolicy},
+                                         {"queryMaxStaleness", &tsQueryMaxStaleness},
                                          {"queryTableNotExistAsEmpty", &tsQueryTbNotExistAsEmpty},
                                          {"queryPlannerTrace", &tsQueryPlannerTrace},
                                          {"queryNodeChunkSize", &tsQueryNodeChunkSize},
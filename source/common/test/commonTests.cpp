@@ -467,6 +467,72 @@ TEST(testCase, var_dataBlock_split_test) {
   blockDataDestroy(b);
 }
 
+TEST(testCase, dataBlock_reorder_test) {
+  int32_t numOfRows = 1000;
+
+  SSDataBlock* b = NULL;
+  int32_t      code = createDataBlock(&b);
+  ASSERT_EQ(code, 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  ASSERT_EQ(blockDataAppendColInfo(b, &infoData), 0);
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 2);
+  ASSERT_EQ(blockDataAppendColInfo(b, &infoData1), 0);
+  ASSERT_EQ(blockDataEnsureCapacity(b, numOfRows), 0);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+
+  // every 7th int and every 11th varchar is NULL, varchars have different lengths
+  char buf[40] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    ASSERT_EQ(colDataSetVal(p0, i, (const char*)&i, (i % 7) == 0), 0);
+    int32_t len = snprintf(varDataVal(buf), sizeof(buf) - VARSTR_HEADER_SIZE, "row%0*d", i % 20, i);
+    varDataSetLen(buf, len);
+    ASSERT_EQ(colDataSetVal(p1, i, buf, (i % 11) == 0), 0);
+    b->info.rows++;
+  }
+
+  // scatter the rows as the batch group-by does, keeping the original order within the same residue
+  int32_t* index = (int32_t*)taosMemoryMalloc(numOfRows * sizeof(int32_t));
+  ASSERT_NE(index, nullptr);
+  int32_t n = 0;
+  for (int32_t r = 0; r < 13; ++r) {
+    for (int32_t i = r; i < numOfRows; i += 13) {
+      index[n++] = i;
+    }
+  }
+  ASSERT_EQ(n, numOfRows);
+  ASSERT_EQ(blockDataReorder(b, index), 0);
+  ASSERT_EQ(b->info.rows, numOfRows);
+
+  p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t j = 0; j < numOfRows; ++j) {
+    int32_t i = index[j];
+    ASSERT_EQ(colDataIsNull_f(p0, j), (i % 7) == 0);
+    if ((i % 7) != 0) {
+      ASSERT_EQ(*(int32_t*)colDataGetData(p0, j), i);
+    }
+    ASSERT_EQ(colDataIsNull_s(p1, j), (i % 11) == 0);
+    if ((i % 11) != 0) {
+      int32_t len = snprintf(buf, sizeof(buf), "row%0*d", i % 20, i);
+      char*   pData = colDataGetData(p1, j);
+      ASSERT_EQ(varDataLen(pData), len);
+      ASSERT_EQ(memcmp(varDataVal(pData), buf, len), 0);
+    }
+  }
+
+  // the reordered block still splits and copies like any other block
+  SSDataBlock* pCopy = NULL;
+  ASSERT_EQ(createOneDataBlock(b, true, &pCopy), 0);
+  ASSERT_EQ(pCopy->info.rows, numOfRows);
+  blockDataDestroy(pCopy);
+
+  taosMemoryFree(index);
+  blockDataDestroy(b);
+}
+
 void check_tm(const STm* tm, int32_t y, int32_t mon, int32_t d, int32_t h, int32_t m, int32_t s, int64_t fsec) {
   ASSERT_EQ(tm->tm.tm_year, y);
   ASSERT_EQ(tm->tm.tm_mon, mon);
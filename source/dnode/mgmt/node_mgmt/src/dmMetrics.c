@@ -26,6 +26,16 @@ static void collectDnodeMetricsInfo(SDnode *pDnode) {
   rawMetrics.applyMemoryAllowed = tsApplyMemoryAllowed;
   rawMetrics.applyMemoryUsed = atomic_load_64(&tsApplyMemoryUsed);
 
+  SRpcStat rpcStat = {0};
+  rpcGetStat(&rpcStat);
+  rawMetrics.rpcCompRawBytes = rpcStat.compRawBytes;
+  rawMetrics.rpcCompBytes = rpcStat.compBytes;
+  rawMetrics.rpcCompCostUs = rpcStat.compCostUs;
+  rawMetrics.rpcDecompCostUs = rpcStat.decompCostUs;
+  rawMetrics.rpcSendWrites = rpcStat.sendWrites;
+  rawMetrics.rpcSendMsgs = rpcStat.sendMsgs;
+  rawMetrics.rpcSendBytes = rpcStat.sendBytes;
+
   int32_t code = addDnodeMetrics(&rawMetrics, dmGetClusterId(), pDnode->data.dnodeId, tsLocalEp);
   if (code != TSDB_CODE_SUCCESS) {
     dError("Failed to add dnode metrics, code: %d", code);
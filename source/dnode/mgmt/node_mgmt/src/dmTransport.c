@@ -435,6 +435,8 @@ int32_t dmInitClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlgorithm = tsCompressMsgAlgorithm;
+  rpcInit.localSock = tsRpcLocalSocket;
   rpcInit.dfp = destroyAhandle;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
@@ -497,6 +499,8 @@ int32_t dmInitStatusClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlgorithm = tsCompressMsgAlgorithm;
+  rpcInit.localSock = tsRpcLocalSocket;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
   rpcInit.retryStepFactor = tsRedirectFactor;
@@ -555,6 +559,8 @@ int32_t dmInitSyncClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlgorithm = tsCompressMsgAlgorithm;
+  rpcInit.localSock = tsRpcLocalSocket;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
   rpcInit.retryStepFactor = tsRedirectFactor;
@@ -639,6 +645,8 @@ int32_t dmInitServer(SDnode *pDnode) {
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.parent = pDnode;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlgorithm = tsCompressMsgAlgorithm;
+  rpcInit.localSock = tsRpcLocalSocket;
   rpcInit.shareConnLimit = tsShareConnLimit * 16;
   rpcInit.ipv6 = tsEnableIpv6;
   rpcInit.enableSSL = tsEnableTLS;
@@ -83,6 +83,10 @@ typedef struct STsdbRowKey      STsdbRowKey;
 #define TSDB_FILE_DLMT ((uint32_t)0xF00AFA0F)
 #define TSDB_FHDR_SIZE 512
 
+#define TSDB_BLOCK_BLOOM_FILTER_FLAG       0x40000000
+#define TSDB_BLOCK_BLOOM_FILTER_ERROR_RATE 0.01
+#define TSDB_BLOCK_BLOOM_FILTER_TYPE(t) (IS_INTEGER_TYPE(t) || (t) == TSDB_DATA_TYPE_VARCHAR)
+
 #define VERSION_MIN 0
 #define VERSION_MAX INT64_MAX
 
@@ -194,6 +198,8 @@ void    tBlockDataDestroy(SBlockData *pBlockData);
 int32_t tBlockDataInit(SBlockData *pBlockData, TABLEID *pId, STSchema *pTSchema, int16_t *aCid, int32_t nCid);
 void    tBlockDataReset(SBlockData *pBlockData);
 int32_t tBlockDataAppendRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema, int64_t uid);
+int32_t tBlockDataAppendBlockRows(SBlockData *pBlockData, SBlockData *pBlockDataFrom, int32_t iRow, int32_t nRow,
+                                  int64_t uid);
 int32_t tBlockDataUpdateRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema);
 int32_t tBlockDataTryUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, int64_t uid);
 int32_t tBlockDataUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema, int64_t uid);
@@ -206,6 +212,7 @@ int32_t tBlockDataDecompressColData(const SDiskDataHdr *hdr, const SBlockCol *bl
 
 SColData *tBlockDataGetColData(SBlockData *pBlockData, int16_t cid);
 int32_t   tBlockDataAddColData(SBlockData *pBlockData, int16_t cid, int8_t type, int8_t cflag, SColData **ppColData);
+int32_t   tBlockDataMergeColData(SBlockData *pBlockData, SColData *aColData, int32_t nColData);
 // SDiskDataHdr
 int32_t tPutDiskDataHdr(SBuffer *buffer, const SDiskDataHdr *pHdr);
 int32_t tGetDiskDataHdr(SBufferReader *br, SDiskDataHdr *pHdr);
@@ -236,6 +243,9 @@ int32_t tsdbFidLevel(int32_t fid, STsdbKeepCfg *pKeepCfg, int64_t nowSec);
 int32_t tsdbBuildDeleteSkyline(SArray *aDelData, int32_t sidx, int32_t eidx, SArray *aSkyline);
 int32_t tPutColumnDataAgg(SBuffer *buffer, SColumnDataAgg *pColAgg);
 int32_t tGetColumnDataAgg(SBufferReader *br, SColumnDataAgg *pColAgg);
+int32_t tPutBlockBloomFilter(SBuffer *buffer, int16_t cid, const SBloomFilter *pBF);
+int32_t tGetBlockBloomFilter(SBufferReader *br, int16_t *cid, SBloomFilter **ppBF);
+bool    tIsBlockBloomFilter(const SBufferReader *br);
 int32_t tRowInfoCmprFn(const void *p1, const void *p2);
 // tsdbMemTable ==============================================================================================
 // SMemTable
@@ -312,6 +322,8 @@ int32_t tsdbMerge(void *arg);
 #define TSDB_STT_FILE_DATA_ITER  2
 #define TSDB_TOMB_FILE_DATA_ITER 3
 
+#define TSDB_CACHE_LOCK_STRIPES 16
+
 #define TSDB_FILTER_FLAG_BY_VERSION           0x1
 #define TSDB_FILTER_FLAG_BY_TABLEID           0x2
 #define TSDB_FILTER_FLAG_IGNORE_DROPPED_TABLE 0x4
@@ -372,13 +384,20 @@ struct STsdb {
   SMemTable           *imem;
   STsdbFS              fs;  // old
   SLRUCache           *lruCache;
-  TdThreadMutex        lruMutex;
+  TdThreadMutex        lruMutex[TSDB_CACHE_LOCK_STRIPES];  // striped by table uid
+  TdThreadRwlock       lruEvictLock;  // shared by calls that may evict, exclusive for write batch read back
   SLRUCache           *biCache;
   TdThreadMutex        biMutex;
   SLRUCache           *bCache;
   TdThreadMutex        bMutex;
   SLRUCache           *pgCache;
   TdThreadMutex        pgMutex;
+  SLRUCache           *colCache;  // decompressed columns of data/stt blocks
+  struct {
+    int64_t hit;
+    int64_t miss;
+    int64_t evict;
+  } colCacheStat;
   struct STFileSystem *pFS;  // new
   SRocksCache          rCache;
   SCompMonitor        *pCompMonitor;
@@ -389,6 +408,10 @@ struct STsdb {
     SArray      *arr;
   } *commitInfo;
   struct SScanMonitor *pScanMonitor;
+  struct {
+    SVATaskID        taskId;
+    volatile int32_t killed;
+  } cacheWarmup;
 };
 
 struct TSDBKEY {
@@ -674,6 +697,16 @@ typedef struct {
   int32_t     fid;
   int64_t     cid;
   int64_t     blkno;
+  bool        noCache;    // bulk scan, keep its pages out of the caches
+  bool        dropCache;  // opened for commit, merge or snapshot, also drop its pages from the OS page cache
+  struct {
+    int64_t  lastPgno;
+    int64_t  nSeq;    // pages read sequentially so far
+    int64_t  pgno;    // first page held in pBuf
+    int32_t  nPage;   // pages held in pBuf
+    int32_t  window;  // pages of the last read ahead
+    uint8_t *pBuf;
+  } ra;
 } STsdbFD;
 
 struct SDelFWriter {
@@ -954,6 +987,7 @@ void    tsdbCloseCache(STsdb *pTsdb);
 int32_t tsdbCacheRowFormatUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, int64_t version, int32_t nRow, SRow **aRow);
 int32_t tsdbCacheColFormatUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SBlockData *pBlockData);
 int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKEY eKey);
+int32_t tsdbAsyncCacheWarmup(STsdb *pTsdb);
 
 int32_t tsdbCacheInsertLast(SLRUCache *pCache, tb_uid_t uid, TSDBROW *row, STsdb *pTsdb);
 int32_t tsdbCacheInsertLastrow(SLRUCache *pCache, STsdb *pTsdb, tb_uid_t uid, TSDBROW *row, bool dup);
@@ -966,6 +1000,13 @@ int32_t tsdbCacheGetBlockSs(SLRUCache *pCache, STsdbFD *pFD, LRUHandle **handle)
 int32_t tsdbCacheGetPageSs(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, LRUHandle **handle);
 void    tsdbCacheSetPageSs(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_t *pPage);
 
+struct STFile;
+int32_t tsdbCacheGetColData(STsdb *pTsdb, const struct STFile *pFile, int64_t offset, int16_t cid,
+                            SBlockData *pBlockData, bool *hit);
+void    tsdbCachePutColData(STsdb *pTsdb, const struct STFile *pFile, int64_t offset, const SColData *pColData);
+void    tsdbGetColCacheStat(STsdb *pTsdb, int64_t *hit, int64_t *miss, int64_t *evict);
+void    tsdbResetColCacheStat(STsdb *pTsdb, int64_t hit, int64_t miss, int64_t evict);
+
 int32_t tsdbCacheDeleteLastrow(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDeleteLast(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDelete(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
@@ -67,6 +67,7 @@ typedef enum {
 #define COMPACT_TASK_ASYNC   3
 #define RETENTION_TASK_ASYNC 4
 #define SCAN_TASK_ASYNC      5
+#define DECODE_TASK_ASYNC    6
 
 int32_t vnodeAsyncOpen();
 void    vnodeAsyncClose();
@@ -115,6 +116,7 @@ int32_t vnodeOpenBufPool(SVnode* pVnode);
 void    vnodeCloseBufPool(SVnode* pVnode);
 void    vnodeBufPoolReset(SVBufPool* pPool);
 void    vnodeBufPoolAddToFreeList(SVBufPool* pPool);
+int64_t vnodeBufPoolSegmentSize(SVnode* pVnode);
 int32_t vnodeBufPoolRecycle(SVBufPool* pPool);
 
 // vnodeOpen.c
@@ -131,6 +133,11 @@ int32_t vnodeGetBatchMeta(SVnode* pVnode, SRpcMsg* pMsg);
 int32_t vnodeGetVSubtablesMeta(SVnode *pVnode, SRpcMsg *pMsg);
 int32_t vnodeGetVStbRefDbs(SVnode *pVnode, SRpcMsg *pMsg);
 
+// vnodeSvr.c
+int32_t vnodeAddFollowerRead(SVnode* pVnode, uint64_t queryId, uint64_t taskId);
+bool    vnodeIsFollowerReadFetch(SVnode* pVnode, SRpcMsg* pMsg);
+void    vnodeRemoveFollowerRead(SVnode* pVnode, SRpcMsg* pMsg);
+
 // vnodeCommit.c
 int32_t vnodeBegin(SVnode* pVnode);
 int32_t vnodeShouldCommit(SVnode* pVnode, bool atExit);
@@ -479,6 +479,7 @@ struct SVnodeWriteMetrics {
   int64_t merge_count;
   int64_t commit_time;
   int64_t merge_time;
+  int64_t merge_bytes;
   int64_t block_commit_time;
   int64_t blocked_commit_count;
   int64_t memtable_wait_time;
@@ -536,6 +537,7 @@ struct SVnode {
   int32_t       blockSec;
   int64_t       blockSeq;
   SQHandle*     pQuery;
+  SHashObj*     pFollowerReads;  // tasks accepted as follower reads, their fetches are served by a follower
   SVMonitorObj  monitor;
   uint32_t      applyQueueErrorCount;
 
@@ -277,10 +277,36 @@ static void tsdbCloseRocksCache(STsdb *pTsdb) {
 #endif
 }
 
+/*
+ * The last cache is locked per table stripe, tables in different stripes may reach the shared write batch
+ * at the same time, so it is guarded by writeBatchMutex.
+ */
+static FORCE_INLINE TdThreadMutex *tsdbCacheTableMutex(STsdb *pTsdb, tb_uid_t uid) {
+  uint64_t h = (uint64_t)uid;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return &pTsdb->lruMutex[h % TSDB_CACHE_LOCK_STRIPES];
+}
+
+// for operations across tables, e.g. flushing the cache or schema changes
+static void tsdbCacheLockAll(STsdb *pTsdb) {
+  for (int32_t i = 0; i < TSDB_CACHE_LOCK_STRIPES; ++i) {
+    (void)taosThreadMutexLock(&pTsdb->lruMutex[i]);
+  }
+}
+
+static void tsdbCacheUnlockAll(STsdb *pTsdb) {
+  for (int32_t i = TSDB_CACHE_LOCK_STRIPES - 1; i >= 0; --i) {
+    (void)taosThreadMutexUnlock(&pTsdb->lruMutex[i]);
+  }
+}
+
 static void rocksMayWrite(STsdb *pTsdb, bool force) {
 #ifdef USE_ROCKSDB
   rocksdb_writebatch_t *wb = pTsdb->rCache.writebatch;
 
+  (void)taosThreadMutexLock(&pTsdb->rCache.writeBatchMutex);
   int count = rocksdb_writebatch_count(wb);
   if ((force && count > 0) || count >= ROCKS_BATCH_SIZE) {
     char *err = NULL;
@@ -294,6 +320,7 @@ static void rocksMayWrite(STsdb *pTsdb, bool force) {
 
     rocksdb_writebatch_clear(wb);
   }
+  (void)taosThreadMutexUnlock(&pTsdb->rCache.writeBatchMutex);
 #endif
 }
 
@@ -793,7 +820,7 @@ int32_t tsdbCacheCommit(STsdb *pTsdb) {
   SLRUCache *pCache = pTsdb->lruCache;
   // rocksdb_writebatch_t *wb = pTsdb->rCache.writebatch;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   taosLRUCacheApply(pCache, tsdbCacheFlushDirty, pTsdb);
 
@@ -801,7 +828,7 @@ int32_t tsdbCacheCommit(STsdb *pTsdb) {
   rocksMayWrite(pTsdb, true);
   rocksdb_flush(pTsdb->rCache.db, pTsdb->rCache.flushoptions, &err);
 #endif
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
 #ifdef USE_ROCKSDB
   if (NULL != err) {
     tsdbError("vgId:%d, %s failed at line %d since %s", TD_VID(pTsdb->pVnode), __func__, __LINE__, err);
@@ -993,6 +1020,23 @@ static int32_t tsdbCacheGetValuesFromRocks(STsdb *pTsdb, size_t numKeys, const c
   TAOS_RETURN(TSDB_CODE_SUCCESS);
 }
 
+/*
+ * An evicted dirty entry leaves the LRU before its deleter puts it into the write batch, and the evicting thread
+ * may work on another table stripe. Block evictions between flushing the batch and reading rocksdb back, so the
+ * values read are never older than what the cache has just dropped.
+ */
+static int32_t tsdbCacheFlushAndGetValuesFromRocks(STsdb *pTsdb, size_t numKeys, const char *const *ppKeysList,
+                                                   size_t *pKeysListSizes, char ***pppValuesList,
+                                                   size_t **ppValuesListSizes) {
+  (void)taosThreadRwlockWrlock(&pTsdb->lruEvictLock);
+  rocksMayWrite(pTsdb, true);  // flush writebatch cache
+  int32_t code =
+      tsdbCacheGetValuesFromRocks(pTsdb, numKeys, ppKeysList, pKeysListSizes, pppValuesList, ppValuesListSizes);
+  (void)taosThreadRwlockUnlock(&pTsdb->lruEvictLock);
+
+  TAOS_RETURN(code);
+}
+
 static int32_t tsdbCacheDropTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid, bool hasPrimaryKey) {
   int32_t code = 0;
 
@@ -1045,7 +1089,9 @@ static int32_t tsdbCacheDropTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid,
         goto _exit;
       }
       if (NULL != pLastCol) {
+        (void)taosThreadMutexLock(&pTsdb->rCache.writeBatchMutex);
         rocksdb_writebatch_delete(wb, keys_list[0], klen);
+        (void)taosThreadMutexUnlock(&pTsdb->rCache.writeBatchMutex);
       }
       taosMemoryFreeClear(pLastCol);
     }
@@ -1059,7 +1105,9 @@ static int32_t tsdbCacheDropTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid,
         goto _exit;
       }
       if (NULL != pLastCol) {
+        (void)taosThreadMutexLock(&pTsdb->rCache.writeBatchMutex);
         rocksdb_writebatch_delete(wb, keys_list[1], klen);
+        (void)taosThreadMutexUnlock(&pTsdb->rCache.writeBatchMutex);
       }
       taosMemoryFreeClear(pLastCol);
     }
@@ -1071,8 +1119,10 @@ static int32_t tsdbCacheDropTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid,
     for (int i = 0; i < 2; i++) {
       LRUHandle *h = taosLRUCacheLookup(pTsdb->lruCache, keys_list[i], klen);
       if (h) {
+        (void)taosThreadRwlockRdlock(&pTsdb->lruEvictLock);
         tsdbLRUCacheRelease(pTsdb->lruCache, h, true);
         taosLRUCacheErase(pTsdb->lruCache, keys_list[i], klen);
+        (void)taosThreadRwlockUnlock(&pTsdb->lruEvictLock);
       }
     }
   }
@@ -1091,7 +1141,7 @@ _exit:
 int32_t tsdbCacheNewTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, const SSchemaWrapper *pSchemaRow) {
   int32_t code = 0;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   if (suid < 0) {
     for (int i = 0; i < pSchemaRow->nCols; ++i) {
@@ -1113,7 +1163,7 @@ int32_t tsdbCacheNewTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, const SSche
     STSchema *pTSchema = NULL;
     code = metaGetTbTSchemaEx(pTsdb->pVnode->pMeta, suid, uid, -1, &pTSchema);
     if (code != TSDB_CODE_SUCCESS) {
-      (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+      tsdbCacheUnlockAll(pTsdb);
 
       TAOS_RETURN(code);
     }
@@ -1137,7 +1187,7 @@ int32_t tsdbCacheNewTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, const SSche
     taosMemoryFree(pTSchema);
   }
 
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
 
   TAOS_RETURN(code);
 }
@@ -1145,7 +1195,7 @@ int32_t tsdbCacheNewTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, const SSche
 int32_t tsdbCacheDropTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, SSchemaWrapper *pSchemaRow) {
   int32_t code = 0;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   code = tsdbCacheCommitNoLock(pTsdb);
   if (code != TSDB_CODE_SUCCESS) {
@@ -1173,7 +1223,7 @@ int32_t tsdbCacheDropTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, SSchemaWra
     STSchema *pTSchema = NULL;
     code = metaGetTbTSchemaEx(pTsdb->pVnode->pMeta, suid, uid, -1, &pTSchema);
     if (code != TSDB_CODE_SUCCESS) {
-      (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+      tsdbCacheUnlockAll(pTsdb);
 
       TAOS_RETURN(code);
     }
@@ -1199,7 +1249,7 @@ int32_t tsdbCacheDropTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, SSchemaWra
 
   rocksMayWrite(pTsdb, false);
 
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
 
   TAOS_RETURN(code);
 }
@@ -1207,7 +1257,7 @@ int32_t tsdbCacheDropTable(STsdb *pTsdb, tb_uid_t uid, tb_uid_t suid, SSchemaWra
 int32_t tsdbCacheDropSubTables(STsdb *pTsdb, SArray *uids, tb_uid_t suid) {
   int32_t code = 0;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   code = tsdbCacheCommitNoLock(pTsdb);
   if (code != TSDB_CODE_SUCCESS) {
@@ -1218,7 +1268,7 @@ int32_t tsdbCacheDropSubTables(STsdb *pTsdb, SArray *uids, tb_uid_t suid) {
   STSchema *pTSchema = NULL;
   code = metaGetTbTSchemaEx(pTsdb->pVnode->pMeta, suid, suid, -1, &pTSchema);
   if (code != TSDB_CODE_SUCCESS) {
-    (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+    tsdbCacheUnlockAll(pTsdb);
 
     TAOS_RETURN(code);
   }
@@ -1248,7 +1298,7 @@ int32_t tsdbCacheDropSubTables(STsdb *pTsdb, SArray *uids, tb_uid_t suid) {
 
   rocksMayWrite(pTsdb, false);
 
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
 
   TAOS_RETURN(code);
 }
@@ -1256,7 +1306,7 @@ int32_t tsdbCacheDropSubTables(STsdb *pTsdb, SArray *uids, tb_uid_t suid) {
 int32_t tsdbCacheNewNTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid, int8_t col_type) {
   int32_t code = 0;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   code = tsdbCacheNewTableColumn(pTsdb, uid, cid, col_type, 0);
   if (code != TSDB_CODE_SUCCESS) {
@@ -1269,7 +1319,7 @@ int32_t tsdbCacheNewNTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid, int8_t
               tstrerror(code));
   }
   // rocksMayWrite(pTsdb, true, false, false);
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
 
   TAOS_RETURN(code);
 }
@@ -1277,7 +1327,7 @@ int32_t tsdbCacheNewNTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid, int8_t
 int32_t tsdbCacheDropNTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid, bool hasPrimayKey) {
   int32_t code = 0;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   code = tsdbCacheCommitNoLock(pTsdb);
   if (code != TSDB_CODE_SUCCESS) {
@@ -1293,7 +1343,7 @@ int32_t tsdbCacheDropNTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid, bool h
 
   rocksMayWrite(pTsdb, false);
 
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
 
   TAOS_RETURN(code);
 }
@@ -1301,7 +1351,7 @@ int32_t tsdbCacheDropNTableColumn(STsdb *pTsdb, int64_t uid, int16_t cid, bool h
 int32_t tsdbCacheNewSTableColumn(STsdb *pTsdb, SArray *uids, int16_t cid, int8_t col_type) {
   int32_t code = 0;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   for (int i = 0; i < TARRAY_SIZE(uids); ++i) {
     tb_uid_t uid = ((tb_uid_t *)TARRAY_DATA(uids))[i];
@@ -1319,14 +1369,14 @@ int32_t tsdbCacheNewSTableColumn(STsdb *pTsdb, SArray *uids, int16_t cid, int8_t
   }
 
   // rocksMayWrite(pTsdb, true, false, false);
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
   TAOS_RETURN(code);
 }
 
 int32_t tsdbCacheDropSTableColumn(STsdb *pTsdb, SArray *uids, int16_t cid, bool hasPrimayKey) {
   int32_t code = 0;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  tsdbCacheLockAll(pTsdb);
 
   code = tsdbCacheCommitNoLock(pTsdb);
   if (code != TSDB_CODE_SUCCESS) {
@@ -1346,7 +1396,7 @@ int32_t tsdbCacheDropSTableColumn(STsdb *pTsdb, SArray *uids, int16_t cid, bool
 
   rocksMayWrite(pTsdb, false);
 
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  tsdbCacheUnlockAll(pTsdb);
 
   TAOS_RETURN(code);
 }
@@ -1418,8 +1468,10 @@ static int32_t tsdbCachePutToLRU(STsdb *pTsdb, SLastKey *pLastKey, SLastCol *pLa
   pLRULastCol->dirty = dirty;
   TAOS_CHECK_EXIT(tsdbCacheReallocSLastCol(pLRULastCol, &charge));
 
+  (void)taosThreadRwlockRdlock(&pTsdb->lruEvictLock);
   LRUStatus status = taosLRUCacheInsert(pTsdb->lruCache, pLastKey, ROCKS_KEY_LEN, pLRULastCol, charge, tsdbCacheDeleter,
                                         tsdbCacheOverWriter, NULL, TAOS_LRU_PRIORITY_LOW, pTsdb);
+  (void)taosThreadRwlockUnlock(&pTsdb->lruEvictLock);
   if (TAOS_LRU_STATUS_OK != status && TAOS_LRU_STATUS_OK_OVERWRITTEN != status) {
     tsdbError("vgId:%d, %s failed at line %d status %d.", TD_VID(pTsdb->pVnode), __func__, __LINE__, status);
     code = TSDB_CODE_FAILED;
@@ -1446,7 +1498,7 @@ static int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SArray
   SArray    *remainCols = NULL;
   SLRUCache *pCache = pTsdb->lruCache;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  (void)taosThreadMutexLock(tsdbCacheTableMutex(pTsdb, uid));
   for (int i = 0; i < num_keys; ++i) {
     SLastUpdateCtx *updCtx = &((SLastUpdateCtx *)TARRAY_DATA(updCtxArray))[i];
     int8_t          lflag = updCtx->lflag;
@@ -1496,13 +1548,13 @@ static int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SArray
     char  **errs = NULL;
     keys_list = taosMemoryCalloc(num_keys, sizeof(char *));
     if (!keys_list) {
-      (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+      (void)taosThreadMutexUnlock(tsdbCacheTableMutex(pTsdb, uid));
       return terrno;
     }
     keys_list_sizes = taosMemoryCalloc(num_keys, sizeof(size_t));
     if (!keys_list_sizes) {
       taosMemoryFree(keys_list);
-      (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+      (void)taosThreadMutexUnlock(tsdbCacheTableMutex(pTsdb, uid));
       return terrno;
     }
     for (int i = 0; i < num_keys; ++i) {
@@ -1512,10 +1564,8 @@ static int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SArray
       keys_list_sizes[i] = ROCKS_KEY_LEN;
     }
 
-    rocksMayWrite(pTsdb, true);  // flush writebatch cache
-
-    code = tsdbCacheGetValuesFromRocks(pTsdb, num_keys, (const char *const *)keys_list, keys_list_sizes, &values_list,
-                                       &values_list_sizes);
+    code = tsdbCacheFlushAndGetValuesFromRocks(pTsdb, num_keys, (const char *const *)keys_list, keys_list_sizes,
+                                               &values_list, &values_list_sizes);
     if (code) {
       taosMemoryFree(keys_list);
       taosMemoryFree(keys_list_sizes);
@@ -1604,7 +1654,7 @@ static int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SArray
   }
 
 _exit:
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  (void)taosThreadMutexUnlock(tsdbCacheTableMutex(pTsdb, uid));
   taosArrayDestroy(remainCols);
 
   if (code) {
@@ -1988,10 +2038,8 @@ static int32_t tsdbCacheLoadFromRocks(STsdb *pTsdb, tb_uid_t uid, SArray *pLastA
     keys_list_sizes[i] = ROCKS_KEY_LEN;
   }
 
-  rocksMayWrite(pTsdb, true);  // flush writebatch cache
-
-  code = tsdbCacheGetValuesFromRocks(pTsdb, num_keys, (const char *const *)keys_list, keys_list_sizes, &values_list,
-                                     &values_list_sizes);
+  code = tsdbCacheFlushAndGetValuesFromRocks(pTsdb, num_keys, (const char *const *)keys_list, keys_list_sizes,
+                                             &values_list, &values_list_sizes);
   if (code) {
     taosMemoryFree(key_list);
     taosMemoryFree(keys_list);
@@ -2150,7 +2198,7 @@ static int32_t tsdbCacheGetBatchFromLru(STsdb *pTsdb, tb_uid_t uid, SArray *pLas
   }
 
   if (remainCols && TARRAY_SIZE(remainCols) > 0) {
-    (void)taosThreadMutexLock(&pTsdb->lruMutex);
+    (void)taosThreadMutexLock(tsdbCacheTableMutex(pTsdb, uid));
 
     for (int i = 0; i < TARRAY_SIZE(remainCols);) {
       SIdxKey   *idxKey = &((SIdxKey *)TARRAY_DATA(remainCols))[i];
@@ -2161,7 +2209,7 @@ static int32_t tsdbCacheGetBatchFromLru(STsdb *pTsdb, tb_uid_t uid, SArray *pLas
         code = tsdbCacheReallocSLastCol(&lastCol, NULL);
         if (code) {
           tsdbLRUCacheRelease(pCache, h, false);
-          (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+          (void)taosThreadMutexUnlock(tsdbCacheTableMutex(pTsdb, uid));
           TAOS_RETURN(code);
         }
 
@@ -2181,7 +2229,7 @@ static int32_t tsdbCacheGetBatchFromLru(STsdb *pTsdb, tb_uid_t uid, SArray *pLas
     // tsdbTrace("tsdb/cache: vgId: %d, load %" PRId64 " from rocks", TD_VID(pTsdb->pVnode), uid);
     code = tsdbCacheLoadFromRocks(pTsdb, uid, pLastArray, remainCols, ignoreFromRocks, pr, ltype);
 
-    (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+    (void)taosThreadMutexUnlock(tsdbCacheTableMutex(pTsdb, uid));
   }
 
 _exit:
@@ -2691,7 +2739,7 @@ int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKE
 
   int numCols = pTSchema->numOfCols;
 
-  (void)taosThreadMutexLock(&pTsdb->lruMutex);
+  (void)taosThreadMutexLock(tsdbCacheTableMutex(pTsdb, uid));
 
   for (int i = 0; i < numCols; ++i) {
     int16_t cid = pTSchema->columns[i].colId;
@@ -2749,10 +2797,8 @@ int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKE
     keys_list_sizes[i] = klen;
   }
 
-  rocksMayWrite(pTsdb, true);  // flush writebatch cache
-
-  TAOS_CHECK_GOTO(tsdbCacheGetValuesFromRocks(pTsdb, numKeys, (const char *const *)keys_list, keys_list_sizes,
-                                              &values_list, &values_list_sizes),
+  TAOS_CHECK_GOTO(tsdbCacheFlushAndGetValuesFromRocks(pTsdb, numKeys, (const char *const *)keys_list, keys_list_sizes,
+                                                      &values_list, &values_list_sizes),
                   NULL, _exit);
 
   // rocksdb_writebatch_t *wb = pTsdb->rCache.writebatch;
@@ -2797,7 +2843,7 @@ int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKE
   rocksMayWrite(pTsdb, false);
 
 _exit:
-  (void)taosThreadMutexUnlock(&pTsdb->lruMutex);
+  (void)taosThreadMutexUnlock(tsdbCacheTableMutex(pTsdb, uid));
 
   for (int i = 0; i < numKeys; ++i) {
     taosMemoryFree(keys_list[i]);
@@ -2819,6 +2865,662 @@ _exit:
   TAOS_RETURN(code);
 }
 
+// last cache warmup ==========================================================================================
+#define TSDB_CACHE_WARMUP_CHECK_ROWS  1024
+#define TSDB_CACHE_WARMUP_LOG_INTERVAL 10000  // ms
+
+typedef struct {
+  int16_t     cid;
+  bool        hasRow;
+  bool        hasLast;
+  SColVal     rowVal;   // value in the last row
+  STsdbRowKey lastKey;  // key of the last non-null value
+  SColVal     lastVal;  // last non-null value
+  uint8_t    *rowBuf;
+  uint32_t    rowCap;
+  uint8_t    *lastBuf;
+  uint32_t    lastCap;
+} SWarmupCol;
+
+typedef struct {
+  STsdb      *pTsdb;
+  int32_t     fid;
+  TABLEID     tbid[1];
+  bool        skip;
+  bool        hasRow;
+  STsdbRowKey rowKey;  // key of the last row
+  int32_t     nCol;
+  SArray     *aCol;  // SArray<SWarmupCol>, sorted by cid, buffers reused across tables
+  SArray     *ctxArray;
+  SSHashObj  *tombUids;
+  int64_t     nTable;
+  int64_t     nRow;
+  int64_t     startMs;
+  int64_t     logMs;
+} SCacheWarmer;
+
+static FORCE_INLINE bool tsdbCacheWarmupCanceled(STsdb *pTsdb) {
+  return atomic_load_32(&pTsdb->cacheWarmup.killed) != 0;
+}
+
+static int32_t tsdbCacheWarmupCopyVal(SColVal *pDst, uint8_t **ppBuf, uint32_t *pCap, const SColVal *pSrc) {
+  *pDst = *pSrc;
+  if ((IS_VAR_DATA_TYPE(pSrc->value.type) || pSrc->value.type == TSDB_DATA_TYPE_DECIMAL) && pSrc->value.nData > 0) {
+    if (*pCap < pSrc->value.nData) {
+      uint8_t *p = taosMemoryRealloc(*ppBuf, pSrc->value.nData);
+      if (p == NULL) {
+        return terrno;
+      }
+      *ppBuf = p;
+      *pCap = pSrc->value.nData;
+    }
+    (void)memcpy(*ppBuf, pSrc->value.pData, pSrc->value.nData);
+    pDst->value.pData = *ppBuf;
+  }
+  return 0;
+}
+
+// rows come with ascending column ids, so *pIdx works as a merge cursor
+static SWarmupCol *tsdbCacheWarmupGetCol(SCacheWarmer *pWarmer, int16_t cid, int32_t *pIdx) {
+  SWarmupCol *aCol = TARRAY_DATA(pWarmer->aCol);
+  int32_t     i = *pIdx;
+
+  while (i < pWarmer->nCol && aCol[i].cid < cid) i++;
+  if (i < pWarmer->nCol && aCol[i].cid == cid) {
+    *pIdx = i + 1;
+    return &aCol[i];
+  }
+
+  if (pWarmer->nCol == TARRAY_SIZE(pWarmer->aCol)) {
+    if (taosArrayPush(pWarmer->aCol, &(SWarmupCol){0}) == NULL) {
+      return NULL;
+    }
+    aCol = TARRAY_DATA(pWarmer->aCol);
+  }
+
+  SWarmupCol spare = aCol[pWarmer->nCol];
+  (void)memmove(&aCol[i + 1], &aCol[i], (pWarmer->nCol - i) * sizeof(SWarmupCol));
+  aCol[i] = spare;
+  aCol[i].cid = cid;
+  aCol[i].hasRow = false;
+  aCol[i].hasLast = false;
+  pWarmer->nCol++;
+
+  *pIdx = i + 1;
+  return &aCol[i];
+}
+
+static bool tsdbCacheWarmupHasMemDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid) {
+  bool hasDel = false;
+
+  (void)taosThreadMutexLock(&pTsdb->mutex);
+  SMemTable *aMem[] = {pTsdb->mem, pTsdb->imem};
+  for (int32_t i = 0; i < sizeof(aMem) / sizeof(aMem[0]) && !hasDel; i++) {
+    if (aMem[i] == NULL) continue;
+
+    STbData *pTbData = tsdbGetTbDataFromMemTable(aMem[i], suid, uid);
+    if (pTbData) {
+      taosRLockLatch(&pTbData->lock);
+      hasDel = (pTbData->pHead != NULL);
+      taosRUnLockLatch(&pTbData->lock);
+    }
+  }
+  (void)taosThreadMutexUnlock(&pTsdb->mutex);
+
+  return hasDel;
+}
+
+static int32_t tsdbCacheWarmupFlushTable(SCacheWarmer *pWarmer) {
+  int32_t code = 0, lino = 0;
+  STsdb  *pTsdb = pWarmer->pTsdb;
+  tb_uid_t suid = pWarmer->tbid->suid;
+  tb_uid_t uid = pWarmer->tbid->uid;
+
+  if (uid == 0 || pWarmer->skip || !pWarmer->hasRow) {
+    goto _exit;
+  }
+
+  // deleted data is left to the lazy load, which applies the tomb records
+  if (tsdbCacheWarmupHasMemDel(pTsdb, suid, uid)) {
+    goto _exit;
+  }
+
+  SWarmupCol *aCol = TARRAY_DATA(pWarmer->aCol);
+  for (int32_t i = 0; i < pWarmer->nCol; i++) {
+    if (aCol[i].hasRow) {
+      SLastUpdateCtx updateCtx = {.lflag = LFLAG_LAST_ROW, .tsdbRowKey = pWarmer->rowKey, .colVal = aCol[i].rowVal};
+      if (!taosArrayPush(pWarmer->ctxArray, &updateCtx)) {
+        TAOS_CHECK_EXIT(terrno);
+      }
+    }
+    if (aCol[i].hasLast) {
+      SLastUpdateCtx updateCtx = {.lflag = LFLAG_LAST, .tsdbRowKey = aCol[i].lastKey, .colVal = aCol[i].lastVal};
+      if (!taosArrayPush(pWarmer->ctxArray, &updateCtx)) {
+        TAOS_CHECK_EXIT(terrno);
+      }
+    }
+  }
+
+  TAOS_CHECK_EXIT(tsdbCacheUpdate(pTsdb, suid, uid, pWarmer->ctxArray));
+
+  // a delete may have reached the memtable while the table was scanned, its own tsdbCacheDel could run before
+  // the update above, so drop what was just cached.
+  if (tsdbCacheWarmupHasMemDel(pTsdb, suid, uid)) {
+    TAOS_CHECK_EXIT(tsdbCacheDel(pTsdb, suid, uid, TSKEY_MIN, TSKEY_MAX));
+  }
+
+  pWarmer->nTable++;
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s, uid:%" PRId64, TD_VID(pTsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code), uid);
+  }
+  taosArrayClear(pWarmer->ctxArray);
+  pWarmer->skip = false;
+  pWarmer->hasRow = false;
+  pWarmer->nCol = 0;
+  TAOS_RETURN(code);
+}
+
+static int32_t tsdbCacheWarmupPutRow(SCacheWarmer *pWarmer, TSDBROW *pRow) {
+  int32_t      code = 0, lino = 0;
+  STsdbRowKey  rowKey;
+  STSDBRowIter iter = {0};
+
+  tsdbRowGetKey(pRow, &rowKey);
+
+  // rows of the same key come in version order, a newer version only overrides the columns it carries
+  bool newRow = !pWarmer->hasRow || tRowKeyCompare(&rowKey.key, &pWarmer->rowKey.key) > 0;
+  if (newRow) {
+    pWarmer->rowKey = rowKey;
+    pWarmer->hasRow = true;
+    SWarmupCol *aCol = TARRAY_DATA(pWarmer->aCol);
+    for (int32_t i = 0; i < pWarmer->nCol; i++) {
+      aCol[i].hasRow = false;
+    }
+  } else {
+    pWarmer->rowKey.version = rowKey.version;
+  }
+
+  TAOS_CHECK_EXIT(tsdbRowIterOpen(&iter, pRow, NULL));
+
+  int32_t iCol = 0;
+  for (SColVal *pColVal = tsdbRowIterNext(&iter); pColVal; pColVal = tsdbRowIterNext(&iter)) {
+    SWarmupCol *pCol = tsdbCacheWarmupGetCol(pWarmer, pColVal->cid, &iCol);
+    if (pCol == NULL) {
+      TAOS_CHECK_EXIT(terrno);
+    }
+
+    if (!pCol->hasRow || !COL_VAL_IS_NONE(pColVal)) {
+      TAOS_CHECK_EXIT(tsdbCacheWarmupCopyVal(&pCol->rowVal, &pCol->rowBuf, &pCol->rowCap, pColVal));
+      pCol->hasRow = true;
+    }
+
+    if (COL_VAL_IS_VALUE(pColVal)) {
+      TAOS_CHECK_EXIT(tsdbCacheWarmupCopyVal(&pCol->lastVal, &pCol->lastBuf, &pCol->lastCap, pColVal));
+      pCol->lastKey = rowKey;
+      pCol->hasLast = true;
+    } else if (COL_VAL_IS_NULL(pColVal) && pCol->hasLast && tRowKeyCompare(&pCol->lastKey.key, &rowKey.key) == 0) {
+      // the value was updated to null, the one before it is unknown here
+      pCol->hasLast = false;
+    }
+  }
+
+_exit:
+  tsdbRowClose(&iter);
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(pWarmer->pTsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+  }
+  TAOS_RETURN(code);
+}
+
+static void tsdbCacheWarmupThrottle(SCacheWarmer *pWarmer) {
+  int64_t nowMs = taosGetTimestampMs();
+
+  if (nowMs - pWarmer->logMs >= TSDB_CACHE_WARMUP_LOG_INTERVAL) {
+    pWarmer->logMs = nowMs;
+    tsdbInfo("vgId:%d, last cache warmup in progress, fid:%d, tables:%" PRId64 ", rows:%" PRId64 ", elapsed:%" PRId64
+             "ms",
+             TD_VID(pWarmer->pTsdb->pVnode), pWarmer->fid, pWarmer->nTable, pWarmer->nRow, nowMs - pWarmer->startMs);
+  }
+
+  int32_t rowsPerSec = tsCacheLastWarmupRowsPerSec;
+  if (rowsPerSec <= 0) {
+    return;
+  }
+
+  // sleep in short steps so that a close is not held up
+  int64_t expectMs = pWarmer->nRow * 1000 / rowsPerSec;
+  int64_t elapsedMs = nowMs - pWarmer->startMs;
+  if (expectMs > elapsedMs) {
+    taosMsleep((int32_t)TMIN(expectMs - elapsedMs, 100));
+  }
+}
+
+static int32_t tsdbCacheWarmupScan(SCacheWarmer *pWarmer, SIterMerger *pDataMerger, SIterMerger *pTombMerger) {
+  int32_t   code = 0, lino = 0;
+  STsdb    *pTsdb = pWarmer->pTsdb;
+  SMetaInfo info;
+
+  // tables with tomb records are left to the lazy load
+  for (STombRecord *record; (record = tsdbIterMergerGetTombRecord(pTombMerger)) != NULL;) {
+    if (tSimpleHashPut(pWarmer->tombUids, &record->uid, sizeof(record->uid), NULL, 0)) {
+      TAOS_CHECK_EXIT(terrno);
+    }
+    TAOS_CHECK_EXIT(tsdbIterMergerSkipTableData(pTombMerger, &(TABLEID){.suid = record->suid, .uid = record->uid}));
+  }
+
+  for (SRowInfo *row; (row = tsdbIterMergerGetData(pDataMerger)) != NULL;) {
+    if (row->uid != pWarmer->tbid->uid) {
+      TAOS_CHECK_EXIT(tsdbCacheWarmupFlushTable(pWarmer));
+
+      if (tsdbCacheWarmupCanceled(pTsdb)) {
+        goto _exit;
+      }
+
+      pWarmer->tbid->suid = row->suid;
+      pWarmer->tbid->uid = row->uid;
+
+      if (tSimpleHashGet(pWarmer->tombUids, &row->uid, sizeof(row->uid)) != NULL ||
+          metaGetInfo(pTsdb->pVnode->pMeta, row->uid, &info, NULL) != 0) {
+        pWarmer->skip = true;
+        TAOS_CHECK_EXIT(tsdbIterMergerSkipTableData(pDataMerger, pWarmer->tbid));
+        continue;
+      }
+    }
+
+    // composite primary keys are left to the lazy load
+    if (row->row.type == TSDBROW_COL_FMT && row->row.pBlockData->nColData > 0 &&
+        (row->row.pBlockData->aColData[0].cflag & COL_IS_KEY)) {
+      pWarmer->skip = true;
+      TAOS_CHECK_EXIT(tsdbIterMergerSkipTableData(pDataMerger, pWarmer->tbid));
+      continue;
+    }
+
+    TAOS_CHECK_EXIT(tsdbCacheWarmupPutRow(pWarmer, &row->row));
+
+    if (++pWarmer->nRow % TSDB_CACHE_WARMUP_CHECK_ROWS == 0) {
+      if (tsdbCacheWarmupCanceled(pTsdb)) {
+        goto _exit;
+      }
+      tsdbCacheWarmupThrottle(pWarmer);
+    }
+
+    TAOS_CHECK_EXIT(tsdbIterMergerNext(pDataMerger));
+  }
+
+  TAOS_CHECK_EXIT(tsdbCacheWarmupFlushTable(pWarmer));
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(pTsdb->pVnode), __func__, __FILE__, lino, tstrerror(code));
+  }
+  TAOS_RETURN(code);
+}
+
+static int32_t tsdbCacheWarmup(void *arg) {
+  int32_t             code = 0, lino = 0;
+  STsdb              *pTsdb = (STsdb *)arg;
+  STFileSet          *fset = NULL;
+  SDataFileReader    *dataReader = NULL;
+  TSttFileReaderArray sttReaderArr[1] = {0};
+  TTsdbIterArray      dataIterArr[1] = {0};
+  TTsdbIterArray      tombIterArr[1] = {0};
+  SIterMerger        *dataMerger = NULL;
+  SIterMerger        *tombMerger = NULL;
+  SCacheWarmer        warmer = {.pTsdb = pTsdb, .fid = INT32_MIN};
+
+  if (tsdbCacheWarmupCanceled(pTsdb)) {
+    goto _exit;
+  }
+
+  // the newest file set holds the latest rows of the tables written recently
+  (void)taosThreadMutexLock(&pTsdb->mutex);
+  if (pTsdb->bgTaskDisabled || TARRAY2_SIZE(pTsdb->pFS->fSetArr) == 0) {
+    (void)taosThreadMutexUnlock(&pTsdb->mutex);
+    goto _exit;
+  }
+  code = tsdbTFileSetInitRef(pTsdb, TARRAY2_LAST(pTsdb->pFS->fSetArr), &fset);
+  (void)taosThreadMutexUnlock(&pTsdb->mutex);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  warmer.fid = fset->fid;
+  warmer.startMs = warmer.logMs = taosGetTimestampMs();
+  tsdbInfo("vgId:%d, start last cache warmup, fid:%d", TD_VID(pTsdb->pVnode), fset->fid);
+
+  warmer.aCol = taosArrayInit(16, sizeof(SWarmupCol));
+  warmer.ctxArray = taosArrayInit(32, sizeof(SLastUpdateCtx));
+  warmer.tombUids = tSimpleHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT));
+  if (warmer.aCol == NULL || warmer.ctxArray == NULL || warmer.tombUids == NULL) {
+    TAOS_CHECK_EXIT(terrno);
+  }
+
+  // open readers and iterators
+  STsdbIter      *iter;
+  STsdbIterConfig config = {0};
+  if (fset->farr[TSDB_FTYPE_HEAD]) {
+    SDataFileReaderConfig dataConfig = {
+        .tsdb = pTsdb,
+        .szPage = pTsdb->pVnode->config.tsdbPageSize,
+    };
+    for (int32_t ftype = 0; ftype < TSDB_FTYPE_MAX; ++ftype) {
+      if (fset->farr[ftype]) {
+        dataConfig.files[ftype].exist = true;
+        dataConfig.files[ftype].file = fset->farr[ftype]->f[0];
+      }
+    }
+    TAOS_CHECK_EXIT(tsdbDataFileReaderOpen(NULL, &dataConfig, &dataReader));
+
+    config.type = TSDB_ITER_TYPE_DATA;
+    config.dataReader = dataReader;
+    TAOS_CHECK_EXIT(tsdbIterOpen(&config, &iter));
+    TAOS_CHECK_EXIT(TARRAY2_APPEND(dataIterArr, iter));
+
+    config.type = TSDB_ITER_TYPE_DATA_TOMB;
+    config.dataReader = dataReader;
+    TAOS_CHECK_EXIT(tsdbIterOpen(&config, &iter));
+    TAOS_CHECK_EXIT(TARRAY2_APPEND(tombIterArr, iter));
+  }
+
+  SSttLvl   *lvl;
+  STFileObj *fobj;
+  TARRAY2_FOREACH(fset->lvlArr, lvl) {
+    TARRAY2_FOREACH(lvl->fobjArr, fobj) {
+      SSttFileReader      *sttReader;
+      SSttFileReaderConfig sttConfig = {
+          .tsdb = pTsdb,
+          .szPage = pTsdb->pVnode->config.tsdbPageSize,
+          .file[0] = fobj->f[0],
+      };
+      TAOS_CHECK_EXIT(tsdbSttFileReaderOpen(fobj->fname, &sttConfig, &sttReader));
+      if ((code = TARRAY2_APPEND(sttReaderArr, sttReader))) {
+        tsdbSttFileReaderClose(&sttReader);
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+
+      config.type = TSDB_ITER_TYPE_STT;
+      config.sttReader = sttReader;
+      TAOS_CHECK_EXIT(tsdbIterOpen(&config, &iter));
+      TAOS_CHECK_EXIT(TARRAY2_APPEND(dataIterArr, iter));
+
+      config.type = TSDB_ITER_TYPE_STT_TOMB;
+      config.sttReader = sttReader;
+      TAOS_CHECK_EXIT(tsdbIterOpen(&config, &iter));
+      TAOS_CHECK_EXIT(TARRAY2_APPEND(tombIterArr, iter));
+    }
+  }
+
+  TAOS_CHECK_EXIT(tsdbIterMergerOpen(dataIterArr, &dataMerger, false));
+  TAOS_CHECK_EXIT(tsdbIterMergerOpen(tombIterArr, &tombMerger, true));
+
+  TAOS_CHECK_EXIT(tsdbCacheWarmupScan(&warmer, dataMerger, tombMerger));
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s, fid:%d", TD_VID(pTsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code), warmer.fid);
+  } else if (fset) {
+    tsdbInfo("vgId:%d, finish last cache warmup, fid:%d, tables:%" PRId64 ", rows:%" PRId64 ", elapsed:%" PRId64
+             "ms, canceled:%d",
+             TD_VID(pTsdb->pVnode), warmer.fid, warmer.nTable, warmer.nRow, taosGetTimestampMs() - warmer.startMs,
+             tsdbCacheWarmupCanceled(pTsdb));
+  }
+  tsdbIterMergerClose(&tombMerger);
+  tsdbIterMergerClose(&dataMerger);
+  TARRAY2_DESTROY(tombIterArr, tsdbIterClose);
+  TARRAY2_DESTROY(dataIterArr, tsdbIterClose);
+  TARRAY2_DESTROY(sttReaderArr, tsdbSttFileReaderClose);
+  tsdbDataFileReaderClose(&dataReader);
+  tsdbTFileSetClear(&fset);
+  for (int32_t i = 0; warmer.aCol && i < TARRAY_SIZE(warmer.aCol); i++) {
+    SWarmupCol *pCol = taosArrayGet(warmer.aCol, i);
+    taosMemoryFree(pCol->rowBuf);
+    taosMemoryFree(pCol->lastBuf);
+  }
+  taosArrayDestroy(warmer.aCol);
+  taosArrayDestroy(warmer.ctxArray);
+  tSimpleHashCleanup(warmer.tombUids);
+  return code;
+}
+
+int32_t tsdbAsyncCacheWarmup(STsdb *pTsdb) {
+  int32_t code = 0;
+
+  if (!tsCacheLastWarmup || TSDB_CACHE_NO(pTsdb->pVnode->config)) {
+    return 0;
+  }
+
+  (void)taosThreadMutexLock(&pTsdb->mutex);
+  if (!pTsdb->bgTaskDisabled) {
+    atomic_store_32(&pTsdb->cacheWarmup.killed, 0);
+    code = vnodeAsync(SCAN_TASK_ASYNC, EVA_PRIORITY_LOW, tsdbCacheWarmup, NULL, pTsdb, &pTsdb->cacheWarmup.taskId);
+  }
+  (void)taosThreadMutexUnlock(&pTsdb->mutex);
+
+  if (code) {
+    tsdbError("vgId:%d %s failed since %s", TD_VID(pTsdb->pVnode), __func__, tstrerror(code));
+  }
+  return code;
+}
+
+// decompressed column cache ==================================================================================
+typedef struct {
+  int64_t fcid;    // commit id of the file
+  int64_t offset;  // block offset in the file
+  int32_t fid;
+  int16_t ftype;
+  int16_t cid;  // column id
+} SColCacheKey;
+
+static void tsdbColDataBufSize(const SColData *pColData, int32_t *szBitMap, int32_t *szOffset) {
+  switch (pColData->flag) {
+    case (HAS_NULL | HAS_NONE):
+    case (HAS_VALUE | HAS_NONE):
+    case (HAS_VALUE | HAS_NULL):
+      *szBitMap = BIT1_SIZE(pColData->nVal);
+      break;
+    case (HAS_VALUE | HAS_NULL | HAS_NONE):
+      *szBitMap = BIT2_SIZE(pColData->nVal);
+      break;
+    default:
+      *szBitMap = 0;
+      break;
+  }
+
+  if (IS_VAR_DATA_TYPE(pColData->type) && (pColData->flag & HAS_VALUE)) {
+    *szOffset = pColData->nVal << 2;
+  } else {
+    *szOffset = 0;
+  }
+}
+
+// a cached column, the buffers of the column follow it in the same allocation
+typedef struct {
+  bool     replaced;  // the same column was put again by another reader, so it is not evicted when freed
+  SColData colData;
+} SColCacheEntry;
+
+static void tsdbColCacheDeleter(const void *key, size_t klen, void *value, void *ud) {
+  SColCacheEntry *pEntry = value;
+  STsdb          *pTsdb = ud;
+  if (!pEntry->replaced) {
+    (void)atomic_add_fetch_64(&pTsdb->colCacheStat.evict, 1);
+  }
+  taosMemoryFree(value);
+}
+
+static void tsdbColCacheOverwriter(const void *key, size_t klen, void *value, void *ud) {
+  ((SColCacheEntry *)value)->replaced = true;
+}
+
+// The cache is charged against the buffer of the vnode, and takes at most half of it. The write buffer pools are
+// sized by the rest, see vnodeBufPoolSegmentSize.
+int64_t tsdbColCacheCapacity(int64_t szBuf) {
+  int64_t capacity = (int64_t)tsTsdbColCacheSize * 1024 * 1024;
+  return TMAX(TMIN(capacity, szBuf / 2), 0);
+}
+
+void tsdbColCacheSetCapacity(SVnode *pVnode, int64_t szBuf) {
+  STsdb *pTsdb = pVnode->pTsdb;
+  if (pTsdb->colCache == NULL) {
+    return;
+  }
+
+  int64_t capacity = tsdbColCacheCapacity(szBuf);
+  taosLRUCacheSetCapacity(pTsdb->colCache, capacity);
+  tsdbInfo("vgId:%d, decompressed column cache capacity is changed to %" PRId64, TD_VID(pTsdb->pVnode), capacity);
+}
+
+static int32_t tsdbOpenColCache(STsdb *pTsdb) {
+  int64_t capacity = tsdbColCacheCapacity(pTsdb->pVnode->config.szBuf);
+  if (capacity <= 0) {
+    return 0;
+  }
+
+  SLRUCache *pCache = taosLRUCacheInit(capacity, 0, .5);
+  if (pCache == NULL) {
+    TAOS_RETURN(TSDB_CODE_OUT_OF_MEMORY);
+  }
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+  pTsdb->colCache = pCache;
+  tsdbInfo("vgId:%d, decompressed column cache opened, capacity:%" PRId64, TD_VID(pTsdb->pVnode), capacity);
+  return 0;
+}
+
+static void tsdbCloseColCache(STsdb *pTsdb) {
+  SLRUCache *pCache = pTsdb->colCache;
+  if (pCache == NULL) {
+    return;
+  }
+
+  int64_t hit, miss, evict;
+  tsdbGetColCacheStat(pTsdb, &hit, &miss, &evict);
+  tsdbInfo("vgId:%d, decompressed column cache closed, hit:%" PRId64 " miss:%" PRId64 " evict:%" PRId64,
+           TD_VID(pTsdb->pVnode), hit, miss, evict);
+
+  // the entries freed with the cache are not evictions
+  taosLRUCacheEraseUnrefEntries(pCache);
+  taosLRUCacheCleanup(pCache);
+  pTsdb->colCache = NULL;
+  atomic_store_64(&pTsdb->colCacheStat.evict, evict);
+}
+
+static void tsdbColCacheKey(const STFile *pFile, int64_t offset, int16_t cid, SColCacheKey *pKey) {
+  memset(pKey, 0, sizeof(*pKey));
+  pKey->fcid = pFile->cid;
+  pKey->offset = offset;
+  pKey->fid = pFile->fid;
+  pKey->ftype = pFile->type;
+  pKey->cid = cid;
+}
+
+int32_t tsdbCacheGetColData(STsdb *pTsdb, const STFile *pFile, int64_t offset, int16_t cid, SBlockData *pBlockData,
+                            bool *hit) {
+  int32_t code = 0;
+
+  *hit = false;
+  if (pTsdb->colCache == NULL) {
+    return 0;
+  }
+
+  SColCacheKey key;
+  tsdbColCacheKey(pFile, offset, cid, &key);
+
+  LRUHandle *h = taosLRUCacheLookup(pTsdb->colCache, &key, sizeof(key));
+  if (h == NULL) {
+    (void)atomic_add_fetch_64(&pTsdb->colCacheStat.miss, 1);
+    return 0;
+  }
+
+  const SColData *pFrom = &((SColCacheEntry *)taosLRUCacheValue(pTsdb->colCache, h))->colData;
+  SColData       *pColData = NULL;
+  int32_t         szBitMap, szOffset;
+
+  code = tBlockDataAddColData(pBlockData, cid, pFrom->type, pFrom->cflag, &pColData);
+  if (code) goto _exit;
+
+  tsdbColDataBufSize(pFrom, &szBitMap, &szOffset);
+  if (szBitMap > 0) {
+    code = tRealloc(&pColData->pBitMap, szBitMap);
+    if (code) goto _exit;
+    memcpy(pColData->pBitMap, pFrom->pBitMap, szBitMap);
+  }
+  if (szOffset > 0) {
+    code = tRealloc((uint8_t **)&pColData->aOffset, szOffset);
+    if (code) goto _exit;
+    memcpy(pColData->aOffset, pFrom->aOffset, szOffset);
+  }
+  if (pFrom->nData > 0) {
+    code = tRealloc(&pColData->pData, pFrom->nData);
+    if (code) goto _exit;
+    memcpy(pColData->pData, pFrom->pData, pFrom->nData);
+  }
+
+  pColData->numOfNone = pFrom->numOfNone;
+  pColData->numOfNull = pFrom->numOfNull;
+  pColData->numOfValue = pFrom->numOfValue;
+  pColData->nVal = pFrom->nVal;
+  pColData->flag = pFrom->flag;
+  pColData->nData = pFrom->nData;
+
+  (void)atomic_add_fetch_64(&pTsdb->colCacheStat.hit, 1);
+  *hit = true;
+
+_exit:
+  tsdbLRUCacheRelease(pTsdb->colCache, h, false);
+  return code;
+}
+
+void tsdbCachePutColData(STsdb *pTsdb, const STFile *pFile, int64_t offset, const SColData *pColData) {
+  if (pTsdb->colCache == NULL) {
+    return;
+  }
+
+  // entry, offsets, data and bitmap live in one allocation, data kept 8-byte aligned
+  int32_t szBitMap, szOffset;
+  tsdbColDataBufSize(pColData, &szBitMap, &szOffset);
+  int32_t szAlignedOffset = ALIGN8(szOffset);
+  size_t  charge = sizeof(SColCacheEntry) + szAlignedOffset + pColData->nData + szBitMap;
+
+  SColCacheEntry *pEntry = taosMemoryMalloc(charge);
+  if (pEntry == NULL) {
+    return;  // ignore cache updating failure
+  }
+
+  SColData *pCached = &pEntry->colData;
+  uint8_t  *p = (uint8_t *)(pEntry + 1);
+  pEntry->replaced = false;
+  *pCached = *pColData;
+  pCached->aOffset = szOffset > 0 ? (int32_t *)p : NULL;
+  pCached->pData = pColData->nData > 0 ? p + szAlignedOffset : NULL;
+  pCached->pBitMap = szBitMap > 0 ? p + szAlignedOffset + pColData->nData : NULL;
+  if (pCached->aOffset) memcpy(pCached->aOffset, pColData->aOffset, szOffset);
+  if (pCached->pData) memcpy(pCached->pData, pColData->pData, pColData->nData);
+  if (pCached->pBitMap) memcpy(pCached->pBitMap, pColData->pBitMap, szBitMap);
+
+  SColCacheKey key;
+  tsdbColCacheKey(pFile, offset, pColData->cid, &key);
+
+  // on failure the value is released by the deleter
+  (void)taosLRUCacheInsert(pTsdb->colCache, &key, sizeof(key), pEntry, charge, tsdbColCacheDeleter,
+                           tsdbColCacheOverwriter, NULL, TAOS_LRU_PRIORITY_LOW, pTsdb);
+}
+
+void tsdbGetColCacheStat(STsdb *pTsdb, int64_t *hit, int64_t *miss, int64_t *evict) {
+  *hit = atomic_load_64(&pTsdb->colCacheStat.hit);
+  *miss = atomic_load_64(&pTsdb->colCacheStat.miss);
+  *evict = atomic_load_64(&pTsdb->colCacheStat.evict);
+}
+
+void tsdbResetColCacheStat(STsdb *pTsdb, int64_t hit, int64_t miss, int64_t evict) {
+  (void)atomic_sub_fetch_64(&pTsdb->colCacheStat.hit, hit);
+  (void)atomic_sub_fetch_64(&pTsdb->colCacheStat.miss, miss);
+  (void)atomic_sub_fetch_64(&pTsdb->colCacheStat.evict, evict);
+}
+
 int32_t tsdbOpenCache(STsdb *pTsdb) {
   int32_t code = 0, lino = 0;
   size_t  cfgCapacity = (size_t)pTsdb->pVnode->config.cacheLastSize * 1024 * 1024;
@@ -2837,9 +3539,14 @@ int32_t tsdbOpenCache(STsdb *pTsdb) {
 
   TAOS_CHECK_GOTO(tsdbOpenRocksCache(pTsdb), &lino, _err);
 
+  TAOS_CHECK_GOTO(tsdbOpenColCache(pTsdb), &lino, _err);
+
   taosLRUCacheSetStrictCapacity(pCache, false);
 
-  (void)taosThreadMutexInit(&pTsdb->lruMutex, NULL);
+  for (int32_t i = 0; i < TSDB_CACHE_LOCK_STRIPES; ++i) {
+    (void)taosThreadMutexInit(&pTsdb->lruMutex[i], NULL);
+  }
+  (void)taosThreadRwlockInit(&pTsdb->lruEvictLock, NULL);
 
 _err:
   if (code) {
@@ -2858,7 +3565,10 @@ void tsdbCloseCache(STsdb *pTsdb) {
 
     taosLRUCacheCleanup(pCache);
 
-    (void)taosThreadMutexDestroy(&pTsdb->lruMutex);
+    for (int32_t i = 0; i < TSDB_CACHE_LOCK_STRIPES; ++i) {
+      (void)taosThreadMutexDestroy(&pTsdb->lruMutex[i]);
+    }
+    (void)taosThreadRwlockDestroy(&pTsdb->lruEvictLock);
   }
 
 #ifdef USE_SHARED_STORAGE
@@ -2869,6 +3579,8 @@ void tsdbCloseCache(STsdb *pTsdb) {
 #endif
 
   tsdbCloseRocksCache(pTsdb);
+
+  tsdbCloseColCache(pTsdb);
 }
 
 static void getTableCacheKey(tb_uid_t uid, int cacheType, char *key, int *len) {
@@ -4120,7 +4832,9 @@ _err:
 void tsdbCacheRelease(SLRUCache *pCache, LRUHandle *h) { tsdbLRUCacheRelease(pCache, h, false); }
 
 void tsdbCacheSetCapacity(SVnode *pVnode, size_t capacity) {
+  (void)taosThreadRwlockRdlock(&pVnode->pTsdb->lruEvictLock);
   taosLRUCacheSetCapacity(pVnode->pTsdb->lruCache, capacity);
+  (void)taosThreadRwlockUnlock(&pVnode->pTsdb->lruEvictLock);
 }
 
 #ifdef BUILD_NO_CALL
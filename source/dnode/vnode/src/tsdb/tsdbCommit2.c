@@ -76,6 +76,7 @@ static int32_t tsdbCommitOpenWriter(SCommitter2 *committer) {
       .cid = committer->cid,
       .expLevel = committer->ctx->expLevel,
       .level = 0,
+      .memRows = true,
   };
 
   if (committer->sttTrigger == 1) {
@@ -224,6 +225,7 @@ static int32_t tsdbCommitOpenReader(SCommitter2 *committer) {
           .tsdb = committer->tsdb,
           .szPage = committer->szPage,
           .file = fobj->f[0],
+          .noCache = true,
       };
 
       TAOS_CHECK_GOTO(tsdbSttFileReaderOpen(fobj->fname, &config, &sttReader), &lino, _exit);
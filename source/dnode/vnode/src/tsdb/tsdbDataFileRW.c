@@ -129,6 +129,7 @@ int32_t tsdbDataFileReaderOpen(const char *fname[], const SDataFileReaderConfig
       if (fname[i]) {
         int32_t lcn = config->files[i].file.lcn;
         TAOS_CHECK_GOTO(tsdbOpenFile(fname[i], config->tsdb, TD_FILE_READ, &reader[0]->fd[i], lcn), &lino, _exit);
+        tsdbSetFileNoCache(reader[0]->fd[i], config->noCache);
       }
     }
   } else {
@@ -138,6 +139,7 @@ int32_t tsdbDataFileReaderOpen(const char *fname[], const SDataFileReaderConfig
         tsdbTFileName(config->tsdb, &config->files[i].file, fname1);
         int32_t lcn = config->files[i].file.lcn;
         TAOS_CHECK_GOTO(tsdbOpenFile(fname1, config->tsdb, TD_FILE_READ, &reader[0]->fd[i], lcn), &lino, _exit);
+        tsdbSetFileNoCache(reader[0]->fd[i], config->noCache);
       }
     }
   }
@@ -150,6 +152,20 @@ _exit:
   return code;
 }
 
+// open another reader on the .data file of reader, with its own fd and buffers, so that both can read in parallel
+int32_t tsdbDataFileReaderCloneData(SDataFileReader *reader, SDataFileReader **clone) {
+  SDataFileReaderConfig config = reader->config[0];
+
+  config.buffers = NULL;
+  for (int32_t i = 0; i < TSDB_FTYPE_MAX; ++i) {
+    if (i != TSDB_FTYPE_DATA) {
+      config.files[i].exist = false;
+    }
+  }
+
+  return tsdbDataFileReaderOpen(NULL, &config, clone);
+}
+
 void tsdbDataFileReaderClose(SDataFileReader **reader) {
   if (reader[0] == NULL) {
     return;
@@ -297,6 +313,13 @@ _exit:
   return code;
 }
 
+int32_t tsdbDataFileReadBlockDataAhead(SDataFileReader *reader, int64_t offset, int64_t size) {
+  if (reader->fd[TSDB_FTYPE_DATA] == NULL) {
+    return 0;
+  }
+  return tsdbPrefetchFile(reader->fd[TSDB_FTYPE_DATA], offset, size);
+}
+
 extern int32_t tBlockDataDecompress(SBufferReader *br, SBlockData *blockData, SBuffer *assist);
 
 int32_t tsdbDataFileReadBlockData(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData) {
@@ -498,6 +521,15 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
       };
       TAOS_CHECK_GOTO(tBlockDataDecompressColData(&hdr, &none, &br, bData, assist), &lino, _exit);
     } else if (cid == blockCol.cid) {
+      // decompressed by another reader
+      bool hit = false;
+      TAOS_CHECK_GOTO(tsdbCacheGetColData(reader->config->tsdb, &reader->config->files[TSDB_FTYPE_DATA].file,
+                                          record->blockOffset, cid, bData, &hit),
+                      &lino, _exit);
+      if (hit) {
+        continue;
+      }
+
       int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
       char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
       // load from file
@@ -513,6 +545,10 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
       // decode the buffer
       SBufferReader br1 = BUFFER_READER_INITIALIZER(0, buffer1);
       TAOS_CHECK_GOTO(tBlockDataDecompressColData(&hdr, &blockCol, &br1, bData, assist), &lino, _exit);
+      if (!reader->fd[TSDB_FTYPE_DATA]->noCache) {
+        tsdbCachePutColData(reader->config->tsdb, &reader->config->files[TSDB_FTYPE_DATA].file, record->blockOffset,
+                            &bData->aColData[bData->nColData - 1]);
+      }
     }
   }
 
@@ -544,6 +580,12 @@ int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *rec
     while (br.offset < record->smaSize) {
       SColumnDataAgg sma[1];
 
+      if (tIsBlockBloomFilter(&br)) {
+        int16_t cid;
+        TAOS_CHECK_GOTO(tGetBlockBloomFilter(&br, &cid, NULL), &lino, _exit);
+        continue;
+      }
+
       TAOS_CHECK_GOTO(tGetColumnDataAgg(&br, sma), &lino, _exit);
       TAOS_CHECK_GOTO(TARRAY2_APPEND_PTR(columnDataAggArray, sma), &lino, _exit);
     }
@@ -563,6 +605,65 @@ _exit:
   return code;
 }
 
+// The sma region of the block is read once for all the columns, aBF[i] is the filter of cids[i] or NULL if the block
+// has none for it.
+int32_t tsdbDataFileReadBlockBloomFilter(SDataFileReader *reader, const SBrinRecord *record, const int16_t cids[],
+                                         int32_t ncid, SBloomFilter *aBF[]) {
+  int32_t  code = 0;
+  int32_t  lino = 0;
+  int32_t  nFound = 0;
+  SBuffer *buffer = reader->buffers + 0;
+
+  for (int32_t i = 0; i < ncid; i++) {
+    aBF[i] = NULL;
+  }
+  if (record->smaSize <= 0 || ncid <= 0) {
+    return 0;
+  }
+
+  tBufferClear(buffer);
+  int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+  char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+  TAOS_CHECK_GOTO(tsdbReadFileToBuffer(reader->fd[TSDB_FTYPE_SMA], record->smaOffset, record->smaSize, buffer, 0,
+                                       encryptAlgorithm, encryptKey),
+                  &lino, _exit);
+
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, buffer);
+  while (br.offset < record->smaSize && nFound < ncid) {
+    if (tIsBlockBloomFilter(&br)) {
+      SBufferReader peek = br;
+      int32_t       colId = 0;
+      int16_t       bcid = 0;
+      int32_t       idx = -1;
+      TAOS_CHECK_GOTO(tBufferGetI32v(&peek, &colId), &lino, _exit);
+      for (int32_t i = 0; i < ncid; i++) {
+        if (cids[i] == (int16_t)(colId & 0xFFFF) && aBF[i] == NULL) {
+          idx = i;
+          break;
+        }
+      }
+      TAOS_CHECK_GOTO(tGetBlockBloomFilter(&br, &bcid, (idx >= 0) ? &aBF[idx] : NULL), &lino, _exit);
+      if (idx >= 0) {
+        nFound++;
+      }
+    } else {
+      SColumnDataAgg sma[1];
+      TAOS_CHECK_GOTO(tGetColumnDataAgg(&br, sma), &lino, _exit);
+    }
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(reader->config->tsdb->pVnode), __func__, __FILE__, lino,
+              tstrerror(code));
+    for (int32_t i = 0; i < ncid; i++) {
+      tBloomFilterDestroy(aBF[i]);
+      aBF[i] = NULL;
+    }
+  }
+  return code;
+}
+
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -725,6 +826,7 @@ static int32_t tsdbDataFileWriterDoOpenReader(SDataFileWriter *writer) {
           .tsdb = writer->config->tsdb,
           .szPage = writer->config->szPage,
           .buffers = writer->buffers,
+          .noCache = true,
       }};
 
       for (int32_t i = 0; i < TSDB_FTYPE_MAX; ++i) {
@@ -1009,6 +1111,77 @@ _exit:
   return code;
 }
 
+typedef struct {
+  uint64_t h1;
+  uint64_t h2;
+} SBloomHash;
+
+static int32_t tBloomHashCmprFn(const void *p1, const void *p2) {
+  const SBloomHash *pHash1 = p1;
+  const SBloomHash *pHash2 = p2;
+  if (pHash1->h1 != pHash2->h1) return pHash1->h1 < pHash2->h1 ? -1 : 1;
+  if (pHash1->h2 != pHash2->h2) return pHash1->h2 < pHash2->h2 ? -1 : 1;
+  return 0;
+}
+
+// the filter is sized by the number of distinct values of the column in the block
+static int32_t tsdbDataFileWriteBloomFilter(SColData *colData, SBuffer *buffer) {
+  int32_t       code = 0;
+  int32_t       lino = 0;
+  SBloomFilter *pBF = NULL;
+  int32_t       nHash = 0;
+  SBloomHash   *aHash = taosMemoryMalloc(sizeof(SBloomHash) * colData->nVal);
+  if (aHash == NULL) {
+    TAOS_CHECK_GOTO(terrno, &lino, _exit);
+  }
+
+  for (int32_t iVal = 0; iVal < colData->nVal; ++iVal) {
+    SColVal cv;
+    TAOS_CHECK_GOTO(tColDataGetValue(colData, iVal, &cv), &lino, _exit);
+    if (!COL_VAL_IS_VALUE(&cv)) continue;
+
+    const char *key = NULL;
+    uint32_t    len = 0;
+    if (IS_VAR_DATA_TYPE(colData->type)) {
+      key = (const char *)cv.value.pData;
+      len = cv.value.nData;
+    } else {
+      key = (const char *)&VALUE_GET_TRIVIAL_DATUM(&cv.value);
+      len = tDataTypes[colData->type].bytes;
+    }
+    aHash[nHash].h1 = HASH_FUNCTION_1(key, len);
+    aHash[nHash].h2 = HASH_FUNCTION_2(key, len);
+    nHash++;
+  }
+
+  if (nHash == 0) {
+    goto _exit;
+  }
+
+  taosSort(aHash, nHash, sizeof(SBloomHash), tBloomHashCmprFn);
+  int32_t nDistinct = 1;
+  for (int32_t i = 1; i < nHash; ++i) {
+    if (tBloomHashCmprFn(&aHash[i], &aHash[nDistinct - 1]) != 0) {
+      aHash[nDistinct++] = aHash[i];
+    }
+  }
+
+  TAOS_CHECK_GOTO(tBloomFilterInit(nDistinct, TSDB_BLOCK_BLOOM_FILTER_ERROR_RATE, &pBF), &lino, _exit);
+  for (int32_t i = 0; i < nDistinct; ++i) {
+    (void)tBloomFilterPutHash(pBF, aHash[i].h1, aHash[i].h2);
+  }
+
+  TAOS_CHECK_GOTO(tPutBlockBloomFilter(buffer, colData->cid, pBF), &lino, _exit);
+
+_exit:
+  if (code) {
+    tsdbError("%s failed at %s:%d since %s", __func__, __FILE__, lino, tstrerror(code));
+  }
+  tBloomFilterDestroy(pBF);
+  taosMemoryFree(aHash);
+  return code;
+}
+
 static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData *bData) {
   if (bData->nRow == 0) {
     return 0;
@@ -1087,6 +1260,15 @@ static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData
 
     TAOS_CHECK_GOTO(tPutColumnDataAgg(&buffers[0], sma), &lino, _exit);
   }
+
+  if (tsTsdbBlockBloomFilter) {
+    for (int32_t i = 0; i < bData->nColData; ++i) {
+      SColData *colData = bData->aColData + i;
+      if (!TSDB_BLOCK_BLOOM_FILTER_TYPE(colData->type) || ((colData->flag & HAS_VALUE) == 0)) continue;
+
+      TAOS_CHECK_GOTO(tsdbDataFileWriteBloomFilter(colData, &buffers[0]), &lino, _exit);
+    }
+  }
   record->smaSize = buffers[0].size;
 
   if (record->smaSize > 0) {
@@ -47,21 +47,26 @@ typedef struct SDataFileReaderConfig {
     STFile file;
   } files[TSDB_FTYPE_MAX];
   SBuffer *buffers;
+  bool     noCache;  // bulk read, keep the pages out of the caches
 } SDataFileReaderConfig;
 
 int32_t tsdbDataFileReaderOpen(const char *fname[/* TSDB_FTYPE_MAX */], const SDataFileReaderConfig *config,
                                SDataFileReader **reader);
 void    tsdbDataFileReaderClose(SDataFileReader **reader);
+int32_t tsdbDataFileReaderCloneData(SDataFileReader *reader, SDataFileReader **clone);
 // .head
 int32_t tsdbDataFileReadBrinBlk(SDataFileReader *reader, const TBrinBlkArray **brinBlkArray);
 int32_t tsdbDataFileReadBrinBlock(SDataFileReader *reader, const SBrinBlk *brinBlk, SBrinBlock *brinBlock);
 // .data
 int32_t tsdbDataFileReadBlockData(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData);
+int32_t tsdbDataFileReadBlockDataAhead(SDataFileReader *reader, int64_t offset, int64_t size);
 int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
                                           STSchema *pTSchema, int16_t cids[], int32_t ncid);
 // .sma
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray);
+int32_t tsdbDataFileReadBlockBloomFilter(SDataFileReader *reader, const SBrinRecord *record, const int16_t cids[],
+                                         int32_t ncid, SBloomFilter *aBF[]);
 // .tomb
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray);
 int32_t tsdbDataFileReadTombBlock(SDataFileReader *reader, const STombBlk *tombBlk, STombBlock *tData);
@@ -18,8 +18,6 @@
 #include "tsdbUpgrade.h"
 #include "vnd.h"
 
-#define BLOCK_COMMIT_FACTOR 3
-
 typedef struct STFileHashEntry {
   struct STFileHashEntry *next;
   char                    fname[TSDB_FILENAME_LEN];
@@ -799,6 +797,12 @@ int32_t tsdbDisableAndCancelAllBgTask(STsdb *pTsdb) {
 
   // disable
   pTsdb->bgTaskDisabled = true;
+  atomic_store_32(&pTsdb->cacheWarmup.killed, 1);
+  if (taosArrayPush(asyncTasks, &pTsdb->cacheWarmup.taskId) == NULL) {
+    taosArrayDestroy(asyncTasks);
+    (void)taosThreadMutexUnlock(&pTsdb->mutex);
+    return terrno;
+  }
 
   // collect channel
   STFileSet *fset;
@@ -940,6 +944,42 @@ void tsdbFSCheckCommit(STsdb *tsdb, int32_t fid) {
   return;
 }
 
+// schedule the merge of a file set by the number of its level-0 stt files
+int32_t tsdbFSetScheduleMerge(STsdb *tsdb, STFileSet *fset, int32_t numFile, int32_t sttTrigger) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  // file sets merge in parallel, the ones about to block commit go first
+  EVAPriority priority = (numFile >= sttTrigger * BLOCK_COMMIT_FACTOR) ? EVA_PRIORITY_HIGH : EVA_PRIORITY_NORMAL;
+
+  // a merge still waiting in the queue is queued again once the backlog grows deep enough to block commit
+  if (priority == EVA_PRIORITY_HIGH && fset->mergePriority != EVA_PRIORITY_HIGH && vnodeATaskValid(&fset->mergeTask) &&
+      vnodeACancel(&fset->mergeTask) == 0) {
+    tsdbInfo("vgId:%d fid:%d promote merge task since level-0 stt files:%d", TD_VID(tsdb->pVnode), fset->fid, numFile);
+  }
+
+  if (numFile >= sttTrigger && (!vnodeATaskValid(&fset->mergeTask))) {
+    SMergeArg *arg = taosMemoryMalloc(sizeof(*arg));
+    if (arg == NULL) {
+      code = terrno;
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+
+    arg->tsdb = tsdb;
+    arg->fid = fset->fid;
+
+    code = vnodeAsync(MERGE_TASK_ASYNC, priority, tsdbMerge, taosAutoMemoryFree, arg, &fset->mergeTask);
+    TSDB_CHECK_CODE(code, lino, _exit);
+    fset->mergePriority = priority;
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d %s failed at line %d since %s", TD_VID(tsdb->pVnode), __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 // IMPORTANT: the caller must hold fs->tsdb->mutex
 int32_t tsdbFSEditCommit(STFileSystem *fs) {
   int32_t code = 0;
@@ -967,19 +1007,9 @@ int32_t tsdbFSEditCommit(STFileSystem *fs) {
 
       // bool    skipMerge = false;
       int32_t numFile = TARRAY2_SIZE(lvl->fobjArr);
-      if (numFile >= sttTrigger && (!vnodeATaskValid(&fset->mergeTask))) {
-        SMergeArg *arg = taosMemoryMalloc(sizeof(*arg));
-        if (arg == NULL) {
-          code = terrno;
-          TSDB_CHECK_CODE(code, lino, _exit);
-        }
-
-        arg->tsdb = fs->tsdb;
-        arg->fid = fset->fid;
 
-        code = vnodeAsync(MERGE_TASK_ASYNC, EVA_PRIORITY_HIGH, tsdbMerge, taosAutoMemoryFree, arg, &fset->mergeTask);
-        TSDB_CHECK_CODE(code, lino, _exit);
-      }
+      code = tsdbFSetScheduleMerge(fs->tsdb, fset, numFile, sttTrigger);
+      TSDB_CHECK_CODE(code, lino, _exit);
 
       if (numFile >= sttTrigger * BLOCK_COMMIT_FACTOR) {
         tsdbFSSetBlockCommit(fset, true);
@@ -1297,6 +1327,8 @@ struct SFileSetReader {
   int64_t    endTime;
   int64_t    lastCompactTime;
   int64_t    totalSize;
+  int32_t    sttBacklog;  // level-0 stt files waiting for merge
+  bool       merging;     // a merge task is queued or running
 };
 
 int32_t tsdbFileSetReaderOpen(void *pVnode, struct SFileSetReader **ppReader) {
@@ -1340,6 +1372,12 @@ static int32_t tsdbFileSetReaderNextNoLock(struct SFileSetReader *pReader) {
   code = tsdbTFileSetInitRef(pReader->pTsdb, *fsetPtr, &pReader->pFileSet);
   if (code) return code;
 
+  pReader->sttBacklog = 0;
+  if (TARRAY2_SIZE((*fsetPtr)->lvlArr) > 0 && TARRAY2_FIRST((*fsetPtr)->lvlArr)->level == 0) {
+    pReader->sttBacklog = TARRAY2_SIZE(TARRAY2_FIRST((*fsetPtr)->lvlArr)->fobjArr);
+  }
+  pReader->merging = vnodeATaskValid(&(*fsetPtr)->mergeTask);
+
   // get file set details
   pReader->fid = pReader->pFileSet->fid;
   tsdbFidKeyRange(pReader->fid, pTsdb->keepCfg.days, pTsdb->keepCfg.precision, &pReader->startTime, &pReader->endTime);
@@ -1415,6 +1453,18 @@ int32_t tsdbFileSetGetEntryField(struct SFileSetReader *pReader, const char *fie
     return TSDB_CODE_SUCCESS;
   }
 
+  fieldName = "stt_backlog";
+  if (strncmp(field, fieldName, strlen(fieldName) + 1) == 0) {
+    *(int32_t *)value = pReader->sttBacklog;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  fieldName = "merging";
+  if (strncmp(field, fieldName, strlen(fieldName) + 1) == 0) {
+    *(bool *)value = pReader->merging;
+    return TSDB_CODE_SUCCESS;
+  }
+
   fieldName = "details";
   if (strncmp(field, fieldName, strlen(fieldName) + 1) == 0) {
     // TODO
@@ -23,6 +23,9 @@
 extern "C" {
 #endif
 
+// commit is blocked once the level-0 stt files of a file set reach this multiple of sttTrigger
+#define BLOCK_COMMIT_FACTOR 3
+
 typedef enum {
   TSDB_FEDIT_COMMIT = 1,  //
   TSDB_FEDIT_MERGE,
@@ -61,6 +64,7 @@ void    tsdbFSUpdateEid(STFileSystem *fs, int64_t cid);
 int32_t tsdbFSEditBegin(STFileSystem *fs, const TFileOpArray *opArray, EFEditT etype);
 int32_t tsdbFSEditCommit(STFileSystem *fs);
 int32_t tsdbFSEditAbort(STFileSystem *fs);
+int32_t tsdbFSetScheduleMerge(STsdb *tsdb, STFileSet *fset, int32_t numFile, int32_t sttTrigger);
 // other
 void tsdbFSGetFSet(STFileSystem *fs, int32_t fid, STFileSet **fset);
 void tsdbFSCheckCommit(STsdb *tsdb, int32_t fid);
@@ -99,6 +99,7 @@ struct STFileSet {
   TSKEY        lastRollup;  // rollup only if lastRollup > lastCommit or expLevel increased
 
   SVATaskID mergeTask;
+  int8_t    mergePriority;  // EVAPriority the merge task is queued with
   SVATaskID compactTask;
   SVATaskID retentionTask;
   SVATaskID migrateTask;
@@ -185,7 +185,7 @@ int32_t tsdbFSetWriterOpen(SFSetWriterConfig *config, SFSetWriter **writer) {
       .skmTb = writer[0]->skmTb,
       .skmRow = writer[0]->skmRow,
       .buffers = writer[0]->buffers,
-
+      .memRows = config->memRows,
   };
   code = tsdbSttFileWriterOpen(&sttWriterConfig, &writer[0]->sttWriter);
   TSDB_CHECK_CODE(code, lino, _exit);
@@ -38,6 +38,7 @@ typedef struct {
   int32_t expLevel;
   int32_t level;
   int32_t lcn;
+  bool    memRows;
   struct {
     bool   exist;
     STFile file;
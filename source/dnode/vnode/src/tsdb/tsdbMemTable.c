@@ -28,6 +28,8 @@
 #define SL_SET_NODE_FORWARD(n, l, p)  atomic_store_ptr(&SL_NODE_FORWARD(n, l), p)
 #define SL_SET_NODE_BACKWARD(n, l, p) atomic_store_ptr(&SL_NODE_BACKWARD(n, l), p)
 
+#define SL_NODE_ALIGN(s)              (((s) + 7) & ~((int64_t)7))
+
 #define SL_MOVE_BACKWARD 0x1
 #define SL_MOVE_FROM_POS 0x2
 
@@ -517,16 +519,20 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKe
   }
 }
 
-static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
+static FORCE_INLINE int8_t tsdbMemSkipListRandLevelImpl(uint32_t *seed, int8_t maxLevel, int8_t curLevel) {
   int8_t level = 1;
-  int8_t tlevel = TMIN(pSl->maxLevel, pSl->level + 1);
+  int8_t tlevel = TMIN(maxLevel, curLevel + 1);
 
-  while ((taosRandR(&pSl->seed) & 0x3) == 0 && level < tlevel) {
+  while ((taosRandR(seed) & 0x3) == 0 && level < tlevel) {
     level++;
   }
 
   return level;
 }
+
+static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
+  return tsdbMemSkipListRandLevelImpl(&pSl->seed, pSl->maxLevel, pSl->level);
+}
 static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode **pos, TSDBROW *pRow,
                            int8_t forward) {
   int32_t           code = 0;
@@ -598,6 +604,131 @@ _exit:
   return code;
 }
 
+// whether a sorted batch starting at pKey lands entirely after the last node of the skiplist
+static bool tbDataCanAppend(STbData *pTbData, STsdbRowKey *pKey) {
+  SMemSkipListNode *pLast = SL_GET_NODE_BACKWARD(pTbData->sl.pTail, 0);
+  if (pLast == pTbData->sl.pHead) return true;
+
+  STsdbRowKey tKey;
+  tsdbRowGetKey(&pLast->row, &tKey);
+  return tsdbRowKeyCmpr(&tKey, pKey) <= 0;
+}
+
+/*
+ * Append a sorted batch of rows after the last node of the skiplist. All nodes are carved out of a single
+ * buffer pool allocation and chained privately before being published at the tail, so an in-order batch
+ * costs one allocation plus a copy instead of a node allocation and a linked insert per row.
+ */
+static int32_t tbDataAppendBatch(SMemTable *pMemTable, STbData *pTbData, TSDBROW *pRow, SRow **aRow, int32_t nRow) {
+  int32_t           code = 0;
+  SMemSkipList     *pSl = &pTbData->sl;
+  SVBufPool        *pPool = pMemTable->pTsdb->pVnode->inUse;
+  SMemSkipListNode *pLast[SL_MAX_LEVEL];
+  SMemSkipListNode *pFirst[SL_MAX_LEVEL] = {0};
+  uint32_t          seed = pSl->seed;
+  int8_t            curLevel = pSl->level;
+  int64_t           totalSize = 0;
+
+  // levels are drawn twice from the same seed, once to size the batch and once to build it
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    int8_t level = tsdbMemSkipListRandLevelImpl(&seed, pSl->maxLevel, curLevel);
+    curLevel = TMAX(curLevel, level);
+    totalSize += SL_NODE_ALIGN(SL_NODE_SIZE(level) + (aRow ? aRow[iRow]->len : 0));
+  }
+  if (totalSize > INT32_MAX) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  char *pBuf = (char *)vnodeBufPoolMallocAligned(pPool, (int)totalSize);
+  if (pBuf == NULL) {
+    return terrno;
+  }
+
+  for (int8_t iLevel = 0; iLevel < pSl->maxLevel; iLevel++) {
+    pLast[iLevel] = SL_GET_NODE_BACKWARD(pSl->pTail, iLevel);
+  }
+
+  TSDBROW tRow = *pRow;
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    SMemSkipListNode *pNode = (SMemSkipListNode *)pBuf;
+    int8_t            level = tsdbMemSkipListRandLevel(pSl);
+    int64_t           nSize = SL_NODE_SIZE(level);
+
+    pNode->level = level;
+    pNode->row = tRow;
+    if (aRow) {
+      pNode->row.pTSRow = (SRow *)((char *)pNode + nSize);
+      memcpy(pNode->row.pTSRow, aRow[iRow], aRow[iRow]->len);
+      nSize += aRow[iRow]->len;
+    }
+
+    for (int8_t iLevel = 0; iLevel < level; iLevel++) {
+      SL_NODE_FORWARD(pNode, iLevel) = pSl->pTail;
+      SL_NODE_BACKWARD(pNode, iLevel) = pLast[iLevel];
+      if (pFirst[iLevel] == NULL) {
+        pFirst[iLevel] = pNode;
+      } else {
+        SL_NODE_FORWARD(pLast[iLevel], iLevel) = pNode;
+      }
+      pLast[iLevel] = pNode;
+    }
+
+    if (pSl->level < level) {
+      pSl->level = level;
+    }
+
+    pBuf += SL_NODE_ALIGN(nSize);
+    if (aRow == NULL) {
+      tRow.iRow++;
+    }
+  }
+
+  // publish the chain, upper levels first as tbDataDoPut does
+  for (int8_t iLevel = pSl->maxLevel - 1; iLevel >= 0; iLevel--) {
+    if (pFirst[iLevel] == NULL) continue;
+
+    SL_SET_NODE_FORWARD(SL_NODE_BACKWARD(pFirst[iLevel], iLevel), iLevel, pFirst[iLevel]);
+    SL_SET_NODE_BACKWARD(pSl->pTail, iLevel, pLast[iLevel]);
+  }
+
+  pSl->size += nRow;
+  return code;
+}
+
+// bytes tColDataCopy takes for the column when its pieces are carved by tsdbCarveMalloc
+static int64_t tsdbColDataCopySize(const SColData *pColData) {
+  int64_t size = 0;
+
+  switch (pColData->flag) {
+    case (HAS_NULL | HAS_NONE):
+    case (HAS_VALUE | HAS_NONE):
+    case (HAS_VALUE | HAS_NULL):
+      size += SL_NODE_ALIGN(BIT1_SIZE(pColData->nVal));
+      break;
+    case (HAS_VALUE | HAS_NULL | HAS_NONE):
+      size += SL_NODE_ALIGN(BIT2_SIZE(pColData->nVal));
+      break;
+    default:
+      break;
+  }
+  if (IS_VAR_DATA_TYPE(pColData->type) && (pColData->flag & HAS_VALUE)) {
+    size += SL_NODE_ALIGN((int64_t)pColData->nVal << 2);
+  }
+  if (pColData->nData) {
+    size += SL_NODE_ALIGN(pColData->nData);
+  }
+  return size;
+}
+
+// hand out consecutive aligned pieces of a buffer sized up front, arg points to the cursor
+static void *tsdbCarveMalloc(void *arg, int32_t size) {
+  char **ppCursor = (char **)arg;
+  void  *p = *ppCursor;
+
+  *ppCursor += SL_NODE_ALIGN(size);
+  return p;
+}
+
 static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
   int32_t code = 0;
@@ -606,42 +737,43 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
   int32_t    nColData = TARRAY_SIZE(pSubmitTbData->aCol);
   SColData  *aColData = (SColData *)TARRAY_DATA(pSubmitTbData->aCol);
 
-  // copy and construct block data
-  SBlockData *pBlockData = vnodeBufPoolMalloc(pPool, sizeof(*pBlockData));
-  if (pBlockData == NULL) {
+  // the block and all the column payloads are copied out of the request into one buffer pool allocation
+  int64_t totalSize = SL_NODE_ALIGN(sizeof(SBlockData)) + SL_NODE_ALIGN(aColData[0].nData) * 2 +
+                      SL_NODE_ALIGN(sizeof(SColData) * (nColData - 1));
+  for (int32_t iColData = 1; iColData < nColData; ++iColData) {
+    totalSize += tsdbColDataCopySize(&aColData[iColData]);
+  }
+  if (totalSize > INT32_MAX) {
+    code = TSDB_CODE_INVALID_PARA;
+    goto _exit;
+  }
+
+  char *pCursor = vnodeBufPoolMallocAligned(pPool, (int)totalSize);
+  if (pCursor == NULL) {
     code = terrno;
     goto _exit;
   }
 
+  // copy and construct block data
+  SBlockData *pBlockData = tsdbCarveMalloc(&pCursor, sizeof(*pBlockData));
+
   pBlockData->suid = pTbData->suid;
   pBlockData->uid = pTbData->uid;
   pBlockData->nRow = aColData[0].nVal;
   pBlockData->aUid = NULL;
-  pBlockData->aVersion = vnodeBufPoolMalloc(pPool, aColData[0].nData);
-  if (pBlockData->aVersion == NULL) {
-    code = terrno;
-    goto _exit;
-  }
-  for (int32_t i = 0; i < pBlockData->nRow; i++) {  // todo: here can be optimized
+  pBlockData->aVersion = tsdbCarveMalloc(&pCursor, aColData[0].nData);
+  for (int32_t i = 0; i < pBlockData->nRow; i++) {
     pBlockData->aVersion[i] = version;
   }
 
-  pBlockData->aTSKEY = vnodeBufPoolMalloc(pPool, aColData[0].nData);
-  if (pBlockData->aTSKEY == NULL) {
-    code = terrno;
-    goto _exit;
-  }
+  pBlockData->aTSKEY = tsdbCarveMalloc(&pCursor, aColData[0].nData);
   memcpy(pBlockData->aTSKEY, aColData[0].pData, aColData[0].nData);
 
   pBlockData->nColData = nColData - 1;
-  pBlockData->aColData = vnodeBufPoolMalloc(pPool, sizeof(SColData) * pBlockData->nColData);
-  if (pBlockData->aColData == NULL) {
-    code = terrno;
-    goto _exit;
-  }
+  pBlockData->aColData = tsdbCarveMalloc(&pCursor, sizeof(SColData) * pBlockData->nColData);
 
   for (int32_t iColData = 0; iColData < pBlockData->nColData; ++iColData) {
-    code = tColDataCopy(&aColData[iColData + 1], &pBlockData->aColData[iColData], (xMallocFn)vnodeBufPoolMalloc, pPool);
+    code = tColDataCopy(&aColData[iColData + 1], &pBlockData->aColData[iColData], tsdbCarveMalloc, &pCursor);
     if (code) goto _exit;
   }
 
@@ -652,12 +784,21 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
 
   // first row
   tsdbRowGetKey(&tRow, &key);
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
   pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
 
+  if (pBlockData->nRow > 1 && tbDataCanAppend(pTbData, &key)) {
+    // in-order batch
+    if ((code = tbDataAppendBatch(pMemTable, pTbData, &tRow, NULL, pBlockData->nRow))) goto _exit;
+    tRow.iRow = pBlockData->nRow - 1;
+    tsdbRowGetKey(&tRow, &key);
+    tRow.iRow = pBlockData->nRow;
+  } else {
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+    if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
+    ++tRow.iRow;
+  }
+
   // remain row
-  ++tRow.iRow;
   if (tRow.iRow < pBlockData->nRow) {
     for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
       pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
@@ -709,15 +850,26 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   TSDBROW           tRow = {.type = TSDBROW_ROW_FMT, .version = version};
   int32_t           iRow = 0;
 
-  // backward put first data
-  tRow.pTSRow = aRow[iRow++];
+  tRow.pTSRow = aRow[iRow];
   tsdbRowGetKey(&tRow, &key);
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
-  if (code) goto _exit;
-
   pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
 
+  if (nRow > 1 && tbDataCanAppend(pTbData, &key)) {
+    // in-order batch
+    code = tbDataAppendBatch(pMemTable, pTbData, &tRow, aRow, nRow);
+    if (code) goto _exit;
+
+    tRow.pTSRow = aRow[nRow - 1];
+    tsdbRowGetKey(&tRow, &key);
+    iRow = nRow;
+  } else {
+    // backward put first data
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+    code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
+    if (code) goto _exit;
+    iRow++;
+  }
+
   // forward put rest data
   if (iRow < nRow) {
     for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
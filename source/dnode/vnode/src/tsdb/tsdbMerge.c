@@ -119,6 +119,7 @@ static int32_t tsdbMergeFileSetBeginOpenReader(SMerger *merger) {
             .tsdb = merger->tsdb,
             .szPage = merger->szPage,
             .file[0] = fobj->f[0],
+            .noCache = true,
         };
 
         TAOS_CHECK_GOTO(tsdbSttFileReaderOpen(fobj->fname, &config, &reader), &lino, _exit);
@@ -198,6 +199,7 @@ static int32_t tsdbMergeFileSetBeginOpenReader(SMerger *merger) {
             .tsdb = merger->tsdb,
             .szPage = merger->szPage,
             .file[0] = fobj->f[0],
+            .noCache = true,
         };
 
         TAOS_CHECK_GOTO(tsdbSttFileReaderOpen(fobj->fname, &config, &reader), &lino, _exit);
@@ -360,6 +362,18 @@ static int32_t tsdbMergeFileSetEnd(SMerger *merger) {
   }
   (void)taosThreadMutexUnlock(&merger->tsdb->mutex);
 
+  // bytes written by this merge
+  int64_t   mergeBytes = 0;
+  STFileOp *op;
+  TARRAY2_FOREACH_PTR(merger->fopArr, op) {
+    if (op->optype == TSDB_FOP_CREATE) {
+      mergeBytes += op->nf.size;
+    } else if (op->optype == TSDB_FOP_MODIFY) {
+      mergeBytes += op->nf.size - op->of.size;
+    }
+  }
+  METRICS_UPDATE(merger->tsdb->pVnode->writeMetrics.merge_bytes, METRIC_LEVEL_HIGH, mergeBytes);
+
 _exit:
   if (code) {
     tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(merger->tsdb->pVnode), __func__, __FILE__, lino,
@@ -21,6 +21,7 @@
 #include "tsdbReadUtil.h"
 #include "tsdbUtil2.h"
 #include "tsimplehash.h"
+#include "vnd.h"
 
 #define ASCENDING_TRAVERSE(o)       (o == TSDB_ORDER_ASC)
 #define getCurrentKeyInSttBlock(_r) (&((_r)->currentKey))
@@ -40,6 +41,7 @@ typedef struct {
   bool overlapWithNeighborBlock;
   bool hasDupTs;
   bool overlapWithDelInfo;
+  bool deletedByDelInfo;  // all rows are covered by the delete skyline
   bool overlapWithSttBlock;
   bool overlapWithKeyInBuf;
   bool partiallyRequired;
@@ -61,6 +63,7 @@ static int32_t doAppendRowFromTSRow(SSDataBlock* pBlock, STsdbReader* pReader, S
 static int32_t doAppendRowFromFileBlock(SSDataBlock* pResBlock, STsdbReader* pReader, SBlockData* pBlockData,
                                         int32_t rowIndex);
 static void    setComposedBlockFlag(STsdbReader* pReader, bool composed);
+static void    drainDecodeSlots(STsdbReader* pReader);
 static int32_t hasBeenDropped(const SArray* pDelList, int32_t* index, int64_t key, int64_t ver, int32_t order,
                               SVersionRange* pVerRange, bool hasPk, bool* dropped);
 
@@ -399,6 +402,7 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
 
   while (1) {
     if (pReader->pFileReader != NULL) {
+      drainDecodeSlots(pReader);
       tsdbDataFileReaderClose(&pReader->pFileReader);
     }
 
@@ -483,6 +487,7 @@ int32_t resetDataBlockIterator(SDataBlockIter* pIter, int32_t order, bool needFr
 
   pIter->order = order;
   pIter->index = -1;
+  pIter->prefetchIndex = -1;
   pIter->numOfBlocks = 0;
 
   if (pIter->blockList == NULL) {
@@ -651,6 +656,12 @@ void tsdbReleaseDataBlock2(void* p) {
 
   STsdbReader* pReader = (STsdbReader*)p;
   SReaderStatus* pStatus = &pReader->status;
+  pStatus->filterColsLoaded = false;
+  for (int32_t i = 0; i < tListLen(pReader->innerReader); ++i) {
+    if (pReader->innerReader[i] != NULL) {
+      pReader->innerReader[i]->status.filterColsLoaded = false;
+    }
+  }
   if (!pStatus->composedDataBlock) {
     (void)tsdbReleaseReader(pReader);
   }
@@ -752,6 +763,9 @@ static int32_t tsdbReaderCreate(SVnode* pVnode, SQueryTableDataCond* pCond, void
   code = tBlockDataCreate(&pReader->status.fileBlockData);
   TSDB_CHECK_CODE(code, lino, _end);
 
+  // the block data of the slots is allocated by the first block decoded into them
+  pReader->decodeAhead.enabled = (tsNumOfScanDecodeThreads > 0);
+
   if (pReader->suppInfo.colId[0] != PRIMARYKEY_TIMESTAMP_COL_ID) {
     tsdbError("the first column isn't primary timestamp, %d, %s", pReader->suppInfo.colId[0], pReader->idStr);
     TSDB_CHECK_CONDITION(pReader->suppInfo.colId[0] == PRIMARYKEY_TIMESTAMP_COL_ID, code, lino, _end,
@@ -830,13 +844,26 @@ static int32_t doLoadBlockIndex(STsdbReader* pReader, SDataFileReader* pFileRead
   }
 #endif
 
-  // todo binary search to the start position
   et1 = taosGetTimestampUs();
 
   pList = &pReader->status.uidList;
 
+  // binary search the first brin block that may hold the queried tables
   int32_t i = 0;
   int32_t j = 0;
+  if (numOfTables > 0) {
+    int32_t hi = TARRAY2_SIZE(pBlkArray);
+    while (i < hi) {
+      int32_t         mid = i + ((hi - i) >> 1);
+      const SBrinBlk* pBlk = &pBlkArray->data[mid];
+      if (pBlk->maxTbid.suid < pReader->info.suid ||
+          (pBlk->maxTbid.suid == pReader->info.suid && pBlk->maxTbid.uid < pList->tableUidList[0])) {
+        i = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+  }
   while (i < TARRAY2_SIZE(pBlkArray)) {
     pBrinBlk = &pBlkArray->data[i];
     if (pBrinBlk->maxTbid.suid < pReader->info.suid) {
@@ -916,6 +943,13 @@ static int32_t loadFileBlockBrinInfo(STsdbReader* pReader, SArray* pIndexList, S
   initBrinRecordIter(&iter, pReader->pFileReader, pIndexList);
 
   while (1) {
+    // jump over the records of the tables not queried and of the blocks ending before the query window
+    if (k < numOfTables) {
+      code = skipBrinRecords(&iter, pReader->info.suid, pReader->status.uidList.tableUidList[k],
+                             pReader->info.window.skey);
+      TSDB_CHECK_CODE(code, lino, _end);
+    }
+
     code = getNextBrinRecord(&iter, &pRecord);
     TSDB_CHECK_CODE(code, lino, _end);
 
@@ -973,8 +1007,18 @@ static int32_t loadFileBlockBrinInfo(STsdbReader* pReader, SArray* pIndexList, S
       }
     }
 
+    // the remaining blocks of this table start even later
+    if (pRecord->firstKey.key.ts > w.ekey) {
+      k += 1;
+      if (k >= numOfTables) {
+        break;
+      } else {
+        continue;
+      }
+    }
+
     // 1. time range check
-    if (pRecord->firstKey.key.ts > w.ekey || pRecord->lastKey.key.ts < w.skey) {
+    if (pRecord->lastKey.key.ts < w.skey) {
       continue;
     }
     // The data block's time range must intersect with the query time range
@@ -1768,7 +1812,10 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, SRowKey* pLastPro
   pResBlock->info.rows = dumpedRows;
   pDumpInfo->rowIndex += step * dumpedRows;
 
-  tColRowGetKeyDeepCopy(pBlockData, pDumpInfo->rowIndex - step, pSupInfo->pkSrcSlot, pLastProcKey);
+  // no last processed key to update when only part of the columns are loaded for the executor to probe the block
+  if (pLastProcKey != NULL) {
+    tColRowGetKeyDeepCopy(pBlockData, pDumpInfo->rowIndex - step, pSupInfo->pkSrcSlot, pLastProcKey);
+  }
 
   // check if current block are all handled
   if (pDumpInfo->rowIndex >= 0 && pDumpInfo->rowIndex < pRecord->numRow) {
@@ -1825,8 +1872,235 @@ _end:
   return pReader->info.pSchema;
 }
 
-static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
-                                   uint64_t uid) {
+// Ask the kernel to read the blocks following the current one in the iterator ahead of time, so that the disk
+// works on them while the current block is decompressed and consumed. Blocks in the iterator are sorted by the file
+// offset, so neighbor blocks are merged into one larger hint.
+static void prefetchFileBlocks(STsdbReader* pReader, SDataBlockIter* pBlockIter) {
+  bool    asc = ASCENDING_TRAVERSE(pBlockIter->order);
+  int32_t step = asc ? 1 : -1;
+  int32_t start = pBlockIter->index + step;
+  int32_t end = pBlockIter->index + step * TSDB_READ_PREFETCH_BLOCKS;
+  int64_t offset = -1;
+  int64_t size = 0;
+
+  if (asc) {
+    start = TMAX(start, pBlockIter->prefetchIndex + 1);
+    end = TMIN(end, pBlockIter->numOfBlocks - 1);
+  } else {
+    start = (pBlockIter->prefetchIndex >= 0) ? TMIN(start, pBlockIter->prefetchIndex - 1) : start;
+    end = TMAX(end, 0);
+  }
+
+  for (int32_t i = start; asc ? (i <= end) : (i >= end); i += step) {
+    SFileDataBlockInfo* pBlockInfo = taosArrayGet(pBlockIter->blockList, i);
+    if (pBlockInfo == NULL) {
+      break;
+    }
+
+    if (offset >= 0 && pBlockInfo->blockOffset == offset + size) {
+      size += pBlockInfo->blockSize;
+    } else if (offset >= 0 && pBlockInfo->blockOffset + pBlockInfo->blockSize == offset) {
+      offset = pBlockInfo->blockOffset;
+      size += pBlockInfo->blockSize;
+    } else {
+      if (offset >= 0) {
+        (void)tsdbDataFileReadBlockDataAhead(pReader->pFileReader, offset, size);
+      }
+      offset = pBlockInfo->blockOffset;
+      size = pBlockInfo->blockSize;
+    }
+
+    pBlockIter->prefetchIndex = i;
+  }
+
+  if (offset >= 0) {
+    (void)tsdbDataFileReadBlockDataAhead(pReader->pFileReader, offset, size);
+  }
+}
+
+static int32_t decodeFileBlockAhead(void* arg) {
+  SBlockDecodeSlot* pSlot = (SBlockDecodeSlot*)arg;
+
+  tBlockDataReset(&pSlot->blockData);
+  pSlot->code = tsdbDataFileReadBlockDataByColumn(pSlot->pFileReader, &pSlot->record, &pSlot->blockData,
+                                                  pSlot->pSchema, pSlot->pColId, pSlot->numOfCols);
+  return pSlot->code;
+}
+
+static int32_t openDecodeSlotReader(STsdbReader* pReader, SBlockDecodeSlot* pSlot) {
+  int32_t code = acquireDecodeReader();
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  code = tsdbDataFileReaderCloneData(pReader->pFileReader, &pSlot->pFileReader);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbDataFileReaderClose(&pSlot->pFileReader);
+    releaseDecodeReader();
+  }
+  return code;
+}
+
+static void closeDecodeSlotReader(SBlockDecodeSlot* pSlot) {
+  if (pSlot->pFileReader != NULL) {
+    tsdbDataFileReaderClose(&pSlot->pFileReader);
+    releaseDecodeReader();
+  }
+}
+
+// Stop all the decode tasks of the reader, and release the file readers and block data of the slots. It must be
+// invoked before the blocks of the current file set are released.
+static void drainDecodeSlots(STsdbReader* pReader) {
+  for (int32_t i = 0; i < TSDB_READ_DECODE_BLOCKS; ++i) {
+    SBlockDecodeSlot* pSlot = &pReader->decodeAhead.slots[i];
+    if (pSlot->busy) {
+      (void)takeDecodeSlot(pSlot);
+    }
+
+    closeDecodeSlotReader(pSlot);
+    tBlockDataDestroy(&pSlot->blockData);
+    (void)tBlockDataCreate(&pSlot->blockData);
+  }
+}
+
+// Take the block decoded ahead by the decode threads, if there is one.
+static bool getDecodedFileBlock(STsdbReader* pReader, SFileDataBlockInfo* pBlockInfo, SBlockData* pBlockData) {
+  SBlockDecodeAhead* pDecode = &pReader->decodeAhead;
+  int32_t            fid = pReader->status.pCurrentFileset->fid;
+
+  for (int32_t i = 0; i < TSDB_READ_DECODE_BLOCKS; ++i) {
+    SBlockDecodeSlot* pSlot = &pDecode->slots[i];
+    if (!pSlot->busy || pSlot->fid != fid || pSlot->record.blockOffset != pBlockInfo->blockOffset) {
+      continue;
+    }
+
+    // the block is loaded by the query thread instead, which reports the error if it is not transient
+    if (!takeDecodeSlot(pSlot)) {
+      if (pSlot->code != TSDB_CODE_SUCCESS) {
+        tsdbDebug("%p failed to decode block ahead since %s, load it again, %s", pReader, tstrerror(pSlot->code),
+                  pReader->idStr);
+      }
+      return false;
+    }
+
+    SBlockData tmp = *pBlockData;
+    *pBlockData = pSlot->blockData;
+    pSlot->blockData = tmp;
+
+    pDecode->numOfHit += 1;
+    pReader->cost.decodeAheadBlocks += 1;
+    return true;
+  }
+
+  return false;
+}
+
+// Hand the blocks following the current one in the iterator to the decode threads, so that they are read and
+// decompressed while the query thread works on the current block. Slots holding blocks that are no longer ahead
+// of the iterator, e.g. blocks skipped by the iterator or loaded column by column, are taken back first.
+static void decodeFileBlocksAhead(STsdbReader* pReader, SDataBlockIter* pBlockIter) {
+  SBlockDecodeAhead*  pDecode = &pReader->decodeAhead;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  int32_t             step = ASCENDING_TRAVERSE(pBlockIter->order) ? 1 : -1;
+  SFileDataBlockInfo* pBlocks[TSDB_READ_DECODE_BLOCKS] = {0};
+  bool                scheduled[TSDB_READ_DECODE_BLOCKS] = {0};
+  int32_t             numOfBlocks = 0;
+  int32_t             fid = 0;
+  int32_t             code = TSDB_CODE_SUCCESS;
+
+  if (!pDecode->enabled || pReader->pFileReader == NULL || pReader->info.pSchema == NULL) {
+    return;
+  }
+
+  fid = pReader->status.pCurrentFileset->fid;
+  for (int32_t i = 1; i <= TSDB_READ_DECODE_BLOCKS; ++i) {
+    int32_t index = pBlockIter->index + step * i;
+    if (index < 0 || index >= pBlockIter->numOfBlocks) {
+      break;
+    }
+    pBlocks[numOfBlocks++] = taosArrayGet(pBlockIter->blockList, index);
+  }
+
+  for (int32_t i = 0; i < TSDB_READ_DECODE_BLOCKS; ++i) {
+    SBlockDecodeSlot* pSlot = &pDecode->slots[i];
+    bool              ahead = false;
+    if (!pSlot->busy) {
+      continue;
+    }
+
+    for (int32_t j = 0; j < numOfBlocks && !ahead; ++j) {
+      if (pBlocks[j] != NULL && pSlot->fid == fid && pSlot->record.blockOffset == pBlocks[j]->blockOffset) {
+        scheduled[j] = true;
+        ahead = true;
+      }
+    }
+
+    if (!ahead) {
+      (void)takeDecodeSlot(pSlot);
+      pDecode->numOfWasted += 1;
+    }
+  }
+
+  if (pDecode->numOfWasted >= TSDB_READ_DECODE_BLOCKS * 4 && pDecode->numOfWasted > pDecode->numOfHit) {
+    tsdbDebug("%p turn off decoding blocks ahead, hit:%d, wasted:%d, %s", pReader, pDecode->numOfHit,
+              pDecode->numOfWasted, pReader->idStr);
+    pDecode->enabled = false;
+    return;
+  }
+
+  for (int32_t i = 0, j = 0; i < TSDB_READ_DECODE_BLOCKS && j < numOfBlocks; ++i) {
+    SBlockDecodeSlot* pSlot = &pDecode->slots[i];
+    if (pSlot->busy) {
+      continue;
+    }
+
+    while (j < numOfBlocks && (pBlocks[j] == NULL || scheduled[j])) {
+      j += 1;
+    }
+    if (j >= numOfBlocks) {
+      break;
+    }
+
+    if (pSlot->pFileReader != NULL && pSlot->fid != fid) {
+      closeDecodeSlotReader(pSlot);
+    }
+
+    // the blocks left are loaded by the query thread if the clones of all readers reach the limit
+    if (pSlot->pFileReader == NULL) {
+      code = openDecodeSlotReader(pReader, pSlot);
+      if (code == TSDB_CODE_OUT_OF_RANGE) {
+        code = TSDB_CODE_SUCCESS;
+        break;
+      } else if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+    }
+
+    blockInfoToRecord(&pSlot->record, pBlocks[j], pSup);
+    pSlot->fid = fid;
+    pSlot->code = TSDB_CODE_SUCCESS;
+    pSlot->pSchema = pReader->info.pSchema;
+    pSlot->pColId = &pSup->colId[1];
+    pSlot->numOfCols = pSup->numOfCols - 1;
+
+    code = vnodeAsync(DECODE_TASK_ASYNC, EVA_PRIORITY_NORMAL, decodeFileBlockAhead, NULL, pSlot, &pSlot->taskId);
+    if (code != TSDB_CODE_SUCCESS) {
+      pSlot->taskId = (SVATaskID){0};
+      break;
+    }
+
+    pSlot->busy = true;
+    scheduled[j] = true;
+  }
+
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbWarn("%p failed to decode blocks ahead since %s, turn it off, %s", pReader, tstrerror(code), pReader->idStr);
+    pDecode->enabled = false;
+  }
+}
+
+static int32_t doLoadFileBlockDataByColumn(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                           uint64_t uid, int16_t* pColId, int32_t numOfCols) {
   int32_t             code = TSDB_CODE_SUCCESS;
   int32_t             lino = 0;
   STSchema*           pSchema = NULL;
@@ -1836,6 +2110,7 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   int64_t             st = 0;
   SBrinRecord         tmp;
   SBrinRecord*        pRecord = NULL;
+  bool                decoded = false;
 
   TSDB_CHECK_NULL(pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
   TSDB_CHECK_NULL(pBlockData, code, lino, _end, TSDB_CODE_INVALID_PARA);
@@ -1845,6 +2120,7 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   pSup = &pReader->suppInfo;
 
   tBlockDataReset(pBlockData);
+  pReader->status.filterColsLoaded = false;
 
   if (pReader->info.pSchema == NULL) {
     pSchema = getTableSchemaImpl(pReader, uid);
@@ -1860,10 +2136,20 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
 
   pDumpInfo = &pReader->status.fBlockDumpInfo;
 
+  prefetchFileBlocks(pReader, pBlockIter);
+
   blockInfoToRecord(&tmp, pBlockInfo, pSup);
   pRecord = &tmp;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+
+  // only the blocks loaded with all the required columns are decoded ahead
+  if (numOfCols == pSup->numOfCols - 1) {
+    decoded = getDecodedFileBlock(pReader, pBlockInfo, pBlockData);
+    decodeFileBlocksAhead(pReader, pBlockIter);
+  }
+
+  if (!decoded) {
+    code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, pColId, numOfCols);
+  }
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1889,6 +2175,59 @@ _end:
   return code;
 }
 
+static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                   uint64_t uid) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  return doLoadFileBlockDataByColumn(pReader, pBlockIter, pBlockData, uid, &pSup->colId[1], pSup->numOfCols - 1);
+}
+
+// The filter columns of current block have been decoded by doRetrieveDataBlockByColumn, they are taken over and only
+// the other columns are decoded.
+static int32_t doLoadFileBlockDataRest(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                       uint64_t uid) {
+  int32_t             code = TSDB_CODE_SUCCESS;
+  int32_t             lino = 0;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  SColData*           aColData = pBlockData->aColData;
+  int32_t             nColData = pBlockData->nColData;
+  int16_t*            pColId = NULL;
+  int32_t             numOfCols = 0;
+
+  pBlockData->aColData = NULL;
+  pBlockData->nColData = 0;
+
+  pColId = taosMemoryMalloc(sizeof(int16_t) * pSup->numOfCols);
+  TSDB_CHECK_NULL(pColId, code, lino, _end, terrno);
+
+  for (int32_t i = 1, j = 0; i < pSup->numOfCols; ++i) {
+    while (j < nColData && aColData[j].cid < pSup->colId[i]) {
+      j += 1;
+    }
+    if (j >= nColData || aColData[j].cid != pSup->colId[i]) {
+      pColId[numOfCols++] = pSup->colId[i];
+    }
+  }
+
+  code = doLoadFileBlockDataByColumn(pReader, pBlockIter, pBlockData, uid, pColId, numOfCols);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  code = tBlockDataMergeColData(pBlockData, aColData, nColData);
+  aColData = NULL;
+  nColData = 0;
+  TSDB_CHECK_CODE(code, lino, _end);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  for (int32_t i = 0; i < nColData; ++i) {
+    tColDataDestroy(&aColData[i]);
+  }
+  taosMemoryFree(aColData);
+  taosMemoryFree(pColId);
+  return code;
+}
+
 /**
  * This is an two rectangles overlap cases.
  */
@@ -2123,6 +2462,8 @@ static int32_t getBlockToLoadInfo(SDataBlockToLoadInfo* pInfo, SFileDataBlockInf
   // has duplicated ts of different version in this block
   pInfo->hasDupTs = (pBlockInfo->numRow > pBlockInfo->count) || (pBlockInfo->count <= 0);
   pInfo->overlapWithDelInfo = overlapWithDelSkyline(pScanInfo, &pRecord, order);
+  pInfo->deletedByDelInfo =
+      pInfo->overlapWithDelInfo && coveredByDelSkyline(pScanInfo, &pRecord, &pReader->info.verRange);
 
   // todo handle the primary key overlap case
   if (pScanInfo->sttKeyInfo.status == STT_FILE_HAS_DATA) {
@@ -2147,18 +2488,27 @@ _end:
 // 4. output buffer should be large enough to hold all rows in current block
 // 5. delete info should not overlap with current block data
 // 6. current block should not contain the duplicated ts
+// The block can be skipped without loading if all its rows are deleted and no other data of the table, i.e. the
+// neighbor block, the stt blocks and the buffer, falls into its time range.
 static int32_t fileBlockShouldLoad(STsdbReader* pReader, SFileDataBlockInfo* pBlockInfo, STableBlockScanInfo* pScanInfo,
-                                   TSDBKEY keyInBuf, bool* load) {
+                                   TSDBKEY keyInBuf, bool* load, bool* deleted) {
   int32_t              code = TSDB_CODE_SUCCESS;
   int32_t              lino = 0;
   SDataBlockToLoadInfo info = {0};
 
   TSDB_CHECK_NULL(load, code, lino, _end, TSDB_CODE_INVALID_PARA);
+  TSDB_CHECK_NULL(deleted, code, lino, _end, TSDB_CODE_INVALID_PARA);
 
   *load = false;
   code = getBlockToLoadInfo(&info, pBlockInfo, pScanInfo, keyInBuf, pReader);
   TSDB_CHECK_CODE(code, lino, _end);
 
+  *deleted = info.deletedByDelInfo && !(info.overlapWithNeighborBlock || info.overlapWithKeyInBuf ||
+                                        info.overlapWithSttBlock);
+  if (*deleted) {
+    goto _end;
+  }
+
   *load = (info.overlapWithNeighborBlock || info.hasDupTs || info.partiallyRequired || info.overlapWithKeyInBuf ||
            info.moreThanCapcity || info.overlapWithDelInfo || info.overlapWithSttBlock);
 
@@ -3957,6 +4307,29 @@ _end:
   return code;
 }
 
+static int32_t skipDeletedFileBlock(STsdbReader* pReader, STableBlockScanInfo* pScanInfo,
+                                    SFileDataBlockInfo* pBlockInfo) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  int32_t        lino = 0;
+  SDataBlockInfo info = {.window = {.skey = pBlockInfo->firstKey, .ekey = pBlockInfo->lastKey}};
+
+  setBlockAllDumped(&pReader->status.fBlockDumpInfo, pBlockInfo->lastKey, pReader->info.order);
+  code = updateLastKeyInfo(&pScanInfo->lastProcKey, pBlockInfo, &info, pReader->suppInfo.numOfPks,
+                           ASCENDING_TRAVERSE(pReader->info.order));
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  pReader->cost.deletedBlocks += 1;
+  tsdbDebug("%p uid:%" PRIu64 " file block skipped since all rows are deleted, rows:%d, brange:%" PRId64 "-%" PRId64
+            ", %s",
+            pReader, pScanInfo->uid, pBlockInfo->numRow, pBlockInfo->firstKey, pBlockInfo->lastKey, pReader->idStr);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t doLoadSttBlockSequentially(STsdbReader* pReader) {
   int32_t              code = TSDB_CODE_SUCCESS;
   int32_t              lino = 0;
@@ -4119,9 +4492,13 @@ static int32_t doBuildDataBlock(STsdbReader* pReader) {
   code = getCurrentKeyInBuf(pScanInfo, pReader, &keyInBuf);
   TSDB_CHECK_CODE(code, lino, _end);
   bool load = false;
-  code = fileBlockShouldLoad(pReader, pBlockInfo, pScanInfo, keyInBuf, &load);
+  bool deleted = false;
+  code = fileBlockShouldLoad(pReader, pBlockInfo, pScanInfo, keyInBuf, &load, &deleted);
   TSDB_CHECK_CODE(code, lino, _end);
-  if (load) {
+  if (deleted) {
+    code = skipDeletedFileBlock(pReader, pScanInfo, pBlockInfo);
+    TSDB_CHECK_CODE(code, lino, _end);
+  } else if (load) {
     code = doLoadFileBlockData(pReader, pBlockIter, &pStatus->fileBlockData, pScanInfo->uid);
     TSDB_CHECK_CODE(code, lino, _end);
 
@@ -4526,6 +4903,7 @@ static int32_t buildBlockFromFiles(STsdbReader* pReader) {
           }
 
           tBlockDataReset(pBlockData);
+          drainDecodeSlots(pReader);
           code = resetDataBlockIterator(pBlockIter, pReader->info.order, shouldFreePkBuf(&pReader->suppInfo), id);
           TSDB_CHECK_CODE(code, lino, _end);
 
@@ -5837,6 +6215,9 @@ void tsdbReaderClose2(void* ptr) {
     }
   }
 
+  // the decode threads refer to the columns and the block list of the reader
+  drainDecodeSlots(pReader);
+
   SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
   TARRAY2_DESTROY(&pSupInfo->colAggArray, NULL);
 
@@ -5900,13 +6281,15 @@ void tsdbReaderClose2(void* ptr) {
       " SMA-time:%.2f ms, fileBlocks:%" PRId64
       ", fileBlocks-load-time:%.2f ms, "
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
-      ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
-      ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
+      ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64 ", deleted-blocks:%" PRId64
+      ", composed-blocks-time:%.2fms, decoded-ahead-blocks:%" PRId64
+      ", STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
       "ms, initSttBlockReader:%.2fms, %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
-      pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
+      pCost->deletedBlocks, pCost->buildComposedBlockTime, pCost->decodeAheadBlocks,
+      numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
       pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
@@ -5929,6 +6312,7 @@ static int32_t doSuspendCurrentReader(STsdbReader* pCurrentReader) {
   pStatus = &pCurrentReader->status;
 
   if (pStatus->loadFromFile) {
+    drainDecodeSlots(pCurrentReader);
     tsdbDataFileReaderClose(&pCurrentReader->pFileReader);
 
     SReadCostSummary* pCost = &pCurrentReader->cost;
@@ -6548,7 +6932,135 @@ _end:
   return code;
 }
 
-static int32_t doRetrieveDataBlock(STsdbReader* pReader, SSDataBlock** pBlock) {
+int32_t tsdbCheckBlockBloomFilter2(void* p, SArray* pProbes, bool* keep) {
+  int32_t             code = TSDB_CODE_SUCCESS;
+  int32_t             lino = 0;
+  STsdbReader*        pReader = (STsdbReader*)p;
+  SFileDataBlockInfo* pBlockInfo = NULL;
+  int32_t             numOfProbes = 0;
+  int16_t*            pColId = NULL;
+  SBloomFilter**      aBF = NULL;
+
+  TSDB_CHECK_NULL(pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
+  TSDB_CHECK_NULL(keep, code, lino, _end, TSDB_CODE_INVALID_PARA);
+
+  *keep = true;
+  if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL || pReader->status.composedDataBlock) {
+    goto _end;
+  }
+
+  code = getCurrentBlockInfo(&pReader->status.blockIter, &pBlockInfo, pReader->idStr);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  numOfProbes = taosArrayGetSize(pProbes);
+  if (pReader->resBlockInfo.pResBlock->info.id.uid != pBlockInfo->uid || pBlockInfo->smaSize <= 0 ||
+      numOfProbes == 0) {
+    goto _end;
+  }
+
+  pColId = taosMemoryMalloc(sizeof(int16_t) * numOfProbes);
+  TSDB_CHECK_NULL(pColId, code, lino, _end, terrno);
+  aBF = taosMemoryCalloc(numOfProbes, sizeof(SBloomFilter*));
+  TSDB_CHECK_NULL(aBF, code, lino, _end, terrno);
+
+  for (int32_t i = 0; i < numOfProbes; ++i) {
+    SBlockBloomProbe* pProbe = taosArrayGet(pProbes, i);
+    TSDB_CHECK_NULL(pProbe, code, lino, _end, terrno);
+    pColId[i] = pProbe->colId;
+  }
+
+  SBrinRecord record;
+  blockInfoToRecord(&record, pBlockInfo, &pReader->suppInfo);
+
+  // the filters of all the probed columns are read with one read of the sma region of the block
+  code = tsdbDataFileReadBlockBloomFilter(pReader->pFileReader, &record, pColId, numOfProbes, aBF);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+  for (int32_t i = 0; i < numOfProbes && *keep; ++i) {
+    SBlockBloomProbe* pProbe = taosArrayGet(pProbes, i);
+    if (aBF[i] == NULL) {
+      continue;
+    }
+
+    // the block could be skipped only if none of the candidate values hits the filter
+    *keep = false;
+    for (int32_t j = 0; j + 1 < taosArrayGetSize(pProbe->pHashes); j += 2) {
+      uint64_t* h1 = taosArrayGet(pProbe->pHashes, j);
+      uint64_t* h2 = taosArrayGet(pProbe->pHashes, j + 1);
+      if (tBloomFilterNoContain(aBF[i], *h1, *h2) != TSDB_CODE_SUCCESS) {
+        *keep = true;
+        break;
+      }
+    }
+  }
+
+  if (!*keep) {
+    tsdbDebug("%p uid:%" PRIu64 " file block skipped by bloom filter, brange:%" PRId64 "-%" PRId64 " %s", pReader,
+              pBlockInfo->uid, pBlockInfo->firstKey, pBlockInfo->lastKey, pReader->idStr);
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+    if (keep != NULL) {
+      *keep = true;
+    }
+  }
+  if (aBF != NULL) {
+    for (int32_t i = 0; i < numOfProbes; ++i) {
+      tBloomFilterDestroy(aBF[i]);
+    }
+  }
+  taosMemoryFree(aBF);
+  taosMemoryFree(pColId);
+  return code;
+}
+
+// Load only the columns in pIdList of current file block and copy them into the result block, the other output
+// columns are filled with NULL. The dump position of the block is left untouched, so the executor is able to evaluate
+// the filter on these columns first, and retrieve the whole block again only when some rows are qualified. The
+// columns loaded here are kept in fileBlockData, the whole retrieve decodes the other columns only.
+static int32_t doRetrieveDataBlockByColumn(STsdbReader* pReader, STableBlockScanInfo* pBlockScanInfo,
+                                           SArray* pIdList) {
+  int32_t             code = TSDB_CODE_SUCCESS;
+  int32_t             lino = 0;
+  SReaderStatus*      pStatus = &pReader->status;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  SFileBlockDumpInfo  dumpInfo = pStatus->fBlockDumpInfo;
+  int16_t*            pColId = NULL;
+  int32_t             numOfCols = 0;
+
+  pColId = taosMemoryMalloc(sizeof(int16_t) * pSup->numOfCols);
+  TSDB_CHECK_NULL(pColId, code, lino, _end, terrno);
+
+  for (int32_t i = 1; i < pSup->numOfCols; ++i) {
+    for (int32_t j = 0; j < taosArrayGetSize(pIdList); ++j) {
+      int16_t* pId = taosArrayGet(pIdList, j);
+      if (pId != NULL && *pId == pSup->colId[i]) {
+        pColId[numOfCols++] = pSup->colId[i];
+        break;
+      }
+    }
+  }
+
+  code = doLoadFileBlockDataByColumn(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid,
+                                     pColId, numOfCols);
+  TSDB_CHECK_CODE(code, lino, _end);
+  pStatus->filterColsLoaded = true;
+
+  code = copyBlockDataToSDataBlock(pReader, NULL);
+  TSDB_CHECK_CODE(code, lino, _end);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  pStatus->fBlockDumpInfo = dumpInfo;
+  taosMemoryFree(pColId);
+  return code;
+}
+
+static int32_t doRetrieveDataBlock(STsdbReader* pReader, SSDataBlock** pBlock, SArray* pIdList) {
   int32_t              code = TSDB_CODE_SUCCESS;
   int32_t              lino = 0;
   SReaderStatus*       pStatus = NULL;
@@ -6572,11 +7084,20 @@ static int32_t doRetrieveDataBlock(STsdbReader* pReader, SSDataBlock** pBlock) {
   TSDB_CHECK_CODE(code, lino, _end);
 
   reset = true;
-  code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
-  TSDB_CHECK_CODE(code, lino, _end);
+  if (pIdList != NULL) {
+    code = doRetrieveDataBlockByColumn(pReader, pBlockScanInfo, pIdList);
+    TSDB_CHECK_CODE(code, lino, _end);
+  } else {
+    if (pStatus->filterColsLoaded) {
+      code = doLoadFileBlockDataRest(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+    } else {
+      code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+    }
+    TSDB_CHECK_CODE(code, lino, _end);
 
-  code = copyBlockDataToSDataBlock(pReader, &pBlockScanInfo->lastProcKey);
-  TSDB_CHECK_CODE(code, lino, _end);
+    code = copyBlockDataToSDataBlock(pReader, &pBlockScanInfo->lastProcKey);
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
 
   *pBlock = pReader->resBlockInfo.pResBlock;
 
@@ -6618,10 +7139,13 @@ int32_t tsdbRetrieveDataBlock2(void* p, SSDataBlock** pBlock, SArray* pIdList) {
     goto _end;
   }
 
-  code = doRetrieveDataBlock(pTReader, pBlock);
+  code = doRetrieveDataBlock(pTReader, pBlock, pIdList);
 
-  tsdbTrace("tsdb/read-retrieve: %p, unlock read mutex", pReader);
-  (void)tsdbReleaseReader(pReader);
+  // the block is still held by the caller after a partial retrieve, which will retrieve or release it later.
+  if (pIdList == NULL) {
+    tsdbTrace("tsdb/read-retrieve: %p, unlock read mutex", pReader);
+    (void)tsdbReleaseReader(pReader);
+  }
   TSDB_CHECK_CODE(code, lino, _end);
 
   //  tsdbReaderSuspend2(pReader);
@@ -6672,6 +7196,7 @@ int32_t tsdbReaderReset2(void* p, SQueryTableDataCond* pCond) {
   memset(&pReader->suppInfo.tsColAgg, 0, sizeof(SColumnDataAgg));
 
   pReader->suppInfo.tsColAgg.colId = PRIMARYKEY_TIMESTAMP_COL_ID;
+  drainDecodeSlots(pReader);
   tsdbDataFileReaderClose(&pReader->pFileReader);
 
   int32_t numOfTables = tSimpleHashGetSize(pStatus->pTableMap);
@@ -20,6 +20,7 @@
 #include "tsdbMerge.h"
 #include "tsdbUtil2.h"
 #include "tsimplehash.h"
+#include "vnd.h"
 
 static bool overlapWithDelSkylineWithoutVer(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord,
                                             int32_t order);
@@ -589,6 +590,31 @@ void initBrinRecordIter(SBrinRecordIter* pIter, SDataFileReader* pReader, SArray
   pIter->pBrinBlockList = pList;
 }
 
+static int32_t loadNextBrinBlock(SBrinRecordIter* pIter) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+
+  pIter->blockIndex += 1;
+  pIter->pCurrentBlk = taosArrayGet(pIter->pBrinBlockList, pIter->blockIndex);
+  TSDB_CHECK_NULL(pIter->pCurrentBlk, code, lino, _end, terrno);
+
+  tBrinBlockClear(&pIter->block);
+  TSDB_CHECK_NULL(pIter->pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
+  code = tsdbDataFileReadBrinBlock(pIter->pReader, pIter->pCurrentBlk, &pIter->block);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("failed to read brinBlock from file, code:%s", tstrerror(code));
+    TSDB_CHECK_CODE(code, lino, _end);
+  }
+
+  pIter->recordIndex = -1;
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 int32_t getNextBrinRecord(SBrinRecordIter* pIter, SBrinRecord** pRecord) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t lino = 0;
@@ -599,23 +625,12 @@ int32_t getNextBrinRecord(SBrinRecordIter* pIter, SBrinRecord** pRecord) {
   *pRecord = NULL;
 
   if (pIter->blockIndex == -1 || (pIter->recordIndex + 1) >= pIter->block.numOfRecords) {
-    pIter->blockIndex += 1;
-    if (pIter->blockIndex >= taosArrayGetSize(pIter->pBrinBlockList)) {
+    if (pIter->blockIndex + 1 >= taosArrayGetSize(pIter->pBrinBlockList)) {
       goto _end;
     }
 
-    pIter->pCurrentBlk = taosArrayGet(pIter->pBrinBlockList, pIter->blockIndex);
-    TSDB_CHECK_NULL(pIter->pCurrentBlk, code, lino, _end, terrno);
-
-    tBrinBlockClear(&pIter->block);
-    TSDB_CHECK_NULL(pIter->pReader, code, lino, _end, TSDB_CODE_INVALID_PARA);
-    code = tsdbDataFileReadBrinBlock(pIter->pReader, pIter->pCurrentBlk, &pIter->block);
-    if (code != TSDB_CODE_SUCCESS) {
-      tsdbError("failed to read brinBlock from file, code:%s", tstrerror(code));
-      TSDB_CHECK_CODE(code, lino, _end);
-    }
-
-    pIter->recordIndex = -1;
+    code = loadNextBrinBlock(pIter);
+    TSDB_CHECK_CODE(code, lino, _end);
   }
 
   pIter->recordIndex += 1;
@@ -630,6 +645,87 @@ _end:
   return code;
 }
 
+// compare the (suid, uid, last key) of a brin record with the given one, reading the columns in place
+static int32_t brinRecordCompare(const SBrinBlock* pBlock, int32_t idx, int64_t suid, int64_t uid, TSKEY skey) {
+  int64_t v = ((const int64_t*)tBufferGetData(&pBlock->suids))[idx];
+  if (v != suid) {
+    return (v < suid) ? -1 : 1;
+  }
+
+  v = ((const int64_t*)tBufferGetData(&pBlock->uids))[idx];
+  if (v != uid) {
+    return (v < uid) ? -1 : 1;
+  }
+
+  v = ((const int64_t*)tBufferGetData(&pBlock->lastKeyTimestamps))[idx];
+  if (v != skey) {
+    return (v < skey) ? -1 : 1;
+  }
+  return 0;
+}
+
+// Skip the records of the tables before (suid, uid) and the records of that table ending before skey without
+// decoding them. The blocks of a table do not overlap in a data file, so (suid, uid, last key) ascends in the brin
+// records and both the brin blocks and the records in a block can be binary searched.
+int32_t skipBrinRecords(SBrinRecordIter* pIter, int64_t suid, int64_t uid, TSKEY skey) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+
+  TSDB_CHECK_NULL(pIter, code, lino, _end, TSDB_CODE_INVALID_PARA);
+
+  while (1) {
+    if (pIter->blockIndex == -1 || (pIter->recordIndex + 1) >= pIter->block.numOfRecords) {
+      int32_t numOfBlocks = taosArrayGetSize(pIter->pBrinBlockList);
+      int32_t lo = pIter->blockIndex + 1;
+      int32_t hi = numOfBlocks;
+      while (lo < hi) {
+        int32_t         mid = lo + ((hi - lo) >> 1);
+        const SBrinBlk* pBlk = taosArrayGet(pIter->pBrinBlockList, mid);
+        if (pBlk->maxTbid.suid < suid || (pBlk->maxTbid.suid == suid && pBlk->maxTbid.uid < uid)) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+
+      if (lo >= numOfBlocks) {  // leave the iterator exhausted
+        pIter->blockIndex = numOfBlocks - 1;
+        pIter->recordIndex = pIter->block.numOfRecords - 1;
+        goto _end;
+      }
+
+      if (lo > pIter->blockIndex + 1) {
+        pIter->blockIndex = lo - 1;
+      }
+
+      code = loadNextBrinBlock(pIter);
+      TSDB_CHECK_CODE(code, lino, _end);
+    }
+
+    int32_t lo = pIter->recordIndex + 1;
+    int32_t hi = pIter->block.numOfRecords;
+    while (lo < hi) {
+      int32_t mid = lo + ((hi - lo) >> 1);
+      if (brinRecordCompare(&pIter->block, mid, suid, uid, skey) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+
+    pIter->recordIndex = lo - 1;
+    if (lo < pIter->block.numOfRecords) {
+      break;
+    }
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 void clearBrinBlockIter(SBrinRecordIter* pIter) {
   if (pIter != NULL) {
     tBrinBlockDestroy(&pIter->block);
@@ -775,6 +871,7 @@ void clearDataBlockIterator(SDataBlockIter* pIter, bool needFree) {
   }
 
   pIter->index = -1;
+  pIter->prefetchIndex = -1;
   pIter->numOfBlocks = 0;
 
   if (needFree) {
@@ -790,6 +887,7 @@ void cleanupDataBlockIterator(SDataBlockIter* pIter, bool needFree) {
   }
 
   pIter->index = -1;
+  pIter->prefetchIndex = -1;
   pIter->numOfBlocks = 0;
   if (needFree) {
     taosArrayDestroyEx(pIter->blockList, freePkItem);
@@ -1634,6 +1732,26 @@ static bool doCheckDatablockOverlapWithoutVersion(STableBlockScanInfo* pBlockSca
   return false;
 }
 
+// index of the last skyline point whose ts is less than (or equal to, if inclusive) the given ts, -1 if none
+static int32_t delSkylineSearch(const SArray* pSkyline, TSKEY ts, bool inclusive) {
+  int32_t left = 0;
+  int32_t right = (int32_t)taosArrayGetSize(pSkyline) - 1;
+  int32_t index = -1;
+
+  while (left <= right) {
+    int32_t  mid = left + ((right - left) >> 1);
+    TSDBKEY* p = taosArrayGet(pSkyline, mid);
+    if (p->ts < ts || (inclusive && p->ts == ts)) {
+      index = mid;
+      left = mid + 1;
+    } else {
+      right = mid - 1;
+    }
+  }
+
+  return index;
+}
+
 bool overlapWithDelSkyline(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord, int32_t order) {
   if (pBlockScanInfo->delSkyline == NULL || (taosArrayGetSize(pBlockScanInfo->delSkyline) == 0)) {
     return false;
@@ -1650,29 +1768,40 @@ bool overlapWithDelSkyline(STableBlockScanInfo* pBlockScanInfo, const SBrinRecor
     return false;
   }
 
-  // version is not overlap
-  if (ASCENDING_TRAVERSE(order)) {
-    return doCheckDatablockOverlap(pBlockScanInfo, pRecord, pBlockScanInfo->fileDelIndex);
-  } else {
-    int32_t index = pBlockScanInfo->fileDelIndex;
-    while (1) {
-      TSDBKEY* p = taosArrayGet(pBlockScanInfo->delSkyline, index);
-      if (p == NULL) {
-        return false;
-      }
+  // version is not overlap, start from the last point before the block, the points ahead of it end before the block
+  int32_t index = delSkylineSearch(pBlockScanInfo->delSkyline, pRecord->firstKey.key.ts, false);
+  return doCheckDatablockOverlap(pBlockScanInfo, pRecord, TMAX(index, 0));
+}
 
-      if (p->ts > pRecord->firstKey.key.ts && index > 0) {
-        index -= 1;
-      } else {  // find the first point that is smaller than the minKey.ts of dataBlock.
-        if (p->ts == pRecord->firstKey.key.ts && p->version < pRecord->maxVer && index > 0) {
-          index -= 1;
-        }
-        break;
-      }
+bool coveredByDelSkyline(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord,
+                         const SVersionRange* pVerRange) {
+  const SArray* pSkyline = pBlockScanInfo->delSkyline;
+  int32_t       num = (int32_t)taosArrayGetSize(pSkyline);
+  if (num < 2) {
+    return false;
+  }
+
+  // the segment [p[i].ts, p[i + 1].ts] deletes the rows of version no greater than p[i].version, so the block is
+  // deleted entirely if consecutive segments cover its time range with versions no less than its max version.
+  int32_t i = delSkylineSearch(pSkyline, pRecord->firstKey.key.ts, true);
+  if (i < 0) {
+    return false;
+  }
+
+  for (; i < num - 1; ++i) {
+    TSDBKEY* p = taosArrayGet(pSkyline, i);
+    TSDBKEY* pNext = taosArrayGet(pSkyline, i + 1);
+    if (p->version <= 0 || p->version < pRecord->maxVer || p->version > pVerRange->maxVer ||
+        p->version < pVerRange->minVer) {
+      return false;
     }
 
-    return doCheckDatablockOverlap(pBlockScanInfo, pRecord, index);
+    if (pNext->ts >= pRecord->lastKey.key.ts) {
+      return true;
+    }
   }
+
+  return false;
 }
 
 bool overlapWithDelSkylineWithoutVer(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord, int32_t order) {
@@ -1715,3 +1844,39 @@ bool overlapWithDelSkylineWithoutVer(STableBlockScanInfo* pBlockScanInfo, const
     return doCheckDatablockOverlapWithoutVersion(pBlockScanInfo, pRecord, index);
   }
 }
+
+static int32_t numOfDecodeReaders = 0;  // data file readers cloned by the decode slots of all readers
+
+// Count a data file reader cloned for a decode slot against TSDB_READ_DECODE_READERS, so that the fds and buffers
+// of the clones are bounded however many queries run. Return TSDB_CODE_OUT_OF_RANGE if the limit is reached.
+int32_t acquireDecodeReader() {
+  if (atomic_add_fetch_32(&numOfDecodeReaders, 1) > TSDB_READ_DECODE_READERS) {
+    (void)atomic_sub_fetch_32(&numOfDecodeReaders, 1);
+    return TSDB_CODE_OUT_OF_RANGE;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+void releaseDecodeReader() { (void)atomic_sub_fetch_32(&numOfDecodeReaders, 1); }
+
+// Wait for the decode task of the slot to finish. A task not picked up by any thread yet is taken back instead, so
+// the query thread never waits in the queue behind other queries. Return true if the task has run.
+bool waitDecodeSlot(SBlockDecodeSlot* pSlot) {
+  bool decoded = true;
+
+  if (vnodeACancel(&pSlot->taskId) == 0) {
+    decoded = false;
+  } else {
+    vnodeAWait(&pSlot->taskId);
+  }
+
+  pSlot->taskId = (SVATaskID){0};
+  return decoded;
+}
+
+// Release the busy slot. Return true if its block has been decoded, the code of a failed decoding is kept in the slot.
+bool takeDecodeSlot(SBlockDecodeSlot* pSlot) {
+  bool decoded = waitDecodeSlot(pSlot) && (pSlot->code == TSDB_CODE_SUCCESS);
+  pSlot->busy = false;
+  return decoded;
+}
@@ -26,6 +26,10 @@ extern "C" {
 
 #define ASCENDING_TRAVERSE(o) (o == TSDB_ORDER_ASC)
 
+#define TSDB_READ_PREFETCH_BLOCKS 8  // number of data blocks ahead of the block iterator to prefetch
+#define TSDB_READ_DECODE_BLOCKS   4  // number of data blocks ahead of the block iterator to decode in parallel
+#define TSDB_READ_DECODE_READERS  256  // data file readers cloned for decoding ahead, by all the readers of the dnode
+
 #define INIT_TIMEWINDOW(_w) \
   do {                      \
     (_w)->skey = INT64_MAX; \
@@ -146,10 +150,12 @@ typedef struct SReadCostSummary {
   double                smaLoadTime;
   SSttBlockLoadCostInfo sttCost;
   int64_t               composedBlocks;
+  int64_t               deletedBlocks;
   double                buildComposedBlockTime;
   double                createScanInfoList;
   double                createSkylineIterTime;
   double                initSttBlockReader;
+  int64_t               decodeAheadBlocks;
 } SReadCostSummary;
 
 typedef struct STableUidList {
@@ -241,7 +247,8 @@ typedef struct SFileDataBlockInfo {
 typedef struct SDataBlockIter {
   int32_t numOfBlocks;
   int32_t index;
-  SArray* blockList;  // SArray<SFileDataBlockInfo>
+  int32_t prefetchIndex;  // the farthest block in blockList that has been prefetched, -1 if none
+  SArray* blockList;      // SArray<SFileDataBlockInfo>
   int32_t order;
 } SDataBlockIter;
 
@@ -261,6 +268,7 @@ typedef struct SReaderStatus {
   SFileBlockDumpInfo    fBlockDumpInfo;
   STFileSet*            pCurrentFileset;  // current opened file set
   SBlockData            fileBlockData;
+  bool                  filterColsLoaded;  // fileBlockData keeps the filter columns of current block only
   SFilesetIter          fileIter;
   SDataBlockIter        blockIter;
   SArray*               pLDataIterArray;
@@ -279,6 +287,27 @@ typedef struct SReaderStatus {
   STableBlockScanInfo** pProcMemTableIter;
 } SReaderStatus;
 
+// a data block decoded by the vnode-decode threads while the query thread is busy with the blocks before it
+typedef struct SBlockDecodeSlot {
+  bool             busy;         // a block is scheduled, or decoded but not consumed yet
+  int32_t          code;
+  int32_t          fid;
+  SVATaskID        taskId;
+  SDataFileReader* pFileReader;  // a clone of the reader of the query, the fd can not be shared among threads
+  SBrinRecord      record;
+  STSchema*        pSchema;
+  int16_t*         pColId;
+  int32_t          numOfCols;
+  SBlockData       blockData;
+} SBlockDecodeSlot;
+
+typedef struct SBlockDecodeAhead {
+  bool             enabled;
+  int32_t          numOfHit;
+  int32_t          numOfWasted;  // decoded blocks not consumed, decoding ahead is turned off if it keeps missing
+  SBlockDecodeSlot slots[TSDB_READ_DECODE_BLOCKS];
+} SBlockDecodeAhead;
+
 struct STsdbReader {
   STsdb*              pTsdb;
   STsdbReaderInfo     info;
@@ -296,6 +325,7 @@ struct STsdbReader {
   SHashObj**          pIgnoreTables;
   SSHashObj*          pSchemaMap;   // keep the retrieved schema info, to avoid the overhead by repeatly load schema
   SDataFileReader*    pFileReader;  // the file reader
+  SBlockDecodeAhead   decodeAhead;
   SBlockInfoBuf       blockInfoBuf;
   EContentData        step;
   STsdbReader*        innerReader[2];
@@ -333,6 +363,7 @@ int32_t getPosInBlockInfoBuf(SBlockInfoBuf* pBuf, int32_t index, STableBlockScan
 // brin records iterator
 void    initBrinRecordIter(SBrinRecordIter* pIter, SDataFileReader* pReader, SArray* pList);
 int32_t getNextBrinRecord(SBrinRecordIter* pIter, SBrinRecord** pRecord);
+int32_t skipBrinRecords(SBrinRecordIter* pIter, int64_t suid, int64_t uid, TSKEY skey);
 void    clearBrinBlockIter(SBrinRecordIter* pIter);
 
 // initialize block iterator API
@@ -354,6 +385,8 @@ int32_t tsdbGetRowsInSttFiles(STFileSet* pFileSet, SArray* pSttFileBlockIterArra
                               const char* pstr);
 bool isCleanSttBlock(SArray* pTimewindowList, STimeWindow* pQueryWindow, STableBlockScanInfo* pScanInfo, int32_t order);
 bool overlapWithDelSkyline(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord, int32_t order);
+bool coveredByDelSkyline(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord,
+                         const SVersionRange* pVerRange);
 int32_t pkCompEx(SRowKey* p1, SRowKey* p2);
 int32_t initRowKey(SRowKey* pKey, int64_t ts, int32_t numOfPks, int32_t type, int32_t len, bool asc);
 void    clearRowKey(SRowKey* pKey);
@@ -363,6 +396,11 @@ int32_t resetDataBlockIterator(SDataBlockIter* pIter, int32_t order, bool hasPk,
 void    clearDataBlockIterator(SDataBlockIter* pIter, bool needFree);
 void    cleanupDataBlockIterator(SDataBlockIter* pIter, bool hasPk);
 
+int32_t acquireDecodeReader();
+void    releaseDecodeReader();
+bool    waitDecodeSlot(SBlockDecodeSlot* pSlot);
+bool    takeDecodeSlot(SBlockDecodeSlot* pSlot);
+
 typedef struct {
   SArray* pTombData;
 } STableLoadInfo;
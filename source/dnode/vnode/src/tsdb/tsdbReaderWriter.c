@@ -121,9 +121,20 @@ _exit:
   return code;
 }
 
+static void tsdbDropReadAhead(STsdbFD *pFD) {
+  if (pFD->dropCache && pFD->ra.nPage > 0) {
+    (void)taosDropFileCache(pFD->pFD, PAGE_OFFSET(pFD->ra.pgno, pFD->szPage), (int64_t)pFD->ra.nPage * pFD->szPage);
+  }
+  pFD->ra.nPage = 0;
+}
+
 void tsdbCloseFile(STsdbFD **ppFD) {
   STsdbFD *pFD = *ppFD;
   if (pFD) {
+    if (pFD->pFD) {
+      tsdbDropReadAhead(pFD);
+    }
+    taosMemoryFree(pFD->ra.pBuf);
     taosMemoryFree(pFD->pBuf);
     int32_t code = taosCloseFile(&pFD->pFD);
     if (code) {
@@ -202,15 +213,15 @@ _exit:
   return code;
 }
 
-static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgorithm, char *encryptKey) {
+#define TSDB_READ_AHEAD_SEQ      2                  // sequential pages before reading ahead
+#define TSDB_READ_AHEAD_MIN      4                  // pages of the first read ahead
+#define TSDB_BULK_SCAN_THRESHOLD (64 * 1024 * 1024)  // sequential bytes of a bulk scan
+
+// read at most nPage pages starting from pgno, at least one page must be read
+static int32_t tsdbReadFilePages(STsdbFD *pFD, int64_t pgno, int32_t nPage, uint8_t *pBuf, int32_t *nPageRead) {
   int32_t code = 0;
   int32_t lino;
 
-  if (!pFD->pFD) {
-    code = tsdbOpenFileImpl(pFD);
-    TSDB_CHECK_CODE(code, lino, _exit);
-  }
-
   int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
   if (pFD->lcn > 1) {
     SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
@@ -227,17 +238,103 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgor
   }
 
   // read
-  n = taosReadFile(pFD->pFD, pFD->pBuf, pFD->szPage);
+  n = taosReadFile(pFD->pFD, pBuf, (int64_t)pFD->szPage * nPage);
   if (n < 0) {
     TSDB_CHECK_CODE(code = terrno, lino, _exit);
   } else if (n < pFD->szPage) {
     tsdbError(
         "vgId:%d %s failed at %s:%d since read file size is less than page size, "
         "read size: %" PRId64 ", page size: %d, fname:%s, pgno:%" PRId64,
-        TD_VID(pFD->pTsdb->pVnode), __func__, __FILE__, __LINE__, n, pFD->szPage, pFD->path, pFD->pgno);
+        TD_VID(pFD->pTsdb->pVnode), __func__, __FILE__, __LINE__, n, pFD->szPage, pFD->path, pgno);
     TSDB_CHECK_CODE(code = TSDB_CODE_FILE_CORRUPTED, lino, _exit);
   }
-  //}
+
+  if (nPageRead) {
+    *nPageRead = (int32_t)(n / pFD->szPage);
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(pFD->pTsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
+static void tsdbTrackReadAhead(STsdbFD *pFD, int64_t pgno) {
+  if (pgno == pFD->ra.lastPgno + 1) {
+    pFD->ra.nSeq++;
+  } else if (pgno != pFD->ra.lastPgno) {
+    pFD->ra.nSeq = 0;
+    pFD->ra.window = 0;
+  }
+  pFD->ra.lastPgno = pgno;
+
+  // a long sequential scan, e.g. a dump, should not evict the pages of interactive queries from the tsdb caches,
+  // the OS page cache is left alone since the guess may be wrong
+  if (!pFD->noCache && pFD->ra.nSeq * pFD->szPage >= TSDB_BULK_SCAN_THRESHOLD) {
+    tsdbDebug("vgId:%d file:%s is scanned in bulk, stop caching its pages", TD_VID(pFD->pTsdb->pVnode), pFD->path);
+    pFD->noCache = true;
+  }
+}
+
+// read a window of pages starting from pgno in one I/O, the window doubles while the access stays sequential
+static int32_t tsdbReadAhead(STsdbFD *pFD, int64_t pgno) {
+  int32_t code = 0;
+  int32_t lino;
+  int32_t window = pFD->ra.window ? pFD->ra.window * 2 : TSDB_READ_AHEAD_MIN;
+
+  window = TMIN(window, tsTsdbReadAheadPages);
+  if (window > pFD->ra.window) {
+    uint8_t *pBuf = taosMemoryRealloc(pFD->ra.pBuf, (int64_t)window * pFD->szPage);
+    if (pBuf == NULL) {
+      TSDB_CHECK_CODE(code = terrno, lino, _exit);
+    }
+    pFD->ra.pBuf = pBuf;
+  }
+
+  tsdbDropReadAhead(pFD);
+
+  int32_t nPage = 0;
+  code = tsdbReadFilePages(pFD, pgno, window, pFD->ra.pBuf, &nPage);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  pFD->ra.pgno = pgno;
+  pFD->ra.nPage = nPage;
+  pFD->ra.window = window;
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(pFD->pTsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
+void tsdbSetFileNoCache(STsdbFD *pFD, bool noCache) {
+  pFD->noCache = noCache;
+  pFD->dropCache = noCache;
+}
+
+static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgorithm, char *encryptKey) {
+  int32_t code = 0;
+  int32_t lino;
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  tsdbTrackReadAhead(pFD, pgno);
+
+  if (pgno >= pFD->ra.pgno && pgno < pFD->ra.pgno + pFD->ra.nPage) {
+    memcpy(pFD->pBuf, pFD->ra.pBuf + (pgno - pFD->ra.pgno) * pFD->szPage, pFD->szPage);
+  } else if (pFD->flag == TD_FILE_READ && tsTsdbReadAheadPages > 1 && pFD->ra.nSeq >= TSDB_READ_AHEAD_SEQ) {
+    code = tsdbReadAhead(pFD, pgno);
+    TSDB_CHECK_CODE(code, lino, _exit);
+    memcpy(pFD->pBuf, pFD->ra.pBuf, pFD->szPage);
+  } else {
+    code = tsdbReadFilePages(pFD, pgno, 1, pFD->pBuf, NULL);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
 
   if (encryptAlgorithm == DND_CA_SM4) {
     // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
@@ -478,7 +575,7 @@ static int32_t tsdbReadFileSs(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64
     // 3, Store Pages in Cache
     int nPage = pgnoEnd - pgno + 1;
     for (int i = 0; i < nPage; ++i) {
-      if (pFD->szFile != pgno) {  // DONOT cache last volatile page
+      if (pFD->szFile != pgno && !pFD->noCache) {  // DONOT cache last volatile page
         tsdbCacheSetPageSs(pFD->pTsdb->pgCache, pFD, pgno, pBlock + i * pFD->szPage);
       }
 
@@ -541,6 +638,47 @@ _exit:
   return code;
 }
 
+int32_t tsdbPrefetchFile(STsdbFD *pFD, int64_t offset, int64_t size) {
+  int32_t code = 0;
+  int32_t lino;
+
+  if (size <= 0) {
+    return code;
+  }
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  // chunks migrated to shared storage are fetched on demand by tsdbReadFileSs
+  if (pFD->ssFile && pFD->lcn > 1) {
+    return code;
+  }
+
+  int64_t pgnoStart = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset, pFD->szPage), pFD->szPage);
+  int64_t pgnoEnd = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset + size - 1, pFD->szPage), pFD->szPage);
+  int64_t fOffset = PAGE_OFFSET(pgnoStart, pFD->szPage);
+  if (pFD->lcn > 1) {
+    SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
+    int64_t    chunksize = (int64_t)pCfg->tsdbPageSize * pCfg->ssChunkSize;
+
+    fOffset -= chunksize * (pFD->lcn - 1);
+  }
+
+  // a failed hint only costs the readahead, the following read will go to the disk as before
+  if (taosPrefetchFile(pFD->pFD, fOffset, (pgnoEnd - pgnoStart + 1) * pFD->szPage) != 0) {
+    tsdbTrace("vgId:%d failed to prefetch file:%s, offset:%" PRId64 ", size:%" PRId64 " since %s",
+              TD_VID(pFD->pTsdb->pVnode), pFD->path, offset, size, tstrerror(terrno));
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(pFD->pTsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbReadFileToBuffer(STsdbFD *pFD, int64_t offset, int64_t size, SBuffer *buffer, int64_t szHint,
                              int32_t encryptAlgorithm, char *encryptKey) {
   int32_t code;
@@ -72,6 +72,7 @@ static int32_t tsdbSnapReadFileSetOpenReader(STsdbSnapReader* reader) {
       .tsdb = reader->tsdb,
       .szPage = reader->tsdb->pVnode->config.tsdbPageSize,
       .buffers = reader->buffers,
+      .noCache = true,
   };
   bool hasDataFile = false;
   for (int32_t ftype = 0; ftype < TSDB_FTYPE_MAX; ftype++) {
@@ -98,6 +99,7 @@ static int32_t tsdbSnapReadFileSetOpenReader(STsdbSnapReader* reader) {
           .szPage = reader->tsdb->pVnode->config.tsdbPageSize,
           .file = fobj->f[0],
           .buffers = reader->buffers,
+          .noCache = true,
       };
 
       code = tsdbSttFileReaderOpen(fobj->fname, &config, &sttReader);
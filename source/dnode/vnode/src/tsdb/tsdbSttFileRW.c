@@ -58,6 +58,7 @@ int32_t tsdbSttFileReaderOpen(const char *fname, const SSttFileReaderConfig *con
     tsdbTFileName(config->tsdb, config->file, fname1);
     TAOS_CHECK_GOTO(tsdbOpenFile(fname1, config->tsdb, TD_FILE_READ, &reader[0]->fd, 0), &lino, _exit);
   }
+  tsdbSetFileNoCache(reader[0]->fd, config->noCache);
 
   // // open each segment reader
   int64_t offset = config->file->size - sizeof(SSttFooter);
@@ -347,6 +348,15 @@ int32_t tsdbSttFileReadBlockDataByColumn(SSttFileReader *reader, const SSttBlk *
       };
       TAOS_CHECK_GOTO(tBlockDataDecompressColData(&hdr, &none, &br, bData, assist), &lino, _exit);
     } else if (cid == blockCol.cid) {
+      // decompressed by another reader
+      bool hit = false;
+      TAOS_CHECK_GOTO(
+          tsdbCacheGetColData(reader->config->tsdb, reader->config->file, sttBlk->bInfo.offset, cid, bData, &hit),
+          &lino, _exit);
+      if (hit) {
+        continue;
+      }
+
       // load from file
       tBufferClear(buffer1);
       TAOS_CHECK_GOTO(
@@ -358,6 +368,10 @@ int32_t tsdbSttFileReadBlockDataByColumn(SSttFileReader *reader, const SSttBlk *
       // decode the buffer
       SBufferReader br1 = BUFFER_READER_INITIALIZER(0, buffer1);
       TAOS_CHECK_GOTO(tBlockDataDecompressColData(&hdr, &blockCol, &br1, bData, assist), &lino, _exit);
+      if (!reader->fd->noCache) {
+        tsdbCachePutColData(reader->config->tsdb, reader->config->file, sttBlk->bInfo.offset,
+                            &bData->aColData[bData->nColData - 1]);
+      }
     }
   }
 
@@ -508,6 +522,13 @@ struct SSttFileWriter {
   STombBlock      tombBlock[1];
   STbStatisBlock  staticBlock[1];
   SBlockData      blockData[1];
+  // pending column-format rows [iRow, iRow + nRow) of pBlockData, appended to blockData in one go
+  struct {
+    SBlockData *pBlockData;
+    int32_t     iRow;
+    int32_t     nRow;
+    int64_t     uid;
+  } colRun[1];
   // helper data
   SSkmInfo skmTb[1];
   SSkmInfo skmRow[1];
@@ -560,12 +581,25 @@ static int32_t tsdbFileDoWriteSttBlockData(STsdbFD *fd, SBlockData *blockData, S
   return 0;
 }
 
-static int32_t tsdbSttFileDoWriteBlockData(SSttFileWriter *writer) {
-  if (writer->blockData->nRow == 0) return 0;
+static int32_t tsdbSttFileFlushColRun(SSttFileWriter *writer) {
+  int32_t code = 0;
+
+  if (writer->colRun->nRow > 0) {
+    code = tBlockDataAppendBlockRows(writer->blockData, writer->colRun->pBlockData, writer->colRun->iRow,
+                                     writer->colRun->nRow, writer->colRun->uid);
+  }
+  writer->colRun->pBlockData = NULL;
+  writer->colRun->nRow = 0;
+  return code;
+}
 
+static int32_t tsdbSttFileDoWriteBlockData(SSttFileWriter *writer) {
   int32_t code = 0;
   int32_t lino = 0;
 
+  TAOS_CHECK_RETURN(tsdbSttFileFlushColRun(writer));
+  if (writer->blockData->nRow == 0) return 0;
+
   tb_uid_t         uid = writer->blockData->suid == 0 ? writer->blockData->uid : writer->blockData->suid;
   SColCompressInfo info = {.defaultCmprAlg = writer->config->cmprAlg, .pColCmpr = NULL};
   code = metaGetColCmpr(writer->config->tsdb->pVnode->pMeta, uid, &(info.pColCmpr));
@@ -998,6 +1032,20 @@ int32_t tsdbSttFileWriteRow(SSttFileWriter *writer, SRowInfo *row) {
                     &lino, _exit);
   }
 
+  // the next row of a column-format batch joins the pending run, it can neither be a duplicate of the previous
+  // row nor overflow the block
+  if (writer->colRun->pBlockData != NULL                                                    //
+      && row->row.type == TSDBROW_COL_FMT                                                  //
+      && row->row.pBlockData == writer->colRun->pBlockData                                 //
+      && row->row.iRow == writer->colRun->iRow + writer->colRun->nRow                      //
+      && row->uid == writer->colRun->uid                                                   //
+      && row->row.pBlockData->aTSKEY[row->row.iRow] > row->row.pBlockData->aTSKEY[row->row.iRow - 1]  //
+      && writer->blockData->nRow + writer->colRun->nRow < writer->config->maxRow) {
+    writer->colRun->nRow++;
+    goto _exit;
+  }
+  TAOS_CHECK_GOTO(tsdbSttFileFlushColRun(writer), &lino, _exit);
+
   // row to col conversion
   if (key.version <= writer->config->compactVersion                                //
       && writer->blockData->nRow > 0                                               //
@@ -1015,6 +1063,12 @@ int32_t tsdbSttFileWriteRow(SSttFileWriter *writer, SRowInfo *row) {
 
     TAOS_CHECK_GOTO(tBlockDataAppendRow(writer->blockData, &row->row, writer->config->skmRow->pTSchema, row->uid),
                     &lino, _exit);
+
+    if (writer->config->memRows && row->row.type == TSDBROW_COL_FMT) {
+      writer->colRun->pBlockData = row->row.pBlockData;
+      writer->colRun->iRow = row->row.iRow + 1;
+      writer->colRun->uid = row->uid;
+    }
   }
 
 _exit:
@@ -1038,6 +1092,9 @@ int32_t tsdbSttFileWriteBlockData(SSttFileWriter *writer, SBlockData *bdata) {
     TAOS_CHECK_GOTO(tsdbSttFileWriteRow(writer, row), &lino, _exit);
   }
 
+  // bdata belongs to the caller
+  TAOS_CHECK_GOTO(tsdbSttFileFlushColRun(writer), &lino, _exit);
+
 _exit:
   if (code) {
     tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(writer->config->tsdb->pVnode), __func__, __FILE__, lino,
@@ -1053,7 +1110,7 @@ int32_t tsdbSttFileWriteTombRecord(SSttFileWriter *writer, const STombRecord *re
   if (!writer->ctx->opened) {
     TAOS_CHECK_GOTO(tsdbSttFWriterDoOpen(writer), &lino, _exit);
   } else {
-    if (writer->blockData->nRow > 0) {
+    if (writer->blockData->nRow > 0 || writer->colRun->nRow > 0) {
       TAOS_CHECK_GOTO(tsdbSttFileDoWriteBlockData(writer), &lino, _exit);
     }
 
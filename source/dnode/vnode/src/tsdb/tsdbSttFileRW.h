@@ -58,6 +58,7 @@ struct SSttFileReaderConfig {
   int32_t  szPage;
   STFile   file[1];
   SBuffer *buffers;
+  bool     noCache;  // bulk read, keep the pages out of the caches
 };
 
 // SSttFileWriter ==========================================
@@ -89,6 +90,7 @@ struct SSttFileWriterConfig {
   SSkmInfo *skmTb;
   SSkmInfo *skmRow;
   SBuffer  *buffers;
+  bool      memRows;  // column-format rows stay valid until the writer is closed, as memtable rows do
 };
 
 #ifdef __cplusplus
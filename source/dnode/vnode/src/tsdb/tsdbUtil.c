@@ -20,6 +20,65 @@
 
 int32_t tsdbGetColCmprAlgFromSet(SHashObj *set, int16_t colId, uint32_t *alg);
 
+// bloom filters of columns are stored after the column SMA of a block, flagged in the column id
+int32_t tPutBlockBloomFilter(SBuffer *buffer, int16_t cid, const SBloomFilter *pBF) {
+  int32_t code;
+
+  if ((code = tBufferPutI32v(buffer, (int32_t)(cid | TSDB_BLOCK_BLOOM_FILTER_FLAG)))) return code;
+  if ((code = tBufferPutU32v(buffer, pBF->hashFunctions))) return code;
+  if ((code = tBufferPutU64v(buffer, pBF->numUnits))) return code;
+  if ((code = tBufferPut(buffer, pBF->buffer, pBF->numUnits * sizeof(uint64_t)))) return code;
+
+  return 0;
+}
+
+int32_t tGetBlockBloomFilter(SBufferReader *br, int16_t *cid, SBloomFilter **ppBF) {
+  int32_t       code;
+  int32_t       colId;
+  uint32_t      hashFunctions;
+  uint64_t      numUnits;
+  SBloomFilter *pBF = NULL;
+
+  if ((code = tBufferGetI32v(br, &colId))) return code;
+  if ((code = tBufferGetU32v(br, &hashFunctions))) return code;
+  if ((code = tBufferGetU64v(br, &numUnits))) return code;
+  if (numUnits == 0 || numUnits > UINT32_MAX / sizeof(uint64_t)) return TSDB_CODE_FILE_CORRUPTED;
+
+  *cid = (int16_t)(colId & 0xFFFF);
+  if (ppBF == NULL) {  // skip it
+    return tBufferGet(br, numUnits * sizeof(uint64_t), NULL);
+  }
+
+  pBF = taosMemoryCalloc(1, sizeof(*pBF));
+  if (pBF == NULL) return terrno;
+
+  pBF->hashFunctions = hashFunctions;
+  pBF->numUnits = numUnits;
+  pBF->numBits = numUnits * 64;
+  pBF->hashFn1 = HASH_FUNCTION_1;
+  pBF->hashFn2 = HASH_FUNCTION_2;
+  pBF->buffer = taosMemoryMalloc(numUnits * sizeof(uint64_t));
+  if (pBF->buffer == NULL) {
+    tBloomFilterDestroy(pBF);
+    return terrno;
+  }
+
+  if ((code = tBufferGet(br, numUnits * sizeof(uint64_t), pBF->buffer))) {
+    tBloomFilterDestroy(pBF);
+    return code;
+  }
+
+  *ppBF = pBF;
+  return 0;
+}
+
+bool tIsBlockBloomFilter(const SBufferReader *br) {
+  SBufferReader reader = *br;
+  int32_t       colId = 0;
+
+  return tBufferGetI32v(&reader, &colId) == 0 && (colId & TSDB_BLOCK_BLOOM_FILTER_FLAG) != 0;
+}
+
 static int32_t tBlockDataCompressKeyPart(SBlockData *bData, SDiskDataHdr *hdr, SBuffer *buffer, SBuffer *assist,
                                          SColCompressInfo *pCompressExt);
 
@@ -1320,6 +1379,73 @@ int32_t tBlockDataAppendRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTS
 _exit:
   return code;
 }
+
+/*
+ * Append rows [iRow, iRow + nRow) of a column-format block column by column, so columnar memtable data is
+ * not walked row by row when written out.
+ */
+int32_t tBlockDataAppendBlockRows(SBlockData *pBlockData, SBlockData *pBlockDataFrom, int32_t iRow, int32_t nRow,
+                                  int64_t uid) {
+  int32_t code = 0;
+
+  if (!(pBlockData->suid || pBlockData->uid) || iRow < 0 || iRow + nRow > pBlockDataFrom->nRow) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+  if (nRow <= 0) {
+    return 0;
+  }
+
+  // uid
+  if (pBlockData->uid == 0) {
+    if (!uid) {
+      return TSDB_CODE_INVALID_PARA;
+    }
+    code = tRealloc((uint8_t **)&pBlockData->aUid, sizeof(int64_t) * (pBlockData->nRow + nRow));
+    if (code) goto _exit;
+    for (int32_t i = 0; i < nRow; i++) {
+      pBlockData->aUid[pBlockData->nRow + i] = uid;
+    }
+  }
+  // version
+  code = tRealloc((uint8_t **)&pBlockData->aVersion, sizeof(int64_t) * (pBlockData->nRow + nRow));
+  if (code) goto _exit;
+  (void)memcpy(pBlockData->aVersion + pBlockData->nRow, pBlockDataFrom->aVersion + iRow, sizeof(int64_t) * nRow);
+  // timestamp
+  code = tRealloc((uint8_t **)&pBlockData->aTSKEY, sizeof(TSKEY) * (pBlockData->nRow + nRow));
+  if (code) goto _exit;
+  (void)memcpy(pBlockData->aTSKEY + pBlockData->nRow, pBlockDataFrom->aTSKEY + iRow, sizeof(TSKEY) * nRow);
+
+  // columns
+  SColVal   cv = {0};
+  int32_t   iColDataFrom = 0;
+  SColData *pColDataFrom = (iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+
+  for (int32_t iColDataTo = 0; iColDataTo < pBlockData->nColData; iColDataTo++) {
+    SColData *pColDataTo = &pBlockData->aColData[iColDataTo];
+
+    while (pColDataFrom && pColDataFrom->cid < pColDataTo->cid) {
+      pColDataFrom = (++iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+    }
+
+    if (pColDataFrom == NULL || pColDataFrom->cid > pColDataTo->cid) {
+      cv = COL_VAL_NONE(pColDataTo->cid, pColDataTo->type);
+      for (int32_t i = 0; i < nRow; i++) {
+        if ((code = tColDataAppendValue(pColDataTo, &cv))) goto _exit;
+      }
+    } else {
+      for (int32_t i = 0; i < nRow; i++) {
+        if ((code = tColDataGetValue(pColDataFrom, iRow + i, &cv))) goto _exit;
+        if ((code = tColDataAppendValue(pColDataTo, &cv))) goto _exit;
+      }
+      pColDataFrom = (++iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+    }
+  }
+  pBlockData->nRow += nRow;
+
+_exit:
+  return code;
+}
+
 int32_t tBlockDataUpdateRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema) {
   int32_t code = 0;
 
@@ -1370,6 +1496,48 @@ int32_t tBlockDataUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTS
 }
 #endif
 
+// Take over the columns in aColData, which are in cid order, and keep the columns of the block in cid order. The
+// columns already in the block are kept and the same ones in aColData are dropped. aColData is freed in any case.
+int32_t tBlockDataMergeColData(SBlockData *pBlockData, SColData *aColData, int32_t nColData) {
+  int32_t   code = 0;
+  int32_t   iFrom = 0;
+  int32_t   iTo = 0;
+  int32_t   nMerged = 0;
+  SColData *aMerged = NULL;
+
+  if (nColData == 0) {
+    goto _exit;
+  }
+
+  aMerged = taosMemoryMalloc(sizeof(SColData) * (pBlockData->nColData + nColData));
+  if (aMerged == NULL) {
+    code = terrno;
+    goto _exit;
+  }
+
+  while (iTo < pBlockData->nColData || iFrom < nColData) {
+    if (iFrom >= nColData || (iTo < pBlockData->nColData && pBlockData->aColData[iTo].cid < aColData[iFrom].cid)) {
+      aMerged[nMerged++] = pBlockData->aColData[iTo++];
+    } else if (iTo >= pBlockData->nColData || aColData[iFrom].cid < pBlockData->aColData[iTo].cid) {
+      aMerged[nMerged++] = aColData[iFrom++];
+    } else {
+      aMerged[nMerged++] = pBlockData->aColData[iTo++];
+      tColDataDestroy(&aColData[iFrom++]);
+    }
+  }
+
+  taosMemoryFree(pBlockData->aColData);
+  pBlockData->aColData = aMerged;
+  pBlockData->nColData = nMerged;
+
+_exit:
+  for (; iFrom < nColData; iFrom++) {
+    tColDataDestroy(&aColData[iFrom]);
+  }
+  taosMemoryFree(aColData);
+  return code;
+}
+
 SColData *tBlockDataGetColData(SBlockData *pBlockData, int16_t cid) {
   int32_t lidx = 0;
   int32_t ridx = pBlockData->nColData - 1;
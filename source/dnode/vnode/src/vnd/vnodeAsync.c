@@ -128,6 +128,7 @@ struct {
     [3] = {"vnode-compact", NULL},
     [4] = {"vnode-retention", NULL},
     [5] = {"vnode-scan", NULL},
+    [6] = {"vnode-decode", NULL},
 };
 
 #define MIN_ASYNC_ID 1
@@ -474,10 +475,11 @@ int32_t vnodeAsyncOpen() {
   int32_t numOfThreads[] = {
       0,                        //
       tsNumOfCommitThreads,     // vnode-commit
-      tsNumOfCommitThreads,     // vnode-merge
+      tsNumOfMergeThreads,      // vnode-merge
       tsNumOfCompactThreads,    // vnode-compact
       tsNumOfRetentionThreads,  // vnode-retention
       2,                        // vnode-scan
+      TMAX(tsNumOfScanDecodeThreads, 1),  // vnode-decode
   };
 
   for (int32_t i = 1; i < sizeof(GVnodeAsyncs) / sizeof(GVnodeAsyncs[0]); i++) {
@@ -56,8 +56,13 @@ static void vnodeBufPoolDestroy(SVBufPool *pPool) {
   taosMemoryFree(pPool);
 }
 
+// the decompressed column cache of tsdb is charged against the vnode buffer, the pools share the rest of it
+int64_t vnodeBufPoolSegmentSize(SVnode *pVnode) {
+  return (pVnode->config.szBuf - tsdbColCacheCapacity(pVnode->config.szBuf)) / VNODE_BUFPOOL_SEGMENTS;
+}
+
 int vnodeOpenBufPool(SVnode *pVnode) {
-  int64_t size = pVnode->config.szBuf / VNODE_BUFPOOL_SEGMENTS;
+  int64_t size = vnodeBufPoolSegmentSize(pVnode);
 
   for (int i = 0; i < VNODE_BUFPOOL_SEGMENTS; i++) {
     // create pool
@@ -224,7 +229,7 @@ static void vnodeBufPoolResize(SVBufPool *pPool, int64_t size) {
 void vnodeBufPoolAddToFreeList(SVBufPool *pPool) {
   SVnode *pVnode = pPool->pVnode;
 
-  int64_t size = pVnode->config.szBuf / VNODE_BUFPOOL_SEGMENTS;
+  int64_t size = vnodeBufPoolSegmentSize(pVnode);
   if (pPool->node.size != size) {
     vnodeBufPoolResize(pPool, size);
   }
@@ -459,6 +459,13 @@ SVnode *vnodeOpen(const char *path, int32_t diskPrimary, STfs *pTfs, STfs *pMoun
   pVnode->blocked = false;
   pVnode->disableWrite = false;
 
+  pVnode->pFollowerReads =
+      taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_ENTRY_LOCK);
+  if (pVnode->pFollowerReads == NULL) {
+    vError("vgId:%d, failed to init follower reads since %s", TD_VID(pVnode), tstrerror(terrno));
+    goto _err;
+  }
+
   if (tsem_init(&pVnode->syncSem, 0, 0) != 0) {
     vError("vgId:%d, failed to init semaphore", TD_VID(pVnode));
     goto _err;
@@ -566,6 +573,11 @@ SVnode *vnodeOpen(const char *path, int32_t diskPrimary, STfs *pTfs, STfs *pMoun
     goto _err;
   }
 
+  // warm up last cache in background
+  if (tsdbAsyncCacheWarmup(pVnode->pTsdb) != 0) {
+    vWarn("vgId:%d, failed to start last cache warmup, tables will be loaded on query", TD_VID(pVnode));
+  }
+
   // open sync
   vInfo("vgId:%d, start to open sync, changeVersion:%d", TD_VID(pVnode), info.config.syncCfg.changeVersion);
   if (vnodeSyncOpen(pVnode, dir, info.config.syncCfg.changeVersion)) {
@@ -591,6 +603,8 @@ _err:
   if (pVnode->pMeta) metaClose(&pVnode->pMeta);
   if (pVnode->freeList) vnodeCloseBufPool(pVnode);
 
+  taosHashCleanup(pVnode->pFollowerReads);
+
   (void)taosThreadRwlockDestroy(&pVnode->metaRWLock);
   taosMemoryFree(pVnode);
   return NULL;
@@ -628,6 +642,7 @@ void vnodeClose(SVnode *pVnode) {
     (void)taosThreadCondDestroy(&pVnode->poolNotEmpty);
     (void)taosThreadMutexDestroy(&pVnode->mutex);
     (void)taosThreadMutexDestroy(&pVnode->lock);
+    taosHashCleanup(pVnode->pFollowerReads);
     taosMemoryFree(pVnode);
   }
 }
@@ -946,7 +946,7 @@ static void vnodeGetBufferInfo(SVnode *pVnode, int64_t *bufferSegmentUsed, int64
     if (pVnode->inUse) {
       *bufferSegmentUsed = pVnode->inUse->size;
     }
-    *bufferSegmentSize = pVnode->config.szBuf / VNODE_BUFPOOL_SEGMENTS;
+    *bufferSegmentSize = vnodeBufPoolSegmentSize(pVnode);
 
     (void)taosThreadMutexUnlock(&pVnode->mutex);
   }
@@ -1416,6 +1416,13 @@ int32_t vnodeGetRawWriteMetrics(void *pVnode, SRawWriteMetrics *pRawMetrics) {
   pRawMetrics->preprocess_time = atomic_load_64(&pVnode1->writeMetrics.preprocess_time);
   pRawMetrics->wal_write_bytes = atomic_load_64(&syncMetrics.wal_write_bytes);
   pRawMetrics->wal_write_time = atomic_load_64(&syncMetrics.wal_write_time);
+  if (tsWalGroupCommit) {
+    SWalGroupCommitStat walStat = {0};
+    walGetGroupCommitStat(pVnode1->pWal, &walStat);
+    pRawMetrics->wal_group_sync_count = walStat.numOfSyncs;
+    pRawMetrics->wal_group_sync_entries = walStat.numOfEntries;
+    pRawMetrics->wal_group_sync_latency = walStat.latency;
+  }
   pRawMetrics->apply_bytes = atomic_load_64(&pVnode1->writeMetrics.apply_bytes);
   pRawMetrics->apply_time = atomic_load_64(&pVnode1->writeMetrics.apply_time);
   pRawMetrics->commit_count = atomic_load_64(&pVnode1->writeMetrics.commit_count);
@@ -1425,8 +1432,11 @@ int32_t vnodeGetRawWriteMetrics(void *pVnode, SRawWriteMetrics *pRawMetrics) {
   pRawMetrics->blocked_commit_time = atomic_load_64(&pVnode1->writeMetrics.block_commit_time);
   pRawMetrics->merge_count = atomic_load_64(&pVnode1->writeMetrics.merge_count);
   pRawMetrics->merge_time = atomic_load_64(&pVnode1->writeMetrics.merge_time);
+  pRawMetrics->merge_bytes = atomic_load_64(&pVnode1->writeMetrics.merge_bytes);
   pRawMetrics->last_cache_commit_time = atomic_load_64(&pVnode1->writeMetrics.last_cache_commit_time);
   pRawMetrics->last_cache_commit_count = atomic_load_64(&pVnode1->writeMetrics.last_cache_commit_count);
+  tsdbGetColCacheStat(pVnode1->pTsdb, &pRawMetrics->col_cache_hit, &pRawMetrics->col_cache_miss,
+                      &pRawMetrics->col_cache_evict);
 
   return 0;
 }
@@ -1460,10 +1470,13 @@ int32_t vnodeResetRawWriteMetrics(void *pVnode, const SRawWriteMetrics *pOldMetr
   (void)atomic_sub_fetch_64(&pVnode1->writeMetrics.blocked_commit_count, pOldMetrics->blocked_commit_count);
   (void)atomic_sub_fetch_64(&pVnode1->writeMetrics.block_commit_time, pOldMetrics->blocked_commit_time);
   (void)atomic_sub_fetch_64(&pVnode1->writeMetrics.merge_count, pOldMetrics->merge_count);
+  (void)atomic_sub_fetch_64(&pVnode1->writeMetrics.merge_bytes, pOldMetrics->merge_bytes);
 
   // Reset new cache metrics
   (void)atomic_sub_fetch_64(&pVnode1->writeMetrics.last_cache_commit_time, pOldMetrics->last_cache_commit_time);
   (void)atomic_sub_fetch_64(&pVnode1->writeMetrics.last_cache_commit_count, pOldMetrics->last_cache_commit_count);
+  tsdbResetColCacheStat(pVnode1->pTsdb, pOldMetrics->col_cache_hit, pOldMetrics->col_cache_miss,
+                        pOldMetrics->col_cache_evict);
 
   // Reset sync metrics
   SSyncMetrics syncMetrics = {
@@ -1472,5 +1485,12 @@ int32_t vnodeResetRawWriteMetrics(void *pVnode, const SRawWriteMetrics *pOldMetr
   };
   syncResetMetrics(pVnode1->sync, &syncMetrics);
 
+  SWalGroupCommitStat walStat = {
+      .numOfSyncs = pOldMetrics->wal_group_sync_count,
+      .numOfEntries = pOldMetrics->wal_group_sync_entries,
+      .latency = pOldMetrics->wal_group_sync_latency,
+  };
+  walResetGroupCommitStat(pVnode1->pWal, &walStat);
+
   return 0;
 }
@@ -1030,6 +1030,89 @@ int32_t vnodePreprocessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg) {
   return qWorkerPreprocessQueryMsg(pVnode->pQuery, pMsg, TDMT_SCH_QUERY == pMsg->msgType);
 }
 
+typedef struct {
+  uint64_t queryId;
+  uint64_t taskId;
+} SVFollowerReadKey;
+
+#define VNODE_FOLLOWER_READ_PURGE_NUM 1024
+#define VNODE_FOLLOWER_READ_KEEP_MS   (30 * 60 * 1000)
+
+// tasks never dropped, e.g. of a client gone, are forgotten after a while
+static void vnodePurgeFollowerReads(SVnode *pVnode, int64_t now) {
+  SArray *pKeys = taosArrayInit(16, sizeof(SVFollowerReadKey));
+  if (pKeys == NULL) return;
+
+  void *pIter = taosHashIterate(pVnode->pFollowerReads, NULL);
+  while (pIter) {
+    if (now - *(int64_t *)pIter > VNODE_FOLLOWER_READ_KEEP_MS) {
+      size_t keyLen = 0;
+      if (taosArrayPush(pKeys, taosHashGetKey(pIter, &keyLen)) == NULL) {
+        taosHashCancelIterate(pVnode->pFollowerReads, pIter);
+        break;
+      }
+    }
+    pIter = taosHashIterate(pVnode->pFollowerReads, pIter);
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pKeys); ++i) {
+    (void)taosHashRemove(pVnode->pFollowerReads, taosArrayGet(pKeys, i), sizeof(SVFollowerReadKey));
+  }
+  taosArrayDestroy(pKeys);
+}
+
+int32_t vnodeAddFollowerRead(SVnode *pVnode, uint64_t queryId, uint64_t taskId) {
+  SVFollowerReadKey key = {.queryId = queryId, .taskId = taskId};
+  int64_t           now = taosGetTimestampMs();
+
+  if (taosHashGetSize(pVnode->pFollowerReads) >= VNODE_FOLLOWER_READ_PURGE_NUM) {
+    vnodePurgeFollowerReads(pVnode, now);
+  }
+  return taosHashPut(pVnode->pFollowerReads, &key, sizeof(key), &now, sizeof(now));
+}
+
+// only the fetches of the tasks this follower accepted are served by it
+bool vnodeIsFollowerReadFetch(SVnode *pVnode, SRpcMsg *pMsg) {
+  SVFollowerReadKey key = {0};
+
+  if (taosHashGetSize(pVnode->pFollowerReads) == 0 ||
+      tDeserializeSchTaskId(pMsg->pCont, pMsg->contLen, &key.queryId, &key.taskId) != 0) {
+    return false;
+  }
+  return taosHashGet(pVnode->pFollowerReads, &key, sizeof(key)) != NULL;
+}
+
+void vnodeRemoveFollowerRead(SVnode *pVnode, SRpcMsg *pMsg) {
+  SVFollowerReadKey key = {0};
+
+  if (taosHashGetSize(pVnode->pFollowerReads) == 0 ||
+      tDeserializeSchTaskId(pMsg->pCont, pMsg->contLen, &key.queryId, &key.taskId) != 0) {
+    return;
+  }
+  (void)taosHashRemove(pVnode->pFollowerReads, &key, sizeof(key));
+}
+
+// a query that accepts stale results may run on a follower whose data is fresh enough
+static bool vnodeIsReadyForFollowerRead(SVnode *pVnode, SRpcMsg *pMsg) {
+  SSubQueryMsg msg = {0};
+
+  if (tDeserializeSSubQueryMsgAttr(pMsg->pCont, pMsg->contLen, &msg) != 0 || msg.maxStaleness <= 0 ||
+      !syncIsReadyForFollowerRead(pVnode->sync, msg.maxStaleness)) {
+    return false;
+  }
+
+  int32_t code = vnodeAddFollowerRead(pVnode, msg.queryId, msg.taskId);
+  if (code != 0) {
+    vError("vgId:%d, failed to accept follower read since %s, QID:0x%" PRIx64, TD_VID(pVnode), tstrerror(code),
+           msg.queryId);
+    return false;
+  }
+
+  vDebug("vgId:%d, query served by follower, max staleness:%dms, QID:0x%" PRIx64, TD_VID(pVnode), msg.maxStaleness,
+         msg.queryId);
+  return true;
+}
+
 int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
   vTrace("message in vnode query queue is processing");
   if (pMsg->msgType == TDMT_VND_TMQ_CONSUME && !syncIsReadyForRead(pVnode->sync)) {
@@ -1053,8 +1136,11 @@ int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
   switch (pMsg->msgType) {
     case TDMT_SCH_QUERY:
       if (!syncIsReadyForRead(pVnode->sync)) {
-        pMsg->code = (terrno) ? terrno : TSDB_CODE_SYN_NOT_LEADER;
-        redirected = true;
+        int32_t readCode = (terrno) ? terrno : TSDB_CODE_SYN_NOT_LEADER;
+        if (!vnodeIsReadyForFollowerRead(pVnode, pMsg)) {
+          pMsg->code = readCode;
+          redirected = true;
+        }
       }
       code = qWorkerProcessQueryMsg(&handle, pVnode->pQuery, pMsg, 0);
       if (redirected) {
@@ -1083,7 +1169,8 @@ int32_t vnodeProcessFetchMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
   if ((pMsg->msgType == TDMT_SCH_FETCH || pMsg->msgType == TDMT_VND_TABLE_META || pMsg->msgType == TDMT_VND_TABLE_CFG ||
        pMsg->msgType == TDMT_VND_BATCH_META || pMsg->msgType == TDMT_VND_TABLE_NAME ||
        pMsg->msgType == TDMT_VND_VSUBTABLES_META || pMsg->msgType == TDMT_VND_VSTB_REF_DBS) &&
-      !syncIsReadyForRead(pVnode->sync)) {
+      !syncIsReadyForRead(pVnode->sync) &&
+      !(pMsg->msgType == TDMT_SCH_FETCH && vnodeIsFollowerReadFetch(pVnode, pMsg))) {
     vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
     return 0;
   }
@@ -1097,6 +1184,7 @@ int32_t vnodeProcessFetchMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
     // case TDMT_SCH_CANCEL_TASK:
     //   return qWorkerProcessCancelMsg(pVnode, pVnode->pQuery, pMsg, 0);
     case TDMT_SCH_DROP_TASK:
+      vnodeRemoveFollowerRead(pVnode, pMsg);
       return qWorkerProcessDropMsg(pVnode, pVnode->pQuery, pMsg, 0);
     case TDMT_SCH_TASK_NOTIFY:
       return qWorkerProcessNotifyMsg(pVnode, pVnode->pQuery, pMsg, 0);
@@ -2783,6 +2871,7 @@ static int32_t vnodeProcessAlterConfigReq(SVnode *pVnode, int64_t ver, void *pRe
     vInfo("vgId:%d, vnode buffer is changed from %" PRId64 " to %" PRId64, TD_VID(pVnode), pVnode->config.szBuf,
           (uint64_t)(req.buffer * 1024LL * 1024LL));
     pVnode->config.szBuf = req.buffer * 1024LL * 1024LL;
+    tsdbColCacheSetCapacity(pVnode, pVnode->config.szBuf);
   }
 
   if (pVnode->config.szCache != req.pages) {
@@ -498,6 +498,16 @@ int32_t vnodeProcessSyncMsg(SVnode *pVnode, SRpcMsg *pMsg, SRpcMsg **pRsp) {
   return code;
 }
 
+// the entries appended by the leader for a batch of sync msgs share one wal fsync
+void vnodeBeginSyncBatch(SVnode *pVnode) { syncBeginGroupCommit(pVnode->sync); }
+
+void vnodeEndSyncBatch(SVnode *pVnode) {
+  int32_t code = syncEndGroupCommit(pVnode->sync);
+  if (code != 0) {
+    vError("vgId:%d, failed to group commit sync batch since %s", pVnode->config.vgId, tstrerror(code));
+  }
+}
+
 static int32_t vnodeSyncEqCtrlMsg(const SMsgCb *msgcb, SRpcMsg *pMsg) {
   if (pMsg == NULL || pMsg->pCont == NULL) {
     return TSDB_CODE_INVALID_PARA;
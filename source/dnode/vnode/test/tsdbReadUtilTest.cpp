@@ -0,0 +1,826 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "tglobal.h"
+#include "tsdbFS2.h"
+#include "tsdbReadUtil.h"
+#include "vnd.h"
+
+namespace {
+
+tsem_t  decodeStarted;
+tsem_t  decodeResume;
+int32_t numOfDecoded = 0;
+
+// a decode task holding the only decode thread until it is told to go on
+int32_t blockingDecode(void *arg) {
+  SBlockDecodeSlot *pSlot = (SBlockDecodeSlot *)arg;
+  (void)tsem_post(&decodeStarted);
+  (void)tsem_wait(&decodeResume);
+  (void)atomic_add_fetch_32(&numOfDecoded, 1);
+  pSlot->code = TSDB_CODE_SUCCESS;
+  return pSlot->code;
+}
+
+int32_t decode(void *arg) {
+  SBlockDecodeSlot *pSlot = (SBlockDecodeSlot *)arg;
+  (void)atomic_add_fetch_32(&numOfDecoded, 1);
+  pSlot->code = TSDB_CODE_SUCCESS;
+  (void)tsem_post(&decodeStarted);
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t failedDecode(void *arg) {
+  SBlockDecodeSlot *pSlot = (SBlockDecodeSlot *)arg;
+  pSlot->code = TSDB_CODE_FILE_CORRUPTED;
+  (void)tsem_post(&decodeStarted);
+  return pSlot->code;
+}
+
+int32_t scheduleDecode(SBlockDecodeSlot *pSlot, int32_t (*execute)(void *)) {
+  pSlot->code = TSDB_CODE_SUCCESS;
+  int32_t code = vnodeAsync(DECODE_TASK_ASYNC, EVA_PRIORITY_NORMAL, execute, NULL, pSlot, &pSlot->taskId);
+  if (code == TSDB_CODE_SUCCESS) {
+    pSlot->busy = true;
+  }
+  return code;
+}
+
+}  // namespace
+
+class TsdbDecodeAheadTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    ASSERT_EQ(vnodeAsyncOpen(), 0);
+    // a single decode thread, so that the tasks queue up behind a blocking one
+    ASSERT_EQ(vnodeAsyncSetWorkers(DECODE_TASK_ASYNC, 1), 0);
+    ASSERT_EQ(tsem_init(&decodeStarted, 0, 0), 0);
+    ASSERT_EQ(tsem_init(&decodeResume, 0, 0), 0);
+  }
+
+  static void TearDownTestSuite() {
+    vnodeAsyncClose();
+    (void)tsem_destroy(&decodeStarted);
+    (void)tsem_destroy(&decodeResume);
+  }
+};
+
+TEST_F(TsdbDecodeAheadTest, readersExhausted) {
+  for (int32_t i = 0; i < TSDB_READ_DECODE_READERS; ++i) {
+    ASSERT_EQ(acquireDecodeReader(), TSDB_CODE_SUCCESS) << "reader " << i;
+  }
+
+  // the blocks left are loaded by the query thread, until a clone is released
+  EXPECT_EQ(acquireDecodeReader(), TSDB_CODE_OUT_OF_RANGE);
+  EXPECT_EQ(acquireDecodeReader(), TSDB_CODE_OUT_OF_RANGE);
+
+  releaseDecodeReader();
+  EXPECT_EQ(acquireDecodeReader(), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(acquireDecodeReader(), TSDB_CODE_OUT_OF_RANGE);
+
+  for (int32_t i = 0; i < TSDB_READ_DECODE_READERS; ++i) {
+    releaseDecodeReader();
+  }
+  EXPECT_EQ(acquireDecodeReader(), TSDB_CODE_SUCCESS);
+  releaseDecodeReader();
+}
+
+TEST_F(TsdbDecodeAheadTest, queuedTaskTakenBack) {
+  SBlockDecodeSlot running = {0};
+  SBlockDecodeSlot queued = {0};
+  numOfDecoded = 0;
+
+  ASSERT_EQ(scheduleDecode(&running, blockingDecode), 0);
+  ASSERT_EQ(tsem_wait(&decodeStarted), 0);
+  ASSERT_EQ(scheduleDecode(&queued, decode), 0);
+
+  // the query thread reaches the queued block first, it is cancelled and loaded by the query thread
+  EXPECT_FALSE(takeDecodeSlot(&queued));
+  EXPECT_FALSE(queued.busy);
+  EXPECT_EQ(queued.taskId.id, 0);
+
+  // the running one is waited for
+  ASSERT_EQ(tsem_post(&decodeResume), 0);
+  EXPECT_TRUE(takeDecodeSlot(&running));
+  EXPECT_FALSE(running.busy);
+  EXPECT_EQ(numOfDecoded, 1);
+
+  // the cancelled task never runs
+  taosMsleep(100);
+  EXPECT_EQ(numOfDecoded, 1);
+}
+
+TEST_F(TsdbDecodeAheadTest, finishedTask) {
+  SBlockDecodeSlot slot = {0};
+
+  ASSERT_EQ(scheduleDecode(&slot, decode), 0);
+  ASSERT_EQ(tsem_wait(&decodeStarted), 0);
+  EXPECT_TRUE(takeDecodeSlot(&slot));
+  EXPECT_FALSE(slot.busy);
+  EXPECT_EQ(slot.taskId.id, 0);
+}
+
+TEST_F(TsdbDecodeAheadTest, workerError) {
+  SBlockDecodeSlot slot = {0};
+
+  // the error of the decode thread is kept in the slot, and the block is not taken as decoded
+  ASSERT_EQ(scheduleDecode(&slot, failedDecode), 0);
+  ASSERT_EQ(tsem_wait(&decodeStarted), 0);
+  EXPECT_FALSE(takeDecodeSlot(&slot));
+  EXPECT_FALSE(slot.busy);
+  EXPECT_EQ(slot.code, TSDB_CODE_FILE_CORRUPTED);
+
+  // the slot is used again afterwards
+  ASSERT_EQ(scheduleDecode(&slot, decode), 0);
+  ASSERT_EQ(tsem_wait(&decodeStarted), 0);
+  EXPECT_TRUE(takeDecodeSlot(&slot));
+  EXPECT_EQ(slot.code, TSDB_CODE_SUCCESS);
+}
+
+TEST(TsdbBlockDataTest, mergeColData) {
+  SBlockData bData = {0};
+  SColData  *pColData = NULL;
+  ASSERT_EQ(tBlockDataCreate(&bData), 0);
+
+  // the primary key decoded with the key part, and the columns of a late materialized block
+  ASSERT_EQ(tBlockDataAddColData(&bData, 2, TSDB_DATA_TYPE_INT, COL_IS_KEY, &pColData), 0);
+  ASSERT_EQ(tBlockDataAddColData(&bData, 4, TSDB_DATA_TYPE_INT, 0, &pColData), 0);
+  ASSERT_EQ(tBlockDataAddColData(&bData, 7, TSDB_DATA_TYPE_INT, 0, &pColData), 0);
+
+  // the filter columns decoded by the probe, with the primary key decoded again
+  int16_t   cids[] = {2, 3, 5, 8};
+  int32_t   nColData = sizeof(cids) / sizeof(cids[0]);
+  SColData *aColData = (SColData *)taosMemoryCalloc(nColData, sizeof(SColData));
+  ASSERT_NE(aColData, nullptr);
+  for (int32_t i = 0; i < nColData; ++i) {
+    tColDataInit(&aColData[i], cids[i], TSDB_DATA_TYPE_BIGINT, 0);
+  }
+
+  ASSERT_EQ(tBlockDataMergeColData(&bData, aColData, nColData), 0);
+
+  int16_t expect[] = {2, 3, 4, 5, 7, 8};
+  ASSERT_EQ(bData.nColData, (int32_t)(sizeof(expect) / sizeof(expect[0])));
+  for (int32_t i = 0; i < bData.nColData; ++i) {
+    EXPECT_EQ(bData.aColData[i].cid, expect[i]);
+    EXPECT_EQ(tBlockDataGetColData(&bData, expect[i]), &bData.aColData[i]);
+  }
+
+  // the column already in the block is kept
+  EXPECT_EQ(tBlockDataGetColData(&bData, 2)->type, TSDB_DATA_TYPE_INT);
+  EXPECT_EQ(tBlockDataGetColData(&bData, 3)->type, TSDB_DATA_TYPE_BIGINT);
+
+  // nothing to merge
+  ASSERT_EQ(tBlockDataMergeColData(&bData, NULL, 0), 0);
+  EXPECT_EQ(bData.nColData, (int32_t)(sizeof(expect) / sizeof(expect[0])));
+
+  tBlockDataDestroy(&bData);
+}
+
+namespace {
+
+void putColumnDataAgg(SBuffer *buffer, int32_t colId, int64_t sum) {
+  SColumnDataAgg agg = {0};
+  agg.colId = colId;
+  agg.numOfNull = 1;
+  agg.sum = sum;
+  agg.max = sum;
+  agg.min = -sum;
+  ASSERT_EQ(tPutColumnDataAgg(buffer, &agg), 0);
+}
+
+void putBloomFilter(SBuffer *buffer, int16_t cid, int64_t from, int64_t to) {
+  SBloomFilter *pBF = NULL;
+  ASSERT_EQ(tBloomFilterInit(to - from, TSDB_BLOCK_BLOOM_FILTER_ERROR_RATE, &pBF), 0);
+  for (int64_t v = from; v < to; ++v) {
+    (void)tBloomFilterPutHash(pBF, HASH_FUNCTION_1((const char *)&v, sizeof(v)),
+                              HASH_FUNCTION_2((const char *)&v, sizeof(v)));
+  }
+  ASSERT_EQ(tPutBlockBloomFilter(buffer, cid, pBF), 0);
+  tBloomFilterDestroy(pBF);
+}
+
+bool mayContain(const SBloomFilter *pBF, int64_t v) {
+  return tBloomFilterNoContain(pBF, HASH_FUNCTION_1((const char *)&v, sizeof(v)),
+                               HASH_FUNCTION_2((const char *)&v, sizeof(v))) != TSDB_CODE_SUCCESS;
+}
+
+}  // namespace
+
+TEST(TsdbBlockBloomFilterTest, roundTrip) {
+  SBuffer buffer;
+  tBufferInit(&buffer);
+
+  // the column SMA, then the bloom filters flagged in the column id
+  putColumnDataAgg(&buffer, 2, 100);
+  putColumnDataAgg(&buffer, 3, 200);
+  putBloomFilter(&buffer, 2, 0, 100);
+  putBloomFilter(&buffer, 3, 1000, 1100);
+
+  SBufferReader  br = BUFFER_READER_INITIALIZER(0, &buffer);
+  SColumnDataAgg agg = {0};
+  for (int16_t cid = 2; cid <= 3; ++cid) {
+    EXPECT_FALSE(tIsBlockBloomFilter(&br));
+    ASSERT_EQ(tGetColumnDataAgg(&br, &agg), 0);
+    EXPECT_EQ(agg.colId, cid);
+    EXPECT_EQ(agg.sum, cid * 100 - 100);
+  }
+
+  // the filter of column 2 is skipped
+  int16_t cid = 0;
+  ASSERT_TRUE(tIsBlockBloomFilter(&br));
+  ASSERT_EQ(tGetBlockBloomFilter(&br, &cid, NULL), 0);
+  EXPECT_EQ(cid, 2);
+
+  SBloomFilter *pBF = NULL;
+  ASSERT_TRUE(tIsBlockBloomFilter(&br));
+  ASSERT_EQ(tGetBlockBloomFilter(&br, &cid, &pBF), 0);
+  ASSERT_NE(pBF, nullptr);
+  EXPECT_EQ(cid, 3);
+  EXPECT_EQ(br.offset, buffer.size);
+
+  // every value written is found, and most of the others are not
+  int32_t numOfFalsePositive = 0;
+  for (int64_t v = 1000; v < 1100; ++v) {
+    EXPECT_TRUE(mayContain(pBF, v)) << v;
+  }
+  for (int64_t v = 0; v < 1000; ++v) {
+    numOfFalsePositive += mayContain(pBF, v) ? 1 : 0;
+  }
+  EXPECT_LT(numOfFalsePositive, 100);
+
+  tBloomFilterDestroy(pBF);
+  tBufferDestroy(&buffer);
+}
+
+TEST(TsdbBlockBloomFilterTest, smaWithoutBloomFilter) {
+  SBuffer buffer;
+  tBufferInit(&buffer);
+
+  // the sma region written by the versions without bloom filters, decimal columns flag the column id as well
+  putColumnDataAgg(&buffer, 2, 100);
+  putColumnDataAgg(&buffer, INT16_MAX, 200);
+
+  SColumnDataAgg decimalAgg = {0};
+  decimalAgg.colId = 4 | DECIMAL_AGG_FLAG;
+  decimalAgg.decimal128Sum[0] = 300;
+  ASSERT_EQ(tPutColumnDataAgg(&buffer, &decimalAgg), 0);
+
+  SBufferReader  br = BUFFER_READER_INITIALIZER(0, &buffer);
+  SColumnDataAgg agg = {0};
+  int32_t        numOfAggs = 0;
+  while (br.offset < buffer.size) {
+    EXPECT_FALSE(tIsBlockBloomFilter(&br));
+    ASSERT_EQ(tGetColumnDataAgg(&br, &agg), 0);
+    numOfAggs += 1;
+  }
+  EXPECT_EQ(numOfAggs, 3);
+  EXPECT_EQ(agg.colId, 4);
+  EXPECT_EQ(agg.decimal128Sum[0], 300);
+
+  tBufferDestroy(&buffer);
+}
+
+namespace {
+
+void buildColData(SColData *pColData, int16_t cid, int32_t nRows, int32_t base) {
+  tColDataInit(pColData, cid, TSDB_DATA_TYPE_INT, 0);
+  for (int32_t i = 0; i < nRows; ++i) {
+    SColVal cv = COL_VAL_NULL(cid, TSDB_DATA_TYPE_INT);
+    if (i % 10 != 0) {
+      SValue value = {.type = TSDB_DATA_TYPE_INT};
+      VALUE_SET_TRIVIAL_DATUM(&value, base + i);
+      cv = COL_VAL_VALUE(cid, value);
+    }
+    ASSERT_EQ(tColDataAppendValue(pColData, &cv), 0);
+  }
+}
+
+}  // namespace
+
+class TsdbColCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    tsdb.pVnode = &vnode;
+    vnode.pTsdb = &tsdb;
+    tsdb.colCache = taosLRUCacheInit(1024 * 1024, 0, .5);
+    ASSERT_NE(tsdb.colCache, nullptr);
+    taosLRUCacheSetStrictCapacity(tsdb.colCache, false);
+
+    file.type = (tsdb_ftype_t)TSDB_FTYPE_DATA;
+    file.fid = 1;
+    file.cid = 10;
+  }
+
+  void TearDown() override {
+    taosLRUCacheEraseUnrefEntries(tsdb.colCache);
+    taosLRUCacheCleanup(tsdb.colCache);
+  }
+
+  bool get(const STFile *pFile, int64_t offset, int16_t cid, SBlockData *pBlockData) {
+    bool hit = false;
+    EXPECT_EQ(tsdbCacheGetColData(&tsdb, pFile, offset, cid, pBlockData, &hit), 0);
+    return hit;
+  }
+
+  void stat(int64_t *hit, int64_t *miss, int64_t *evict) { tsdbGetColCacheStat(&tsdb, hit, miss, evict); }
+
+  SVnode vnode = {0};
+  STsdb  tsdb = {0};
+  STFile file = {};
+};
+
+TEST_F(TsdbColCacheTest, hitAndMiss) {
+  SBlockData bData = {0};
+  SColData   colData = {0};
+  int64_t    hit = 0, miss = 0, evict = 0;
+  ASSERT_EQ(tBlockDataCreate(&bData), 0);
+  buildColData(&colData, 2, 100, 1000);
+
+  EXPECT_FALSE(get(&file, 4096, 2, &bData));
+  tsdbCachePutColData(&tsdb, &file, 4096, &colData);
+  ASSERT_TRUE(get(&file, 4096, 2, &bData));
+
+  // the cached column is a copy of the one decoded
+  SColData *pColData = tBlockDataGetColData(&bData, 2);
+  ASSERT_NE(pColData, nullptr);
+  EXPECT_EQ(pColData->nVal, 100);
+  EXPECT_EQ(pColData->flag, colData.flag);
+  for (int32_t i = 0; i < 100; ++i) {
+    SColVal cv;
+    ASSERT_EQ(tColDataGetValue(pColData, i, &cv), 0);
+    if (i % 10 == 0) {
+      EXPECT_TRUE(COL_VAL_IS_NULL(&cv));
+    } else {
+      EXPECT_EQ(VALUE_GET_TRIVIAL_DATUM(&cv.value), 1000 + i);
+    }
+  }
+
+  // another column, or another block of the file
+  EXPECT_FALSE(get(&file, 4096, 3, &bData));
+  EXPECT_FALSE(get(&file, 8192, 2, &bData));
+
+  stat(&hit, &miss, &evict);
+  EXPECT_EQ(hit, 1);
+  EXPECT_EQ(miss, 3);
+  EXPECT_EQ(evict, 0);
+
+  // the counters reported are taken away
+  tsdbResetColCacheStat(&tsdb, hit, miss, evict);
+  stat(&hit, &miss, &evict);
+  EXPECT_EQ(hit + miss + evict, 0);
+
+  tColDataDestroy(&colData);
+  tBlockDataDestroy(&bData);
+}
+
+TEST_F(TsdbColCacheTest, fileChanged) {
+  SBlockData bData = {0};
+  SColData   colData = {0};
+  int64_t    hit = 0, miss = 0, evict = 0;
+  ASSERT_EQ(tBlockDataCreate(&bData), 0);
+  buildColData(&colData, 2, 100, 1000);
+
+  tsdbCachePutColData(&tsdb, &file, 4096, &colData);
+  ASSERT_TRUE(get(&file, 4096, 2, &bData));
+
+  // the file set is rewritten by a commit or compaction, the blocks at the same offset of the new file are not hit
+  STFile newFile = file;
+  newFile.cid = file.cid + 1;
+  tBlockDataReset(&bData);
+  EXPECT_FALSE(get(&newFile, 4096, 2, &bData));
+
+  // so is the stt file of the same file set
+  STFile sttFile = file;
+  sttFile.type = (tsdb_ftype_t)TSDB_FTYPE_STT;
+  EXPECT_FALSE(get(&sttFile, 4096, 2, &bData));
+
+  stat(&hit, &miss, &evict);
+  EXPECT_EQ(hit, 1);
+  EXPECT_EQ(miss, 2);
+
+  tColDataDestroy(&colData);
+  tBlockDataDestroy(&bData);
+}
+
+TEST_F(TsdbColCacheTest, evict) {
+  SColData colData = {0};
+  int64_t  hit = 0, miss = 0, evict = 0;
+  buildColData(&colData, 2, 1000, 0);
+
+  // the same column put by two readers replaces the first one, which is not an eviction
+  tsdbCachePutColData(&tsdb, &file, 0, &colData);
+  tsdbCachePutColData(&tsdb, &file, 0, &colData);
+  stat(&hit, &miss, &evict);
+  EXPECT_EQ(evict, 0);
+  EXPECT_EQ(taosLRUCacheGetElems(tsdb.colCache), 1);
+
+  // about 4KB each, far more than the capacity
+  const int32_t numOfBlocks = 1024;
+  for (int32_t i = 1; i < numOfBlocks; ++i) {
+    tsdbCachePutColData(&tsdb, &file, i * 4096, &colData);
+  }
+
+  stat(&hit, &miss, &evict);
+  EXPECT_GT(evict, 0);
+  EXPECT_EQ(evict + taosLRUCacheGetElems(tsdb.colCache), numOfBlocks);
+
+  tColDataDestroy(&colData);
+}
+
+TEST_F(TsdbColCacheTest, capacity) {
+  int32_t colCacheSize = tsTsdbColCacheSize;
+
+  // the cache takes at most half of the vnode buffer
+  tsTsdbColCacheSize = 64;
+  EXPECT_EQ(tsdbColCacheCapacity(256LL * 1024 * 1024), 64LL * 1024 * 1024);
+  EXPECT_EQ(tsdbColCacheCapacity(96LL * 1024 * 1024), 48LL * 1024 * 1024);
+
+  tsTsdbColCacheSize = 0;
+  EXPECT_EQ(tsdbColCacheCapacity(96LL * 1024 * 1024), 0);
+
+  // and follows the buffer when it is altered
+  tsTsdbColCacheSize = 64;
+  tsdbColCacheSetCapacity(&vnode, 32LL * 1024 * 1024);
+  EXPECT_EQ(taosLRUCacheGetCapacity(tsdb.colCache), 16LL * 1024 * 1024);
+
+  tsTsdbColCacheSize = colCacheSize;
+}
+
+class TsdbDelSkylineTest : public ::testing::Test {
+ protected:
+  void TearDown() override { taosArrayDestroy(scanInfo.delSkyline); }
+
+  // each delete is {sKey, eKey, version}
+  void buildSkyline(std::initializer_list<SDelData> dels) {
+    SArray *aDelData = taosArrayInit(dels.size(), sizeof(SDelData));
+    ASSERT_NE(aDelData, nullptr);
+    for (const SDelData &del : dels) {
+      ASSERT_NE(taosArrayPush(aDelData, &del), nullptr);
+    }
+
+    taosArrayDestroy(scanInfo.delSkyline);
+    scanInfo.delSkyline = taosArrayInit(4, sizeof(TSDBKEY));
+    ASSERT_NE(scanInfo.delSkyline, nullptr);
+    ASSERT_EQ(tsdbBuildDeleteSkyline(aDelData, 0, (int32_t)dels.size() - 1, scanInfo.delSkyline), 0);
+    taosArrayDestroy(aDelData);
+  }
+
+  bool covered(TSKEY firstTs, TSKEY lastTs, int64_t maxVer, int64_t queryVer = INT64_MAX) {
+    SBrinRecord record = {0};
+    record.firstKey.key.ts = firstTs;
+    record.lastKey.key.ts = lastTs;
+    record.minVer = 1;
+    record.maxVer = maxVer;
+
+    SVersionRange verRange = {.minVer = 0, .maxVer = queryVer};
+    return overlapWithDelSkyline(&scanInfo, &record, TSDB_ORDER_ASC) &&
+           coveredByDelSkyline(&scanInfo, &record, &verRange);
+  }
+
+  STableBlockScanInfo scanInfo = {0};
+};
+
+TEST_F(TsdbDelSkylineTest, fullyDeleted) {
+  buildSkyline({{.version = 10, .sKey = 100, .eKey = 200}});
+
+  EXPECT_TRUE(covered(120, 180, 5));
+  // the ends of the delete range are deleted as well
+  EXPECT_TRUE(covered(100, 200, 5));
+
+  // two overlapping deletes cover the block together
+  buildSkyline({{.version = 10, .sKey = 100, .eKey = 200}, {.version = 12, .sKey = 150, .eKey = 300}});
+  EXPECT_TRUE(covered(120, 280, 8));
+}
+
+TEST_F(TsdbDelSkylineTest, partlyCovered) {
+  buildSkyline({{.version = 10, .sKey = 100, .eKey = 200}});
+
+  // the block goes beyond either edge of the delete range
+  EXPECT_FALSE(covered(99, 150, 5));
+  EXPECT_FALSE(covered(150, 201, 5));
+  EXPECT_FALSE(covered(50, 250, 5));
+
+  // a gap between two deletes
+  buildSkyline({{.version = 10, .sKey = 100, .eKey = 200}, {.version = 10, .sKey = 210, .eKey = 300}});
+  EXPECT_FALSE(covered(150, 250, 5));
+  EXPECT_TRUE(covered(210, 300, 5));
+}
+
+TEST_F(TsdbDelSkylineTest, versionBelowMaxVer) {
+  buildSkyline({{.version = 10, .sKey = 100, .eKey = 200}});
+
+  // rows written after the delete are kept
+  EXPECT_TRUE(covered(120, 180, 10));
+  EXPECT_FALSE(covered(120, 180, 11));
+
+  // the delete is not in the version range of the query
+  EXPECT_FALSE(covered(120, 180, 5, 9));
+
+  // a later segment deletes the older rows only
+  buildSkyline({{.version = 10, .sKey = 100, .eKey = 200}, {.version = 5, .sKey = 150, .eKey = 300}});
+  EXPECT_TRUE(covered(120, 200, 8));
+  EXPECT_FALSE(covered(120, 280, 8));
+  EXPECT_TRUE(covered(120, 280, 5));
+}
+
+// tables of uid 10, 20, ..., 60 under suid 1, each with 5 blocks of [100 * i, 100 * i + 99], written 8 records to
+// a brin block, so that the records of the table of uid 20 lie across the first two brin blocks
+class TsdbBrinRecordIterTest : public ::testing::Test {
+ protected:
+  static const int32_t numOfTables = 6;
+  static const int32_t numOfBlocksPerTable = 5;
+  static const int32_t numOfRecordsPerBrinBlock = 8;
+
+  void SetUp() override {
+    tsdb.pVnode = &vnode;
+    vnode.pTsdb = &tsdb;
+    vnode.config.tsdbPageSize = 4096;
+    snprintf(path, sizeof(path), "%s/tsdbBrinRecordIterTest.head", tsTempDir);
+
+    SBuffer buffers[3];
+    for (int32_t i = 0; i < 3; ++i) {
+      tBufferInit(&buffers[i]);
+    }
+
+    STsdbFD *fd = NULL;
+    ASSERT_EQ(tsdbOpenFile(path, &tsdb, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC, &fd, 0), 0);
+
+    SBrinBlock    block;
+    TBrinBlkArray brinBlkArray = {0};
+    SVersionRange range = {.minVer = VERSION_MAX, .maxVer = VERSION_MIN};
+    int64_t       fileSize = 0;
+    ASSERT_EQ(tBrinBlockInit(&block), 0);
+    for (int32_t t = 0; t < numOfTables; ++t) {
+      for (int32_t i = 0; i < numOfBlocksPerTable; ++i) {
+        SBrinRecord record = {0};
+        record.suid = 1;
+        record.uid = (t + 1) * 10;
+        record.firstKey.key.ts = 100 * i;
+        record.lastKey.key.ts = 100 * i + 99;
+        record.minVer = record.maxVer = 1;
+        record.numRow = 100;
+        ASSERT_EQ(tBrinBlockPut(&block, &record), 0);
+
+        if (block.numOfRecords == numOfRecordsPerBrinBlock) {
+          ASSERT_EQ(tsdbFileWriteBrinBlock(fd, &block, NO_COMPRESSION, &fileSize, &brinBlkArray, buffers, &range, 0,
+                                           NULL),
+                    0);
+        }
+      }
+    }
+    ASSERT_EQ(tsdbFileWriteBrinBlock(fd, &block, NO_COMPRESSION, &fileSize, &brinBlkArray, buffers, &range, 0, NULL),
+              0);
+    ASSERT_EQ(tsdbFsyncFile(fd, 0, NULL), 0);
+    tsdbCloseFile(&fd);
+    tBrinBlockDestroy(&block);
+    for (int32_t i = 0; i < 3; ++i) {
+      tBufferDestroy(&buffers[i]);
+    }
+
+    pBrinBlkList = taosArrayInit(brinBlkArray.size, sizeof(SBrinBlk));
+    ASSERT_NE(pBrinBlkList, nullptr);
+    for (int32_t i = 0; i < brinBlkArray.size; ++i) {
+      ASSERT_NE(taosArrayPush(pBrinBlkList, &brinBlkArray.data[i]), nullptr);
+    }
+    taosMemoryFree(brinBlkArray.data);
+    ASSERT_EQ(taosArrayGetSize(pBrinBlkList), 4);
+
+    const char           *fname[TSDB_FTYPE_MAX] = {0};
+    SDataFileReaderConfig config = {0};
+    fname[TSDB_FTYPE_HEAD] = path;
+    config.tsdb = &tsdb;
+    config.szPage = vnode.config.tsdbPageSize;
+    ASSERT_EQ(tsdbDataFileReaderOpen(fname, &config, &pReader), 0);
+    initBrinRecordIter(&iter, pReader, pBrinBlkList);
+  }
+
+  void TearDown() override {
+    clearBrinBlockIter(&iter);
+    tsdbDataFileReaderClose(&pReader);
+    taosArrayDestroy(pBrinBlkList);
+    (void)taosRemoveFile(path);
+  }
+
+  // skip to (uid, skey) and return the (uid, first key) of the next record, or (0, -1) if none is left
+  std::pair<int64_t, TSKEY> skipAndNext(int64_t suid, int64_t uid, TSKEY skey) {
+    SBrinRecord *pRecord = NULL;
+    EXPECT_EQ(skipBrinRecords(&iter, suid, uid, skey), 0);
+    EXPECT_EQ(getNextBrinRecord(&iter, &pRecord), 0);
+    if (pRecord == NULL) {
+      return {0, -1};
+    }
+    return {pRecord->uid, pRecord->firstKey.key.ts};
+  }
+
+  SVnode           vnode = {0};
+  STsdb            tsdb = {0};
+  char             path[PATH_MAX] = {0};
+  SArray          *pBrinBlkList = NULL;
+  SDataFileReader *pReader = NULL;
+  SBrinRecordIter  iter = {0};
+};
+
+TEST_F(TsdbBrinRecordIterTest, skipTables) {
+  EXPECT_EQ(skipAndNext(1, 10, INT64_MIN), std::make_pair(10L, 0L));
+  // the records of the tables before are jumped over, in the same brin block and in the later ones
+  EXPECT_EQ(skipAndNext(1, 20, INT64_MIN), std::make_pair(20L, 0L));
+  EXPECT_EQ(skipAndNext(1, 40, INT64_MIN), std::make_pair(40L, 0L));
+  EXPECT_EQ(skipAndNext(1, 60, 200), std::make_pair(60L, 200L));
+  EXPECT_EQ(iter.blockIndex, 3);
+}
+
+TEST_F(TsdbBrinRecordIterTest, tablesNotInFile) {
+  // a table of a smaller suid, or between two tables of the file, stops at the next table
+  EXPECT_EQ(skipAndNext(0, 100, INT64_MIN), std::make_pair(10L, 0L));
+  EXPECT_EQ(skipAndNext(1, 25, INT64_MIN), std::make_pair(30L, 0L));
+  // a table after the last one leaves the iterator exhausted
+  EXPECT_EQ(skipAndNext(1, 65, INT64_MIN), std::make_pair(0L, -1L));
+  EXPECT_EQ(skipAndNext(1, 65, INT64_MIN), std::make_pair(0L, -1L));
+}
+
+TEST_F(TsdbBrinRecordIterTest, recordsAcrossBrinBlocks) {
+  // the records of the table of uid 20 are the last 3 of the first brin block and the first 2 of the second one
+  EXPECT_EQ(skipAndNext(1, 20, 150), std::make_pair(20L, 100L));
+  EXPECT_EQ(iter.blockIndex, 0);
+  EXPECT_EQ(skipAndNext(1, 20, 350), std::make_pair(20L, 300L));
+  EXPECT_EQ(iter.blockIndex, 1);
+
+  // the blocks ending before skey are skipped, the iterator never goes back
+  EXPECT_EQ(skipAndNext(1, 20, INT64_MIN), std::make_pair(20L, 400L));
+  EXPECT_EQ(skipAndNext(1, 20, 1000), std::make_pair(30L, 0L));
+}
+
+namespace {
+
+tsem_t mergeStarted;
+tsem_t mergeResume;
+
+// a task holding the only merge thread until it is told to go on
+int32_t blockingMerge(void *arg) {
+  (void)tsem_post(&mergeStarted);
+  (void)tsem_wait(&mergeResume);
+  return TSDB_CODE_SUCCESS;
+}
+
+}  // namespace
+
+class TsdbMergeScheduleTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    ASSERT_EQ(vnodeAsyncOpen(), 0);
+    ASSERT_EQ(vnodeAsyncSetWorkers(MERGE_TASK_ASYNC, 1), 0);
+    ASSERT_EQ(tsem_init(&mergeStarted, 0, 0), 0);
+    ASSERT_EQ(tsem_init(&mergeResume, 0, 0), 0);
+  }
+
+  static void TearDownTestSuite() {
+    vnodeAsyncClose();
+    (void)tsem_destroy(&mergeStarted);
+    (void)tsem_destroy(&mergeResume);
+  }
+
+  void SetUp() override {
+    tsdb.pVnode = &vnode;
+    vnode.pTsdb = &tsdb;
+    fset.fid = 1;
+  }
+
+  SVnode    vnode = {0};
+  STsdb     tsdb = {0};
+  STFileSet fset = {};
+};
+
+TEST_F(TsdbMergeScheduleTest, promotedByLevel0Depth) {
+  const int32_t sttTrigger = 4;
+  const int32_t blockCommit = sttTrigger * BLOCK_COMMIT_FACTOR;
+
+  // the merges stay queued behind a task holding the merge thread
+  SVATaskID blocker = {0};
+  ASSERT_EQ(vnodeAsync(MERGE_TASK_ASYNC, EVA_PRIORITY_HIGH, blockingMerge, NULL, NULL, &blocker), 0);
+  ASSERT_EQ(tsem_wait(&mergeStarted), 0);
+
+  ASSERT_EQ(tsdbFSetScheduleMerge(&tsdb, &fset, sttTrigger - 1, sttTrigger), 0);
+  EXPECT_FALSE(vnodeATaskValid(&fset.mergeTask));
+
+  ASSERT_EQ(tsdbFSetScheduleMerge(&tsdb, &fset, sttTrigger, sttTrigger), 0);
+  ASSERT_TRUE(vnodeATaskValid(&fset.mergeTask));
+  EXPECT_EQ(fset.mergePriority, EVA_PRIORITY_NORMAL);
+  SVATaskID queued = fset.mergeTask;
+
+  // a deeper backlog not blocking commit yet leaves the queued task as it is
+  ASSERT_EQ(tsdbFSetScheduleMerge(&tsdb, &fset, blockCommit - 1, sttTrigger), 0);
+  EXPECT_EQ(fset.mergeTask.id, queued.id);
+  EXPECT_EQ(fset.mergePriority, EVA_PRIORITY_NORMAL);
+
+  // once it blocks commit, the task is taken back and queued again at high priority
+  ASSERT_EQ(tsdbFSetScheduleMerge(&tsdb, &fset, blockCommit, sttTrigger), 0);
+  EXPECT_FALSE(vnodeATaskValid(&queued));
+  ASSERT_TRUE(vnodeATaskValid(&fset.mergeTask));
+  EXPECT_NE(fset.mergeTask.id, queued.id);
+  EXPECT_EQ(fset.mergePriority, EVA_PRIORITY_HIGH);
+
+  // and only once
+  SVATaskID promoted = fset.mergeTask;
+  ASSERT_EQ(tsdbFSetScheduleMerge(&tsdb, &fset, blockCommit + 1, sttTrigger), 0);
+  EXPECT_EQ(fset.mergeTask.id, promoted.id);
+
+  // the merge of the fake file set never runs
+  EXPECT_EQ(vnodeACancel(&fset.mergeTask), 0);
+  ASSERT_EQ(tsem_post(&mergeResume), 0);
+  vnodeAWait(&blocker);
+}
+
+TEST(TsdbBlockDataTest, appendBlockRows) {
+  const int32_t nRow = 20;
+  const int64_t uid = 100;
+  SBlockData    from = {0};
+  SBlockData    byRun = {0};
+  SBlockData    byRow = {0};
+  SColData     *pColData = NULL;
+
+  // a column-format batch of a table in the memtable
+  ASSERT_EQ(tBlockDataCreate(&from), 0);
+  from.suid = 1;
+  from.uid = uid;
+  for (int16_t cid : {2, 3, 5}) {
+    ASSERT_EQ(tBlockDataAddColData(&from, cid, TSDB_DATA_TYPE_INT, 0, &pColData), 0);
+    buildColData(pColData, cid, nRow, cid * 1000);
+  }
+  ASSERT_EQ(tRealloc((uint8_t **)&from.aVersion, sizeof(int64_t) * nRow), 0);
+  ASSERT_EQ(tRealloc((uint8_t **)&from.aTSKEY, sizeof(TSKEY) * nRow), 0);
+  for (int32_t i = 0; i < nRow; ++i) {
+    from.aVersion[i] = 1000 + i;
+    from.aTSKEY[i] = 100 + i;
+  }
+  from.nRow = nRow;
+
+  // the stt block of the super table, missing a column of the batch and with a column the batch does not carry
+  for (SBlockData *pBlockData : {&byRun, &byRow}) {
+    ASSERT_EQ(tBlockDataCreate(pBlockData), 0);
+    pBlockData->suid = 1;
+    for (int16_t cid : {2, 4, 5}) {
+      ASSERT_EQ(tBlockDataAddColData(pBlockData, cid, TSDB_DATA_TYPE_INT, 0, &pColData), 0);
+    }
+  }
+
+  // the first row of a run is appended as a row, as the stt writer does, then the run in two pieces
+  TSDBROW row = tsdbRowFromBlockData(&from, 0);
+  ASSERT_EQ(tBlockDataAppendRow(&byRun, &row, NULL, uid), 0);
+  ASSERT_EQ(tBlockDataAppendBlockRows(&byRun, &from, 1, 14, uid), 0);
+  ASSERT_EQ(tBlockDataAppendBlockRows(&byRun, &from, 15, nRow - 15, uid), 0);
+  for (int32_t i = 0; i < nRow; ++i) {
+    row = tsdbRowFromBlockData(&from, i);
+    ASSERT_EQ(tBlockDataAppendRow(&byRow, &row, NULL, uid), 0);
+  }
+
+  ASSERT_EQ(byRun.nRow, nRow);
+  ASSERT_EQ(byRow.nRow, nRow);
+  for (int32_t i = 0; i < nRow; ++i) {
+    EXPECT_EQ(byRun.aUid[i], byRow.aUid[i]);
+    EXPECT_EQ(byRun.aVersion[i], byRow.aVersion[i]);
+    EXPECT_EQ(byRun.aTSKEY[i], byRow.aTSKEY[i]);
+  }
+  ASSERT_EQ(byRun.nColData, byRow.nColData);
+  for (int32_t iCol = 0; iCol < byRun.nColData; ++iCol) {
+    SColData *pRun = &byRun.aColData[iCol];
+    SColData *pRow = &byRow.aColData[iCol];
+    ASSERT_EQ(pRun->nVal, nRow);
+    ASSERT_EQ(pRow->nVal, nRow);
+    EXPECT_EQ(pRun->flag, pRow->flag) << pRun->cid;
+    for (int32_t i = 0; i < nRow; ++i) {
+      SColVal cvRun, cvRow;
+      ASSERT_EQ(tColDataGetValue(pRun, i, &cvRun), 0);
+      ASSERT_EQ(tColDataGetValue(pRow, i, &cvRow), 0);
+      EXPECT_EQ(cvRun.flag, cvRow.flag) << pRun->cid << ":" << i;
+      if (COL_VAL_IS_VALUE(&cvRun)) {
+        EXPECT_EQ(VALUE_GET_TRIVIAL_DATUM(&cvRun.value), VALUE_GET_TRIVIAL_DATUM(&cvRow.value)) << pRun->cid << ":" << i;
+      }
+    }
+  }
+  // the column missing in the batch is none
+  SColVal cv;
+  ASSERT_EQ(tColDataGetValue(tBlockDataGetColData(&byRun, 4), 3, &cv), 0);
+  EXPECT_TRUE(COL_VAL_IS_NONE(&cv));
+
+  // out of the batch
+  EXPECT_EQ(tBlockDataAppendBlockRows(&byRun, &from, 15, nRow - 14, uid), TSDB_CODE_INVALID_PARA);
+  EXPECT_EQ(byRun.nRow, nRow);
+
+  tBlockDataDestroy(&from);
+  tBlockDataDestroy(&byRun);
+  tBlockDataDestroy(&byRow);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "vnd.h"
+
+namespace {
+
+const int32_t vgId = 2;
+
+SRpcMsg buildQueryMsg(uint64_t queryId, uint64_t taskId, int32_t maxStaleness) {
+  char         sql[] = "select * from st";
+  char         plan[] = "{\"NodeType\":\"1\"}";
+  SSubQueryMsg req = {0};
+  req.header.vgId = vgId;
+  req.queryId = queryId;
+  req.taskId = taskId;
+  req.taskType = TASK_TYPE_TEMP;
+  req.sqlLen = strlen(sql);
+  req.sql = sql;
+  req.msgLen = strlen(plan);
+  req.msg = plan;
+  req.maxStaleness = maxStaleness;
+
+  SRpcMsg msg = {.msgType = TDMT_SCH_QUERY};
+  msg.contLen = tSerializeSSubQueryMsg(NULL, 0, &req);
+  msg.pCont = taosMemoryCalloc(1, msg.contLen);
+  EXPECT_EQ(tSerializeSSubQueryMsg(msg.pCont, msg.contLen, &req), msg.contLen);
+  return msg;
+}
+
+SRpcMsg buildFetchMsg(uint64_t queryId, uint64_t taskId) {
+  SResFetchReq req = {0};
+  req.header.vgId = vgId;
+  req.queryId = queryId;
+  req.taskId = taskId;
+
+  SRpcMsg msg = {.msgType = TDMT_SCH_FETCH};
+  msg.contLen = tSerializeSResFetchReq(NULL, 0, &req, false);
+  msg.pCont = taosMemoryCalloc(1, msg.contLen);
+  EXPECT_EQ(tSerializeSResFetchReq(msg.pCont, msg.contLen, &req, false), msg.contLen);
+  return msg;
+}
+
+SRpcMsg buildDropMsg(uint64_t queryId, uint64_t taskId) {
+  STaskDropReq req = {0};
+  req.header.vgId = vgId;
+  req.queryId = queryId;
+  req.taskId = taskId;
+
+  SRpcMsg msg = {.msgType = TDMT_SCH_DROP_TASK};
+  msg.contLen = tSerializeSTaskDropReq(NULL, 0, &req);
+  msg.pCont = taosMemoryCalloc(1, msg.contLen);
+  EXPECT_EQ(tSerializeSTaskDropReq(msg.pCont, msg.contLen, &req), msg.contLen);
+  return msg;
+}
+
+bool isFollowerReadFetch(SVnode *pVnode, uint64_t queryId, uint64_t taskId) {
+  SRpcMsg msg = buildFetchMsg(queryId, taskId);
+  bool    admitted = vnodeIsFollowerReadFetch(pVnode, &msg);
+  taosMemoryFree(msg.pCont);
+  return admitted;
+}
+
+}  // namespace
+
+class VnodeFollowerReadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    vnode.pFollowerReads = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_ENTRY_LOCK);
+    ASSERT_NE(vnode.pFollowerReads, nullptr);
+  }
+
+  void TearDown() override { taosHashCleanup(vnode.pFollowerReads); }
+
+  SVnode vnode = {0};
+};
+
+TEST_F(VnodeFollowerReadTest, subQueryMsgAttr) {
+  SRpcMsg      msg = buildQueryMsg(0x1234, 7, 3000);
+  SSubQueryMsg req = {0};
+
+  // the staleness bound is read without copying the sql and the plan, and the msg is left as is
+  ASSERT_EQ(tDeserializeSSubQueryMsgAttr(msg.pCont, msg.contLen, &req), 0);
+  EXPECT_EQ(req.queryId, 0x1234);
+  EXPECT_EQ(req.taskId, 7);
+  EXPECT_EQ(req.taskType, TASK_TYPE_TEMP);
+  EXPECT_EQ(req.maxStaleness, 3000);
+  EXPECT_EQ(req.sql, nullptr);
+  EXPECT_EQ(req.msg, nullptr);
+  EXPECT_EQ(ntohl(((SMsgHead *)msg.pCont)->vgId), vgId);
+
+  // the full msg decodes as before
+  SSubQueryMsg full = {0};
+  ASSERT_EQ(tDeserializeSSubQueryMsg(msg.pCont, msg.contLen, &full), 0);
+  EXPECT_EQ(full.maxStaleness, 3000);
+  EXPECT_STREQ(full.sql, "select * from st");
+  tFreeSSubQueryMsg(&full);
+
+  uint64_t queryId = 0, taskId = 0;
+  ASSERT_EQ(tDeserializeSchTaskId(msg.pCont, msg.contLen, &queryId, &taskId), 0);
+  EXPECT_EQ(queryId, 0x1234);
+  EXPECT_EQ(taskId, 7);
+  taosMemoryFree(msg.pCont);
+}
+
+TEST_F(VnodeFollowerReadTest, fetchOfAcceptedTask) {
+  // nothing accepted, no fetch is served by the follower
+  EXPECT_FALSE(isFollowerReadFetch(&vnode, 0x1234, 7));
+
+  ASSERT_EQ(vnodeAddFollowerRead(&vnode, 0x1234, 7), 0);
+  EXPECT_TRUE(isFollowerReadFetch(&vnode, 0x1234, 7));
+
+  // another task of the query, or the same task id of another query, was not accepted here
+  EXPECT_FALSE(isFollowerReadFetch(&vnode, 0x1234, 8));
+  EXPECT_FALSE(isFollowerReadFetch(&vnode, 0x5678, 7));
+
+  // the task is forgotten once dropped
+  SRpcMsg drop = buildDropMsg(0x1234, 7);
+  vnodeRemoveFollowerRead(&vnode, &drop);
+  taosMemoryFree(drop.pCont);
+  EXPECT_FALSE(isFollowerReadFetch(&vnode, 0x1234, 7));
+  EXPECT_EQ(taosHashGetSize(vnode.pFollowerReads), 0);
+}
+
+TEST_F(VnodeFollowerReadTest, purgeNeverDropped) {
+  int64_t acceptTs = taosGetTimestampMs() - 24 * 3600 * 1000;
+  for (uint64_t taskId = 0; taskId < 1024; ++taskId) {
+    uint64_t key[2] = {1, taskId};
+    ASSERT_EQ(taosHashPut(vnode.pFollowerReads, key, sizeof(key), &acceptTs, sizeof(acceptTs)), 0);
+  }
+  EXPECT_TRUE(isFollowerReadFetch(&vnode, 1, 0));
+
+  // the tasks accepted long ago are forgotten when the next one is accepted
+  ASSERT_EQ(vnodeAddFollowerRead(&vnode, 2, 0), 0);
+  EXPECT_EQ(taosHashGetSize(vnode.pFollowerReads), 1);
+  EXPECT_FALSE(isFollowerReadFetch(&vnode, 1, 0));
+  EXPECT_TRUE(isFollowerReadFetch(&vnode, 2, 0));
+}
@@ -265,6 +265,18 @@ typedef struct STableMetaCacheInfo {
   uint64_t   cacheHit;
 } STableMetaCacheInfo;
 
+// The filter columns are loaded ahead only while enough blocks are filtered out by them. When less than
+// LATE_MATERIALIZE_MIN_SKIP_PERCENT of the probed blocks are skipped, the blocks are loaded wholly for a while.
+#define LATE_MATERIALIZE_PROBE_BLOCKS     64
+#define LATE_MATERIALIZE_PAUSE_BLOCKS     1024
+#define LATE_MATERIALIZE_MIN_SKIP_PERCENT 10
+
+typedef struct SLateMaterializeInfo {
+  int32_t numOfProbed;   // blocks probed since the last check
+  int32_t numOfSkipped;  // blocks among them without any qualified rows
+  int32_t pausedBlocks;  // blocks left to be loaded wholly before probing again
+} SLateMaterializeInfo;
+
 typedef struct STableScanBase {
   STsdbReader*           dataReader;
   SFileBlockLoadRecorder readRecorder;
@@ -281,6 +293,9 @@ typedef struct STableScanBase {
   // there are more than one table list exists in one task, if only one vnode exists.
   STableListInfo* pTableListInfo;
   TsdReader       readerAPI;
+  SArray*         pFilterColIds;  // SArray<col_id_t>, columns loaded ahead to evaluate the filter, NULL if disabled
+  SArray*         pBloomProbes;   // SArray<SBlockBloomProbe>, probe the bloom filters of blocks, NULL if disabled
+  SLateMaterializeInfo lateMaterialize;  // turns pFilterColIds off for a while when the filter is not selective
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -809,10 +824,14 @@ int32_t     getBufferPgSize(int32_t rowSize, uint32_t* defaultPgsz, int64_t* def
 extern void doDestroyExchangeOperatorInfo(void* param);
 
 int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo, SColumnInfoData** pRet);
+int32_t applyFilterResult(SSDataBlock* pBlock, const SColumnInfoData* p, int32_t status, SColMatchInfo* pColMatchInfo);
+bool    lateMaterializeBlock(SLateMaterializeInfo* pInfo);
+bool    updateLateMaterialize(SLateMaterializeInfo* pInfo, bool filterOut);
 int32_t addTagPseudoColumnData(SReadHandle* pHandle, const SExprInfo* pExpr, int32_t numOfExpr, SSDataBlock* pBlock,
                                int32_t rows, SExecTaskInfo* pTask, STableMetaCacheInfo* pCache);
 
 int32_t appendOneRowToDataBlock(SSDataBlock* pBlock, STupleHandle* pTupleHandle);
+void    setTableScanLoadData(struct SOperatorInfo* pOperator);
 int32_t setResultRowInitCtx(SResultRow* pResult, SqlFunctionCtx* pCtx, int32_t numOfOutput,
                             int32_t* rowEntryInfoOffset);
 void    clearResultRowInitFlag(SqlFunctionCtx* pCtx, int32_t numOfOutput);
@@ -592,7 +592,23 @@ int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* p
       filterExecute(pFilterInfo, pBlock, pRet != NULL ? pRet : &p, NULL, param1.numOfCols, &status);
   QUERY_CHECK_CODE(code, lino, _err);
 
-  code = extractQualifiedTupleByFilterResult(pBlock, pRet != NULL ? *pRet : p, status);
+  code = applyFilterResult(pBlock, pRet != NULL ? *pRet : p, status, pColMatchInfo);
+  QUERY_CHECK_CODE(code, lino, _err);
+
+_err:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
+int32_t applyFilterResult(SSDataBlock* pBlock, const SColumnInfoData* p, int32_t status, SColMatchInfo* pColMatchInfo) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+
+  code = extractQualifiedTupleByFilterResult(pBlock, p, status);
   QUERY_CHECK_CODE(code, lino, _err);
 
   if (pColMatchInfo != NULL) {
@@ -617,11 +633,38 @@ _err:
   if (code != TSDB_CODE_SUCCESS) {
     qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
   }
-  colDataDestroy(p);
-  taosMemoryFree(p);
   return code;
 }
 
+// Return true if the filter columns of the next block should be loaded and filtered ahead of the other columns.
+bool lateMaterializeBlock(SLateMaterializeInfo* pInfo) {
+  if (pInfo->pausedBlocks > 0) {
+    pInfo->pausedBlocks -= 1;
+    return false;
+  }
+  return true;
+}
+
+// Record the result of a probed block, return true if the late materialization is paused from now on.
+bool updateLateMaterialize(SLateMaterializeInfo* pInfo, bool filterOut) {
+  pInfo->numOfProbed += 1;
+  if (filterOut) {
+    pInfo->numOfSkipped += 1;
+  }
+
+  if (pInfo->numOfProbed < LATE_MATERIALIZE_PROBE_BLOCKS) {
+    return false;
+  }
+
+  bool paused = (pInfo->numOfSkipped * 100 < pInfo->numOfProbed * LATE_MATERIALIZE_MIN_SKIP_PERCENT);
+  if (paused) {
+    pInfo->pausedBlocks = LATE_MATERIALIZE_PAUSE_BLOCKS;
+  }
+  pInfo->numOfProbed = 0;
+  pInfo->numOfSkipped = 0;
+  return paused;
+}
+
 int32_t extractQualifiedTupleByFilterResult(SSDataBlock* pBlock, const SColumnInfoData* p, int32_t status) {
   int32_t code = TSDB_CODE_SUCCESS;
   int8_t* pIndicator = (int8_t*)p->pData;
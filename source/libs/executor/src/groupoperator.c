@@ -30,17 +30,73 @@
 #include "thash.h"
 #include "ttypes.h"
 
+#define GROUP_BATCH_MIN_ROWS     64                 // small blocks are cheap enough on the row path
+#define GROUP_BATCH_MAX_AVG_RUN  4                  // use the batch path when rows of a group rarely stay adjacent
+#define GROUP_BATCH_MAX_KEY_BUF  (16 * 1024 * 1024)  // upper bound of the serialized keys of one block
+
+typedef struct SGroupBatchBuf {
+  int32_t   capacity;     // max rows the buffers can hold
+  int32_t   tableSize;    // allocated slots of pTable, power of 2
+  char*     pKeys;        // serialized group key of each row, groupKeyLen bytes per row
+  int32_t*  pKeyLen;      // length of each serialized key
+  uint32_t* pHash;        // hash value of each key
+  int32_t*  pRowGroup;    // group index in the block of each row
+  int32_t*  pIndex;       // row permutation that puts the rows of each group together
+  int32_t*  pGroupRow;    // first row of each group
+  int32_t*  pGroupStart;  // start position of each group in pIndex
+  int32_t*  pGroupCount;  // rows of each group
+  int32_t*  pTable;       // open addressing table of group indexes, -1 for empty slot
+} SGroupBatchBuf;
+
+#define GROUP_SPILL_PART_BITS      4  // each spill level fans out the new groups into 16 partitions
+#define GROUP_SPILL_PARTS          (1 << GROUP_SPILL_PART_BITS)
+#define GROUP_SPILL_MAX_LEVEL      (32 / GROUP_SPILL_PART_BITS)  // bits of the key hash are used up beyond it
+#define GROUP_SPILL_STAGE_ROWS     4096
+#define GROUP_SPILL_PAGE_SIZE      (256 * 1024)
+#define GROUP_SPILL_BUF_PAGES      32
+#define GROUP_SPILL_DEFAULT_BUDGET (1024 * 1024 * 1024L)
+#define GROUP_SPILL_MAX_GROUPS     (MAX_INTERVAL_TIME_WINDOW / 2)
+
+typedef struct SGroupSpillPage {
+  int32_t  pageId;
+  uint64_t groupId;
+} SGroupSpillPage;
+
+typedef struct SGroupSpillPart {
+  int32_t      level;   // rows are routed to the partition by the bits of the key hash at (level - 1)
+  int64_t      rows;
+  SArray*      pPages;  // SArray<SGroupSpillPage>
+  SSDataBlock* pStage;  // rows not written into pages yet
+} SGroupSpillPart;
+
+typedef struct SGroupSpillInfo {
+  int64_t          budget;     // memory allowed for the in memory groups
+  int32_t          level;      // spill level of the input being aggregated, 0 for the rows from downstream
+  bool             spilling;   // rows of new groups go to pCurParts instead of the hash table
+  bool             maxLevelWarned;
+  SDiskbasedBuf*   pBuf;       // pages of all partitions
+  SArray*          pParts;     // SArray<SGroupSpillPart*>, aggregated one by one after the in memory groups
+  int32_t          partIndex;  // next partition to aggregate
+  SGroupSpillPart* pCurParts[GROUP_SPILL_PARTS];
+  SSDataBlock*     pLoadBlock;
+  int64_t          spillRows;
+} SGroupSpillInfo;
+
 typedef struct SGroupbyOperatorInfo {
-  SOptrBasicInfo binfo;
-  SAggSupporter  aggSup;
-  SArray*        pGroupCols;     // group by columns, SArray<SColumn>
-  SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
-  bool           isInit;         // denote if current val is initialized or not
-  char*          keyBuf;         // group by keys for hash
-  int32_t        groupKeyLen;    // total group by column width
-  SGroupResInfo  groupResInfo;
-  SExprSupp      scalarSup;
-  SOperatorInfo* pOperator;
+  SOptrBasicInfo  binfo;
+  SAggSupporter   aggSup;
+  SArray*         pGroupCols;     // group by columns, SArray<SColumn>
+  SArray*         pGroupColVals;  // current group column values, SArray<SGroupKeys>
+  bool            isInit;         // denote if current val is initialized or not
+  char*           keyBuf;         // group by keys for hash
+  int32_t         groupKeyLen;    // total group by column width
+  SGroupResInfo   groupResInfo;
+  SExprSupp       scalarSup;
+  SOperatorInfo*  pOperator;
+  bool            batchKey;  // group keys can be serialized column by column, json and blob keys can not
+  bool            useBatch;  // rows of recent blocks are scattered over groups, aggregate with doHashGroupbyAggBatch
+  SGroupBatchBuf  batchBuf;
+  SGroupSpillInfo spill;
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -76,6 +132,41 @@ static void freeGroupKey(void* param) {
   taosMemoryFree(pKey->pData);
 }
 
+static void destroyGroupBatchBuf(SGroupBatchBuf* pBuf) {
+  taosMemoryFreeClear(pBuf->pKeys);
+  taosMemoryFreeClear(pBuf->pKeyLen);
+  taosMemoryFreeClear(pBuf->pHash);
+  taosMemoryFreeClear(pBuf->pRowGroup);
+  taosMemoryFreeClear(pBuf->pIndex);
+  taosMemoryFreeClear(pBuf->pGroupRow);
+  taosMemoryFreeClear(pBuf->pGroupStart);
+  taosMemoryFreeClear(pBuf->pGroupCount);
+  taosMemoryFreeClear(pBuf->pTable);
+  pBuf->capacity = 0;
+  pBuf->tableSize = 0;
+}
+
+static void destroyGroupSpillPart(void* param) {
+  SGroupSpillPart* pPart = *(SGroupSpillPart**)param;
+  if (pPart == NULL) {
+    return;
+  }
+
+  taosArrayDestroy(pPart->pPages);
+  blockDataDestroy(pPart->pStage);
+  taosMemoryFree(pPart);
+}
+
+static void destroyGroupSpillInfo(SGroupSpillInfo* pSpill) {
+  taosArrayDestroyEx(pSpill->pParts, destroyGroupSpillPart);
+  destroyDiskbasedBuf(pSpill->pBuf);
+  blockDataDestroy(pSpill->pLoadBlock);
+
+  int64_t budget = pSpill->budget;
+  memset(pSpill, 0, sizeof(SGroupSpillInfo));
+  pSpill->budget = budget;
+}
+
 static void destroyGroupOperatorInfo(void* param) {
   if (param == NULL) {
     return;
@@ -86,6 +177,8 @@ static void destroyGroupOperatorInfo(void* param) {
   taosMemoryFreeClear(pInfo->keyBuf);
   taosArrayDestroy(pInfo->pGroupCols);
   taosArrayDestroyEx(pInfo->pGroupColVals, freeGroupKey);
+  destroyGroupBatchBuf(&pInfo->batchBuf);
+  destroyGroupSpillInfo(&pInfo->spill);
   cleanupExprSupp(&pInfo->scalarSup);
 
   if (pInfo->pOperator != NULL) {
@@ -308,6 +401,238 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+static int32_t ensureGroupBatchBuf(SGroupBatchBuf* pBuf, int32_t rows, int32_t keyLen) {
+  if (rows <= pBuf->capacity) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  destroyGroupBatchBuf(pBuf);
+
+  int32_t tableSize = 1;
+  while (tableSize < rows * 2) {
+    tableSize <<= 1;
+  }
+
+  pBuf->pKeys = taosMemoryMalloc((int64_t)rows * keyLen);
+  pBuf->pKeyLen = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBuf->pHash = taosMemoryMalloc(rows * sizeof(uint32_t));
+  pBuf->pRowGroup = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBuf->pIndex = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBuf->pGroupRow = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBuf->pGroupStart = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBuf->pGroupCount = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBuf->pTable = taosMemoryMalloc(tableSize * sizeof(int32_t));
+  if (pBuf->pKeys == NULL || pBuf->pKeyLen == NULL || pBuf->pHash == NULL || pBuf->pRowGroup == NULL ||
+      pBuf->pIndex == NULL || pBuf->pGroupRow == NULL || pBuf->pGroupStart == NULL || pBuf->pGroupCount == NULL ||
+      pBuf->pTable == NULL) {
+    int32_t code = terrno;
+    destroyGroupBatchBuf(pBuf);
+    return code;
+  }
+
+  pBuf->capacity = rows;
+  pBuf->tableSize = tableSize;
+  return TSDB_CODE_SUCCESS;
+}
+
+// the block can be rearranged by blockDataReorder only if the payload of every column is loaded, and no sma describes
+// all of its rows
+static bool isBlockReorderable(const SSDataBlock* pBlock) {
+  if (!pBlock->info.dataLoad || pBlock->pBlockAgg != NULL) {
+    return false;
+  }
+
+  size_t numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, i);
+    if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
+      if (pColInfoData->varmeta.offset == NULL) {
+        return false;
+      }
+    } else if (pColInfoData->pData == NULL || pColInfoData->nullbitmap == NULL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// serialize the group keys of all rows column by column, the layout is the same as buildGroupKeys
+static void buildBatchGroupKeys(SGroupbyOperatorInfo* pInfo, SSDataBlock* pBlock) {
+  SGroupBatchBuf* pBuf = &pInfo->batchBuf;
+  int32_t         rows = pBlock->info.rows;
+  int32_t         numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
+  int32_t         stride = pInfo->groupKeyLen;
+
+  for (int32_t j = 0; j < rows; ++j) {
+    pBuf->pKeyLen[j] = sizeof(int8_t) * numOfGroupCols;
+  }
+
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn*         pCol = taosArrayGet(pInfo->pGroupCols, i);
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+    SColumnDataAgg*  pColAgg = (pBlock->pBlockAgg != NULL) ? &pBlock->pBlockAgg[pCol->slotId] : NULL;
+    char*            pKey = pBuf->pKeys;
+
+    if (IS_VAR_DATA_TYPE(pCol->type)) {
+      for (int32_t j = 0; j < rows; ++j, pKey += stride) {
+        if (colDataIsNull(pColInfoData, rows, j, pColAgg)) {
+          pKey[i] = 1;
+          continue;
+        }
+
+        char* val = colDataGetVarData(pColInfoData, j);
+        pKey[i] = 0;
+        varDataCopy(pKey + pBuf->pKeyLen[j], val);
+        pBuf->pKeyLen[j] += varDataTLen(val);
+      }
+    } else {
+      int32_t bytes = pCol->bytes;
+      for (int32_t j = 0; j < rows; ++j, pKey += stride) {
+        if (colDataIsNull(pColInfoData, rows, j, pColAgg)) {
+          pKey[i] = 1;
+          continue;
+        }
+
+        pKey[i] = 0;
+        memcpy(pKey + pBuf->pKeyLen[j], colDataGetNumData(pColInfoData, j), bytes);
+        pBuf->pKeyLen[j] += bytes;
+      }
+    }
+  }
+}
+
+// hash all keys at first, then probe the block local table to assign each row a group index in the order of the
+// first appearance of each group. Return the number of runs of adjacent rows that belong to the same group.
+static int32_t assignBatchGroups(SGroupBatchBuf* pBuf, int32_t rows, int32_t stride, int32_t* pNumOfGroups) {
+  _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
+  for (int32_t j = 0; j < rows; ++j) {
+    pBuf->pHash[j] = hashFn(pBuf->pKeys + (int64_t)j * stride, pBuf->pKeyLen[j]);
+  }
+
+  int32_t tableSize = 1;
+  while (tableSize < rows * 2) {
+    tableSize <<= 1;
+  }
+
+  uint32_t mask = tableSize - 1;
+  memset(pBuf->pTable, 0xFF, tableSize * sizeof(int32_t));
+
+  int32_t numOfGroups = 0;
+  int32_t runs = 0;
+  for (int32_t j = 0; j < rows; ++j) {
+    char*    pKey = pBuf->pKeys + (int64_t)j * stride;
+    uint32_t slot = pBuf->pHash[j] & mask;
+    int32_t  g = -1;
+
+    while (1) {
+      g = pBuf->pTable[slot];
+      if (g < 0) {
+        g = numOfGroups++;
+        pBuf->pTable[slot] = g;
+        pBuf->pGroupRow[g] = j;
+        pBuf->pGroupCount[g] = 0;
+        break;
+      }
+
+      int32_t r = pBuf->pGroupRow[g];
+      if (pBuf->pHash[r] == pBuf->pHash[j] && pBuf->pKeyLen[r] == pBuf->pKeyLen[j] &&
+          memcmp(pBuf->pKeys + (int64_t)r * stride, pKey, pBuf->pKeyLen[j]) == 0) {
+        break;
+      }
+
+      slot = (slot + 1) & mask;
+    }
+
+    if (j == 0 || pBuf->pRowGroup[j - 1] != g) {
+      runs += 1;
+    }
+
+    pBuf->pRowGroup[j] = g;
+    pBuf->pGroupCount[g] += 1;
+  }
+
+  // counting sort, rows of one group keep their original order
+  int32_t start = 0;
+  for (int32_t g = 0; g < numOfGroups; ++g) {
+    pBuf->pGroupStart[g] = start;
+    start += pBuf->pGroupCount[g];
+    pBuf->pGroupCount[g] = 0;
+  }
+
+  for (int32_t j = 0; j < rows; ++j) {
+    int32_t g = pBuf->pRowGroup[j];
+    pBuf->pIndex[pBuf->pGroupStart[g] + pBuf->pGroupCount[g]] = j;
+    pBuf->pGroupCount[g] += 1;
+  }
+
+  *pNumOfGroups = numOfGroups;
+  return runs;
+}
+
+static void updateGroupBatchMode(SGroupbyOperatorInfo* pInfo, int32_t rows, int32_t runs) {
+  if (!pInfo->batchKey || rows < GROUP_BATCH_MIN_ROWS) {
+    return;
+  }
+
+  pInfo->useBatch = ((int64_t)runs * GROUP_BATCH_MAX_AVG_RUN > rows);
+}
+
+/*
+ * The row path sets the output buffer and invokes the aggregate functions for every run of adjacent rows with the
+ * same key, which degenerates to one hash probe and one function call per row for high cardinality keys that are not
+ * clustered. Here the keys of the whole block are serialized and hashed column by column, the rows are grouped with
+ * a block local table and rearranged so that rows of each group are adjacent, then each group is aggregated once.
+ */
+static void doHashGroupbyAggBatch(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupBatchBuf*       pBuf = &pInfo->batchBuf;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+  int32_t               rows = pBlock->info.rows;
+  int32_t               stride = pInfo->groupKeyLen;
+  int32_t               numOfGroups = 0;
+
+  int32_t code = ensureGroupBatchBuf(pBuf, rows, stride);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  buildBatchGroupKeys(pInfo, pBlock);
+  int32_t runs = assignBatchGroups(pBuf, rows, stride, &numOfGroups);
+
+  // rows of each group are already adjacent, the permutation is the identity
+  if (runs > numOfGroups) {
+    code = blockDataReorder(pBlock, pBuf->pIndex);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+  }
+
+  for (int32_t g = 0; g < numOfGroups; ++g) {
+    int32_t row = pBuf->pGroupRow[g];
+    code = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs,
+                                   pBuf->pKeys + (int64_t)row * stride, pBuf->pKeyLen[row], pBlock->info.id.groupId,
+                                   pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    int32_t rowIndex = pBuf->pGroupStart[g];
+    code = applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, pBuf->pGroupCount[g], rows,
+                                           pOperator->exprSupp.numOfExprs);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, rows, rowIndex);
+  }
+
+  // the row path starts from a new group key for the next block
+  pInfo->isInit = false;
+  updateGroupBatchMode(pInfo, rows, runs);
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
@@ -319,10 +644,17 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   //    return;
   //  }
 
+  if (pInfo->useBatch && pBlock->info.rows >= GROUP_BATCH_MIN_ROWS &&
+      (int64_t)pBlock->info.rows * pInfo->groupKeyLen <= GROUP_BATCH_MAX_KEY_BUF && isBlockReorderable(pBlock)) {
+    doHashGroupbyAggBatch(pOperator, pBlock);
+    return;
+  }
+
   int32_t len = 0;
   terrno = TSDB_CODE_SUCCESS;
 
   int32_t num = 0;
+  int32_t runs = 0;
   for (int32_t j = 0; j < pBlock->info.rows; ++j) {
     // Compare with the previous row of this column, and do not set the output buffer again if they are identical.
     if (!pInfo->isInit) {
@@ -369,6 +701,7 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
     doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
     recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, j);
     num = 1;
+    runs += 1;
   }
 
   if (num > 0) {
@@ -386,7 +719,467 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
       T_LONG_JMP(pTaskInfo->env, ret);
     }
     doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+    runs += 1;
+  }
+
+  updateGroupBatchMode(pInfo, pBlock->info.rows, runs);
+}
+
+// in memory groups may take half of the per query quota of the memory pool, the rest is left to the other operators
+static int64_t getGroupSpillBudget() {
+  if (tsGroupSpillMemThreshold > 0) {
+    return (int64_t)tsGroupSpillMemThreshold * 1024;
+  }
+  if (tsQueryUseMemoryPool && tsSingleQueryMaxMemorySize > 0) {
+    return (int64_t)tsSingleQueryMaxMemorySize * 1048576 / 2;
+  }
+
+  return GROUP_SPILL_DEFAULT_BUDGET;
+}
+
+static bool groupMemExceedBudget(SGroupbyOperatorInfo* pInfo) {
+  SAggSupporter* pSup = &pInfo->aggSup;
+  int64_t        size = tSimpleHashGetMemSize(pSup->pResultRowHashTable) + getTotalBufSize(pSup->pResultBuf);
+  return size > pInfo->spill.budget || tSimpleHashGetSize(pSup->pResultRowHashTable) > GROUP_SPILL_MAX_GROUPS;
+}
+
+// the key is composed in the same way as doSetResultOutBufByKey
+static bool groupResultRowExists(SGroupbyOperatorInfo* pInfo, char* pKey, int32_t len, uint64_t groupId) {
+  SAggSupporter* pSup = &pInfo->aggSup;
+  SET_RES_WINDOW_KEY(pSup->keyBuf, pKey, len, groupId);
+  *(uint64_t*)pSup->keyBuf = calcGroupId(pSup->keyBuf, GET_RES_WINDOW_KEY_LEN(len));
+  return tSimpleHashGet(pSup->pResultRowHashTable, pSup->keyBuf, GET_RES_WINDOW_KEY_LEN(len)) != NULL;
+}
+
+static void buildBlockGroupKeys(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupBatchBuf*       pBuf = &pInfo->batchBuf;
+
+  if (pInfo->batchKey) {
+    buildBatchGroupKeys(pInfo, pBlock);
+    return;
   }
+
+  terrno = TSDB_CODE_SUCCESS;
+  for (int32_t j = 0; j < pBlock->info.rows; ++j) {
+    recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, j);
+    if (terrno != TSDB_CODE_SUCCESS) {  // group by json error
+      T_LONG_JMP(pOperator->pTaskInfo->env, terrno);
+    }
+    pBuf->pKeyLen[j] = buildGroupKeys(pBuf->pKeys + (int64_t)j * pInfo->groupKeyLen, pInfo->pGroupColVals);
+  }
+
+  // the current group key of the row path is overwritten
+  pInfo->isInit = false;
+}
+
+static int32_t flushGroupSpillPart(SGroupSpillInfo* pSpill, SGroupSpillPart* pPart) {
+  int32_t      code = TSDB_CODE_SUCCESS;
+  int32_t      lino = 0;
+  SSDataBlock* pStage = pPart->pStage;
+  SSDataBlock* p = NULL;
+  int32_t      start = 0;
+
+  while (pStage != NULL && start < pStage->info.rows) {
+    int32_t stop = 0;
+    code = blockDataSplitRows(pStage, pStage->info.hasVarCol, start, &stop, getBufPageSize(pSpill->pBuf));
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    code = blockDataExtractBlock(pStage, start, stop - start + 1, &p);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    SGroupSpillPage page = {.pageId = -1, .groupId = pStage->info.id.groupId};
+    void*           pPage = getNewBufPage(pSpill->pBuf, &page.pageId);
+    QUERY_CHECK_NULL(pPage, code, lino, _end, terrno);
+
+    code = blockDataToBuf(pPage, p);
+    setBufPageDirty(pPage, true);
+    releaseBufPage(pSpill->pBuf, pPage);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    void* tmp = taosArrayPush(pPart->pPages, &page);
+    QUERY_CHECK_NULL(tmp, code, lino, _end, terrno);
+
+    blockDataDestroy(p);
+    p = NULL;
+    start = stop + 1;
+  }
+
+  if (pStage != NULL) {
+    blockDataCleanup(pStage);
+  }
+
+_end:
+  blockDataDestroy(p);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
+static int32_t appendGroupSpillRows(SGroupSpillInfo* pSpill, SGroupSpillPart* pPart, SSDataBlock* pBlock,
+                                    int32_t start, int32_t num) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+
+  if (pPart->pStage == NULL) {
+    code = createOneDataBlock(pBlock, false, &pPart->pStage);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  // the group id is a part of the group key, rows of different group ids never share a page
+  SSDataBlock* pStage = pPart->pStage;
+  if (pStage->info.rows > 0 && pStage->info.id.groupId != pBlock->info.id.groupId) {
+    code = flushGroupSpillPart(pSpill, pPart);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  code = blockDataEnsureCapacity(pStage, pStage->info.rows + num);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  code = blockDataMergeNRows(pStage, pBlock, start, num);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  pStage->info.id.groupId = pBlock->info.id.groupId;
+  pPart->rows += num;
+  pSpill->spillRows += num;
+
+  if (pStage->info.rows >= GROUP_SPILL_STAGE_ROWS) {
+    code = flushGroupSpillPart(pSpill, pPart);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
+static int32_t startGroupSpill(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  int32_t               code = TSDB_CODE_SUCCESS;
+  int32_t               lino = 0;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupSpillInfo*      pSpill = &pInfo->spill;
+  SGroupSpillPart*      pPart = NULL;
+
+  if (pSpill->pBuf == NULL) {
+    if (!osTempSpaceAvailable()) {
+      code = TSDB_CODE_NO_DISKSPACE;
+      qError("%s group by spill failed since %s, tempDir:%s", GET_TASKID(pOperator->pTaskInfo), tstrerror(code),
+             tsTempDir);
+      return code;
+    }
+
+    int32_t numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+    int32_t pageSize = blockDataGetRowSize(pBlock) * 4 + blockDataGetSerialMetaSize(numOfCols);
+    pageSize = TMAX(pageSize, GROUP_SPILL_PAGE_SIZE);
+
+    code = createDiskbasedBuf(&pSpill->pBuf, pageSize, (int64_t)pageSize * GROUP_SPILL_BUF_PAGES, "groupSpillBuf",
+                              tsTempDir);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    pSpill->pParts = taosArrayInit(GROUP_SPILL_PARTS, POINTER_BYTES);
+    QUERY_CHECK_NULL(pSpill->pParts, code, lino, _end, terrno);
+
+    code = createOneDataBlock(pBlock, false, &pSpill->pLoadBlock);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  for (int32_t i = 0; i < GROUP_SPILL_PARTS; ++i) {
+    pPart = taosMemoryCalloc(1, sizeof(SGroupSpillPart));
+    QUERY_CHECK_NULL(pPart, code, lino, _end, terrno);
+
+    pPart->level = pSpill->level + 1;
+    pPart->pPages = taosArrayInit(4, sizeof(SGroupSpillPage));
+    QUERY_CHECK_NULL(pPart->pPages, code, lino, _end, terrno);
+
+    void* tmp = taosArrayPush(pSpill->pParts, &pPart);
+    QUERY_CHECK_NULL(tmp, code, lino, _end, terrno);
+
+    pSpill->pCurParts[i] = pPart;
+    pPart = NULL;
+  }
+
+  // blocks with sma only or not loaded can not be moved into the partitions, the scan loads all blocks from now on
+  if (pSpill->level == 0) {
+    setTableScanLoadData(pOperator->pDownstream[0]);
+  }
+
+  pSpill->spilling = true;
+  qDebug("%s group by uses %" PRId64 " bytes for %d groups, exceeds the budget:%" PRId64
+         ", spill new groups into %d partitions, level:%d",
+         GET_TASKID(pOperator->pTaskInfo),
+         (int64_t)(tSimpleHashGetMemSize(pInfo->aggSup.pResultRowHashTable) + getTotalBufSize(pInfo->aggSup.pResultBuf)),
+         tSimpleHashGetSize(pInfo->aggSup.pResultRowHashTable), pSpill->budget, GROUP_SPILL_PARTS, pSpill->level + 1);
+
+_end:
+  if (pPart != NULL) {
+    destroyGroupSpillPart(&pPart);
+  }
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
+static int32_t finishGroupSpill(SGroupSpillInfo* pSpill) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < GROUP_SPILL_PARTS; ++i) {
+    SGroupSpillPart* pPart = pSpill->pCurParts[i];
+    if (pPart == NULL) {
+      continue;
+    }
+
+    code = flushGroupSpillPart(pSpill, pPart);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    blockDataDestroy(pPart->pStage);
+    pPart->pStage = NULL;
+    pSpill->pCurParts[i] = NULL;
+  }
+
+  pSpill->spilling = false;
+  return code;
+}
+
+/*
+ * Rows of the groups already in memory are aggregated as usual, the rows of the new groups are moved into the
+ * partitions chosen by the hash value of their group keys. The block is rearranged so that the rows staying in memory
+ * come first, followed by the rows of each partition.
+ */
+static void spillNewGroupRows(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupSpillInfo*      pSpill = &pInfo->spill;
+  SGroupBatchBuf*       pBuf = &pInfo->batchBuf;
+  int32_t               rows = pBlock->info.rows;
+  int32_t               stride = pInfo->groupKeyLen;
+  int32_t               shift = pSpill->level * GROUP_SPILL_PART_BITS;
+  int32_t               counts[GROUP_SPILL_PARTS] = {0};
+  int32_t               starts[GROUP_SPILL_PARTS] = {0};
+  int32_t               numOfMem = 0;
+  _hash_fn_t            hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
+
+  int32_t code = ensureGroupBatchBuf(pBuf, rows, stride);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  buildBlockGroupKeys(pOperator, pBlock);
+
+  for (int32_t j = 0; j < rows; ++j) {
+    char* pKey = pBuf->pKeys + (int64_t)j * stride;
+    if (groupResultRowExists(pInfo, pKey, pBuf->pKeyLen[j], pBlock->info.id.groupId)) {
+      pBuf->pRowGroup[j] = -1;
+      numOfMem += 1;
+      continue;
+    }
+
+    int32_t p = (hashFn(pKey, pBuf->pKeyLen[j]) >> shift) & (GROUP_SPILL_PARTS - 1);
+    pBuf->pRowGroup[j] = p;
+    counts[p] += 1;
+  }
+
+  if (numOfMem == rows) {
+    return;
+  }
+
+  int32_t start = numOfMem;
+  for (int32_t p = 0; p < GROUP_SPILL_PARTS; ++p) {
+    starts[p] = start;
+    start += counts[p];
+  }
+
+  int32_t memPos = 0;
+  for (int32_t j = 0; j < rows; ++j) {
+    int32_t p = pBuf->pRowGroup[j];
+    pBuf->pIndex[(p < 0) ? memPos++ : starts[p]++] = j;
+  }
+
+  code = blockDataReorder(pBlock, pBuf->pIndex);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  start = numOfMem;
+  for (int32_t p = 0; p < GROUP_SPILL_PARTS; ++p) {
+    if (counts[p] == 0) {
+      continue;
+    }
+
+    code = appendGroupSpillRows(pSpill, pSpill->pCurParts[p], pBlock, start, counts[p]);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+    start += counts[p];
+  }
+
+  blockDataKeepFirstNRows(pBlock, numOfMem);
+  code = setInputDataBlock(&pOperator->exprSupp, pBlock, pInfo->binfo.inputTsOrder, pBlock->info.scanFlag, true);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+}
+
+// the group of the first row, which is the group of all rows if the block carries sma or is not loaded
+static bool isBlockGroupInMemory(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+
+  terrno = TSDB_CODE_SUCCESS;
+  recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, 0);
+  if (terrno != TSDB_CODE_SUCCESS) {  // group by json error
+    T_LONG_JMP(pOperator->pTaskInfo->env, terrno);
+  }
+  int32_t len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
+
+  // the current group key of the row path is overwritten
+  pInfo->isInit = false;
+  return groupResultRowExists(pInfo, pInfo->keyBuf, len, pBlock->info.id.groupId);
+}
+
+static void doHashGroupbyAggWithSpill(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupSpillInfo*      pSpill = &pInfo->spill;
+  int32_t               code = TSDB_CODE_SUCCESS;
+
+  // a block loaded by the scan after spilling started may still carry the sma, its rows are moved with the data
+  if (pSpill->spilling && pBlock->pBlockAgg != NULL && pBlock->info.dataLoad) {
+    taosMemoryFreeClear(pBlock->pBlockAgg);
+    code = setInputDataBlock(&pOperator->exprSupp, pBlock, pInfo->binfo.inputTsOrder, pBlock->info.scanFlag, true);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+  }
+
+  if (pSpill->spilling) {
+    if (isBlockReorderable(pBlock)) {
+      spillNewGroupRows(pOperator, pBlock);
+    } else if (!isBlockGroupInMemory(pOperator, pBlock)) {
+      // the scan has been asked to load all blocks, rows of the group may be in the partitions already
+      qError("%s group by got a block not loaded while spilling, rows:%" PRId64, GET_TASKID(pTaskInfo),
+             pBlock->info.rows);
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR);
+    }
+  }
+
+  if (pBlock->info.rows > 0) {
+    doHashGroupbyAgg(pOperator, pBlock);
+  }
+
+  if (pSpill->spilling || !groupMemExceedBudget(pInfo)) {
+    return;
+  }
+
+  if (pSpill->level >= GROUP_SPILL_MAX_LEVEL) {
+    if (!pSpill->maxLevelWarned) {
+      pSpill->maxLevelWarned = true;
+      qWarn("%s group by spill level:%d reaches the limit, keep the groups in memory", GET_TASKID(pTaskInfo),
+            pSpill->level);
+    }
+    return;
+  }
+
+  code = startGroupSpill(pOperator, pBlock);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+}
+
+static void clearGroupResultRows(SOperatorInfo* pOperator) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+
+  tSimpleHashClear(pInfo->aggSup.pResultRowHashTable);
+  clearDiskbasedBuf(pInfo->aggSup.pResultBuf);
+  pInfo->aggSup.currentPageId = -1;
+  initResultRowInfo(&pInfo->binfo.resultRowInfo);
+
+  pInfo->groupResInfo.index = 0;
+  pInfo->groupResInfo.iter = 0;
+  pInfo->groupResInfo.dataPos = NULL;
+  pInfo->isInit = false;
+}
+
+/*
+ * Aggregate the next spilled partition once the results of the current groups are all returned. Partitions are
+ * aggregated with the same memory budget, and spill again into the next level if they are still too large.
+ * Return false if there is no partition left.
+ */
+static bool aggregateNextSpillPart(SOperatorInfo* pOperator) {
+  int32_t               code = TSDB_CODE_SUCCESS;
+  int32_t               lino = 0;
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupSpillInfo*      pSpill = &pInfo->spill;
+  SGroupSpillPart*      pPart = NULL;
+
+  if (pSpill->pParts == NULL) {
+    return false;
+  }
+
+  if (pSpill->spilling) {
+    code = finishGroupSpill(pSpill);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  // skip the empty partitions
+  while (pSpill->partIndex < taosArrayGetSize(pSpill->pParts)) {
+    SGroupSpillPart** ppPart = taosArrayGet(pSpill->pParts, pSpill->partIndex++);
+    if ((*ppPart)->rows > 0) {
+      pPart = *ppPart;
+      *ppPart = NULL;
+      break;
+    }
+  }
+
+  if (pPart == NULL) {
+    return false;
+  }
+
+  clearGroupResultRows(pOperator);
+  pSpill->level = pPart->level;
+
+  qDebug("%s group by aggregates spilled partition, level:%d, rows:%" PRId64 ", pages:%d", GET_TASKID(pTaskInfo),
+         pPart->level, pPart->rows, (int32_t)taosArrayGetSize(pPart->pPages));
+
+  SSDataBlock* pBlock = pSpill->pLoadBlock;
+  for (int32_t i = 0; i < taosArrayGetSize(pPart->pPages); ++i) {
+    SGroupSpillPage* pPage = taosArrayGet(pPart->pPages, i);
+    void*            page = getBufPage(pSpill->pBuf, pPage->pageId);
+    QUERY_CHECK_NULL(page, code, lino, _end, terrno);
+
+    blockDataCleanup(pBlock);
+    code = blockDataFromBuf(pBlock, page);
+    int32_t ret = dBufSetBufPageRecycled(pSpill->pBuf, page);
+    QUERY_CHECK_CODE(code, lino, _end);
+    QUERY_CHECK_CODE(ret, lino, _end);
+
+    pBlock->info.id.groupId = pPage->groupId;
+    pBlock->info.dataLoad = 1;
+    pBlock->info.scanFlag = pInfo->binfo.pRes->info.scanFlag;
+    code = setInputDataBlock(&pOperator->exprSupp, pBlock, pInfo->binfo.inputTsOrder, pBlock->info.scanFlag, true);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    doHashGroupbyAggWithSpill(pOperator, pBlock);
+  }
+
+  if (pSpill->spilling) {
+    code = finishGroupSpill(pSpill);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+_end:
+  if (pPart != NULL) {
+    destroyGroupSpillPart(&pPart);
+  }
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+  return true;
 }
 
 bool hasRemainResultByHash(SOperatorInfo* pOperator) {
@@ -445,6 +1238,13 @@ static SSDataBlock* buildGroupResultDataBlockByHash(SOperatorInfo* pOperator) {
     QUERY_CHECK_CODE(code, lino, _end);
 
     if (!hasRemainResultByHash(pOperator)) {
+      if (aggregateNextSpillPart(pOperator)) {
+        if (pRes->info.rows > 0) {
+          break;
+        }
+        continue;
+      }
+
       setOperatorCompleted(pOperator);
       // clean hash after completed
       tSimpleHashCleanup(pInfo->aggSup.pResultRowHashTable);
@@ -504,7 +1304,7 @@ static int32_t hashGroupbyAggregateNext(SOperatorInfo* pOperator, SSDataBlock**
       QUERY_CHECK_CODE(code, lino, _end);
     }
 
-    doHashGroupbyAgg(pOperator, pBlock);
+    doHashGroupbyAggWithSpill(pOperator, pBlock);
   }
 
   pOperator->status = OP_RES_TO_RETURN;
@@ -560,6 +1360,8 @@ static int32_t resetGroupOperState(SOperatorInfo* pOper) {
   }
 
   pInfo->isInit = false;
+  pInfo->useBatch = false;
+  destroyGroupSpillInfo(&pInfo->spill);
 
   return code;
 }
@@ -608,6 +1410,16 @@ int32_t createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNo
   code = initGroupOptrInfo(&pInfo->pGroupColVals, &pInfo->groupKeyLen, &pInfo->keyBuf, pInfo->pGroupCols);
   QUERY_CHECK_CODE(code, lino, _error);
 
+  pInfo->spill.budget = getGroupSpillBudget();
+  pInfo->batchKey = true;
+  for (int32_t i = 0; i < taosArrayGetSize(pInfo->pGroupCols); ++i) {
+    SColumn* pCol = taosArrayGet(pInfo->pGroupCols, i);
+    if (pCol->type == TSDB_DATA_TYPE_JSON || IS_STR_DATA_BLOB(pCol->type)) {
+      pInfo->batchKey = false;
+      break;
+    }
+  }
+
   int32_t    num = 0;
   SExprInfo* pExprInfo = NULL;
 
@@ -337,6 +337,43 @@ static bool isDynVtbScan(SOperatorInfo* pOperator) {
   return pOperator->dynamicTask && ((STableScanInfo*)(pOperator->info))->virtualStableScan;
 }
 
+// Load the columns referenced by the filter only, and evaluate the filter on them. The other columns of the block are
+// loaded afterwards only if any rows are qualified.
+static int32_t doLateMaterializeFilter(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
+                                       SColumnInfoData** pFilterRes, int32_t* pFilterStatus, bool* pFilterOut) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  int32_t        lino = 0;
+  SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
+  SStorageAPI*   pAPI = &pTaskInfo->storageAPI;
+  SSDataBlock*   p = NULL;
+
+  *pFilterOut = false;
+  code = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, &p, pTableScanInfo->pFilterColIds);
+  QUERY_CHECK_CODE(code, lino, _end);
+  if (p == NULL || p != pBlock || pBlock->info.rows == 0) {
+    goto _end;
+  }
+
+  SFilterColumnParam param = {.numOfCols = taosArrayGetSize(pBlock->pDataBlock), .pDataBlock = pBlock->pDataBlock};
+  code = filterSetDataFromSlotId(pOperator->exprSupp.pFilterInfo, &param);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  code = filterExecute(pOperator->exprSupp.pFilterInfo, pBlock, pFilterRes, NULL, param.numOfCols, pFilterStatus);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  *pFilterOut = (*pFilterStatus == FILTER_RESULT_NONE_QUALIFIED);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS || *pFilterOut) {
+    colDataDestroy(*pFilterRes);
+    taosMemoryFreeClear(*pFilterRes);
+  }
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
                              uint32_t* status) {
   int32_t        code = TSDB_CODE_SUCCESS;
@@ -445,6 +482,28 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     }
   }
 
+  // try to filter data block according to the bloom filters of columns
+  if (pTableScanInfo->pBloomProbes != NULL) {
+    bool keep = true;
+    code = pAPI->tsdReader.tsdReaderCheckBlockBloomFilter(pTableScanInfo->dataReader, pTableScanInfo->pBloomProbes,
+                                                          &keep);
+    if (code) {
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      QUERY_CHECK_CODE(code, lino, _end);
+    }
+
+    if (!keep) {
+      qDebug("%s data block filter out by bloom filter, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+      pCost->filterOutBlocks += 1;
+      (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+      taosMemoryFreeClear(pBlock->pBlockAgg);
+
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
   // free the sma info, since it should not be involved in *later computing process.
   taosMemoryFreeClear(pBlock->pBlockAgg);
 
@@ -473,9 +532,36 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalCheckedRows += pBlock->info.rows;
   pCost->loadBlocks += 1;
 
-  SSDataBlock* p = NULL;
+  SSDataBlock*     p = NULL;
+  SColumnInfoData* pFilterRes = NULL;
+  int32_t          filterStatus = FILTER_RESULT_ALL_QUALIFIED;
+  if (pTableScanInfo->pFilterColIds != NULL && lateMaterializeBlock(&pTableScanInfo->lateMaterialize)) {
+    bool filterOut = false;
+    code = doLateMaterializeFilter(pOperator, pTableScanInfo, pBlock, &pFilterRes, &filterStatus, &filterOut);
+    if (code) {
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      QUERY_CHECK_CODE(code, lino, _end);
+    }
+
+    if (updateLateMaterialize(&pTableScanInfo->lateMaterialize, filterOut)) {
+      qDebug("%s few blocks filtered out by filter columns, load the next %d blocks wholly", GET_TASKID(pTaskInfo),
+             LATE_MATERIALIZE_PAUSE_BLOCKS);
+    }
+
+    if (filterOut) {
+      qDebug("%s data block filter out by filter columns, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+      pCost->filterOutBlocks += 1;
+      (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
   code = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, &p, NULL);
   if (p == NULL || code != TSDB_CODE_SUCCESS || p != pBlock) {
+    colDataDestroy(pFilterRes);
+    taosMemoryFree(pFilterRes);
     return code;
   }
 
@@ -486,6 +572,8 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     // dyn vtb scan do not read tag from origin tables.
     code = doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
     if (code) {
+      colDataDestroy(pFilterRes);
+      taosMemoryFree(pFilterRes);
       return code;
     }
   }
@@ -494,7 +582,14 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalRows -= pBlock->info.rows;
 
   if (pOperator->exprSupp.pFilterInfo != NULL) {
-    code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo, NULL);
+    if (pFilterRes != NULL) {
+      // the filter has been evaluated on the same rows before the whole block is loaded
+      code = applyFilterResult(pBlock, pFilterRes, filterStatus, &pTableScanInfo->matchInfo);
+      colDataDestroy(pFilterRes);
+      taosMemoryFreeClear(pFilterRes);
+    } else {
+      code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo, NULL);
+    }
     QUERY_CHECK_CODE(code, lino, _end);
 
     int64_t st = taosGetTimestampUs();
@@ -1631,6 +1726,259 @@ static int32_t getTableScannerExecInfo(struct SOperatorInfo* pOptr, void** pOptr
   return 0;
 }
 
+static SColMatchItem* getColMatchItemBySlotId(SColMatchInfo* pMatchInfo, int32_t slotId) {
+  for (int32_t i = 0; i < taosArrayGetSize(pMatchInfo->pList); ++i) {
+    SColMatchItem* pItem = taosArrayGet(pMatchInfo->pList, i);
+    if (pItem != NULL && pItem->dstSlotId == slotId) {
+      return pItem;
+    }
+  }
+  return NULL;
+}
+
+typedef struct SFilterColCollector {
+  SColMatchInfo* pMatchInfo;
+  SArray*        pColIds;
+  bool           valid;
+} SFilterColCollector;
+
+static EDealRes collectFilterColId(SNode* pNode, void* pContext) {
+  SFilterColCollector* pCxt = pContext;
+  if (nodeType(pNode) != QUERY_NODE_COLUMN) {
+    return DEAL_RES_CONTINUE;
+  }
+
+  SColMatchItem* pItem = getColMatchItemBySlotId(pCxt->pMatchInfo, ((SColumnNode*)pNode)->slotId);
+  if (pItem == NULL) {
+    // tag or pseudo column, which is not available before the whole block is retrieved
+    pCxt->valid = false;
+    return DEAL_RES_END;
+  }
+
+  if (pItem->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+    return DEAL_RES_CONTINUE;
+  }
+
+  col_id_t colId = pItem->colId;
+  for (int32_t j = 0; j < taosArrayGetSize(pCxt->pColIds); ++j) {
+    if (*(col_id_t*)taosArrayGet(pCxt->pColIds, j) == colId) {
+      return DEAL_RES_CONTINUE;
+    }
+  }
+
+  if (taosArrayPush(pCxt->pColIds, &colId) == NULL) {
+    pCxt->valid = false;
+    return DEAL_RES_ERROR;
+  }
+  return DEAL_RES_CONTINUE;
+}
+
+// Collect the data columns referenced by the filter condition. The filter is evaluated on them ahead of loading the
+// whole block, which pays off only when the scan loads some other columns that are not involved in the filter.
+static int32_t initFilterColIds(SNode* pConditions, SColMatchInfo* pMatchInfo, SArray** ppColIds) {
+  SFilterColCollector cxt = {.pMatchInfo = pMatchInfo, .pColIds = NULL, .valid = true};
+
+  *ppColIds = NULL;
+  cxt.pColIds = taosArrayInit(4, sizeof(col_id_t));
+  if (cxt.pColIds == NULL) {
+    return terrno;
+  }
+
+  nodesWalkExpr(pConditions, collectFilterColId, &cxt);
+
+  int32_t numOfDataCols = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pMatchInfo->pList); ++i) {
+    SColMatchItem* pItem = taosArrayGet(pMatchInfo->pList, i);
+    if (pItem != NULL && pItem->colId != PRIMARYKEY_TIMESTAMP_COL_ID) {
+      numOfDataCols += 1;
+    }
+  }
+
+  if (!cxt.valid || taosArrayGetSize(cxt.pColIds) == 0 || taosArrayGetSize(cxt.pColIds) >= numOfDataCols) {
+    taosArrayDestroy(cxt.pColIds);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  *ppColIds = cxt.pColIds;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void destroyBloomProbe(void* p) { taosArrayDestroy(((SBlockBloomProbe*)p)->pHashes); }
+
+// the key is the same as the one hashed into the block bloom filter by the data file writer
+static bool getBloomProbeKey(int8_t colType, const SValueNode* pVal, int64_t* pBuf, const char** ppKey,
+                             uint32_t* pLen) {
+  int8_t type = pVal->node.resType.type;
+  if (pVal->isNull) {
+    return false;
+  }
+
+  if (colType == TSDB_DATA_TYPE_VARCHAR) {
+    if (type != TSDB_DATA_TYPE_VARCHAR || pVal->datum.p == NULL) {
+      return false;
+    }
+    *ppKey = varDataVal(pVal->datum.p);
+    *pLen = varDataLen(pVal->datum.p);
+    return true;
+  }
+
+  if (!IS_INTEGER_TYPE(colType) || !IS_INTEGER_TYPE(type)) {
+    return false;
+  }
+
+  // the value must be representable by the column type
+  bool    huge = IS_UNSIGNED_NUMERIC_TYPE(type) && pVal->datum.u > INT64_MAX;
+  int64_t v = IS_SIGNED_NUMERIC_TYPE(type) ? pVal->datum.i : (int64_t)pVal->datum.u;
+  bool    fit = false;
+  switch (colType) {
+    case TSDB_DATA_TYPE_TINYINT:
+      fit = (v >= INT8_MIN && v <= INT8_MAX);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      fit = (v >= INT16_MIN && v <= INT16_MAX);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      fit = (v >= INT32_MIN && v <= INT32_MAX);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+      fit = true;
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      fit = (v >= 0 && v <= UINT8_MAX);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      fit = (v >= 0 && v <= UINT16_MAX);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      fit = (v >= 0 && v <= UINT32_MAX);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      fit = huge || (v >= 0);
+      break;
+    default:
+      break;
+  }
+  if (huge && colType != TSDB_DATA_TYPE_UBIGINT) {
+    fit = false;
+  }
+
+  *pBuf = v;
+  *ppKey = (const char*)pBuf;
+  *pLen = tDataTypes[colType].bytes;
+  return fit;
+}
+
+static int32_t addBloomProbe(SNode* pCond, SColMatchInfo* pMatchInfo, SArray* pProbes) {
+  int32_t          code = TSDB_CODE_SUCCESS;
+  int32_t          lino = 0;
+  SOperatorNode*   pOp = (SOperatorNode*)pCond;
+  SNode*           pLeft = NULL;
+  SNode*           pRight = NULL;
+  SBlockBloomProbe probe = {0};
+
+  if (nodeType(pCond) != QUERY_NODE_OPERATOR || (pOp->opType != OP_TYPE_EQUAL && pOp->opType != OP_TYPE_IN)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pLeft = pOp->pLeft;
+  pRight = pOp->pRight;
+  if (pOp->opType == OP_TYPE_EQUAL && pRight != NULL && nodeType(pRight) == QUERY_NODE_COLUMN) {
+    TSWAP(pLeft, pRight);
+  }
+  if (pLeft == NULL || pRight == NULL || nodeType(pLeft) != QUERY_NODE_COLUMN) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnNode*   pCol = (SColumnNode*)pLeft;
+  SColMatchItem* pItem = getColMatchItemBySlotId(pMatchInfo, pCol->slotId);
+  int8_t         colType = pCol->node.resType.type;
+  if (pItem == NULL || pItem->colId == PRIMARYKEY_TIMESTAMP_COL_ID ||
+      (!IS_INTEGER_TYPE(colType) && colType != TSDB_DATA_TYPE_VARCHAR)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SNodeList* pValues = NULL;
+  if (pOp->opType == OP_TYPE_IN) {
+    if (nodeType(pRight) != QUERY_NODE_NODE_LIST) {
+      return TSDB_CODE_SUCCESS;
+    }
+    pValues = ((SNodeListNode*)pRight)->pNodeList;
+  } else if (nodeType(pRight) != QUERY_NODE_VALUE) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  probe.colId = pItem->colId;
+  probe.pHashes = taosArrayInit(2, sizeof(uint64_t));
+  QUERY_CHECK_NULL(probe.pHashes, code, lino, _end, terrno);
+
+  int32_t numOfValues = (pValues != NULL) ? LIST_LENGTH(pValues) : 1;
+  for (int32_t i = 0; i < numOfValues; ++i) {
+    SNode*      pNode = (pValues != NULL) ? nodesListGetNode(pValues, i) : pRight;
+    int64_t     buf = 0;
+    const char* key = NULL;
+    uint32_t    len = 0;
+    if (pNode == NULL || nodeType(pNode) != QUERY_NODE_VALUE ||
+        !getBloomProbeKey(colType, (SValueNode*)pNode, &buf, &key, &len)) {
+      goto _end;
+    }
+
+    uint64_t h1 = HASH_FUNCTION_1(key, len);
+    uint64_t h2 = HASH_FUNCTION_2(key, len);
+    QUERY_CHECK_NULL(taosArrayPush(probe.pHashes, &h1), code, lino, _end, terrno);
+    QUERY_CHECK_NULL(taosArrayPush(probe.pHashes, &h2), code, lino, _end, terrno);
+  }
+
+  QUERY_CHECK_NULL(taosArrayPush(pProbes, &probe), code, lino, _end, terrno);
+  probe.pHashes = NULL;
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  taosArrayDestroy(probe.pHashes);
+  return code;
+}
+
+// Extract the equal/in conditions on data columns combined by AND, which are used to skip the file blocks by the bloom
+// filters of columns, if any.
+static int32_t initBloomProbes(SNode* pConditions, SColMatchInfo* pMatchInfo, SArray** ppProbes) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t lino = 0;
+  SArray* pProbes = NULL;
+
+  *ppProbes = NULL;
+  if (pConditions == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pProbes = taosArrayInit(2, sizeof(SBlockBloomProbe));
+  QUERY_CHECK_NULL(pProbes, code, lino, _end, terrno);
+
+  if (nodeType(pConditions) == QUERY_NODE_LOGIC_CONDITION &&
+      ((SLogicConditionNode*)pConditions)->condType == LOGIC_COND_TYPE_AND) {
+    SNode* pNode = NULL;
+    FOREACH(pNode, ((SLogicConditionNode*)pConditions)->pParameterList) {
+      code = addBloomProbe(pNode, pMatchInfo, pProbes);
+      QUERY_CHECK_CODE(code, lino, _end);
+    }
+  } else {
+    code = addBloomProbe(pConditions, pMatchInfo, pProbes);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  if (taosArrayGetSize(pProbes) > 0) {
+    *ppProbes = pProbes;
+    pProbes = NULL;
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  taosArrayDestroyEx(pProbes, destroyBloomProbe);
+  return code;
+}
+
 static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
   cleanupQueryTableDataCond(&pBase->cond);
   cleanupQueryTableDataCond(&pBase->orgCond);
@@ -1644,6 +1992,11 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
     taosArrayDestroy(pBase->matchInfo.pList);
   }
 
+  taosArrayDestroy(pBase->pFilterColIds);
+  pBase->pFilterColIds = NULL;
+  taosArrayDestroyEx(pBase->pBloomProbes, destroyBloomProbe);
+  pBase->pBloomProbes = NULL;
+
   tableListDestroy(pBase->pTableListInfo);
   taosLRUCacheCleanup(pBase->metaCache.pTableMetaEntryCache);
   cleanupExprSupp(&pBase->pseudoSup);
@@ -1670,6 +2023,35 @@ static void resetClolumnReserve(SSDataBlock* pBlock, int32_t dataRequireFlag) {
   }
 }
 
+// Let the table scans in the operator tree load the data of every block from now on, instead of skipping the data or
+// loading the sma only.
+void setTableScanLoadData(SOperatorInfo* pOperator) {
+  if (pOperator == NULL) {
+    return;
+  }
+
+  if (pOperator->operatorType == QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    STableScanInfo* pInfo = pOperator->info;
+    pInfo->base.dataBlockLoadFlag = FUNC_DATA_REQUIRED_DATA_LOAD;
+    SSDataBlock* pBlock = pInfo->pResBlock;
+    for (int32_t i = 0; pBlock != NULL && i < taosArrayGetSize(pBlock->pDataBlock); ++i) {
+      SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, i);
+      if (pCol) {
+        pCol->info.noData = false;
+      }
+    }
+    return;
+  } else if (pOperator->operatorType == QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN) {
+    STableMergeScanInfo* pInfo = pOperator->info;
+    pInfo->base.dataBlockLoadFlag = FUNC_DATA_REQUIRED_DATA_LOAD;
+    return;
+  }
+
+  for (int32_t i = 0; i < pOperator->numOfDownstream; ++i) {
+    setTableScanLoadData(pOperator->pDownstream[i]);
+  }
+}
+
 int32_t createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode, SReadHandle* readHandle,
                                     STableListInfo* pTableListInfo, SExecTaskInfo* pTaskInfo,
                                     SOperatorInfo** pOptrInfo) {
@@ -1738,6 +2120,14 @@ int32_t createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode, SReadHa
                             pTaskInfo->pStreamRuntimeInfo);
   QUERY_CHECK_CODE(code, lino, _error);
 
+  if (pOperator->exprSupp.pFilterInfo != NULL && !pScanNode->node.dynamicOp) {
+    code = initFilterColIds(pTableScanNode->scan.node.pConditions, &pInfo->base.matchInfo, &pInfo->base.pFilterColIds);
+    QUERY_CHECK_CODE(code, lino, _error);
+
+    code = initBloomProbes(pTableScanNode->scan.node.pConditions, &pInfo->base.matchInfo, &pInfo->base.pBloomProbes);
+    QUERY_CHECK_CODE(code, lino, _error);
+  }
+
   pInfo->currentGroupId = -1;
 
   pInfo->tableEndIndex = -1;
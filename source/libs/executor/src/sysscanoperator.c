@@ -3013,6 +3013,24 @@ static SSDataBlock* sysTableBuildUserFileSets(SOperatorInfo* pOperator) {
       code = colDataSetVal(pColInfoData, numOfRows, (char*)&shouldCompact, false);
       QUERY_CHECK_CODE(code, lino, _end);
 
+      // stt_backlog
+      int32_t sttBacklog = 0;
+      code = pAPI->tsdReader.fileSetGetEntryField(pInfo->pFileSetReader, "stt_backlog", &sttBacklog);
+      QUERY_CHECK_CODE(code, lino, _end);
+      pColInfoData = taosArrayGet(p->pDataBlock, index++);
+      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
+      code = colDataSetVal(pColInfoData, numOfRows, (char*)&sttBacklog, false);
+      QUERY_CHECK_CODE(code, lino, _end);
+
+      // merging
+      bool merging = false;
+      code = pAPI->tsdReader.fileSetGetEntryField(pInfo->pFileSetReader, "merging", &merging);
+      QUERY_CHECK_CODE(code, lino, _end);
+      pColInfoData = taosArrayGet(p->pDataBlock, index++);
+      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
+      code = colDataSetVal(pColInfoData, numOfRows, (char*)&merging, false);
+      QUERY_CHECK_CODE(code, lino, _end);
+
       // // details
       // const char* details = NULL;
       // code = pAPI->tsdReader.fileSetGetEntryField(pInfo->pFileSetReader, "details", &details);
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "executil.h"
+#include "executorInt.h"
 
 TEST(execUtilTest, resRowTest) {
   SDiskbasedBuf *pBuf = nullptr;
@@ -33,3 +34,29 @@ TEST(execUtilTest, resRowTest) {
 
   destroyDiskbasedBuf(pBuf);
 }
+
+TEST(execUtilTest, lateMaterializeTest) {
+  SLateMaterializeInfo info = {0};
+
+  // a selective filter keeps the late materialization on
+  for (int32_t i = 0; i < LATE_MATERIALIZE_PROBE_BLOCKS * 4; ++i) {
+    EXPECT_TRUE(lateMaterializeBlock(&info));
+    EXPECT_FALSE(updateLateMaterialize(&info, i % 2 == 0));
+  }
+
+  // most of the probed blocks are qualified, the blocks are loaded wholly for a while
+  for (int32_t i = 0; i < LATE_MATERIALIZE_PROBE_BLOCKS - 1; ++i) {
+    EXPECT_TRUE(lateMaterializeBlock(&info));
+    EXPECT_FALSE(updateLateMaterialize(&info, i == 0));
+  }
+  EXPECT_TRUE(lateMaterializeBlock(&info));
+  EXPECT_TRUE(updateLateMaterialize(&info, false));
+
+  for (int32_t i = 0; i < LATE_MATERIALIZE_PAUSE_BLOCKS; ++i) {
+    EXPECT_FALSE(lateMaterializeBlock(&info));
+  }
+
+  // and probed again afterwards
+  EXPECT_TRUE(lateMaterializeBlock(&info));
+  EXPECT_EQ(info.numOfProbed, 0);
+}
@@ -45,6 +45,9 @@ extern "C" {
 #define WRITE_PREPROCESS_TIME         WRITE_TABLE ":preprocess_time"
 #define WRITE_WAL_WRITE_BYTES         WRITE_TABLE ":wal_write_bytes"
 #define WRITE_WAL_WRITE_TIME          WRITE_TABLE ":wal_write_time"
+#define WRITE_WAL_GROUP_SYNC_COUNT    WRITE_TABLE ":wal_group_sync_count"
+#define WRITE_WAL_GROUP_SYNC_ENTRIES  WRITE_TABLE ":wal_group_sync_entries"
+#define WRITE_WAL_GROUP_SYNC_LATENCY  WRITE_TABLE ":wal_group_sync_latency"
 #define WRITE_APPLY_BYTES             WRITE_TABLE ":apply_bytes"
 #define WRITE_APPLY_TIME              WRITE_TABLE ":apply_time"
 #define WRITE_COMMIT_COUNT            WRITE_TABLE ":commit_count"
@@ -54,14 +57,25 @@ extern "C" {
 #define WRITE_BLOCKED_COMMIT_TIME     WRITE_TABLE ":blocked_commit_time"
 #define WRITE_MERGE_COUNT             WRITE_TABLE ":merge_count"
 #define WRITE_MERGE_TIME              WRITE_TABLE ":merge_time"
+#define WRITE_MERGE_BYTES             WRITE_TABLE ":merge_bytes"
 #define WRITE_LAST_CACHE_COMMIT_TIME  WRITE_TABLE ":last_cache_commit_time"
 #define WRITE_LAST_CACHE_COMMIT_COUNT WRITE_TABLE ":last_cache_commit_count"
+#define WRITE_COL_CACHE_HIT           WRITE_TABLE ":col_cache_hit"
+#define WRITE_COL_CACHE_MISS          WRITE_TABLE ":col_cache_miss"
+#define WRITE_COL_CACHE_EVICT         WRITE_TABLE ":col_cache_evict"
 
 #define DNODE_TABLE                    "taosd_dnodes_metrics"
 #define DNODE_RPC_QUEUE_MEMORY_ALLOWED DNODE_TABLE ":rpc_queue_memory_allowed"
 #define DNODE_RPC_QUEUE_MEMORY_USED    DNODE_TABLE ":rpc_queue_memory_used"
 #define DNODE_APPLY_MEMORY_ALLOWED     DNODE_TABLE ":apply_memory_allowed"
 #define DNODE_APPLY_MEMORY_USED        DNODE_TABLE ":apply_memory_used"
+#define DNODE_RPC_COMP_RAW_BYTES       DNODE_TABLE ":rpc_comp_raw_bytes"
+#define DNODE_RPC_COMP_BYTES           DNODE_TABLE ":rpc_comp_bytes"
+#define DNODE_RPC_COMP_COST            DNODE_TABLE ":rpc_comp_cost"
+#define DNODE_RPC_DECOMP_COST          DNODE_TABLE ":rpc_decomp_cost"
+#define DNODE_RPC_SEND_WRITES          DNODE_TABLE ":rpc_send_writes"
+#define DNODE_RPC_SEND_MSGS            DNODE_TABLE ":rpc_send_msgs"
+#define DNODE_RPC_SEND_BYTES           DNODE_TABLE ":rpc_send_bytes"
 
 extern taos_counter_t *write_total_requests;
 extern taos_counter_t *write_total_rows;
@@ -71,6 +85,9 @@ extern taos_counter_t *write_fetch_batch_meta_count;
 extern taos_counter_t *write_preprocess_time;
 extern taos_counter_t *write_wal_write_bytes;
 extern taos_counter_t *write_wal_write_time;
+extern taos_counter_t *write_wal_group_sync_count;
+extern taos_counter_t *write_wal_group_sync_entries;
+extern taos_counter_t *write_wal_group_sync_latency;
 extern taos_counter_t *write_apply_bytes;
 extern taos_counter_t *write_apply_time;
 extern taos_counter_t *write_commit_count;
@@ -80,14 +97,25 @@ extern taos_counter_t *write_blocked_commit_count;
 extern taos_counter_t *write_blocked_commit_time;
 extern taos_counter_t *write_merge_count;
 extern taos_counter_t *write_merge_time;
+extern taos_counter_t *write_merge_bytes;
 extern taos_counter_t *write_last_cache_commit_time;
 extern taos_counter_t *write_last_cache_commit_count;
+extern taos_counter_t *write_col_cache_hit;
+extern taos_counter_t *write_col_cache_miss;
+extern taos_counter_t *write_col_cache_evict;
 
 // Global dnode metrics counters
 extern taos_gauge_t *dnode_rpc_queue_memory_allowed;
 extern taos_gauge_t *dnode_rpc_queue_memory_used;
 extern taos_gauge_t *dnode_apply_memory_allowed;
 extern taos_gauge_t *dnode_apply_memory_used;
+extern taos_gauge_t *dnode_rpc_comp_raw_bytes;
+extern taos_gauge_t *dnode_rpc_comp_bytes;
+extern taos_gauge_t *dnode_rpc_comp_cost;
+extern taos_gauge_t *dnode_rpc_decomp_cost;
+extern taos_gauge_t *dnode_rpc_send_writes;
+extern taos_gauge_t *dnode_rpc_send_msgs;
+extern taos_gauge_t *dnode_rpc_send_bytes;
 
 // Macro for deleting a counter key with error logging
 #define METRICS_DELETE_COUNTER(counter, key)                                     \
@@ -23,6 +23,9 @@ taos_counter_t *write_fetch_batch_meta_count = NULL;
 taos_counter_t *write_preprocess_time = NULL;
 taos_counter_t *write_wal_write_bytes = NULL;
 taos_counter_t *write_wal_write_time = NULL;
+taos_counter_t *write_wal_group_sync_count = NULL;
+taos_counter_t *write_wal_group_sync_entries = NULL;
+taos_counter_t *write_wal_group_sync_latency = NULL;
 taos_counter_t *write_apply_bytes = NULL;
 taos_counter_t *write_apply_time = NULL;
 taos_counter_t *write_commit_count = NULL;
@@ -32,14 +35,25 @@ taos_counter_t *write_blocked_commit_count = NULL;
 taos_counter_t *write_blocked_commit_time = NULL;
 taos_counter_t *write_merge_count = NULL;
 taos_counter_t *write_merge_time = NULL;
+taos_counter_t *write_merge_bytes = NULL;
 taos_counter_t *write_last_cache_commit_time = NULL;
 taos_counter_t *write_last_cache_commit_count = NULL;
+taos_counter_t *write_col_cache_hit = NULL;
+taos_counter_t *write_col_cache_miss = NULL;
+taos_counter_t *write_col_cache_evict = NULL;
 
 // Global dnode metrics counters
 taos_gauge_t *dnode_rpc_queue_memory_allowed = NULL;
 taos_gauge_t *dnode_rpc_queue_memory_used = NULL;
 taos_gauge_t *dnode_apply_memory_allowed = NULL;
 taos_gauge_t *dnode_apply_memory_used = NULL;
+taos_gauge_t *dnode_rpc_comp_raw_bytes = NULL;
+taos_gauge_t *dnode_rpc_comp_bytes = NULL;
+taos_gauge_t *dnode_rpc_comp_cost = NULL;
+taos_gauge_t *dnode_rpc_decomp_cost = NULL;
+taos_gauge_t *dnode_rpc_send_writes = NULL;
+taos_gauge_t *dnode_rpc_send_msgs = NULL;
+taos_gauge_t *dnode_rpc_send_bytes = NULL;
 
 // Helper function to clean expired metrics from a counter
 static void cleanExpiredCounterMetrics(taos_counter_t *counter, SHashObj *pValidVgroups, const char *counterName) {
@@ -94,6 +108,12 @@ int32_t initMetricsManager() {
       taos_counter_new(WRITE_WAL_WRITE_BYTES, "WAL write bytes", 6, write_labels));
   write_wal_write_time = taos_collector_registry_must_register_metric(
       taos_counter_new(WRITE_WAL_WRITE_TIME, "WAL write time", 6, write_labels));
+  write_wal_group_sync_count = taos_collector_registry_must_register_metric(
+      taos_counter_new(WRITE_WAL_GROUP_SYNC_COUNT, "WAL group commit fsync count", 6, write_labels));
+  write_wal_group_sync_entries = taos_collector_registry_must_register_metric(
+      taos_counter_new(WRITE_WAL_GROUP_SYNC_ENTRIES, "WAL entries made durable by group commit", 6, write_labels));
+  write_wal_group_sync_latency = taos_collector_registry_must_register_metric(
+      taos_counter_new(WRITE_WAL_GROUP_SYNC_LATENCY, "WAL group commit latency", 6, write_labels));
   write_apply_bytes =
       taos_collector_registry_must_register_metric(taos_counter_new(WRITE_APPLY_BYTES, "Apply bytes", 6, write_labels));
   write_apply_time =
@@ -112,10 +132,18 @@ int32_t initMetricsManager() {
       taos_collector_registry_must_register_metric(taos_counter_new(WRITE_MERGE_COUNT, "Merge count", 6, write_labels));
   write_merge_time =
       taos_collector_registry_must_register_metric(taos_counter_new(WRITE_MERGE_TIME, "Merge time", 6, write_labels));
+  write_merge_bytes =
+      taos_collector_registry_must_register_metric(taos_counter_new(WRITE_MERGE_BYTES, "Merge bytes", 6, write_labels));
   write_last_cache_commit_time = taos_collector_registry_must_register_metric(
       taos_counter_new(WRITE_LAST_CACHE_COMMIT_TIME, "Last cache commit time", 6, write_labels));
   write_last_cache_commit_count = taos_collector_registry_must_register_metric(
       taos_counter_new(WRITE_LAST_CACHE_COMMIT_COUNT, "Last cache commit count", 6, write_labels));
+  write_col_cache_hit = taos_collector_registry_must_register_metric(
+      taos_counter_new(WRITE_COL_CACHE_HIT, "Decompressed column cache hits", 6, write_labels));
+  write_col_cache_miss = taos_collector_registry_must_register_metric(
+      taos_counter_new(WRITE_COL_CACHE_MISS, "Decompressed column cache misses", 6, write_labels));
+  write_col_cache_evict = taos_collector_registry_must_register_metric(
+      taos_counter_new(WRITE_COL_CACHE_EVICT, "Decompressed column cache evictions", 6, write_labels));
 
   // Initialize global dnode counters
   const char *dnode_labels[] = {"metric_type", "cluster_id", "dnode_id", "dnode_ep"};
@@ -127,6 +155,20 @@ int32_t initMetricsManager() {
       taos_gauge_new(DNODE_APPLY_MEMORY_ALLOWED, "Apply memory allowed", 4, dnode_labels));
   dnode_apply_memory_used = taos_collector_registry_must_register_metric(
       taos_gauge_new(DNODE_APPLY_MEMORY_USED, "Apply memory used", 4, dnode_labels));
+  dnode_rpc_comp_raw_bytes = taos_collector_registry_must_register_metric(
+      taos_gauge_new(DNODE_RPC_COMP_RAW_BYTES, "RPC bytes before compression", 4, dnode_labels));
+  dnode_rpc_comp_bytes = taos_collector_registry_must_register_metric(
+      taos_gauge_new(DNODE_RPC_COMP_BYTES, "RPC bytes after compression", 4, dnode_labels));
+  dnode_rpc_comp_cost = taos_collector_registry_must_register_metric(
+      taos_gauge_new(DNODE_RPC_COMP_COST, "RPC compression time in us", 4, dnode_labels));
+  dnode_rpc_decomp_cost = taos_collector_registry_must_register_metric(
+      taos_gauge_new(DNODE_RPC_DECOMP_COST, "RPC decompression time in us", 4, dnode_labels));
+  dnode_rpc_send_writes = taos_collector_registry_must_register_metric(
+      taos_gauge_new(DNODE_RPC_SEND_WRITES, "RPC socket writes", 4, dnode_labels));
+  dnode_rpc_send_msgs = taos_collector_registry_must_register_metric(
+      taos_gauge_new(DNODE_RPC_SEND_MSGS, "RPC msgs sent", 4, dnode_labels));
+  dnode_rpc_send_bytes = taos_collector_registry_must_register_metric(
+      taos_gauge_new(DNODE_RPC_SEND_BYTES, "RPC bytes sent", 4, dnode_labels));
 
   return TSDB_CODE_SUCCESS;
 }
@@ -152,14 +194,21 @@ int32_t addWriteMetrics(int32_t vgId, int32_t dnodeId, int64_t clusterId, const
   // Update global shared counters using monitorfw
   taos_counter_add(write_total_rows, (double)pRawMetrics->total_rows, label_values);
   taos_counter_add(write_wal_write_time, (double)pRawMetrics->wal_write_time, label_values);
+  taos_counter_add(write_wal_group_sync_count, (double)pRawMetrics->wal_group_sync_count, label_values);
+  taos_counter_add(write_wal_group_sync_entries, (double)pRawMetrics->wal_group_sync_entries, label_values);
+  taos_counter_add(write_wal_group_sync_latency, (double)pRawMetrics->wal_group_sync_latency, label_values);
   taos_counter_add(write_commit_count, (double)pRawMetrics->commit_count, label_values);
   taos_counter_add(write_commit_time, (double)pRawMetrics->commit_time, label_values);
   taos_counter_add(write_blocked_commit_count, (double)pRawMetrics->blocked_commit_count, label_values);
   taos_counter_add(write_blocked_commit_time, (double)pRawMetrics->blocked_commit_time, label_values);
   taos_counter_add(write_merge_count, (double)pRawMetrics->merge_count, label_values);
   taos_counter_add(write_merge_time, (double)pRawMetrics->merge_time, label_values);
+  taos_counter_add(write_merge_bytes, (double)pRawMetrics->merge_bytes, label_values);
   taos_counter_add(write_last_cache_commit_time, (double)pRawMetrics->last_cache_commit_time, label_values);
   taos_counter_add(write_last_cache_commit_count, (double)pRawMetrics->last_cache_commit_count, label_values);
+  taos_counter_add(write_col_cache_hit, (double)pRawMetrics->col_cache_hit, label_values);
+  taos_counter_add(write_col_cache_miss, (double)pRawMetrics->col_cache_miss, label_values);
+  taos_counter_add(write_col_cache_evict, (double)pRawMetrics->col_cache_evict, label_values);
 
   // Update low level metrics when tsMetricsFlag is 1
   if (tsMetricsLevel == 1) {
@@ -193,6 +242,13 @@ int32_t addDnodeMetrics(const SRawDnodeMetrics *pRawMetrics, int64_t clusterId,
   taos_gauge_set(dnode_rpc_queue_memory_used, (double)pRawMetrics->rpcQueueMemoryUsed, label_values);
   taos_gauge_set(dnode_apply_memory_allowed, (double)pRawMetrics->applyMemoryAllowed, label_values);
   taos_gauge_set(dnode_apply_memory_used, (double)pRawMetrics->applyMemoryUsed, label_values);
+  taos_gauge_set(dnode_rpc_comp_raw_bytes, (double)pRawMetrics->rpcCompRawBytes, label_values);
+  taos_gauge_set(dnode_rpc_comp_bytes, (double)pRawMetrics->rpcCompBytes, label_values);
+  taos_gauge_set(dnode_rpc_comp_cost, (double)pRawMetrics->rpcCompCostUs, label_values);
+  taos_gauge_set(dnode_rpc_decomp_cost, (double)pRawMetrics->rpcDecompCostUs, label_values);
+  taos_gauge_set(dnode_rpc_send_writes, (double)pRawMetrics->rpcSendWrites, label_values);
+  taos_gauge_set(dnode_rpc_send_msgs, (double)pRawMetrics->rpcSendMsgs, label_values);
+  taos_gauge_set(dnode_rpc_send_bytes, (double)pRawMetrics->rpcSendBytes, label_values);
 
   return TSDB_CODE_SUCCESS;
 }
@@ -208,6 +264,9 @@ int32_t cleanupExpiredMetrics(SHashObj *pValidVgroups) {
   cleanExpiredCounterMetrics(write_preprocess_time, pValidVgroups, "write_preprocess_time");
   cleanExpiredCounterMetrics(write_wal_write_bytes, pValidVgroups, "write_wal_write_bytes");
   cleanExpiredCounterMetrics(write_wal_write_time, pValidVgroups, "write_wal_write_time");
+  cleanExpiredCounterMetrics(write_wal_group_sync_count, pValidVgroups, "write_wal_group_sync_count");
+  cleanExpiredCounterMetrics(write_wal_group_sync_entries, pValidVgroups, "write_wal_group_sync_entries");
+  cleanExpiredCounterMetrics(write_wal_group_sync_latency, pValidVgroups, "write_wal_group_sync_latency");
   cleanExpiredCounterMetrics(write_apply_bytes, pValidVgroups, "write_apply_bytes");
   cleanExpiredCounterMetrics(write_apply_time, pValidVgroups, "write_apply_time");
   cleanExpiredCounterMetrics(write_commit_count, pValidVgroups, "write_commit_count");
@@ -217,7 +276,11 @@ int32_t cleanupExpiredMetrics(SHashObj *pValidVgroups) {
   cleanExpiredCounterMetrics(write_blocked_commit_time, pValidVgroups, "write_blocked_commit_time");
   cleanExpiredCounterMetrics(write_merge_count, pValidVgroups, "write_merge_count");
   cleanExpiredCounterMetrics(write_merge_time, pValidVgroups, "write_merge_time");
+  cleanExpiredCounterMetrics(write_merge_bytes, pValidVgroups, "write_merge_bytes");
   cleanExpiredCounterMetrics(write_last_cache_commit_time, pValidVgroups, "write_last_cache_commit_time");
   cleanExpiredCounterMetrics(write_last_cache_commit_count, pValidVgroups, "write_last_cache_commit_count");
+  cleanExpiredCounterMetrics(write_col_cache_hit, pValidVgroups, "write_col_cache_hit");
+  cleanExpiredCounterMetrics(write_col_cache_miss, pValidVgroups, "write_col_cache_miss");
+  cleanExpiredCounterMetrics(write_col_cache_evict, pValidVgroups, "write_col_cache_evict");
   return TSDB_CODE_SUCCESS;
 }
\ No newline at end of file
@@ -268,6 +268,7 @@ typedef struct SSchJobAttr {
   bool         needFetch;
   bool         needFlowCtrl;
   bool         localExec;
+  int32_t      maxStaleness;  // ms, scan tasks may run on followers when it is positive
 } SSchJobAttr;
 
 typedef struct {
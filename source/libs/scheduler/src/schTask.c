@@ -836,7 +836,14 @@ int32_t schSetTaskCandidateAddrs(SSchJob *pJob, SSchTask *pTask) {
       SCH_ERR_RET(terrno);
     }
 
-    SCH_TASK_TLOG("use execNode in plan as candidate addr, numOfEps:%d", pTask->plan->execNode.epSet.numOfEps);
+    // a scan allowing stale results starts on a random replica to spread the reads of the vgroup
+    SQueryNodeAddr *pAddr = taosArrayGetLast(pTask->candidateAddrs);
+    if (pJob->attr.maxStaleness > 0 && SCH_IS_DATA_BIND_QRY_TASK(pTask) && pAddr->epSet.numOfEps > 1) {
+      pAddr->epSet.inUse = taosRand() % pAddr->epSet.numOfEps;
+    }
+
+    SCH_TASK_TLOG("use execNode in plan as candidate addr, numOfEps:%d, inUse:%d", pAddr->epSet.numOfEps,
+                  pAddr->epSet.inUse);
 
     return TSDB_CODE_SUCCESS;
   }
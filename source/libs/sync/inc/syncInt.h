@@ -207,6 +207,9 @@ struct SSyncNode {
 
   // restore state
   bool restoreFinish;
+
+  // within a group commit, the leader leaves the fsync of the entries it appends to syncEndGroupCommit
+  bool groupCommit;
   // SSnapshot*             pSnapshot;
   SSyncSnapshotSender*   senders[TSDB_MAX_REPLICA + TSDB_MAX_LEARNER_REPLICA];
   SSyncSnapshotReceiver* pNewNodeReceiver;
@@ -227,6 +230,10 @@ struct SSyncNode {
   int64_t roleTimeMs;
   int64_t lastReplicateTime;
 
+  // follower read lease, renewed by the heartbeats of the current leader
+  int64_t   leaseRecvTime;
+  SyncIndex leaseCommitIndex;
+
   int32_t electNum;
   int32_t becomeLeaderNum;
   int32_t becomeAssignedLeaderNum;
@@ -295,6 +302,7 @@ bool      syncNodeHeartbeatReplyTimeout(SSyncNode* pSyncNode);
 bool      syncNodeSnapshotSending(SSyncNode* pSyncNode);
 bool      syncNodeSnapshotRecving(SSyncNode* pSyncNode);
 bool      syncNodeIsReadyForRead(SSyncNode* pSyncNode);
+bool      syncNodeIsReadyForFollowerRead(SSyncNode* pSyncNode, int32_t maxStalenessMs);
 
 // raft state change --------------
 void    syncNodeUpdateTerm(SSyncNode* pSyncNode, SyncTerm term);
@@ -100,7 +100,7 @@ typedef struct SyncAppendEntries {
   SyncTerm  privateTerm;
   int16_t   reserved;
   uint32_t  dataLen;
-  char      data[];
+  char      data[];  // one or more consecutive raft entries, back to back
 } SyncAppendEntries;
 
 typedef struct SyncAppendEntriesReply {
@@ -117,6 +117,7 @@ typedef struct SyncAppendEntriesReply {
   SyncIndex lastSendIndex;
   int64_t   startTime;
   int16_t   fsmState;
+  int16_t   acceptBatch;  // the follower accepts several entries in one append entries msg
 } SyncAppendEntriesReply;
 
 typedef struct SyncHeartbeat {
@@ -262,6 +263,8 @@ int32_t syncBuildAppendEntries(SRpcMsg* pMsg, int32_t dataLen, int32_t vgId);
 int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
                                             SRpcMsg* pRpcMsg);
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t nEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg);
 int32_t syncBuildHeartbeat(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildHeartbeatReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildPreSnapshot(SRpcMsg* pMsg, int32_t vgId);
@@ -22,6 +22,8 @@ extern "C" {
 
 #include "syncInt.h"
 
+#define SYNC_APPEND_BATCH_MAX_ENTRIES 64
+
 typedef struct SSyncReplInfo {
   bool    barrier;
   bool    acked;
@@ -37,6 +39,7 @@ typedef struct SSyncLogReplMgr {
   int64_t       size;
   bool          restored;
   int64_t       peerStartTime;
+  bool          peerAcceptBatch;
   int32_t       retryBackoff;
   int32_t       peerId;
   int64_t       sendCount;
@@ -112,6 +115,7 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
                              const SRpcMsg* pMsg);
 int32_t syncLogBufferCommit(SSyncLogBuffer* pBuf, SSyncNode* pNode, int64_t commitIndex, const STraceId* trace,
                             const char* src);
+int32_t syncLogBufferGroupCommit(SSyncLogBuffer* pBuf, SSyncNode* pNode);
 int32_t syncLogBufferReset(SSyncLogBuffer* pBuf, SSyncNode* pNode);
 
 // private
@@ -123,6 +123,7 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   pReply->matchIndex = SYNC_INDEX_INVALID;
   pReply->lastSendIndex = pMsg->prevLogIndex + 1;
   pReply->startTime = ths->startTime;
+  pReply->acceptBatch = 1;
 
   if (pMsg->term < raftStoreGetTerm(ths)) {
     goto _SEND_RESPONSE;
@@ -143,37 +144,54 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
     goto _IGNORE;
   }
 
-  pEntry = syncEntryBuildFromAppendEntries(pMsg);
-  if (pEntry == NULL) {
-    sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
-    goto _IGNORE;
-  }
-
-  if (pMsg->prevLogIndex + 1 != pEntry->index || pEntry->term < 0) {
-    sError("vgId:%d, invalid previous log index in msg. index:%" PRId64 ",  term:%" PRId64 ", prevLogIndex:%" PRId64
-           ", prevLogTerm:%" PRId64,
-           ths->vgId, pEntry->index, pEntry->term, pMsg->prevLogIndex, pMsg->prevLogTerm);
-    goto _IGNORE;
-  }
-
-  sGDebug(&pRpcMsg->info.traceId,
-          "vgId:%d, index:%" PRId64 ", recv append entries msg, term:%" PRId64 ", preLogIndex:%" PRId64
-          ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 " entryterm:%" PRId64,
-          pMsg->vgId, pMsg->prevLogIndex + 1, pMsg->term, pMsg->prevLogIndex, pMsg->prevLogTerm, pMsg->commitIndex,
-          pEntry->term);
-
-  if (ths->fsmState == SYNC_FSM_STATE_INCOMPLETE) {
-    pReply->fsmState = ths->fsmState;
-    sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, pEntry->index);
-    syncEntryDestroy(pEntry);
-    goto _SEND_RESPONSE;
-  }
-
-  // accept
-  if (syncLogBufferAccept(ths->pLogBuf, ths, pEntry, pMsg->prevLogTerm) < 0) {
-    goto _SEND_RESPONSE;
+  // the msg carries one or more consecutive entries, accept them in order until one is refused
+  uint32_t  offset = 0;
+  SyncIndex prevLogIndex = pMsg->prevLogIndex;
+  SyncTerm  prevLogTerm = pMsg->prevLogTerm;
+  while (offset < pMsg->dataLen) {
+    pEntry = syncEntryBuildFromAppendEntriesAt(pMsg, &offset);
+    if (pEntry == NULL) {
+      sError("vgId:%d, failed to get raft entry from append entries since %s, offset:%u", ths->vgId, terrstr(),
+             offset);
+      if (accepted) break;
+      goto _IGNORE;
+    }
+
+    if (prevLogIndex + 1 != pEntry->index || pEntry->term < 0) {
+      sError("vgId:%d, invalid previous log index in msg. index:%" PRId64 ",  term:%" PRId64 ", prevLogIndex:%" PRId64
+             ", prevLogTerm:%" PRId64,
+             ths->vgId, pEntry->index, pEntry->term, prevLogIndex, prevLogTerm);
+      if (accepted) {
+        syncEntryDestroy(pEntry);
+        pEntry = NULL;
+        break;
+      }
+      goto _IGNORE;
+    }
+
+    sGDebug(&pRpcMsg->info.traceId,
+            "vgId:%d, index:%" PRId64 ", recv append entries msg, term:%" PRId64 ", preLogIndex:%" PRId64
+            ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 " entryterm:%" PRId64,
+            pMsg->vgId, pEntry->index, pMsg->term, prevLogIndex, prevLogTerm, pMsg->commitIndex, pEntry->term);
+
+    if (ths->fsmState == SYNC_FSM_STATE_INCOMPLETE) {
+      pReply->fsmState = ths->fsmState;
+      sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, pEntry->index);
+      syncEntryDestroy(pEntry);
+      goto _SEND_RESPONSE;
+    }
+
+    // accept
+    SyncIndex index = pEntry->index;
+    SyncTerm  term = pEntry->term;
+    if (syncLogBufferAccept(ths->pLogBuf, ths, pEntry, prevLogTerm) < 0) {
+      break;
+    }
+    accepted = true;
+    pReply->lastSendIndex = index;
+    prevLogIndex = index;
+    prevLogTerm = term;
   }
-  accepted = true;
 
 _SEND_RESPONSE:
   pEntry = NULL;
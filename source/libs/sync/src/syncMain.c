@@ -291,6 +291,46 @@ int32_t syncProcessMsg(int64_t rid, SRpcMsg* pMsg) {
   TAOS_RETURN(code);
 }
 
+// the leader shares one wal fsync among the entries it appends until syncEndGroupCommit, which acks them at once
+void syncBeginGroupCommit(int64_t rid) {
+  if (!tsWalGroupCommit) return;
+
+  SSyncNode* pSyncNode = syncNodeAcquire(rid);
+  if (pSyncNode == NULL) return;
+
+  pSyncNode->groupCommit = true;
+  syncNodeRelease(pSyncNode);
+}
+
+int32_t syncEndGroupCommit(int64_t rid) {
+  int32_t    code = 0;
+  SSyncNode* pSyncNode = syncNodeAcquire(rid);
+  if (pSyncNode == NULL) {
+    code = TSDB_CODE_SYN_RETURN_VALUE_NULL;
+    if (terrno != 0) code = terrno;
+    TAOS_RETURN(code);
+  }
+
+  if (!pSyncNode->groupCommit) {
+    syncNodeRelease(pSyncNode);
+    TAOS_RETURN(code);
+  }
+  pSyncNode->groupCommit = false;
+
+  code = syncLogBufferGroupCommit(pSyncNode->pLogBuf, pSyncNode);
+
+  // the followers may have acked the entries before the leader synced them
+  if (code == 0 && pSyncNode->state == TAOS_SYNC_STATE_LEADER) {
+    SyncIndex commitIndex = syncNodeCheckCommitIndex(pSyncNode, pSyncNode->pLogBuf->matchIndex, NULL);
+    if (pSyncNode->fsmState != SYNC_FSM_STATE_INCOMPLETE) {
+      code = syncLogBufferCommit(pSyncNode->pLogBuf, pSyncNode, commitIndex, NULL, "group-commit");
+    }
+  }
+
+  syncNodeRelease(pSyncNode);
+  TAOS_RETURN(code);
+}
+
 int32_t syncLeaderTransfer(int64_t rid) {
   int32_t    code = 0;
   SSyncNode* pSyncNode = syncNodeAcquire(rid);
@@ -585,6 +625,47 @@ bool syncIsReadyForRead(int64_t rid) {
   return ready;
 }
 
+// a follower may serve reads if it has applied everything the leader had committed when its latest heartbeat was
+// received, and that heartbeat is no older than maxStalenessMs. a negative maxStalenessMs only checks the role.
+bool syncNodeIsReadyForFollowerRead(SSyncNode* pSyncNode, int32_t maxStalenessMs) {
+  if (pSyncNode->state != TAOS_SYNC_STATE_FOLLOWER && pSyncNode->state != TAOS_SYNC_STATE_LEARNER) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return false;
+  }
+
+  if (!pSyncNode->restoreFinish) {
+    terrno = TSDB_CODE_SYN_RESTORING;
+    return false;
+  }
+
+  if (maxStalenessMs < 0) {
+    return true;
+  }
+
+  int64_t   recvTime = atomic_load_64(&pSyncNode->leaseRecvTime);
+  SyncIndex commitIndex = atomic_load_64(&pSyncNode->leaseCommitIndex);
+  if (recvTime <= 0 || taosGetTimestampMs() - recvTime > maxStalenessMs ||
+      pSyncNode->pFsm->FpAppliedIndexCb(pSyncNode->pFsm) < commitIndex) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return false;
+  }
+
+  return true;
+}
+
+bool syncIsReadyForFollowerRead(int64_t rid, int32_t maxStalenessMs) {
+  SSyncNode* pSyncNode = syncNodeAcquire(rid);
+  if (pSyncNode == NULL) {
+    sError("sync ready for follower read error");
+    return false;
+  }
+
+  bool ready = syncNodeIsReadyForFollowerRead(pSyncNode, maxStalenessMs);
+
+  syncNodeRelease(pSyncNode);
+  return ready;
+}
+
 #ifdef BUILD_NO_CALL
 bool syncSnapshotSending(int64_t rid) {
   SSyncNode* pSyncNode = syncNodeAcquire(rid);
@@ -3702,7 +3783,7 @@ static int32_t syncNodeAppendNoopOld(SSyncNode* ths) {
   LRUHandle* h = NULL;
 
   if (ths->state == TAOS_SYNC_STATE_LEADER) {
-    int32_t code = ths->pLogStore->syncLogAppendEntry(ths->pLogStore, pEntry, false);
+    int32_t code = ths->pLogStore->syncLogAppendEntry(ths->pLogStore, pEntry, false, false);
     if (code != 0) {
       sError("append noop error");
       return -1;
@@ -3772,6 +3853,8 @@ int32_t syncNodeOnHeartbeat(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
     resetElect = true;
 
     ths->minMatchIndex = pMsg->minMatchIndex;
+    atomic_store_64(&ths->leaseCommitIndex, pMsg->commitIndex);
+    atomic_store_64(&ths->leaseRecvTime, tsMs);
 
     if (ths->state == TAOS_SYNC_STATE_FOLLOWER || ths->state == TAOS_SYNC_STATE_LEARNER) {
       SRpcMsg rpcMsgLocalCmd = {0};
@@ -150,9 +150,17 @@ int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId) {
 
 int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
                                             SRpcMsg* pRpcMsg) {
-  uint32_t dataLen = pEntry->bytes;
+  return syncBuildAppendEntriesFromRaftEntries(pNode, &pEntry, 1, prevLogTerm, pRpcMsg);
+}
+
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t nEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg) {
+  uint32_t dataLen = 0;
+  for (int32_t i = 0; i < nEntries; i++) {
+    dataLen += ppEntries[i]->bytes;
+  }
   uint32_t bytes = sizeof(SyncAppendEntries) + dataLen;
-  pRpcMsg->info.traceId = pEntry->originRpcTraceId;
+  pRpcMsg->info.traceId = ppEntries[0]->originRpcTraceId;
   pRpcMsg->contLen = bytes;
   pRpcMsg->pCont = rpcMallocCont(pRpcMsg->contLen);
   if (pRpcMsg->pCont == NULL) {
@@ -164,9 +172,13 @@ int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pE
   pMsg->msgType = pRpcMsg->msgType = TDMT_SYNC_APPEND_ENTRIES;
   pMsg->dataLen = dataLen;
 
-  (void)memcpy(pMsg->data, pEntry, dataLen);
+  char* pData = pMsg->data;
+  for (int32_t i = 0; i < nEntries; i++) {
+    (void)memcpy(pData, ppEntries[i], ppEntries[i]->bytes);
+    pData += ppEntries[i]->bytes;
+  }
 
-  pMsg->prevLogIndex = pEntry->index - 1;
+  pMsg->prevLogIndex = ppEntries[0]->index - 1;
   pMsg->prevLogTerm = prevLogTerm;
   pMsg->vgId = pNode->vgId;
   pMsg->srcId = pNode->myRaftId;
@@ -518,7 +518,7 @@ static inline bool syncLogStoreNeedFlush(SSyncRaftEntry* pEntry, int32_t replica
   return (replicaNum > 1) && (pEntry->originalRpcType == TDMT_VND_COMMIT);
 }
 
-int32_t syncLogStorePersist(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaftEntry* pEntry) {
+int32_t syncLogStorePersist(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaftEntry* pEntry, bool deferSync) {
   int32_t code = 0;
   if (pEntry->index < 0) return TSDB_CODE_SYN_INTERNAL_ERROR;
   SyncIndex lastVer = pLogStore->syncLogLastIndex(pLogStore);
@@ -536,7 +536,7 @@ int32_t syncLogStorePersist(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaf
   }
 #endif
   bool doFsync = syncLogStoreNeedFlush(pEntry, pNode->replicaNum);
-  if ((code = pLogStore->syncLogAppendEntry(pLogStore, pEntry, doFsync)) < 0) {
+  if ((code = pLogStore->syncLogAppendEntry(pLogStore, pEntry, doFsync, deferSync)) < 0) {
     sError("failed to persist raft entry since %s, index:%" PRId64 ", term:%" PRId64, tstrerror(code), pEntry->index,
            pEntry->term);
     TAOS_RETURN(code);
@@ -553,8 +553,16 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
   SSyncLogStore* pLogStore = pNode->pLogStore;
   int64_t        matchIndex = pBuf->matchIndex;
+  int64_t        syncedIndex = matchIndex;
   int32_t        code = 0;
 
+  // a leader sends the entries out before its own fsync, which is left to the group commit below and
+  // overlaps with the followers persisting them. its own ack is counted once the fsync completes.
+  // within a group commit, both are left to syncLogBufferGroupCommit, so the entries of all proposals
+  // in the batch share one fsync.
+  bool deferSync = (pNode->state == TAOS_SYNC_STATE_LEADER && pNode->replicaNum > 1);
+  bool groupCommit = (deferSync && pNode->groupCommit);
+
   while (pBuf->matchIndex + 1 < pBuf->endIndex) {
     int64_t index = pBuf->matchIndex + 1;
     if (index < 0) {
@@ -624,7 +632,7 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
             pNode->vgId, pMsg, pBuf->startIndex, pBuf->matchIndex, pBuf->endIndex);
 
     // persist
-    if ((code = syncLogStorePersist(pLogStore, pNode, pEntry)) < 0) {
+    if ((code = syncLogStorePersist(pLogStore, pNode, pEntry, deferSync)) < 0) {
       sError("vgId:%d, msg:%p, failed to persist sync log entry from buffer since %s, index:%" PRId64, pNode->vgId,
              pMsg, tstrerror(code), pEntry->index);
       taosMsleep(1);
@@ -675,12 +683,22 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
       goto _out;
     }
 
-    // update my match index
     matchIndex = pBuf->matchIndex;
-    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, pBuf->matchIndex);
   }  // end of while
 
 _out:
+  // entries persisted above may share one fsync, only durable ones count as matched. a leader stepped down within
+  // a group commit syncs the entries left pending as well, before acking any of them.
+  if (!groupCommit && (matchIndex > syncedIndex || pNode->groupCommit)) {
+    if ((code = pLogStore->syncLogGroupCommit(pLogStore)) != 0) {
+      sError("vgId:%d, msg:%p, failed to sync log entries in (%" PRId64 ", %" PRId64 "] since %s", pNode->vgId, pMsg,
+             syncedIndex, matchIndex, tstrerror(code));
+      matchIndex = syncedIndex;
+    } else {
+      // update my match index
+      syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, matchIndex);
+    }
+  }
   pBuf->matchIndex = matchIndex;
   if (pMatchTerm) {
     *pMatchTerm = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem->term;
@@ -690,6 +708,26 @@ _out:
   return matchIndex;
 }
 
+int32_t syncLogBufferGroupCommit(SSyncLogBuffer* pBuf, SSyncNode* pNode) {
+  SSyncLogStore* pLogStore = pNode->pLogStore;
+  int32_t        code = 0;
+
+  (void)taosThreadMutexLock(&pBuf->mutex);
+  SyncIndex matchIndex = pBuf->matchIndex;
+  SyncIndex syncedIndex = syncIndexMgrGetIndex(pNode->pMatchIndex, &pNode->myRaftId);
+  if (matchIndex > syncedIndex) {
+    // on failure the fsync stays pending, and the ack is not counted until a later one succeeds
+    if ((code = pLogStore->syncLogGroupCommit(pLogStore)) != 0) {
+      sError("vgId:%d, failed to group commit log entries in (%" PRId64 ", %" PRId64 "] since %s", pNode->vgId,
+             syncedIndex, matchIndex, tstrerror(code));
+    } else {
+      syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, matchIndex);
+    }
+  }
+  (void)taosThreadMutexUnlock(&pBuf->mutex);
+  TAOS_RETURN(code);
+}
+
 int32_t syncFsmExecute(SSyncNode* pNode, SSyncFSM* pFsm, ESyncState role, SyncTerm term, SSyncRaftEntry* pEntry,
                        int32_t applyCode, bool force) {
   // learner need to execute fsm when it catch up entry log
@@ -1201,6 +1239,7 @@ int32_t syncLogReplProcessReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncApp
     syncLogReplReset(pMgr);
     pMgr->peerStartTime = pMsg->startTime;
   }
+  pMgr->peerAcceptBatch = (pMsg->acceptBatch != 0);
   (void)taosThreadMutexUnlock(&pMgr->mutex);
 
   (void)taosThreadMutexLock(&pBuf->mutex);
@@ -1272,6 +1311,92 @@ int32_t syncLogReplProbe(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex inde
   return 0;
 }
 
+// pack the entries from index up to lastIndex into one msg within syncAppendBatchSize, stopping after a barrier.
+// the states of the sent entries are set and the last one is returned in pSentIndex.
+static int32_t syncLogReplSendBatchTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncIndex lastIndex,
+                                      SRaftId* pDestId, int64_t nowMs, SyncIndex* pSentIndex) {
+  SSyncRaftEntry* entries[SYNC_APPEND_BATCH_MAX_ENTRIES] = {0};
+  bool            inBuf[SYNC_APPEND_BATCH_MAX_ENTRIES] = {0};
+  int32_t         nEntries = 0;
+  int64_t         batchBytes = (int64_t)tsSyncAppendBatchSize * 1024;
+  int64_t         bytes = 0;
+  SyncTerm        prevLogTerm = -1;
+  SRpcMsg         msgOut = {0};
+  SSyncLogBuffer* pBuf = pNode->pLogBuf;
+  int32_t         code = 0;
+  int32_t         lino = 0;
+
+  if (!pMgr->peerAcceptBatch || batchBytes <= 0) {
+    lastIndex = index;
+  }
+  lastIndex = TMIN(lastIndex, index + SYNC_APPEND_BATCH_MAX_ENTRIES - 1);
+
+  for (SyncIndex i = index; i <= lastIndex; i++) {
+    SSyncRaftEntry* pEntry = NULL;
+    code = syncLogBufferGetOneEntry(pBuf, pNode, i, &inBuf[nEntries], &pEntry);
+    if (pEntry == NULL) {
+      if (nEntries > 0) {
+        code = 0;
+        break;
+      }
+      sWarn("vgId:%d, failed to get raft entry for index:%" PRId64, pNode->vgId, i);
+      if (code == TSDB_CODE_WAL_LOG_NOT_EXIST) {
+        sInfo("vgId:%d, reset sync log repl of peer addr:0x%" PRIx64 " since %s, index:%" PRId64, pNode->vgId,
+              pDestId->addr, tstrerror(code), i);
+        syncLogReplReset(pMgr);
+      }
+      goto _out;
+    }
+    if (nEntries > 0 && bytes + pEntry->bytes > batchBytes) {
+      if (!inBuf[nEntries]) syncEntryDestroy(pEntry);
+      break;
+    }
+
+    entries[nEntries++] = pEntry;
+    bytes += pEntry->bytes;
+    if (syncLogReplBarrier(pEntry)) {
+      break;
+    }
+  }
+
+  code = syncLogReplGetPrevLogTerm(pMgr, pNode, index, &prevLogTerm);
+  if (prevLogTerm < 0) {
+    sError("vgId:%d, failed to get prev log term since %s, index:%" PRId64, pNode->vgId, tstrerror(code), index);
+    goto _out;
+  }
+
+  code = syncBuildAppendEntriesFromRaftEntries(pNode, entries, nEntries, prevLogTerm, &msgOut);
+  if (code < 0) {
+    sError("vgId:%d, failed to get append entries for index:%" PRId64, pNode->vgId, index);
+    goto _out;
+  }
+
+  TRACE_SET_MSGID(&(msgOut.info.traceId), tGenIdPI64());
+  sGDebug(&msgOut.info.traceId,
+          "vgId:%d, index:%" PRId64 ", replicate %d msgs to dest addr:0x%" PRIx64 ", term:%" PRId64
+          " prevterm:%" PRId64 ", bytes:%" PRId64,
+          pNode->vgId, index, nEntries, pDestId->addr, entries[nEntries - 1]->term, prevLogTerm, bytes);
+
+  TAOS_CHECK_GOTO(syncNodeSendAppendEntries(pNode, pDestId, &msgOut), &lino, _out);
+  msgOut.pCont = NULL;
+
+  for (int32_t i = 0; i < nEntries; i++) {
+    int64_t pos = entries[i]->index % pMgr->size;
+    pMgr->states[pos].barrier = syncLogReplBarrier(entries[i]);
+    pMgr->states[pos].timeMs = nowMs;
+    pMgr->states[pos].term = entries[i]->term;
+    pMgr->states[pos].acked = false;
+  }
+  *pSentIndex = entries[nEntries - 1]->index;
+
+_out:
+  rpcFreeCont(msgOut.pCont);
+  for (int32_t i = 0; i < nEntries; i++) {
+    if (!inBuf[i]) syncEntryDestroy(entries[i]);
+  }
+  TAOS_RETURN(code);
+}
+
 int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   if (!pMgr->restored) return TSDB_CODE_SYN_INTERNAL_ERROR;
 
@@ -1288,42 +1413,43 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   SyncTerm  term = -1;
   SyncIndex firstIndex = -1;
 
-  for (SyncIndex index = pMgr->endIndex; index <= pNode->pLogBuf->matchIndex; index++) {
+  for (SyncIndex index = pMgr->endIndex; index <= pNode->pLogBuf->matchIndex;) {
     if (batchSize < count || limit <= index - pMgr->startIndex) {
       break;
     }
     if (pMgr->startIndex + 1 < index && pMgr->states[(index - 1) % pMgr->size].barrier) {
       break;
     }
-    int64_t  pos = index % pMgr->size;
-    SRaftId* pDestId = &pNode->replicasId[pMgr->peerId];
-    bool     barrier = false;
-    SyncTerm term = -1;
+    SRaftId*  pDestId = &pNode->replicasId[pMgr->peerId];
+    SyncIndex lastIndex = TMIN(pNode->pLogBuf->matchIndex, pMgr->startIndex + limit - 1);
+    SyncIndex sentIndex = -1;
 
-    code = syncLogReplSendTo(pMgr, pNode, index, &term, pDestId, &barrier);
+    lastIndex = TMIN(lastIndex, index + batchSize - count);
+    code = syncLogReplSendBatchTo(pMgr, pNode, index, lastIndex, pDestId, nowMs, &sentIndex);
     if (code < 0) {
       sError("vgId:%d, failed to replicate log entry since %s, index:%" PRId64 ", dest addr:0x%016" PRIx64, pNode->vgId,
              tstrerror(code), index, pDestId->addr);
       TAOS_RETURN(code);
     }
-    pMgr->states[pos].barrier = barrier;
-    pMgr->states[pos].timeMs = nowMs;
-    pMgr->states[pos].term = term;
-    pMgr->states[pos].acked = false;
+    if (sentIndex < index) {
+      break;
+    }
 
     if (firstIndex == -1) {
       firstIndex = index;
     }
 
-    count++;
+    count += sentIndex - index + 1;
 
-    pMgr->endIndex = index + 1;
-    if (barrier) {
+    pMgr->endIndex = sentIndex + 1;
+    if (pMgr->states[sentIndex % pMgr->size].barrier) {
       sInfo("vgId:%d, replicated sync barrier to dnode:%d, index:%" PRId64 ", term:%" PRId64 ", repl-mgr:[%" PRId64
             " %" PRId64 ", %" PRId64 ")",
-            pNode->vgId, DID(pDestId), index, term, pMgr->startIndex, pMgr->matchIndex, pMgr->endIndex);
+            pNode->vgId, DID(pDestId), sentIndex, pMgr->states[sentIndex % pMgr->size].term, pMgr->startIndex,
+            pMgr->matchIndex, pMgr->endIndex);
       break;
     }
+    index = sentIndex + 1;
   }
 
   TAOS_CHECK_RETURN(syncLogReplRetryOnNeed(pMgr, pNode));
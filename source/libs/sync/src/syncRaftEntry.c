@@ -79,6 +79,29 @@ SSyncRaftEntry* syncEntryBuildFromAppendEntries(const SyncAppendEntries* pMsg) {
   return pEntry;
 }
 
+// build the entry at *pOffset of a msg carrying several entries, and move *pOffset to the next one
+SSyncRaftEntry* syncEntryBuildFromAppendEntriesAt(const SyncAppendEntries* pMsg, uint32_t* pOffset) {
+  uint32_t bytes = 0;
+  if (*pOffset + sizeof(SSyncRaftEntry) > pMsg->dataLen) {
+    terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
+    return NULL;
+  }
+  (void)memcpy(&bytes, pMsg->data + *pOffset + offsetof(SSyncRaftEntry, bytes), sizeof(bytes));
+  if (bytes < sizeof(SSyncRaftEntry) || bytes > pMsg->dataLen - *pOffset) {
+    terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
+    return NULL;
+  }
+
+  SSyncRaftEntry* pEntry = taosMemoryMalloc(bytes);
+  if (pEntry == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+  (void)memcpy(pEntry, pMsg->data + *pOffset, bytes);
+  *pOffset += bytes;
+  return pEntry;
+}
+
 SSyncRaftEntry* syncEntryBuildNoop(SyncTerm term, SyncIndex index, int32_t vgId) {
   SSyncRaftEntry* pEntry = syncEntryBuild(sizeof(SMsgHead));
   if (pEntry == NULL) return NULL;
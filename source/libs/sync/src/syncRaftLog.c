@@ -23,7 +23,9 @@
 
 // public function
 static int32_t   raftLogRestoreFromSnapshot(struct SSyncLogStore* pLogStore, SyncIndex snapshotIndex);
-static int32_t   raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync);
+static int32_t   raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync,
+                                    bool deferSync);
+static int32_t   raftLogGroupCommit(struct SSyncLogStore* pLogStore);
 static int32_t   raftLogTruncate(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
 static bool      raftLogExist(struct SSyncLogStore* pLogStore, SyncIndex index);
 static int32_t   raftLogUpdateCommitIndex(SSyncLogStore* pLogStore, SyncIndex index);
@@ -87,6 +89,7 @@ SSyncLogStore* logStoreCreate(SSyncNode* pSyncNode) {
   pLogStore->syncLogIndexRetention = raftLogIndexRetention;
   pLogStore->syncLogLastTerm = raftLogLastTerm;
   pLogStore->syncLogAppendEntry = raftLogAppendEntry;
+  pLogStore->syncLogGroupCommit = raftLogGroupCommit;
   pLogStore->syncLogGetEntry = raftLogGetEntry;
   pLogStore->syncLogTruncate = raftLogTruncate;
   pLogStore->syncLogWriteIndex = raftLogWriteIndex;
@@ -252,7 +255,8 @@ _exit:
 
   return code;
 }
-static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync) {
+static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync,
+                                  bool deferSync) {
   SSyncLogStoreData* pData = pLogStore->data;
   SWal*              pWal = pData->pWal;
 
@@ -280,7 +284,8 @@ static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntr
     TAOS_RETURN(err);
   }
 
-  code = walFsync(pWal, forceSync);
+  // a forced fsync, e.g. of a vnode commit, is never left to the group commit
+  code = (deferSync && !forceSync) ? walDeferFsync(pWal, false) : walFsync(pWal, forceSync);
   if (TSDB_CODE_SUCCESS != code) {
     sNError(pData->pSyncNode, "wal fsync failed since %s", tstrerror(code));
     TAOS_RETURN(code);
@@ -291,6 +296,16 @@ static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntr
   TAOS_RETURN(TSDB_CODE_SUCCESS);
 }
 
+static int32_t raftLogGroupCommit(struct SSyncLogStore* pLogStore) {
+  SSyncLogStoreData* pData = pLogStore->data;
+
+  int32_t code = walGroupCommit(pData->pWal);
+  if (TSDB_CODE_SUCCESS != code) {
+    sNError(pData->pSyncNode, "wal group commit failed since %s", tstrerror(code));
+  }
+  TAOS_RETURN(code);
+}
+
 // entry found, return 0
 // entry not found, return -1, terrno = TSDB_CODE_WAL_LOG_NOT_EXIST
 // other error, return -1
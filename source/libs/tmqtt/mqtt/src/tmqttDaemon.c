@@ -311,6 +311,7 @@ int32_t udfdOpenClientRpc() {
   rpcInit.parent = &global;
   rpcInit.rfp = udfdRpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlgorithm = tsCompressMsgAlgorithm;
 
   int32_t connLimitNum = tsNumOfRpcSessions / (tsNumOfRpcThreads * 3);
   connLimitNum = TMAX(connLimitNum, 10);
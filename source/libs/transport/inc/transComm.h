@@ -162,12 +162,12 @@ typedef struct {
 #define TRANS_VER 2
 typedef struct {
   char version : 4;       // RPC version
-  char comp : 2;          // compression algorithm, 0:no compression 1:lz4
+  char comp : 2;          // 0: no compression, 1: compressed, the algorithm is kept in STransCompMsg, 2: dictionary
   char noResp : 2;        // noResp bits, 0: resp, 1: resp
   char withUserInfo : 2;  // 0: sent user info or not
   char secured : 2;
-  char spi : 2;
-  char hasEpSet : 2;  // contain epset or not, 0(default): no epset, 1: contain epset
+  char compCap : 2;       // TRANS_COMP_CAP_XXX, the compression the sender is able to decompress
+  char hasEpSet : 2;      // contain epset or not, 0(default): no epset, 1: contain epset
 
   uint64_t timestamp;
   int32_t  compatibilityVer;
@@ -181,11 +181,45 @@ typedef struct {
   uint8_t  content[0];  // message body starts from here
 } STransMsgHead;
 
+// the 2 bits fields are signed char, read them through the masks
+#define TRANS_MSG_COMP(pHead)     ((pHead)->comp & 0x3)
+#define TRANS_MSG_COMP_CAP(pHead) ((int8_t)((pHead)->compCap & 0x3))
+
+#define TRANS_MSG_DICT 2  // comp of a frame carrying a dictionary for the msgs after it on the connection, no msg
+
+#define TRANS_COMP_LZ4       0  // legacy peers always leave STransCompMsg.algo as 0
+#define TRANS_COMP_ZSTD      1
+#define TRANS_COMP_ZSTD_DICT 2  // zstd with the dictionary of the msg type, the payload starts with the dictionary id
+
+#define TRANS_COMP_CAP_LZ4       0
+#define TRANS_COMP_CAP_ZSTD      1
+#define TRANS_COMP_CAP_ZSTD_DICT 2  // also dictionaries sent on the connection
+
+// zstd is not built into the util library on Windows and macOS, see zstdCompressLevelImpl
+#if defined(WINDOWS) || defined(DARWIN)
+#define TRANS_COMP_CAP TRANS_COMP_CAP_LZ4
+#else
+#define TRANS_COMP_CAP TRANS_COMP_CAP_ZSTD_DICT
+#endif
+
 typedef struct {
-  int32_t reserved;
+  int32_t algo;  // compression algorithm of the payload, TRANS_COMP_XXX
   int32_t contLen;
 } STransCompMsg;
 
+typedef struct {
+  int64_t count;
+  int64_t rawBytes;
+  int64_t compBytes;
+  int64_t compCostUs;
+  int64_t decompCostUs;
+} STransCompStat;
+
+typedef struct {
+  SArray*   pSent;  // ids of the dictionaries sent to the peer
+  SHashObj* pRecv;  // id -> dictionary received from the peer
+} STransConnDict;
+
 typedef struct {
   uint32_t timeStamp;
   uint8_t  auth[TSDB_AUTH_LEN];
@@ -520,6 +554,8 @@ int32_t     transDQCreate(uv_loop_t* loop, SDelayQueue** queue);
 void        transDQDestroy(SDelayQueue* queue, void (*freeFunc)(void* arg));
 SDelayTask* transDQSched(SDelayQueue* queue, void (*func)(void* arg), void* arg, uint64_t timeoutMs);
 void        transDQCancel(SDelayQueue* queue, SDelayTask* task);
+
+bool transGetDictToSend(STransConnDict* pConnDict, char* msg, uv_buf_t* pBuf);
 #endif
 
 bool transReqEpsetIsEqual(SReqEpSet* a, SReqEpSet* b);
@@ -535,9 +571,14 @@ void    transCleanup();
 void    transPrintEpSet(SEpSet* pEpSet);
 
 void    transFreeMsg(void* msg);
-int32_t transCompressMsg(char* msg, int32_t len);
-int32_t transDecompressMsg(char** msg, int32_t* len);
+int32_t transCompressMsg(char* msg, int32_t len, int8_t algo);
+int32_t transDecompressMsg(char** msg, int32_t* len, STransConnDict* pConnDict);
 int32_t transDecompressMsgExt(char const* msg, int32_t len, char** out, int32_t* outLen);
+int32_t transRecompressMsg(char* msg, int32_t len, int8_t algo);
+int8_t  transChooseCompAlgo(int8_t algo, int8_t peerCap);
+void    transGetCompStat(int8_t algo, STransCompStat* pStat);
+int32_t transRecvDict(STransConnDict* pConnDict, STransMsgHead* pHead, int32_t msgLen);
+void    transConnDictCleanup(STransConnDict* pConnDict);
 
 int32_t transOpenRefMgt(int size, void (*func)(void*));
 void    transCloseRefMgt(int32_t refMgt);
@@ -609,6 +650,39 @@ enum { REQ_STATUS_INIT = 0, REQ_STATUS_PROCESSING };
 #define READ_TIMEOUT        100000
 
 #ifndef TD_ASTRA_RPC
+#define TRANS_BATCH_SEND_MAX_MSGS   1024               // max msgs coalesced into one write
+#define TRANS_BATCH_SEND_MAX_BYTES  (4 * 1024 * 1024)  // max bytes coalesced into one write
+#define TRANS_BATCH_SEND_MIN_MSGS   16                 // shallower queues may wait for the in-flight write
+#define TRANS_BATCH_SEND_LATENCY_US 500                // max time a msg waits for the in-flight write
+
+typedef struct {
+  int64_t writes;     // write syscalls issued
+  int64_t msgs;       // msgs carried by these writes
+  int64_t bytes;      // bytes carried by these writes
+  int32_t maxMsgs;    // max msgs carried by one write
+  int32_t inflight;   // writes not completed yet
+  int64_t pendingTs;  // time the oldest unsent msg started to wait, 0 if none
+} STransSendStat;
+
+#define TRANS_LOCAL_SOCK_PATH_LEN 104  // the smallest sun_path among supported platforms
+#define TRANS_LOCAL_SOCK_RETRY_MS 30000  // how long a client keeps to tcp after a local socket failed
+#ifdef CUS_PROMPT
+#define TRANS_LOCAL_SOCK_DIR "/var/run/" CUS_PROMPT
+#else
+#define TRANS_LOCAL_SOCK_DIR "/var/run/taos"
+#endif
+
+bool transGetLocalSockPath(const char* fqdn, uint32_t port, char* path, int32_t len);
+bool transCheckLocalSockDir(bool create, int64_t* owner);
+bool transCheckLocalSockPeer(int32_t fd, int64_t owner);
+
+bool transSendMayDefer(STransSendStat* pStat, int32_t depth);
+void transSendStatOnWrite(STransSendStat* pStat, int32_t msgs, int32_t bytes, int32_t left);
+void transSendStatOnWriteDone(STransSendStat* pStat);
+void transSendStatPrint(STransSendStat* pStat, const char* label, void* conn);
+// totals of all the conns of the process
+void transGetSendStat(int64_t* writes, int64_t* msgs, int64_t* bytes);
+
 typedef struct {
   queue      node;  // queue for write
   queue      q;     // queue for reqs
@@ -62,6 +62,8 @@ typedef struct {
   char     user[TSDB_UNI_LEN];  // meter ID
   int32_t  compatibilityVer;
   int32_t  compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t   compressAlgorithm;  // 0: lz4, 1: zstd, 2: zstd with dictionaries, if the peer is able to decompress it
+  int8_t   localSock;          // talk to local endpoints through unix domain socket instead of tcp
   int8_t   encryption;    // encrypt or not
 
   int32_t retryMinInterval;  // retry init interval
@@ -118,6 +120,8 @@ typedef struct {
   char     user[TSDB_UNI_LEN];  // meter ID
   int32_t  compatibilityVer;
   int32_t  compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t   compressAlgorithm;  // 0: lz4, 1: zstd, 2: zstd with dictionaries, if the peer is able to decompress it
+  int8_t   localSock;          // talk to local endpoints through unix domain socket instead of tcp
   int8_t   encryption;    // encrypt or not
 
   int32_t retryMinInterval;  // retry init interval
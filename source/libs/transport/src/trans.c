@@ -57,6 +57,8 @@ void* rpcOpen(const SRpcInit* pInit) {
   }
 
   pRpc->encryption = pInit->encryption;
+  pRpc->compressAlgorithm = pInit->compressAlgorithm;
+  pRpc->localSock = pInit->localSock;
   pRpc->compatibilityVer = pInit->compatibilityVer;
 
   pRpc->retryMinInterval = pInit->retryMinInterval;  // retry init interval
@@ -265,6 +267,21 @@ int32_t rpcCvtErrCode(int32_t code) {
   return code;
 }
 
+void rpcGetStat(SRpcStat* pStat) {
+  int8_t algos[] = {TRANS_COMP_LZ4, TRANS_COMP_ZSTD, TRANS_COMP_ZSTD_DICT};
+
+  (void)memset(pStat, 0, sizeof(*pStat));
+  for (int32_t i = 0; i < tListLen(algos); i++) {
+    STransCompStat stat = {0};
+    transGetCompStat(algos[i], &stat);
+    pStat->compRawBytes += stat.rawBytes;
+    pStat->compBytes += stat.compBytes;
+    pStat->compCostUs += stat.compCostUs;
+    pStat->decompCostUs += stat.decompCostUs;
+  }
+  transGetSendStat(&pStat->sendWrites, &pStat->sendMsgs, &pStat->sendBytes);
+}
+
 int32_t rpcInit() { return transInit(); }
 
 void rpcCleanup(void) {
@@ -320,6 +337,8 @@ void* rpcOpen(const SRpcInit* pInit) {
   }
 
   pRpc->encryption = pInit->encryption;
+  pRpc->compressAlgorithm = pInit->compressAlgorithm;
+  pRpc->localSock = pInit->localSock;
   pRpc->compatibilityVer = pInit->compatibilityVer;
 
   pRpc->retryMinInterval = pInit->retryMinInterval;  // retry init interval
@@ -569,6 +588,8 @@ int32_t rpcCvtErrCode(int32_t code) {
   return code;
 }
 
+void rpcGetStat(SRpcStat* pStat) { (void)memset(pStat, 0, sizeof(*pStat)); }
+
 int32_t rpcInit() { return transInit(); }
 
 void rpcCleanup(void) {
@@ -74,6 +74,9 @@ typedef struct SCliConn {
   SHashObj* pQTable;
   int8_t    userInited;
   void*     pInitUserReq;
+  int8_t    peerCompCap;  // algorithms the peer is able to decompress, TRANS_COMP_CAP_*
+
+  STransConnDict dict;  // msg dictionaries sent to and received from the peer
 
   void*   heap;  // point to req conn heap
   int32_t heapMissHit;
@@ -89,10 +92,15 @@ typedef struct SCliConn {
   queue  batchSendq;
   int8_t inThreadSendq;
 
+  STransSendStat sendStat;
+
   STransTLS* pTls;
   int8_t     enableSSL;  // enable SSL or not
   int8_t     sslConnected;
 
+  int8_t  localSock;       // connected through unix domain socket, stream is uv_pipe_t
+  int64_t localSockOwner;  // uid expected to serve the local socket
+
 } SCliConn;
 
 typedef struct {
@@ -152,6 +160,8 @@ typedef struct SCliThrd {
   SArray* pQIdBuf;  // tmp buf to avoid alloc buf;
   queue   batchSendSet;
   int8_t  thrdInited;
+
+  int64_t localSockFailTs;  // last time a local socket failed, tcp is used for a while after it
 } SCliThrd;
 
 typedef struct SCliObj {
@@ -181,6 +191,7 @@ static int32_t cliDoConn(SCliThrd* pThrd, SCliConn* conn);
 static void    cliBatchSendCb(uv_write_t* req, int status);
 void           cliBatchSendImpl(SCliConn* pConn);
 static int32_t cliBatchSend(SCliConn* conn, int8_t direct);
+static int8_t  cliMayUseLocalSock(SCliThrd* pThrd, char* ip, int32_t port, int64_t* owner);
 void           cliConnCheckTimoutMsg(SCliConn* conn);
 bool           cliConnRmReleaseReq(SCliConn* conn, STransMsgHead* pHead);
 static int32_t cliConnStartRead(SCliConn* conn);
@@ -666,11 +677,21 @@ void cliHandleResp(SCliConn* conn) {
     return;
   }
 
-  if ((code = transDecompressMsg((char**)&pHead, &msgLen)) < 0) {
+  if (TRANS_MSG_COMP(pHead) == TRANS_MSG_DICT) {
+    // a msg dictionary the server sends ahead of the first msg compressed with it
+    if ((code = transRecvDict(&conn->dict, pHead, msgLen)) != 0) {
+      tWarn("%s conn:%p, failed to recv msg dictionary since %s", CONN_GET_INST_LABEL(conn), conn, tstrerror(code));
+    }
+    taosMemoryFree(pHead);
+    return;
+  }
+
+  if ((code = transDecompressMsg((char**)&pHead, &msgLen, &conn->dict)) < 0) {
     tDebug("%s conn:%p, recv invalid packet, failed to decompress", CONN_GET_INST_LABEL(conn), conn);
     // TODO: notify cb
     return;
   }
+  conn->peerCompCap = TRANS_MSG_COMP_CAP(pHead);
   int64_t qId = taosHton64(pHead->qid);
   pHead->code = htonl(pHead->code);
   pHead->msgLen = htonl(pHead->msgLen);
@@ -1121,13 +1142,18 @@ static int32_t cliCreateConn(SCliThrd* pThrd, SCliConn** pCliConn, char* ip, int
   TAOS_CHECK_GOTO(cliGetConnTimer(pThrd, conn), &lino, _failed);
 
   // read/write stream handle
-  conn->stream = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
+  conn->localSock = cliMayUseLocalSock(pThrd, ip, port, &conn->localSockOwner);
+  conn->stream = (uv_stream_t*)taosMemoryMalloc(conn->localSock ? sizeof(uv_pipe_t) : sizeof(uv_tcp_t));
   if (conn->stream == NULL) {
     code = terrno;
     TAOS_CHECK_GOTO(code, NULL, _failed);
   }
 
-  code = uv_tcp_init(pThrd->loop, (uv_tcp_t*)(conn->stream));
+  if (conn->localSock) {
+    code = uv_pipe_init(pThrd->loop, (uv_pipe_t*)(conn->stream), 0);
+  } else {
+    code = uv_tcp_init(pThrd->loop, (uv_tcp_t*)(conn->stream));
+  }
   if (code != 0) {
     tError("failed to init tcp handle, code:%d, %s", code, uv_strerror(code));
     code = TSDB_CODE_THIRDPARTY_ERROR;
@@ -1197,7 +1223,8 @@ static void cliDestroyAllQidFromThrd(SCliConn* conn) {
 static void cliDestroyConn(SCliConn* conn, bool clear) { cliHandleException(conn); }
 static void cliDestroy(uv_handle_t* handle) {
   int32_t code = 0;
-  if (uv_handle_get_type(handle) != UV_TCP || handle->data == NULL) {
+  uv_handle_type type = uv_handle_get_type(handle);
+  if ((type != UV_TCP && type != UV_NAMED_PIPE) || handle->data == NULL) {
     return;
   }
   SCliConn* conn = handle->data;
@@ -1205,6 +1232,7 @@ static void cliDestroy(uv_handle_t* handle) {
   cliResetConnTimer(conn);
 
   tDebug("%s conn:%p, try to destroy", CONN_GET_INST_LABEL(conn), conn);
+  transSendStatPrint(&conn->sendStat, CONN_GET_INST_LABEL(conn), conn);
 
   code = destroyAllReqs(conn);
   if (code != 0) {
@@ -1233,6 +1261,7 @@ static void cliDestroy(uv_handle_t* handle) {
   destroyWQ(&conn->wq);
 
   transDestroyBuffer(&conn->readBuf);
+  transConnDictCleanup(&conn->dict);
 
   tTrace("%s conn:%p, destroy successfully", CONN_GET_INST_LABEL(conn), conn);
 
@@ -1446,6 +1475,7 @@ static void cliBatchSendCb(uv_write_t* req, int status) {
     removeReqFromSendQ(pReq);
   }
   freeWReqToWQ(&conn->wq, wrapper);
+  transSendStatOnWriteDone(&conn->sendStat);
 
   int32_t ref = transUnrefCliHandle(conn);
   if (ref <= 0) {
@@ -1559,20 +1589,27 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
     tTrace("%s conn:%p, msg is sent", pInst->label, pConn);
     return 0;
   }
+  if (transSendMayDefer(&pConn->sendStat, size)) {
+    tTrace("%s conn:%p, %d msg wait for in-flight write", pInst->label, pConn, size);
+    return 0;
+  }
+  size = TMIN(size, TRANS_BATCH_SEND_MAX_MSGS);
+
+  // each msg may be preceded by the frame of the dictionary it is compressed with
   uv_buf_t* wb = NULL;
-  if (pConn->bufSize < size) {
-    uv_buf_t* twb = (uv_buf_t*)taosMemoryRealloc(pConn->buf, size * sizeof(uv_buf_t));
+  if (pConn->bufSize < size * 2) {
+    uv_buf_t* twb = (uv_buf_t*)taosMemoryRealloc(pConn->buf, size * 2 * sizeof(uv_buf_t));
     if (twb == NULL) {
       return TSDB_CODE_OUT_OF_MEMORY;
     }
     pConn->buf = twb;
-    pConn->bufSize = size;
+    pConn->bufSize = size * 2;
   }
 
   wb = pConn->buf;
 
-  int     j = 0;
-  int32_t batchLimit = 64;
+  int j = 0;
+  int numOfMsgs = 0;
 
   queue reqToSend;
   QUEUE_INIT(&reqToSend);
@@ -1587,7 +1624,8 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
     if (pReq->pCont == 0) {
       pReq->pCont = (void*)rpcMallocCont(0);
       if (pReq->pCont == NULL) {
-        return TSDB_CODE_OUT_OF_MEMORY;
+        notifyAndDestroyReq(pConn, pCliMsg, terrno);
+        continue;
       }
       pReq->contLen = 0;
     }
@@ -1602,7 +1640,10 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
       contLen = transContLenFromMsg(msgLen);
     } else {
       if (pConn->userInited == 0) {
-        return terrno;
+        tError("%s conn:%p, failed to add user info to msg %s", CONN_GET_INST_LABEL(pConn), pConn,
+               TMSG_INFO(pReq->msgType));
+        notifyAndDestroyReq(pConn, pCliMsg, TSDB_CODE_INVALID_MSG);
+        continue;
       }
     }
     if (pHead->comp == 0) {
@@ -1613,6 +1654,7 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
       pHead->magicNum = htonl(TRANS_MAGIC_NUM);
       pHead->version = TRANS_VER;
       pHead->compatibilityVer = htonl(pInst->compatibilityVer);
+      pHead->compCap = TRANS_COMP_CAP;
     }
     pHead->timestamp = taosHton64(pCliMsg->st);
     pHead->seqNum = taosHton64(pConn->seq);
@@ -1620,14 +1662,31 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
 
     if (pHead->comp == 0) {
       if (pInst->compressSize != -1 && pInst->compressSize < contLen) {
-        msgLen = transCompressMsg(content, contLen) + sizeof(STransMsgHead);
+        int8_t algo = transChooseCompAlgo(pInst->compressAlgorithm, pConn->peerCompCap);
+        msgLen = transCompressMsg(content, contLen, algo) + sizeof(STransMsgHead);
         pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
       }
     } else {
       msgLen = (int32_t)ntohl((uint32_t)(pHead->msgLen));
+      // a retried msg keeps the compression chosen for its previous peer, which this peer may not decode
+      int32_t compLen = transRecompressMsg(content, msgLen - sizeof(STransMsgHead),
+                                           transChooseCompAlgo(pInst->compressAlgorithm, pConn->peerCompCap));
+      if (compLen < 0) {
+        // the msg is left compressed for the previous peer, fail it alone and go on with the others
+        tError("%s conn:%p, failed to recompress msg %s since %s", CONN_GET_INST_LABEL(pConn), pConn,
+               TMSG_INFO(pReq->msgType), tstrerror(compLen));
+        notifyAndDestroyReq(pConn, pCliMsg, compLen);
+        continue;
+      }
+      msgLen = compLen + sizeof(STransMsgHead);
+      pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
+    }
+    if (transGetDictToSend(&pConn->dict, content, &wb[j])) {
+      totalLen += wb[j++].len;
     }
     wb[j++] = uv_buf_init((char*)pHead, msgLen);
     totalLen += msgLen;
+    numOfMsgs++;
 
     pCliMsg->seq = pConn->seq;
     pCliMsg->sent = 1;
@@ -1641,10 +1700,13 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
     QUEUE_PUSH(&reqToSend, &pCliMsg->sendQ);
 
     pCliMsg->inSendQ = 1;
-    if (j >= batchLimit) {
+    if (numOfMsgs >= size || totalLen >= TRANS_BATCH_SEND_MAX_BYTES) {
       break;
     }
   }
+  if (j == 0) {
+    return 0;  // every msg popped failed
+  }
   transRefCliHandle(pConn);
   uv_write_t* req = allocWReqFromWQ(&pConn->wq, pConn);
 
@@ -1663,7 +1725,7 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
   SWReqsWrapper* pWreq = req->data;
 
   QUEUE_MOVE(&reqToSend, &pWreq->node);
-  tTrace("%s conn:%p, start to send msg, batch size:%d, len:%d", CONN_GET_INST_LABEL(pConn), pConn, j, totalLen);
+  tTrace("%s conn:%p, start to send msg, batch size:%d, len:%d", CONN_GET_INST_LABEL(pConn), pConn, numOfMsgs, totalLen);
 
   if (pConn->enableSSL == 0) {
     int32_t ret = uv_write(req, (uv_stream_t*)pConn->stream, wb, j, cliBatchSendCb);
@@ -1684,6 +1746,8 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
 
     freeWReqToWQ(&pConn->wq, req->data);
     TAOS_UNUSED(transUnrefCliHandle(pConn));
+  } else {
+    transSendStatOnWrite(&pConn->sendStat, numOfMsgs, totalLen, transQueueSize(&pConn->reqsToSend));
   }
 
   return code;
@@ -1713,6 +1777,76 @@ int32_t cliBuildSockByIpType(SIpAddr* ipAddr, struct sockaddr* addr) {
   }
   return 0;
 }
+static int8_t cliMayUseLocalSock(SCliThrd* pThrd, char* ip, int32_t port, int64_t* owner) {
+  STrans* pInst = pThrd->pInst;
+  char    path[PATH_MAX] = {0};
+  if (!pInst->localSock || pInst->enableSSL) {
+    return 0;
+  }
+  if (strcmp(ip, tsLocalFqdn) != 0 && strcmp(ip, "localhost") != 0 && strcmp(ip, "127.0.0.1") != 0 &&
+      strcmp(ip, "::1") != 0) {
+    return 0;
+  }
+  if (taosGetTimestampMs() - pThrd->localSockFailTs < TRANS_LOCAL_SOCK_RETRY_MS) {
+    return 0;
+  }
+  // the socket file exists only if the server on this host listens on it, or left by a server stopped
+  if (!transGetLocalSockPath(tsLocalFqdn, port, path, sizeof(path)) ||
+      !taosCheckAccessFile(path, TD_FILE_ACCESS_EXIST_OK | TD_FILE_ACCESS_WRITE_OK) ||
+      !transCheckLocalSockDir(false, owner)) {
+    return 0;
+  }
+  return 1;
+}
+
+static bool cliCheckLocalSockPeer(SCliConn* conn) {
+  uv_os_fd_t fd;
+  if (uv_fileno((uv_handle_t*)conn->stream, &fd) != 0) {
+    return false;
+  }
+  return transCheckLocalSockPeer((int32_t)(intptr_t)fd, conn->localSockOwner);
+}
+
+static int32_t cliDoLocalConn(SCliThrd* pThrd, SCliConn* conn) {
+  int32_t lino = 0;
+  int32_t code = 0;
+  STrans* pInst = pThrd->pInst;
+  char    path[PATH_MAX] = {0};
+
+  if (!transGetLocalSockPath(tsLocalFqdn, conn->port, path, sizeof(path))) {
+    TAOS_CHECK_GOTO(TSDB_CODE_INVALID_PARA, &lino, _exception1);
+  }
+  tTrace("%s conn:%p, try to connect to %s through %s", pInst->label, conn, conn->dstAddr, path);
+
+  transRefCliHandle(conn);
+
+  conn->list = taosHashGet((SHashObj*)pThrd->pool, conn->dstAddr, strlen(conn->dstAddr));
+  if (conn->list != NULL) {
+    conn->list->totalSize += 1;
+  }
+
+  uv_pipe_connect(&conn->connReq, (uv_pipe_t*)(conn->stream), path, cliConnCb);
+
+  conn->registered = 1;
+  transRefCliHandle(conn);
+  int ret = uv_timer_start(conn->timer, cliConnTimeout, TRANS_CONN_TIMEOUT, 0);
+  if (ret != 0) {
+    tError("%s conn:%p, failed to start timer since %s", transLabel(pInst), conn, uv_err_name(ret));
+    TAOS_CHECK_GOTO(TSDB_CODE_THIRDPARTY_ERROR, &lino, _exception2);
+  }
+  return TSDB_CODE_RPC_ASYNC_IN_PROCESS;
+
+_exception1:
+  tError("%s conn:%p, failed to do connect since %s", transLabel(pInst), conn, tstrerror(code));
+  cliDestroyConn(conn, true);
+  return code;
+
+_exception2:
+  TAOS_UNUSED(transUnrefCliHandle(conn));
+  tError("%s conn:%p, failed to do connect since %s", transLabel(pInst), conn, tstrerror(code));
+  return code;
+}
+
 static int32_t cliDoConn(SCliThrd* pThrd, SCliConn* conn) {
   int32_t lino = 0;
   STrans* pInst = pThrd->pInst;
@@ -1721,6 +1855,10 @@ static int32_t cliDoConn(SCliThrd* pThrd, SCliConn* conn) {
   struct sockaddr_storage addr;
   SIpAddr                 ipaddr;
 
+  if (conn->localSock) {
+    return cliDoLocalConn(pThrd, conn);
+  }
+
   int32_t code = cliGetIpFromFqdnCache(pThrd->fqdn2ipCache, conn->ipStr, &ipaddr, pInst->ipv6);
   TAOS_CHECK_GOTO(code, &lino, _exception1);
 
@@ -1803,6 +1941,12 @@ int32_t cliConnSetSockInfo(SCliConn* pConn) {
   struct sockaddr_storage peername, sockname;
   int                     addrlen = sizeof(peername);
 
+  if (pConn->localSock) {
+    tstrncpy(pConn->dst, pConn->dstAddr, sizeof(pConn->dst));
+    tstrncpy(pConn->src, "local", sizeof(pConn->src));
+    return 0;
+  }
+
   int32_t code = uv_tcp_getpeername((uv_tcp_t*)pConn->stream, (struct sockaddr*)&peername, &addrlen);
   if (code != 0) {
     tWarn("failed to get perrname since %s", uv_err_name(code));
@@ -1848,6 +1992,17 @@ void cliConnCb(uv_connect_t* req, int status) {
     tError("%s conn:%p, failed to connect to %s since %s", CONN_GET_INST_LABEL(pConn), pConn, pConn->dstAddr,
            uv_strerror(status));
     cliMayUpdateFqdnCache(pThrd->fqdn2ipCache, pConn->dstAddr);
+    if (pConn->localSock) {
+      // most likely a socket left by a stopped server, the retry goes through tcp
+      pThrd->localSockFailTs = taosGetTimestampMs();
+    }
+    TAOS_CHECK_GOTO(TSDB_CODE_THIRDPARTY_ERROR, &lino, _error);
+  }
+
+  if (pConn->localSock && !cliCheckLocalSockPeer(pConn)) {
+    tError("%s conn:%p, local socket of %s not served by its owner, use tcp instead", CONN_GET_INST_LABEL(pConn),
+           pConn, pConn->dstAddr);
+    pThrd->localSockFailTs = taosGetTimestampMs();
     TAOS_CHECK_GOTO(TSDB_CODE_THIRDPARTY_ERROR, &lino, _error);
   }
 
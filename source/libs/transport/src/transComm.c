@@ -15,6 +15,7 @@
 
 #include "transComm.h"
 #include "osTime.h"
+#include "tcompression.h"
 #include "tqueue.h"
 #include "transLog.h"
 
@@ -30,12 +31,417 @@ static int32_t transSyncMsgMgt;
 
 void transDestroySyncMsg(void* msg);
 
-int32_t transCompressMsg(char* msg, int32_t len) {
+#define TRANS_ZSTD_LEVEL 3  // rpc favors latency, higher levels cost far more cpu for little gain
+
+#define TRANS_DICT_SIZE        (16 * 1024)  // capacity of a trained dictionary
+#define TRANS_DICT_SAMPLES     64           // msgs of a msg type its dictionary is trained with
+#define TRANS_DICT_SAMPLE_SIZE (4 * 1024)   // only the head of a msg is sampled, schemas and tag names repeat there
+#define TRANS_DICT_CONN_MAX    64           // dictionaries a connection may receive from its peer
+
+static STransCompStat transCompStat[TRANS_COMP_ZSTD_DICT + 1];
+
+#define TRANS_COMP_STAT(algo) \
+  (&transCompStat[((algo) >= TRANS_COMP_LZ4 && (algo) <= TRANS_COMP_ZSTD_DICT) ? (algo) : TRANS_COMP_LZ4])
+
+/*
+ * A dictionary is trained for each msg type from the first msgs of the type compressed with TRANS_COMP_ZSTD_DICT in
+ * the process, and it is never replaced. It is sent on a connection as a frame of its own, ahead of the first msg
+ * compressed with it, so the peer keeps the dictionaries by id for each connection.
+ */
+typedef struct {
+  int32_t id;
+  int32_t msgType;
+  void*   pCDict;
+  void*   pDDict;    // msgs compressed with it are decompressed again to add user info or before a retry
+  char*   pFrame;    // STransMsgHead, id and the dictionary
+  int32_t frameLen;
+} STransDict;
+
+typedef struct {
+  int32_t     numOfSamples;
+  int32_t     len;
+  char*       pSamples;
+  size_t      sizes[TRANS_DICT_SAMPLES];
+  bool        training;
+  bool        failed;  // msgs of the type stay on plain zstd
+  STransDict* pDict;
+} STransDictSlot;
+
+static TdThreadMutex transDictMutex;
+static SHashObj*     transDictSlots;  // msgType -> STransDictSlot
+static SHashObj*     transDicts;      // id -> STransDict*
+static int32_t       transDictId;
+
+static void transDestroyDict(STransDict* pDict) {
+  if (pDict == NULL) {
+    return;
+  }
+  if (pDict->pCDict != NULL) zstdFreeCDictImpl(pDict->pCDict);
+  if (pDict->pDDict != NULL) zstdFreeDDictImpl(pDict->pDDict);
+  taosMemoryFree(pDict->pFrame);
+  taosMemoryFree(pDict);
+}
+
+static void transInitDictMgt() {
+  if (taosThreadMutexInit(&transDictMutex, NULL) != 0) {
+    tError("failed to init rpc msg dictionary mutex");
+    return;
+  }
+  transDictSlots = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT), true, HASH_NO_LOCK);
+  transDicts = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT), true, HASH_NO_LOCK);
+  if (transDictSlots == NULL || transDicts == NULL) {
+    tError("failed to init rpc msg dictionaries since %s", tstrerror(terrno));
+  }
+}
+
+static void transDestroyDictMgt() {
+  if (transDictSlots == NULL && transDicts == NULL) {
+    return;
+  }
+  void* p = taosHashIterate(transDictSlots, NULL);
+  while (p != NULL) {
+    taosMemoryFree(((STransDictSlot*)p)->pSamples);
+    transDestroyDict(((STransDictSlot*)p)->pDict);
+    p = taosHashIterate(transDictSlots, p);
+  }
+  taosHashCleanup(transDictSlots);
+  taosHashCleanup(transDicts);
+  transDictSlots = NULL;
+  transDicts = NULL;
+  (void)taosThreadMutexDestroy(&transDictMutex);
+}
+
+static STransDict* transTrainDict(int32_t msgType, const char* pSamples, const size_t* sizes, int32_t numOfSamples) {
+  int32_t     code = 0;
+  int32_t     dictLen = TRANS_DICT_SIZE;
+  int32_t     hdrLen = sizeof(STransMsgHead) + sizeof(int32_t);
+  int64_t     start = taosGetTimestampUs();
+  STransDict* pDict = taosMemoryCalloc(1, sizeof(STransDict));
+  if (pDict == NULL) {
+    return NULL;
+  }
+
+  pDict->pFrame = taosMemoryCalloc(1, hdrLen + TRANS_DICT_SIZE);
+  if (pDict->pFrame == NULL) {
+    transDestroyDict(pDict);
+    return NULL;
+  }
+
+  char* pData = pDict->pFrame + hdrLen;
+  code = zstdTrainDictImpl(pSamples, sizes, numOfSamples, pData, &dictLen);
+  if (code != 0) {
+    tInfo("no rpc msg dictionary for %s, failed to train it from %d msgs", TMSG_INFO(msgType), numOfSamples);
+    transDestroyDict(pDict);
+    return NULL;
+  }
+
+  pDict->pCDict = zstdCreateCDictImpl(pData, dictLen, TRANS_ZSTD_LEVEL);
+  pDict->pDDict = zstdCreateDDictImpl(pData, dictLen);
+  if (pDict->pCDict == NULL || pDict->pDDict == NULL) {
+    transDestroyDict(pDict);
+    return NULL;
+  }
+
+  pDict->id = atomic_add_fetch_32(&transDictId, 1);
+  pDict->msgType = msgType;
+  pDict->frameLen = hdrLen + dictLen;
+
+  STransMsgHead* pHead = (STransMsgHead*)pDict->pFrame;
+  pHead->version = TRANS_VER;
+  pHead->comp = TRANS_MSG_DICT;
+  pHead->compCap = TRANS_COMP_CAP;
+  pHead->magicNum = htonl(TRANS_MAGIC_NUM);
+  pHead->msgType = msgType;
+  pHead->msgLen = htonl(pDict->frameLen);
+  int32_t id = htonl(pDict->id);
+  memcpy(pHead->content, &id, sizeof(id));
+
+  tInfo("rpc msg dictionary:%d trained for %s from %d msgs, size:%d, cost:%" PRId64 "us", pDict->id,
+        TMSG_INFO(msgType), numOfSamples, dictLen, taosGetTimestampUs() - start);
+  return pDict;
+}
+
+// Get the dictionary of the msg type. Until there is one, the msg is kept as a sample to train it.
+static STransDict* transGetMsgDict(int32_t msgType, const char* msg, int32_t len) {
+  STransDict*     pDict = NULL;
+  STransDictSlot* pSlot = NULL;
+  char*           pSamples = NULL;
+  int32_t         numOfSamples = 0;
+  size_t          sizes[TRANS_DICT_SAMPLES] = {0};
+
+  if (transDictSlots == NULL || transDicts == NULL) {
+    return NULL;
+  }
+
+  (void)taosThreadMutexLock(&transDictMutex);
+  pSlot = taosHashGet(transDictSlots, &msgType, sizeof(msgType));
+  if (pSlot == NULL) {
+    STransDictSlot slot = {0};
+    if (taosHashPut(transDictSlots, &msgType, sizeof(msgType), &slot, sizeof(slot)) == 0) {
+      pSlot = taosHashGet(transDictSlots, &msgType, sizeof(msgType));
+    }
+  }
+  if (pSlot == NULL || pSlot->failed || pSlot->training || pSlot->pDict != NULL) {
+    pDict = pSlot ? pSlot->pDict : NULL;
+    (void)taosThreadMutexUnlock(&transDictMutex);
+    return pDict;
+  }
+
+  if (pSlot->pSamples == NULL) {
+    pSlot->pSamples = taosMemoryMalloc(TRANS_DICT_SAMPLES * TRANS_DICT_SAMPLE_SIZE);
+    if (pSlot->pSamples == NULL) {
+      (void)taosThreadMutexUnlock(&transDictMutex);
+      return NULL;
+    }
+  }
+
+  int32_t size = TMIN(len, TRANS_DICT_SAMPLE_SIZE);
+  memcpy(pSlot->pSamples + pSlot->len, msg, size);
+  pSlot->len += size;
+  pSlot->sizes[pSlot->numOfSamples++] = size;
+  if (pSlot->numOfSamples < TRANS_DICT_SAMPLES) {
+    (void)taosThreadMutexUnlock(&transDictMutex);
+    return NULL;
+  }
+
+  // the training takes a few milliseconds, the other threads go on with plain zstd meanwhile
+  pSlot->training = true;
+  pSamples = pSlot->pSamples;
+  numOfSamples = pSlot->numOfSamples;
+  memcpy(sizes, pSlot->sizes, sizeof(sizes));
+  pSlot->pSamples = NULL;
+  (void)taosThreadMutexUnlock(&transDictMutex);
+
+  pDict = transTrainDict(msgType, pSamples, sizes, numOfSamples);
+  taosMemoryFree(pSamples);
+
+  (void)taosThreadMutexLock(&transDictMutex);
+  pSlot = taosHashGet(transDictSlots, &msgType, sizeof(msgType));
+  if (pDict != NULL && taosHashPut(transDicts, &pDict->id, sizeof(pDict->id), &pDict, POINTER_BYTES) != 0) {
+    transDestroyDict(pDict);
+    pDict = NULL;
+  }
+  pSlot->training = false;
+  pSlot->failed = (pDict == NULL);
+  pSlot->pDict = pDict;
+  (void)taosThreadMutexUnlock(&transDictMutex);
+  return pDict;
+}
+
+static STransDict* transGetDictById(int32_t id) {
+  STransDict* pDict = NULL;
+  if (transDicts == NULL) {
+    return NULL;
+  }
+
+  (void)taosThreadMutexLock(&transDictMutex);
+  STransDict** ppDict = taosHashGet(transDicts, &id, sizeof(id));
+  if (ppDict != NULL) {
+    pDict = *ppDict;
+  }
+  (void)taosThreadMutexUnlock(&transDictMutex);
+  return pDict;
+}
+
+static int32_t transDictIdOfMsg(const char* cont) {
+  STransMsgHead* pHead = transHeadFromCont(cont);
+  STransCompMsg* pComp = (STransCompMsg*)cont;
+  int32_t        id = 0;
+  if (TRANS_MSG_COMP(pHead) != 1 || ntohl(pComp->algo) != TRANS_COMP_ZSTD_DICT) {
+    return 0;
+  }
+  memcpy(&id, cont + sizeof(STransCompMsg), sizeof(id));
+  return ntohl(id);
+}
+
+// Get the frame of the dictionary the msg is compressed with, if the dictionary is not sent on the connection yet.
+bool transGetDictToSend(STransConnDict* pConnDict, char* msg, uv_buf_t* pBuf) {
+  int32_t id = transDictIdOfMsg(msg);
+  if (id == 0) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pConnDict->pSent); ++i) {
+    if (*(int32_t*)taosArrayGet(pConnDict->pSent, i) == id) {
+      return false;
+    }
+  }
+
+  STransDict* pDict = transGetDictById(id);
+  if (pDict == NULL) {
+    return false;
+  }
+
+  // sent again with the next msg if it can not be recorded, the peer replaces it
+  if (pConnDict->pSent == NULL) {
+    pConnDict->pSent = taosArrayInit(4, sizeof(int32_t));
+  }
+  if (pConnDict->pSent != NULL && taosArrayPush(pConnDict->pSent, &id) == NULL) {
+    tWarn("failed to record rpc msg dictionary:%d sent since %s", id, tstrerror(terrno));
+  }
+
+  *pBuf = uv_buf_init(pDict->pFrame, pDict->frameLen);
+  return true;
+}
+
+static void transFreeRecvDict(void* p) { zstdFreeDDictImpl(*(void**)p); }
+
+int32_t transRecvDict(STransConnDict* pConnDict, STransMsgHead* pHead, int32_t msgLen) {
+  int32_t id = 0;
+  int32_t dictLen = msgLen - (int32_t)sizeof(STransMsgHead) - (int32_t)sizeof(id);
+  if (dictLen <= 0) {
+    return TSDB_CODE_INVALID_MSG;
+  }
+  memcpy(&id, pHead->content, sizeof(id));
+  id = ntohl(id);
+
+  if (pConnDict->pRecv == NULL) {
+    pConnDict->pRecv = taosHashInit(4, taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT), true, HASH_NO_LOCK);
+    if (pConnDict->pRecv == NULL) {
+      return terrno;
+    }
+    taosHashSetFreeFp(pConnDict->pRecv, transFreeRecvDict);
+  }
+
+  (void)taosHashRemove(pConnDict->pRecv, &id, sizeof(id));
+  if (taosHashGetSize(pConnDict->pRecv) >= TRANS_DICT_CONN_MAX) {
+    tError("too many rpc msg dictionaries received on the connection, dictionary:%d", id);
+    return TSDB_CODE_INVALID_MSG;
+  }
+
+  void* pDDict = zstdCreateDDictImpl(pHead->content + sizeof(id), dictLen);
+  if (pDDict == NULL) {
+    return TSDB_CODE_INVALID_MSG;
+  }
+  int32_t code = taosHashPut(pConnDict->pRecv, &id, sizeof(id), &pDDict, POINTER_BYTES);
+  if (code != 0) {
+    zstdFreeDDictImpl(pDDict);
+    return code;
+  }
+
+  tDebug("recv rpc msg dictionary:%d for %s, size:%d", id, TMSG_INFO(pHead->msgType), dictLen);
+  return 0;
+}
+
+void transConnDictCleanup(STransConnDict* pConnDict) {
+  taosArrayDestroy(pConnDict->pSent);
+  taosHashCleanup(pConnDict->pRecv);
+  pConnDict->pSent = NULL;
+  pConnDict->pRecv = NULL;
+}
+
+static int32_t transDoCompress(int8_t algo, STransDict* pDict, char* src, int32_t len, char* dst, int32_t cap) {
+  int32_t dstLen = cap;
+  if (algo == TRANS_COMP_ZSTD_DICT) {
+    int32_t id = htonl(pDict->id);
+    memcpy(dst, &id, sizeof(id));
+    dstLen = cap - sizeof(id);
+    if (zstdCompressDictImpl(src, len, dst + sizeof(id), &dstLen, pDict->pCDict) != 0) {
+      return 0;
+    }
+    return dstLen + sizeof(id);
+  } else if (algo == TRANS_COMP_ZSTD) {
+    if (zstdCompressLevelImpl(src, len, dst, &dstLen, TRANS_ZSTD_LEVEL) != 0) {
+      return 0;
+    }
+    return dstLen;
+  }
+  return LZ4_compress_default(src, dst, len, cap);
+}
+
+// The dictionaries of a received msg are those sent by the peer on the connection, while a msg of this process is
+// compressed with a dictionary of its own.
+static int32_t transDoDecompress(int32_t algo, STransConnDict* pConnDict, char* src, int32_t len, char* dst,
+                                 int32_t oriLen) {
+  int64_t start = taosGetTimestampUs();
+  int32_t decompLen = -1;
+  int32_t dstLen = oriLen;
+  if (algo == TRANS_COMP_ZSTD_DICT) {
+    int32_t id = 0;
+    void*   pDDict = NULL;
+    if (len > sizeof(id)) {
+      memcpy(&id, src, sizeof(id));
+      id = ntohl(id);
+      if (pConnDict != NULL) {
+        void** pp = pConnDict->pRecv ? taosHashGet(pConnDict->pRecv, &id, sizeof(id)) : NULL;
+        pDDict = pp ? *pp : NULL;
+      } else {
+        STransDict* pDict = transGetDictById(id);
+        pDDict = pDict ? pDict->pDDict : NULL;
+      }
+    }
+    if (pDDict == NULL) {
+      tError("rpc msg dictionary:%d not found", id);
+      return -1;
+    }
+    if (zstdDecompressDictImpl(src + sizeof(id), len - sizeof(id), dst, &dstLen, pDDict) == 0) {
+      decompLen = dstLen;
+    }
+  } else if (algo == TRANS_COMP_ZSTD) {
+    if (zstdDecompressImpl(src, len, dst, &dstLen) == 0) {
+      decompLen = dstLen;
+    }
+  } else if (algo == TRANS_COMP_LZ4) {
+    decompLen = LZ4_decompress_safe(src, dst, len, oriLen);
+  } else {
+    tError("invalid rpc msg compression algorithm:%d", algo);
+    return -1;
+  }
+
+  int64_t elapse = taosGetTimestampUs() - start;
+  (void)atomic_add_fetch_64(&TRANS_COMP_STAT(algo)->decompCostUs, elapse);
+  if (elapse >= 100 * 1000) {
+    tWarn("dcompress msg cost %dms", (int)(elapse / 1000));
+  }
+  return decompLen;
+}
+
+int8_t transChooseCompAlgo(int8_t algo, int8_t peerCap) {
+  // an algorithm is used only after the peer advertised it is able to decompress it, otherwise fall back
+  int8_t cap = TMIN(TRANS_COMP_CAP, peerCap);
+  if (algo == TRANS_COMP_ZSTD_DICT && cap >= TRANS_COMP_CAP_ZSTD_DICT) {
+    return TRANS_COMP_ZSTD_DICT;
+  } else if (algo >= TRANS_COMP_ZSTD && cap >= TRANS_COMP_CAP_ZSTD) {
+    return TRANS_COMP_ZSTD;
+  }
+  return TRANS_COMP_LZ4;
+}
+
+void transGetCompStat(int8_t algo, STransCompStat* pStat) {
+  STransCompStat* pSrc = TRANS_COMP_STAT(algo);
+  pStat->count = atomic_load_64(&pSrc->count);
+  pStat->rawBytes = atomic_load_64(&pSrc->rawBytes);
+  pStat->compBytes = atomic_load_64(&pSrc->compBytes);
+  pStat->compCostUs = atomic_load_64(&pSrc->compCostUs);
+  pStat->decompCostUs = atomic_load_64(&pSrc->decompCostUs);
+}
+
+static void transPrintCompStat() {
+  int8_t      algos[] = {TRANS_COMP_LZ4, TRANS_COMP_ZSTD, TRANS_COMP_ZSTD_DICT};
+  const char* names[] = {"lz4", "zstd", "zstd dictionary"};
+  for (int32_t i = 0; i < tListLen(algos); i++) {
+    STransCompStat stat = {0};
+    transGetCompStat(algos[i], &stat);
+    if (stat.count == 0) continue;
+    tInfo("rpc msg %s compression, count:%" PRId64 ", raw:%" PRId64 ", compressed:%" PRId64
+          ", ratio:%.2f%%, cost:%" PRId64 "us, decompress cost:%" PRId64 "us",
+          names[i], stat.count, stat.rawBytes, stat.compBytes, stat.compBytes * 100.0 / stat.rawBytes,
+          stat.compCostUs, stat.decompCostUs);
+  }
+}
+
+int32_t transCompressMsg(char* msg, int32_t len, int8_t algo) {
   int32_t        ret = 0;
   int            compHdr = sizeof(STransCompMsg);
   STransMsgHead* pHead = transHeadFromCont(msg);
+  STransDict*    pDict = NULL;
+
+  int64_t start = taosGetTimestampUs();
+  if (algo == TRANS_COMP_ZSTD_DICT) {
+    pDict = transGetMsgDict(pHead->msgType, msg, len);
+    algo = (pDict != NULL) ? TRANS_COMP_ZSTD_DICT : TRANS_COMP_ZSTD;
+  }
 
-  int64_t start = taosGetTimestampMs();
   char* buf = taosMemoryMalloc(len + compHdr + 8);  // 8 extra bytes
   if (buf == NULL) {
     tWarn("failed to allocate memory for rpc msg compression, contLen:%d", len);
@@ -43,18 +449,18 @@ int32_t transCompressMsg(char* msg, int32_t len) {
     return ret;
   }
 
-  int32_t clen = LZ4_compress_default(msg, buf, len, len + compHdr);
+  int32_t clen = transDoCompress(algo, pDict, msg, len, buf, len + compHdr);
   /*
    * only the compressed size is less than the value of contLen - overhead, the compression is applied
-   * The first four bytes is set to 0, the second four bytes are utilized to keep the original length of message
+   * The first four bytes keep the algorithm, the second four bytes are utilized to keep the original length of message
    */
   if (clen > 0 && clen < len - compHdr) {
     STransCompMsg* pComp = (STransCompMsg*)msg;
-    pComp->reserved = 0;
+    pComp->algo = htonl(algo);
     pComp->contLen = htonl(len);
     memcpy(msg + compHdr, buf, clen);
 
-    tDebug("compress rpc msg, before:%d, after:%d", len, clen);
+    tDebug("compress rpc msg, algo:%d, before:%d, after:%d", algo, len, clen);
     ret = clen + compHdr;
     pHead->comp = 1;
   } else {
@@ -63,18 +469,21 @@ int32_t transCompressMsg(char* msg, int32_t len) {
   }
   taosMemoryFree(buf);
 
-  int64_t elapse = taosGetTimestampMs() - start;
-  if (elapse >= 100) {
-    tWarn("compress msg cost %dms", (int)(elapse));
+  int64_t         elapse = taosGetTimestampUs() - start;
+  STransCompStat* pStat = TRANS_COMP_STAT(algo);
+  (void)atomic_add_fetch_64(&pStat->count, 1);
+  (void)atomic_add_fetch_64(&pStat->rawBytes, len);
+  (void)atomic_add_fetch_64(&pStat->compBytes, ret);
+  (void)atomic_add_fetch_64(&pStat->compCostUs, elapse);
+  if (elapse >= 100 * 1000) {
+    tWarn("compress msg cost %dms", (int)(elapse / 1000));
   }
   return ret;
 }
-int32_t transDecompressMsg(char** msg, int32_t* len) {
+int32_t transDecompressMsg(char** msg, int32_t* len, STransConnDict* pConnDict) {
   STransMsgHead* pHead = (STransMsgHead*)(*msg);
   if (pHead->comp == 0) return 0;
 
-  int64_t start = taosGetTimestampMs();
-
   char* pCont = transContFromHead(pHead);
 
   STransCompMsg* pComp = (STransCompMsg*)pCont;
@@ -87,8 +496,9 @@ int32_t transDecompressMsg(char** msg, int32_t* len) {
   }
 
   STransMsgHead* pNewHead = (STransMsgHead*)buf;
-  int32_t        decompLen = LZ4_decompress_safe(pCont + sizeof(STransCompMsg), (char*)pNewHead->content,
-                                                 tlen - sizeof(STransMsgHead) - sizeof(STransCompMsg), oriLen);
+  int32_t        decompLen = transDoDecompress(ntohl(pComp->algo), pConnDict, pCont + sizeof(STransCompMsg),
+                                               tlen - sizeof(STransMsgHead) - sizeof(STransCompMsg),
+                                               (char*)pNewHead->content, oriLen);
 
   if (decompLen != oriLen) {
     taosMemoryFree(buf);
@@ -101,11 +511,6 @@ int32_t transDecompressMsg(char** msg, int32_t* len) {
 
   taosMemoryFree(pHead);
   *msg = buf;
-
-  int64_t elapse = taosGetTimestampMs() - start;
-  if (elapse >= 100) {
-    tWarn("dcompress msg cost %dms", (int)(elapse));
-  }
   return 0;
 }
 int32_t transDecompressMsgExt(char const* msg, int32_t len, char** out, int32_t* outLen) {
@@ -120,11 +525,11 @@ int32_t transDecompressMsgExt(char const* msg, int32_t len, char** out, int32_t*
   if (buf == NULL) {
     return terrno;
   }
-  int64_t start = taosGetTimestampMs();
 
   STransMsgHead* pNewHead = (STransMsgHead*)buf;
-  int32_t        decompLen = LZ4_decompress_safe(pCont + sizeof(STransCompMsg), (char*)pNewHead->content,
-                                                 tlen - sizeof(STransMsgHead) - sizeof(STransCompMsg), oriLen);
+  int32_t        decompLen = transDoDecompress(ntohl(pComp->algo), NULL, pCont + sizeof(STransCompMsg),
+                                               tlen - sizeof(STransMsgHead) - sizeof(STransCompMsg),
+                                               (char*)pNewHead->content, oriLen);
   if (decompLen != oriLen) {
     tError("msgLen:%d, originLen:%d, decompLen:%d", len, oriLen, decompLen);
     taosMemoryFree(buf);
@@ -136,12 +541,37 @@ int32_t transDecompressMsgExt(char const* msg, int32_t len, char** out, int32_t*
   *outLen = oriLen + sizeof(STransMsgHead);
   pNewHead->msgLen = *outLen;
   pNewHead->comp = 0;
+  return 0;
+}
 
-  int64_t elapse = taosGetTimestampMs() - start;
-  if (elapse >= 100) {
-    tWarn("dcompress msg cost %dms", (int)(elapse));
+/*
+ * Compress a msg compressed for a previous peer again with the algorithm chosen for the current one. The msg is left
+ * as it is on failure.
+ */
+int32_t transRecompressMsg(char* msg, int32_t len, int8_t algo) {
+  STransCompMsg* pComp = (STransCompMsg*)msg;
+  int32_t        oriAlgo = ntohl(pComp->algo);
+  int32_t        oriLen = htonl(pComp->contLen);
+  if (oriAlgo == algo || oriAlgo == TRANS_COMP_LZ4) {
+    return len;  // every peer is able to decompress lz4
   }
-  return 0;
+
+  char* buf = taosMemoryMalloc(oriLen);
+  if (buf == NULL) {
+    return terrno;
+  }
+  int32_t decompLen =
+      transDoDecompress(oriAlgo, NULL, msg + sizeof(STransCompMsg), len - sizeof(STransCompMsg), buf, oriLen);
+  if (decompLen != oriLen) {
+    taosMemoryFree(buf);
+    return TSDB_CODE_INVALID_MSG;
+  }
+
+  // the msg was compressed in place, so the buffer still has room for the original content
+  memcpy(msg, buf, oriLen);
+  taosMemoryFree(buf);
+  transHeadFromCont(msg)->comp = 0;
+  return transCompressMsg(msg, oriLen, algo);
 }
 
 void transFreeMsg(void* msg) {
@@ -827,6 +1257,7 @@ static void transInitEnv() {
   svrRefMgt = transOpenRefMgt(50000, transDestroyExHandle);
   instMgt = taosOpenRef(50, rpcCloseImpl);
   transSyncMsgMgt = taosOpenRef(50, transDestroySyncMsg);
+  transInitDictMgt();
   TAOS_UNUSED(uv_os_setenv("UV_TCP_SINGLE_ACCEPT", "1"));
 }
 static void transDestroyEnv() {
@@ -834,6 +1265,7 @@ static void transDestroyEnv() {
   transCloseRefMgt(svrRefMgt);
   transCloseRefMgt(instMgt);
   transCloseRefMgt(transSyncMsgMgt);
+  transDestroyDictMgt();
 }
 
 int32_t transInit() {
@@ -852,6 +1284,7 @@ int32_t transGetSyncMsgMgt() { return transSyncMsgMgt; }
 
 void transCleanup() {
   // clean env
+  transPrintCompStat();
   transDestroyEnv();
 }
 int32_t transOpenRefMgt(int size, void (*func)(void*)) {
@@ -1078,6 +1511,93 @@ void freeWReqToWQ(queue* wq, SWReqsWrapper* w) {
   QUEUE_PUSH(wq, &w->q);
 }
 
+bool transGetLocalSockPath(const char* fqdn, uint32_t port, char* path, int32_t len) {
+#ifdef WINDOWS
+  return false;
+#else
+  int32_t n = snprintf(path, len, "%s%staosd.%s.%u.sock", TRANS_LOCAL_SOCK_DIR, TD_DIRSEP, fqdn, port);
+  return n > 0 && n < len && n < TRANS_LOCAL_SOCK_PATH_LEN;
+#endif
+}
+
+// only root can create the socket dir, and nobody but its owner can create entries in it, so a socket found there is
+// served by the dir owner
+bool transCheckLocalSockDir(bool create, int64_t* owner) {
+#ifdef WINDOWS
+  return false;
+#else
+  uint32_t mode = 0;
+  if (create && taosMkDir(TRANS_LOCAL_SOCK_DIR) != 0) {
+    tWarn("failed to create %s since %s, local socket disabled", TRANS_LOCAL_SOCK_DIR, tstrerror(terrno));
+    return false;
+  }
+  if (taosLStatFileOwner(TRANS_LOCAL_SOCK_DIR, &mode, owner) != 0) {
+    return false;
+  }
+  if (!S_ISDIR(mode) || (mode & (S_IWGRP | S_IWOTH)) != 0) {
+    tWarn("%s is not a directory writable only by its owner, local socket disabled", TRANS_LOCAL_SOCK_DIR);
+    return false;
+  }
+  if (create && *owner != (int64_t)geteuid()) {
+    tWarn("%s is owned by uid:%" PRId64 ", not this process, local socket disabled", TRANS_LOCAL_SOCK_DIR, *owner);
+    return false;
+  }
+  return true;
+#endif
+}
+
+bool transCheckLocalSockPeer(int32_t fd, int64_t owner) {
+  int64_t uid = -1;
+  if (taosGetPeerUid(fd, &uid) != 0) {
+    tWarn("failed to get peer of local socket since %s", tstrerror(terrno));
+    return false;
+  }
+  if (uid != owner) {
+    tWarn("local socket served by uid:%" PRId64 ", expect uid:%" PRId64, uid, owner);
+    return false;
+  }
+  return true;
+}
+
+static STransSendStat transSendTotal;  // only writes, msgs and bytes are kept
+
+bool transSendMayDefer(STransSendStat* pStat, int32_t depth) {
+  int64_t now = taosGetTimestampUs();
+  if (pStat->pendingTs == 0) {
+    pStat->pendingTs = now;
+  }
+  // with a write in flight, a shallow queue waits for its completion to be coalesced into the next write, as long
+  // as the oldest msg is still within the latency budget
+  return pStat->inflight > 0 && depth < TRANS_BATCH_SEND_MIN_MSGS &&
+         now - pStat->pendingTs < TRANS_BATCH_SEND_LATENCY_US;
+}
+void transSendStatOnWrite(STransSendStat* pStat, int32_t msgs, int32_t bytes, int32_t left) {
+  pStat->writes++;
+  pStat->msgs += msgs;
+  pStat->bytes += bytes;
+  pStat->maxMsgs = TMAX(pStat->maxMsgs, msgs);
+  pStat->inflight++;
+  pStat->pendingTs = left > 0 ? taosGetTimestampUs() : 0;
+
+  (void)atomic_add_fetch_64(&transSendTotal.writes, 1);
+  (void)atomic_add_fetch_64(&transSendTotal.msgs, msgs);
+  (void)atomic_add_fetch_64(&transSendTotal.bytes, bytes);
+}
+void transGetSendStat(int64_t* writes, int64_t* msgs, int64_t* bytes) {
+  *writes = atomic_load_64(&transSendTotal.writes);
+  *msgs = atomic_load_64(&transSendTotal.msgs);
+  *bytes = atomic_load_64(&transSendTotal.bytes);
+}
+void transSendStatOnWriteDone(STransSendStat* pStat) {
+  if (pStat->inflight > 0) pStat->inflight--;
+}
+void transSendStatPrint(STransSendStat* pStat, const char* label, void* conn) {
+  if (pStat->writes == 0) return;
+  tDebug("%s conn:%p, send summary, writes:%" PRId64 ", msgs:%" PRId64 ", bytes:%" PRId64
+         ", msgs per write:%.2f, max msgs per write:%d",
+         label, conn, pStat->writes, pStat->msgs, pStat->bytes, (double)pStat->msgs / pStat->writes, pStat->maxMsgs);
+}
+
 int32_t transSetReadOption(uv_handle_t* handle) {
   int32_t code = 0;
   int32_t fd;
@@ -1165,7 +1685,7 @@ SHashObj*     hashTable = NULL;
 
 void transDestroySyncMsg(void* msg);
 
-int32_t transCompressMsg(char* msg, int32_t len) {
+int32_t transCompressMsg(char* msg, int32_t len, int8_t algo) {
   int32_t        ret = 0;
   int            compHdr = sizeof(STransCompMsg);
   STransMsgHead* pHead = transHeadFromCont(msg);
@@ -1184,7 +1704,7 @@ int32_t transCompressMsg(char* msg, int32_t len) {
    */
   if (clen > 0 && clen < len - compHdr) {
     STransCompMsg* pComp = (STransCompMsg*)msg;
-    pComp->reserved = 0;
+    pComp->algo = htonl(TRANS_COMP_LZ4);
     pComp->contLen = htonl(len);
     memcpy(msg + compHdr, buf, clen);
 
@@ -1198,7 +1718,7 @@ int32_t transCompressMsg(char* msg, int32_t len) {
   taosMemoryFree(buf);
   return ret;
 }
-int32_t transDecompressMsg(char** msg, int32_t* len) { return 0; }
+int32_t transDecompressMsg(char** msg, int32_t* len, STransConnDict* pConnDict) { return 0; }
 
 void transFreeMsg(void* msg) {
   if (msg == NULL) {
@@ -28,9 +28,10 @@ typedef struct {
 } SSvrRegArg;
 
 typedef struct SSvrConn {
-  int32_t    ref;
-  uv_tcp_t*  pTcp;
-  uv_timer_t pTimer;
+  int32_t      ref;
+  uv_stream_t* pTcp;  // uv_tcp_t, or uv_pipe_t for local conn
+  uv_timer_t   pTimer;
+  int8_t       localSock;
 
   queue       queue;
   SConnBuffer readBuf;  // read buf,
@@ -57,6 +58,7 @@ typedef struct SSvrConn {
   char    info[64];
   char    user[TSDB_UNI_LEN];  // user ID for the link
   int8_t  userInited;
+  int8_t  peerCompCap;  // algorithms the peer is able to decompress, TRANS_COMP_CAP_*
   char    secret[TSDB_PASSWORD_LEN];
   char    ckey[TSDB_PASSWORD_LEN];  // ciphering key
 
@@ -64,10 +66,17 @@ typedef struct SSvrConn {
 
   // state req dict
   SHashObj* pQTable;
+
+  STransConnDict dict;  // msg dictionaries sent to and received from the peer
+
   uv_buf_t* buf;
   int32_t   bufSize;
   queue     wq;  // uv_write_t queue
 
+  queue          batchSendq;
+  int8_t         inThreadSendq;
+  STransSendStat sendStat;
+
   int8_t enableSSL;
 
   STransTLS* pTls;  // TLS connection
@@ -107,6 +116,8 @@ typedef struct SWorkThrd {
   void* pInst;
   bool  quit;
 
+  queue batchSendSet;  // conns with resps to send at the end of current async batch
+
   SIpWhiteListTab* pWhiteList;
   int64_t          whiteListVer;
   int8_t           enableIpWhiteList;
@@ -135,6 +146,9 @@ typedef struct SServerObj {
   SIpAddr     addr;
   bool        inited;
   int8_t      ipv6;
+
+  int8_t    localSock;
+  uv_pipe_t localListen;  // unix domain socket for clients on the same host
 } SServerObj;
 
 SIpWhiteListTab* uvWhiteListCreate();
@@ -166,15 +180,17 @@ static void uvWorkAfterTask(uv_work_t* req, int status);
 static void uvWalkCb(uv_handle_t* handle, void* arg);
 static void uvFreeCb(uv_handle_t* handle);
 
-static FORCE_INLINE void uvStartSendRespImpl(SSvrRespMsg* smsg);
+static FORCE_INLINE void uvStartSendRespImpl(SSvrConn* pConn);
 
-static int32_t uvPrepareSendData(SSvrRespMsg* msg, uv_buf_t* wb);
+static int32_t uvPrepareSendData(SSvrRespMsg* msg, uv_buf_t* wb, int32_t* bufNum);
 static void    uvStartSendResp(SSvrRespMsg* msg);
 
 static void uvNotifyLinkBrokenToApp(SSvrConn* conn);
 
 static FORCE_INLINE void      destroySmsg(SSvrRespMsg* smsg);
-static FORCE_INLINE SSvrConn* createConn(void* hThrd);
+static FORCE_INLINE SSvrConn* createConn(void* hThrd, int8_t localSock);
+static void uvOnAcceptLocalCb(uv_stream_t* stream, int status);
+static void uvInitLocalListen(SServerObj* srv);
 static FORCE_INLINE void      destroyConn(SSvrConn* conn, bool clear /*clear handle or not*/);
 
 int32_t uvGetConnRefOfThrd(SWorkThrd* thrd) { return thrd ? thrd->connRefMgt : -1; }
@@ -530,7 +546,7 @@ static int32_t uvMayHandleReleaseReq(SSvrConn* pConn, STransMsgHead* pHead) {
 
     transQueuePush(&pConn->resps, &srvMsg->q);
 
-    uvStartSendRespImpl(srvMsg);
+    uvStartSendRespImpl(pConn);
     taosMemoryFree(pHead);
     return TSDB_CODE_RPC_ASYNC_IN_PROCESS;
   }
@@ -579,11 +595,22 @@ static bool uvHandleReq(SSvrConn* pConn) {
     tError("%s conn:%p, read invalid packet", transLabel(pInst), pConn);
     return false;
   }
-  if (transDecompressMsg((char**)&pHead, &msgLen) < 0) {
+  if (TRANS_MSG_COMP(pHead) == TRANS_MSG_DICT) {
+    // a msg dictionary the client sends ahead of the first msg compressed with it
+    int32_t code = transRecvDict(&pConn->dict, pHead, msgLen);
+    taosMemoryFree(pHead);
+    if (code != 0) {
+      tError("%s conn:%p, failed to recv msg dictionary since %s", transLabel(pInst), pConn, tstrerror(code));
+      return false;
+    }
+    return true;
+  }
+  if (transDecompressMsg((char**)&pHead, &msgLen, &pConn->dict) < 0) {
     tError("%s conn:%p, recv invalid packet, failed to decompress", transLabel(pInst), pConn);
     taosMemoryFree(pHead);
     return false;
   }
+  pConn->peerCompCap = TRANS_MSG_COMP_CAP(pHead);
 
   if (uvConnMayGetUserInfo(pConn, &pHead, &msgLen) == true) {
     tDebug("%s conn:%p, get user info", transLabel(pInst), pConn);
@@ -813,6 +840,7 @@ void uvOnSendCb(uv_write_t* req, int status) {
   QUEUE_MOVE(&wrapper->node, &src);
 
   freeWReqToWQ(&conn->wq, wrapper);
+  transSendStatOnWriteDone(&conn->sendStat);
   if (conn->enableSSL) {
     sslBufferUnref(&conn->pTls->sendBuf);
   }
@@ -830,6 +858,10 @@ void uvOnSendCb(uv_write_t* req, int status) {
               smsg->msg.info.seqNum, smsg->msg.info.qId);
       destroySmsg(smsg);
     }
+    // resps deferred or left over by this write
+    if (!conn->broken && transQueueSize(&conn->resps) > 0) {
+      uvStartSendRespImpl(conn);
+    }
   } else {
     while (!QUEUE_IS_EMPTY(&src)) {
       queue* head = QUEUE_HEAD(&src);
@@ -862,7 +894,8 @@ static void uvOnPipeWriteCb(uv_write_t* req, int status) {
   taosMemoryFree(req);
 }
 
-static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb) {
+// The msg may be preceded by the frame of the dictionary it is compressed with, so it takes one or two bufs.
+static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb, int32_t* bufNum) {
   SSvrConn*  pConn = smsg->pConn;
   STransMsg* pMsg = &smsg->msg;
   if (pMsg->pCont == 0) {
@@ -881,6 +914,7 @@ static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb) {
   pHead->seqNum = taosHton64(pMsg->info.seqNum);
   pHead->qid = taosHton64(pMsg->info.qId);
   pHead->withUserInfo = pConn->userInited == 0 ? 1 : 0;
+  pHead->compCap = TRANS_COMP_CAP;
 
   // handle invalid drop_task resp, TD-20098
   // if (pConn->inType == TDMT_SCH_DROP_TASK && pMsg->code == TSDB_CODE_VND_INVALID_VGROUP_ID) {
@@ -900,7 +934,8 @@ static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb) {
   STrans* pInst = pConn->pInst;
   if (pMsg->info.compressed == 0 && !taosIpAddrIsEqual(&pConn->clientIp, &pConn->serverIp) &&
       pInst->compressSize != -1 && pInst->compressSize < pMsg->contLen) {
-    len = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+    int8_t algo = transChooseCompAlgo(pInst->compressAlgorithm, pConn->peerCompCap);
+    len = transCompressMsg(pMsg->pCont, pMsg->contLen, algo) + sizeof(STransMsgHead);
     pHead->msgLen = (int32_t)htonl((uint32_t)len);
   }
 
@@ -908,12 +943,18 @@ static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb) {
   tGDebug("%s conn:%p, %s is sent to %s, local info:%s, len:%d, seqNum:%" PRId64 ", sid:%" PRId64, transLabel(pInst),
           pConn, TMSG_INFO(pHead->msgType), pConn->dst, pConn->src, len, pMsg->info.seqNum, pMsg->info.qId);
 
-  wb->base = (char*)pHead;
-  wb->len = len;
+  *bufNum = 0;
+  if (transGetDictToSend(&pConn->dict, pMsg->pCont, &wb[0])) {
+    (*bufNum)++;
+  }
+  wb[*bufNum].base = (char*)pHead;
+  wb[*bufNum].len = len;
+  (*bufNum)++;
   return 0;
 }
 
-static int32_t uvBuildToSendData(SSvrConn* pConn, uv_buf_t** ppBuf, int32_t* bufNum, queue* toSendQ) {
+static int32_t uvBuildToSendData(SSvrConn* pConn, uv_buf_t** ppBuf, int32_t* bufNum, int32_t* msgNum,
+                                 queue* toSendQ) {
   int32_t code = 0;
   int32_t size = transQueueSize(&pConn->resps);
   tTrace("%s conn:%p, has %d msg to send", transLabel(pConn->pInst), pConn, size);
@@ -921,26 +962,30 @@ static int32_t uvBuildToSendData(SSvrConn* pConn, uv_buf_t** ppBuf, int32_t* buf
     return 0;
   }
 
-  if (pConn->bufSize < size) {
-    pConn->buf = taosMemoryRealloc(pConn->buf, size * sizeof(uv_buf_t));
+  if (pConn->bufSize < size * 2) {
+    pConn->buf = taosMemoryRealloc(pConn->buf, size * 2 * sizeof(uv_buf_t));
     if (pConn->buf == NULL) {
       return terrno;
     }
-    pConn->bufSize = size;
+    pConn->bufSize = size * 2;
   }
   uv_buf_t* pWb = pConn->buf;
 
   int32_t count = 0;
+  int32_t num = 0;
+  int32_t bytes = 0;
 
-  while (transQueueSize(&pConn->resps) > 0) {
+  while (transQueueSize(&pConn->resps) > 0 && count < TRANS_BATCH_SEND_MAX_MSGS &&
+         bytes < TRANS_BATCH_SEND_MAX_BYTES) {
     queue*       el = transQueuePop(&pConn->resps);
     SSvrRespMsg* pMsg = QUEUE_DATA(el, SSvrRespMsg, q);
-    uv_buf_t     wb;
-    code = uvPrepareSendData(pMsg, &wb);
+    int32_t      n = 0;
+    code = uvPrepareSendData(pMsg, &pWb[num], &n);
     if (code != 0) {
       return code;
     }
-    pWb[count] = wb;
+    for (int32_t i = 0; i < n; i++) bytes += pWb[num + i].len;
+    num += n;
     pMsg->sent = 1;
     QUEUE_PUSH(toSendQ, &pMsg->q);
     count++;
@@ -950,15 +995,15 @@ static int32_t uvBuildToSendData(SSvrConn* pConn, uv_buf_t** ppBuf, int32_t* buf
     return 0;
   }
 
-  *bufNum = count;
+  *bufNum = num;
+  *msgNum = count;
   *ppBuf = pWb;
 
   return 0;
 }
 
-static FORCE_INLINE void uvStartSendRespImpl(SSvrRespMsg* smsg) {
-  int32_t   code = 0;
-  SSvrConn* pConn = smsg->pConn;
+static FORCE_INLINE void uvStartSendRespImpl(SSvrConn* pConn) {
+  int32_t code = 0;
   if (pConn->broken) {
     return;
   }
@@ -967,6 +1012,10 @@ static FORCE_INLINE void uvStartSendRespImpl(SSvrRespMsg* smsg) {
     tTrace("%s conn:%p, has %d msg to send", transLabel(pConn->pInst), pConn, size);
     return;
   }
+  if (transSendMayDefer(&pConn->sendStat, size)) {
+    tTrace("%s conn:%p, %d msg wait for in-flight write", transLabel(pConn->pInst), pConn, size);
+    return;
+  }
 
   uv_write_t* req = allocWReqFromWQ(&pConn->wq, pConn);
   if (req == NULL) {
@@ -978,7 +1027,8 @@ static FORCE_INLINE void uvStartSendRespImpl(SSvrRespMsg* smsg) {
 
   uv_buf_t* pBuf = NULL;
   int32_t   bufNum = 0;
-  code = uvBuildToSendData(pConn, &pBuf, &bufNum, &pWreq->node);
+  int32_t   msgNum = 0;
+  code = uvBuildToSendData(pConn, &pBuf, &bufNum, &msgNum, &pWreq->node);
   if (code != 0) {
     tError("%s conn:%p, failed to send data", transLabel(pConn->pInst), pConn);
     return;
@@ -999,7 +1049,11 @@ static FORCE_INLINE void uvStartSendRespImpl(SSvrRespMsg* smsg) {
     code = sslWrite(pConn->pTls, (uv_stream_t*)pConn->pTcp, req, pBuf, bufNum, uvOnSendCb);
   }
 
-  if (code != 0) {
+  if (code == 0) {
+    int32_t bytes = 0;
+    for (int32_t i = 0; i < bufNum; i++) bytes += pBuf[i].len;
+    transSendStatOnWrite(&pConn->sendStat, msgNum, bytes, transQueueSize(&pConn->resps));
+  } else {
     pConn->broken = true;
     while (!QUEUE_IS_EMPTY(&pWreq->node)) {
       queue* head = QUEUE_HEAD(&pWreq->node);
@@ -1041,10 +1095,28 @@ static void uvStartSendResp(SSvrRespMsg* smsg) {
   }
 
   transQueuePush(&pConn->resps, &smsg->q);
-  uvStartSendRespImpl(smsg);
+
+  // resps of the same conn in one async batch are coalesced into one write by uvFlushBatchSend
+  if (!pConn->inThreadSendq) {
+    SWorkThrd* pThrd = pConn->hostThrd;
+    QUEUE_PUSH(&pThrd->batchSendSet, &pConn->batchSendq);
+    pConn->inThreadSendq = 1;
+  }
   return;
 }
 
+static void uvFlushBatchSend(SWorkThrd* pThrd) {
+  while (!QUEUE_IS_EMPTY(&pThrd->batchSendSet)) {
+    queue* el = QUEUE_HEAD(&pThrd->batchSendSet);
+    QUEUE_REMOVE(el);
+
+    SSvrConn* pConn = QUEUE_DATA(el, SSvrConn, batchSendq);
+    pConn->inThreadSendq = 0;
+    QUEUE_INIT(&pConn->batchSendq);
+    uvStartSendRespImpl(pConn);
+  }
+}
+
 static FORCE_INLINE void destroySmsg(SSvrRespMsg* smsg) {
   if (smsg == NULL) {
     return;
@@ -1097,6 +1169,7 @@ void uvWorkerAsyncCb(uv_async_t* handle) {
 
     // release handle to rpc init
     if (msg->type == Quit || msg->type == Update) {
+      uvFlushBatchSend(pThrd);
       (*transAsyncHandle[msg->type])(msg, pThrd);
     } else {
       STransMsg transMsg = msg->msg;
@@ -1117,6 +1190,7 @@ void uvWorkerAsyncCb(uv_async_t* handle) {
       (*transAsyncHandle[msg->type])(msg, pThrd);
     }
   }
+  uvFlushBatchSend(pThrd);
 }
 static void uvWalkCb(uv_handle_t* handle, void* arg) {
   if (!uv_is_closing(handle)) {
@@ -1159,6 +1233,8 @@ static void uvWorkAfterTask(uv_work_t* req, int status) {
   taosMemoryFree(req);
 }
 
+static void uvDispatchConn(SServerObj* pObj, uv_stream_t* stream, uv_stream_t* cli);
+
 void uvOnAcceptCb(uv_stream_t* stream, int status) {
   if (status == -1) {
     return;
@@ -1174,7 +1250,27 @@ void uvOnAcceptCb(uv_stream_t* stream, int status) {
     taosMemoryFree(cli);
     return;
   }
-  err = uv_accept(stream, (uv_stream_t*)cli);
+  uvDispatchConn(pObj, stream, (uv_stream_t*)cli);
+}
+static void uvOnAcceptLocalCb(uv_stream_t* stream, int status) {
+  if (status < 0) {
+    return;
+  }
+  SServerObj* pObj = container_of(stream, SServerObj, localListen);
+
+  uv_pipe_t* cli = (uv_pipe_t*)taosMemoryMalloc(sizeof(uv_pipe_t));
+  if (cli == NULL) return;
+
+  int err = uv_pipe_init(pObj->loop, cli, 0);
+  if (err != 0) {
+    tError("failed to create local conn:%s", uv_err_name(err));
+    taosMemoryFree(cli);
+    return;
+  }
+  uvDispatchConn(pObj, stream, (uv_stream_t*)cli);
+}
+static void uvDispatchConn(SServerObj* pObj, uv_stream_t* stream, uv_stream_t* cli) {
+  int err = uv_accept(stream, cli);
   if (err == 0) {
 #if defined(WINDOWS) || defined(DARWIN)
     if (pObj->numOfWorkerReady < pObj->numOfThreads) {
@@ -1210,6 +1306,16 @@ void uvOnAcceptCb(uv_stream_t* stream, int status) {
     }
   }
 }
+static void uvConnSetLocalInfo(SSvrConn* pConn) {
+  // peers of a local conn are on this host, take them as loopback so ip based checks keep working
+  SIpAddr ip = {.type = 0, .mask = 32};
+  tstrncpy(ip.ipv4, "127.0.0.1", sizeof(ip.ipv4));
+  pConn->clientIp = ip;
+  pConn->serverIp = ip;
+  pConn->port = 0;
+  tstrncpy(pConn->dst, "local", sizeof(pConn->dst));
+  tstrncpy(pConn->src, "local", sizeof(pConn->src));
+}
 void uvGetSockInfo(struct sockaddr* addr, SIpAddr* ip) {
   if (addr->sa_family == AF_INET) {
     struct sockaddr_in* addr_in = (struct sockaddr_in*)addr;
@@ -1265,21 +1371,26 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
     return;
   }
 
-  SSvrConn* pConn = createConn(pThrd);
+  SSvrConn* pConn = createConn(pThrd, uv_pipe_pending_type(pipe) == UV_NAMED_PIPE);
   if (pConn == NULL) {
     // uv_close((uv_handle_t*)q, NULL);
     return;
   }
 
-  if ((code = uv_accept(q, (uv_stream_t*)(pConn->pTcp))) == 0) {
+  if ((code = uv_accept(q, pConn->pTcp)) == 0) {
     uv_os_fd_t fd;
     TAOS_UNUSED(uv_fileno((const uv_handle_t*)pConn->pTcp, &fd));
-    tTrace("conn:%p, created, fd:%d", pConn, fd);
+    tTrace("conn:%p, created, fd:%d, local:%d", pConn, fd, pConn->localSock);
+
+    if (pConn->localSock) {
+      uvConnSetLocalInfo(pConn);
+      goto _start_read;
+    }
 
     struct sockaddr_storage peername, sockname;
     // Get and valid the peer info
     int addrlen = sizeof(peername);
-    if ((code = uv_tcp_getpeername(pConn->pTcp, (struct sockaddr*)&peername, &addrlen)) != 0) {
+    if ((code = uv_tcp_getpeername((uv_tcp_t*)pConn->pTcp, (struct sockaddr*)&peername, &addrlen)) != 0) {
       tError("conn:%p, failed to get peer info since %s", pConn, uv_strerror(code));
       transUnrefSrvHandle(pConn);
       return;
@@ -1293,7 +1404,7 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
 
     // Get and valid the sock info
     addrlen = sizeof(sockname);
-    if ((code = uv_tcp_getsockname(pConn->pTcp, (struct sockaddr*)&sockname, &addrlen)) != 0) {
+    if ((code = uv_tcp_getsockname((uv_tcp_t*)pConn->pTcp, (struct sockaddr*)&sockname, &addrlen)) != 0) {
       tError("conn:%p, failed to get local info since %s", pConn, uv_strerror(code));
       transUnrefSrvHandle(pConn);
       return;
@@ -1317,6 +1428,7 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
       tWarn("failed to set tcp option since %s", tstrerror(code));
     }
 
+  _start_read:;
     void (*pAllocCb)(uv_handle_t*, size_t, uv_buf_t*) = uvAllocRecvBufferCb;
     void (*pRecvCb)(uv_stream_t*, ssize_t, const uv_buf_t*) = uvOnRecvCb;
     if (pConn->enableSSL) {
@@ -1392,6 +1504,7 @@ static int32_t addHandleToWorkloop(SWorkThrd* pThrd, char* pipeName) {
 
   // conn set
   QUEUE_INIT(&pThrd->conn);
+  QUEUE_INIT(&pThrd->batchSendSet);
 
   code = transAsyncPoolCreate(pThrd->loop, 8, pThrd, uvWorkerAsyncCb, &pThrd->asyncPool);
   if (code != 0) {
@@ -1411,6 +1524,31 @@ static int32_t addHandleToWorkloop(SWorkThrd* pThrd, char* pipeName) {
   return 0;
 }
 
+static void uvInitLocalListen(SServerObj* srv) {
+  char    path[PATH_MAX] = {0};
+  int64_t owner = 0;
+  if (!srv->localSock || !transGetLocalSockPath(tsLocalFqdn, srv->port, path, sizeof(path)) ||
+      !transCheckLocalSockDir(true, &owner)) {
+    return;
+  }
+  // the tcp port is owned by this server now, so a socket file left with the same name is stale
+  TAOS_UNUSED(taosRemoveFile(path));
+
+  int code = uv_pipe_init(srv->loop, &srv->localListen, 0);
+  if (code != 0) {
+    tWarn("failed to init local listen since %s", uv_err_name(code));
+    return;
+  }
+  if ((code = uv_pipe_bind(&srv->localListen, path)) != 0 ||
+      (code = uv_pipe_chmod(&srv->localListen, UV_READABLE | UV_WRITABLE)) != 0 ||
+      (code = uv_listen((uv_stream_t*)&srv->localListen, 4096 * 2, uvOnAcceptLocalCb)) != 0) {
+    tWarn("failed to listen on %s since %s, local clients fall back to tcp", path, uv_err_name(code));
+    uv_close((uv_handle_t*)&srv->localListen, NULL);
+    return;
+  }
+  tInfo("listen on %s for local clients", path);
+}
+
 static int32_t addHandleToAcceptloop(void* arg) {
   // impl later
   SServerObj* srv = arg;
@@ -1464,6 +1602,7 @@ static int32_t addHandleToAcceptloop(void* arg) {
     tError("failed to listen since %s", uv_err_name(code));
     return TSDB_CODE_RPC_PORT_EADDRINUSE;
   }
+  uvInitLocalListen(srv);
   return 0;
 }
 
@@ -1483,7 +1622,7 @@ void uvDestroyResp(void* e) {
   SSvrRespMsg* pMsg = QUEUE_DATA(e, SSvrRespMsg, q);
   destroySmsg(pMsg);
 }
-static FORCE_INLINE SSvrConn* createConn(void* hThrd) {
+static FORCE_INLINE SSvrConn* createConn(void* hThrd, int8_t localSock) {
   int32_t    code = 0;
   SWorkThrd* pThrd = hThrd;
   int32_t    lino;
@@ -1540,7 +1679,8 @@ static FORCE_INLINE SSvrConn* createConn(void* hThrd) {
   wqInited = 1;
 
   // init client handle
-  pConn->pTcp = (uv_tcp_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
+  pConn->localSock = localSock;
+  pConn->pTcp = (uv_stream_t*)taosMemoryMalloc(localSock ? sizeof(uv_pipe_t) : sizeof(uv_tcp_t));
   if (pConn->pTcp == NULL) {
     TAOS_CHECK_GOTO(terrno, &lino, _end);
   }
@@ -1551,7 +1691,11 @@ static FORCE_INLINE SSvrConn* createConn(void* hThrd) {
     TAOS_CHECK_GOTO(terrno, &lino, _end);
   }
 
-  code = uv_tcp_init(pThrd->loop, pConn->pTcp);
+  if (localSock) {
+    code = uv_pipe_init(pThrd->loop, (uv_pipe_t*)pConn->pTcp, 0);
+  } else {
+    code = uv_tcp_init(pThrd->loop, (uv_tcp_t*)pConn->pTcp);
+  }
   if (code != 0) {
     tError("%s failed to create conn since %s" PRId64, transLabel(pInst), uv_strerror(code));
     TAOS_CHECK_GOTO(TSDB_CODE_THIRDPARTY_ERROR, NULL, _end);
@@ -1648,6 +1792,7 @@ static void uvDestroyConn(uv_handle_t* handle) {
 
   STrans* pInst = thrd->pInst;
   tDebug("%s conn:%p try to destroy", transLabel(pInst), conn);
+  transSendStatPrint(&conn->sendStat, transLabel(pInst), conn);
 
   transQueueDestroy(&conn->resps);
 
@@ -1658,6 +1803,7 @@ static void uvDestroyConn(uv_handle_t* handle) {
   uvConnDestroyAllState(conn);
 
   transDestroyBuffer(&conn->readBuf);
+  transConnDictCleanup(&conn->dict);
 
   destroyWQ(&conn->wq);
   sslDestroy(conn->pTls);
@@ -1723,6 +1869,7 @@ void* transInitServer(SIpAddr* addr, char* label, int numOfThreads, void* fp, vo
   STrans* pInst = (STrans*)pInit;
 
   srv->ipv6 = pInst->ipv6;
+  srv->localSock = pInst->localSock && !pInst->enableSSL;
   srv->addr = *addr;
   srv->ip = 0;
   srv->port = addr->port;
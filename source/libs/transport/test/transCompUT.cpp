@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3 * or later ("AGPL"), as published by the Free
+ * Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include "tglobal.h"
+#include "tmisce.h"
+#include "transComm.h"
+#include "trpc.h"
+#include "tversion.h"
+
+namespace {
+
+const int32_t compPort = 7011;
+const int32_t msgSize = 8 * 1024;
+const int32_t numOfSamples = 64;  // msgs a dictionary is trained with, see TRANS_DICT_SAMPLES
+
+// rows of a csv like payload, the field names repeat while the values differ between msgs
+void fillMsg(char *pCont, int32_t len, int32_t seed) {
+  int32_t pos = 0;
+  int32_t row = 0;
+  while (pos < len) {
+    char line[160];
+    int  n = snprintf(line, sizeof(line), "tbname=meters_%d,location=California.SanFrancisco,groupid=%d,ts=%" PRId64
+                      ",current=%d.%d,voltage=%d,phase=0.%d\n",
+                      seed * 31 + row, seed % 10, (int64_t)1700000000000 + seed * 1000 + row, 10 + row % 7,
+                      (seed + row) % 10, 200 + (seed * row) % 40, (seed ^ row) % 1000);
+    n = TMIN(n, len - pos);
+    memcpy(pCont + pos, line, n);
+    pos += n;
+    row++;
+  }
+}
+
+char *buildMsg(int32_t msgType, int32_t seed) {
+  char *pCont = (char *)rpcMallocCont(msgSize);
+  if (pCont == NULL) return NULL;
+  fillMsg(pCont, msgSize, seed);
+  STransMsgHead *pHead = transHeadFromCont(pCont);
+  pHead->msgType = msgType;
+  pHead->version = TRANS_VER;
+  pHead->magicNum = htonl(TRANS_MAGIC_NUM);
+  return pCont;
+}
+
+// copy the compressed msg into a buffer of its own as it is received, and decompress it
+int32_t recvMsg(char *pCont, int32_t compLen, STransConnDict *pConnDict, char **ppMsg, int32_t *pLen) {
+  *pLen = compLen + sizeof(STransMsgHead);
+  *ppMsg = (char *)taosMemoryMalloc(*pLen);
+  memcpy(*ppMsg, transHeadFromCont(pCont), *pLen);
+  return transDecompressMsg(ppMsg, pLen, pConnDict);
+}
+
+int32_t compAlgo(char *pCont) { return ntohl(((STransCompMsg *)pCont)->algo); }
+
+bool dictSupported() { return TRANS_COMP_CAP >= TRANS_COMP_CAP_ZSTD_DICT; }
+
+}  // namespace
+
+class TransCompTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { ASSERT_EQ(rpcInit(), 0); }
+};
+
+TEST_F(TransCompTest, negotiate) {
+  EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_LZ4, TRANS_COMP_CAP_ZSTD_DICT), TRANS_COMP_LZ4);
+  // a legacy peer leaves compCap as 0
+  EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_ZSTD, TRANS_COMP_CAP_LZ4), TRANS_COMP_LZ4);
+  EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_ZSTD_DICT, TRANS_COMP_CAP_LZ4), TRANS_COMP_LZ4);
+  if (TRANS_COMP_CAP < TRANS_COMP_CAP_ZSTD) {
+    EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_ZSTD_DICT, TRANS_COMP_CAP_ZSTD_DICT), TRANS_COMP_LZ4);
+    return;
+  }
+  EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_ZSTD, TRANS_COMP_CAP_ZSTD), TRANS_COMP_ZSTD);
+  EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_ZSTD, TRANS_COMP_CAP_ZSTD_DICT), TRANS_COMP_ZSTD);
+  // a peer without dictionaries still gets zstd
+  EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_ZSTD_DICT, TRANS_COMP_CAP_ZSTD), TRANS_COMP_ZSTD);
+  EXPECT_EQ(transChooseCompAlgo(TRANS_COMP_ZSTD_DICT, TRANS_COMP_CAP_ZSTD_DICT), TRANS_COMP_ZSTD_DICT);
+}
+
+TEST_F(TransCompTest, roundTrip) {
+  int8_t algos[] = {TRANS_COMP_LZ4, TRANS_COMP_ZSTD};
+  for (int32_t i = 0; i < tListLen(algos); i++) {
+    if (algos[i] == TRANS_COMP_ZSTD && TRANS_COMP_CAP < TRANS_COMP_CAP_ZSTD) continue;
+
+    char *pCont = buildMsg(5, i);
+    ASSERT_NE(pCont, nullptr);
+    char expect[msgSize];
+    memcpy(expect, pCont, msgSize);
+
+    int32_t compLen = transCompressMsg(pCont, msgSize, algos[i]);
+    ASSERT_LT(compLen, msgSize);
+    EXPECT_EQ((int32_t)transHeadFromCont(pCont)->comp, 1);
+    EXPECT_EQ(compAlgo(pCont), algos[i]);
+
+    char   *pMsg = NULL;
+    int32_t len = 0;
+    ASSERT_EQ(recvMsg(pCont, compLen, NULL, &pMsg, &len), 0);
+    EXPECT_EQ(len, msgSize + (int32_t)sizeof(STransMsgHead));
+    EXPECT_EQ(memcmp(transContFromHead(pMsg), expect, msgSize), 0);
+
+    taosMemoryFree(pMsg);
+    rpcFreeCont(pCont);
+  }
+}
+
+TEST_F(TransCompTest, dictionary) {
+  if (!dictSupported()) {
+    GTEST_SKIP() << "no zstd dictionary";
+  }
+
+  // the msgs of the type are compressed with plain zstd until enough samples are taken to train the dictionary
+  const int32_t msgType = 7;
+  char         *pCont = NULL;
+  for (int32_t i = 0; i < numOfSamples; i++) {
+    pCont = buildMsg(msgType, i);
+    ASSERT_NE(pCont, nullptr);
+    (void)transCompressMsg(pCont, msgSize, TRANS_COMP_ZSTD_DICT);
+    if (i < numOfSamples - 1) {
+      EXPECT_EQ(compAlgo(pCont), TRANS_COMP_ZSTD);
+    }
+    rpcFreeCont(pCont);
+  }
+
+  pCont = buildMsg(msgType, 1000);
+  ASSERT_NE(pCont, nullptr);
+  char expect[msgSize];
+  memcpy(expect, pCont, msgSize);
+  int32_t compLen = transCompressMsg(pCont, msgSize, TRANS_COMP_ZSTD_DICT);
+  ASSERT_EQ(compAlgo(pCont), TRANS_COMP_ZSTD_DICT);
+
+  // a msg of another type is not compressed with the dictionary
+  char *pOther = buildMsg(msgType + 2, 1000);
+  ASSERT_NE(pOther, nullptr);
+  (void)transCompressMsg(pOther, msgSize, TRANS_COMP_ZSTD_DICT);
+  EXPECT_EQ(compAlgo(pOther), TRANS_COMP_ZSTD);
+  rpcFreeCont(pOther);
+
+  // a peer that has not received the dictionary rejects the msg
+  STransConnDict recv = {0};
+  char          *pMsg = NULL;
+  int32_t        len = 0;
+  EXPECT_NE(recvMsg(pCont, compLen, &recv, &pMsg, &len), 0);
+  taosMemoryFree(pMsg);
+
+  // the dictionary is sent once on a connection
+  STransConnDict sent = {0};
+  uv_buf_t       frame = {0};
+  ASSERT_TRUE(transGetDictToSend(&sent, pCont, &frame));
+  uv_buf_t again = {0};
+  EXPECT_FALSE(transGetDictToSend(&sent, pCont, &again));
+
+  STransMsgHead *pFrame = (STransMsgHead *)taosMemoryMalloc(frame.len);
+  memcpy(pFrame, frame.base, frame.len);
+  EXPECT_EQ(TRANS_MSG_COMP(pFrame), TRANS_MSG_DICT);
+  EXPECT_EQ((int32_t)ntohl(pFrame->msgLen), (int32_t)frame.len);
+  EXPECT_NE(transRecvDict(&recv, pFrame, sizeof(STransMsgHead)), 0);
+  ASSERT_EQ(transRecvDict(&recv, pFrame, frame.len), 0);
+  taosMemoryFree(pFrame);
+
+  ASSERT_EQ(recvMsg(pCont, compLen, &recv, &pMsg, &len), 0);
+  EXPECT_EQ(len, msgSize + (int32_t)sizeof(STransMsgHead));
+  EXPECT_EQ(memcmp(transContFromHead(pMsg), expect, msgSize), 0);
+  taosMemoryFree(pMsg);
+
+  // a retry to a peer without dictionaries compresses the msg again, and a failed one leaves it as it is
+  char saved[msgSize];
+  memcpy(saved, pCont, compLen);
+  ((STransCompMsg *)pCont)->contLen = htonl(msgSize / 2);
+  EXPECT_LT(transRecompressMsg(pCont, compLen, TRANS_COMP_ZSTD), 0);
+  EXPECT_EQ(memcmp(pCont + sizeof(STransCompMsg), saved + sizeof(STransCompMsg), compLen - sizeof(STransCompMsg)),
+            0);
+  ((STransCompMsg *)pCont)->contLen = htonl(msgSize);
+
+  EXPECT_EQ(transRecompressMsg(pCont, compLen, TRANS_COMP_ZSTD_DICT), compLen);
+  compLen = transRecompressMsg(pCont, compLen, TRANS_COMP_LZ4);
+  ASSERT_GT(compLen, 0);
+  EXPECT_EQ(compAlgo(pCont), TRANS_COMP_LZ4);
+  ASSERT_EQ(recvMsg(pCont, compLen, NULL, &pMsg, &len), 0);
+  EXPECT_EQ(memcmp(transContFromHead(pMsg), expect, msgSize), 0);
+  taosMemoryFree(pMsg);
+
+  transConnDictCleanup(&sent);
+  transConnDictCleanup(&recv);
+  rpcFreeCont(pCont);
+}
+
+namespace {
+
+typedef struct {
+  tsem_t  sem;
+  int32_t code;
+} SCompResp;
+
+// the seed of the payload is kept in its first bytes, so the server checks the msg it decompressed
+void processCompReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  SRpcMsg rpcMsg = {0};
+  rpcMsg.code = TSDB_CODE_INVALID_MSG;
+  if (pMsg->contLen == msgSize) {
+    int32_t seed = 0;
+    memcpy(&seed, pMsg->pCont, sizeof(seed));
+    char *expect = (char *)taosMemoryMalloc(msgSize);
+    fillMsg(expect, msgSize, seed);
+    if (memcmp((char *)pMsg->pCont + sizeof(seed), expect + sizeof(seed), msgSize - sizeof(seed)) == 0) {
+      rpcMsg.code = 0;
+    }
+    taosMemoryFree(expect);
+  }
+  rpcMsg.pCont = rpcMallocCont(16);
+  rpcMsg.contLen = 16;
+  rpcMsg.info = pMsg->info;
+  rpcFreeCont(pMsg->pCont);
+  rpcSendResponse(&rpcMsg);
+}
+
+void processCompResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  SCompResp *pResp = (SCompResp *)parent;
+  pResp->code = pMsg->code;
+  rpcFreeCont(pMsg->pCont);
+  tsem_post(&pResp->sem);
+}
+
+void *openCompRpc(int8_t connType, void *parent) {
+  SRpcInit rpcInit = {0};
+  if (connType == TAOS_CONN_SERVER) {
+    tstrncpy(rpcInit.localFqdn, "localhost", sizeof(rpcInit.localFqdn));
+    rpcInit.localPort = compPort;
+    rpcInit.cfp = processCompReq;
+  } else {
+    rpcInit.cfp = processCompResp;
+    rpcInit.shareConnLimit = 16;
+  }
+  rpcInit.label = (char *)"COMP";
+  rpcInit.numOfThreads = 1;
+  rpcInit.user = (char *)"user";
+  rpcInit.parent = parent;
+  rpcInit.connType = connType;
+  rpcInit.compressSize = 0;
+  rpcInit.compressAlgorithm = TRANS_COMP_ZSTD_DICT;
+  (void)taosVersionStrToInt(td_version, &rpcInit.compatibilityVer);
+  return rpcOpen(&rpcInit);
+}
+
+}  // namespace
+
+TEST_F(TransCompTest, rpcWithDictionary) {
+  if (!dictSupported()) {
+    GTEST_SKIP() << "no zstd dictionary";
+  }
+
+  void *pSrv = openCompRpc(TAOS_CONN_SERVER, NULL);
+  ASSERT_NE(pSrv, nullptr);
+
+  SCompResp resp;
+  ASSERT_EQ(tsem_init(&resp.sem, 0, 0), 0);
+  void *pCli = openCompRpc(TAOS_CONN_CLIENT, &resp);
+  ASSERT_NE(pCli, nullptr);
+
+  STransCompStat before = {0};
+  transGetCompStat(TRANS_COMP_ZSTD_DICT, &before);
+
+  SEpSet epSet = {0};
+  addEpIntoEpSet(&epSet, "localhost", compPort);
+
+  // the first msg goes with lz4 until the server tells what it decompresses, the dictionary is trained after that
+  for (int32_t i = 0; i < numOfSamples * 2; i++) {
+    SRpcMsg req = {0};
+    req.msgType = 1;
+    req.pCont = rpcMallocCont(msgSize);
+    ASSERT_NE(req.pCont, nullptr);
+    req.contLen = msgSize;
+    fillMsg((char *)req.pCont, msgSize, i);
+    memcpy(req.pCont, &i, sizeof(i));
+
+    resp.code = -1;
+    ASSERT_EQ(rpcSendRequest(pCli, &epSet, &req, NULL), 0);
+    (void)tsem_wait(&resp.sem);
+    ASSERT_EQ(resp.code, 0) << "msg " << i;
+  }
+
+  STransCompStat after = {0};
+  transGetCompStat(TRANS_COMP_ZSTD_DICT, &after);
+  EXPECT_GT(after.count, before.count);
+  EXPECT_LT(after.compBytes - before.compBytes, after.rawBytes - before.rawBytes);
+
+  rpcClose(pCli);
+  rpcClose(pSrv);
+  (void)tsem_destroy(&resp.sem);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3 * or later ("AGPL"), as published by the Free
+ * Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#define ALLOW_FORBID_FUNC
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#ifndef WINDOWS
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include "tglobal.h"
+#include "tmisce.h"
+#include "transComm.h"
+#include "trpc.h"
+#include "tversion.h"
+
+namespace {
+
+const int32_t localSockPort = 7010;
+
+typedef struct {
+  tsem_t  sem;
+  int32_t code;
+} SLocalSockResp;
+
+void processLocalSockReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  SRpcMsg rpcMsg = {0};
+  rpcMsg.pCont = rpcMallocCont(16);
+  rpcMsg.contLen = 16;
+  rpcMsg.info = pMsg->info;
+  rpcFreeCont(pMsg->pCont);
+  rpcSendResponse(&rpcMsg);
+}
+
+void processLocalSockResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  SLocalSockResp *pResp = (SLocalSockResp *)parent;
+  pResp->code = pMsg->code;
+  rpcFreeCont(pMsg->pCont);
+  tsem_post(&pResp->sem);
+}
+
+bool retryOnNetworkErr(int32_t code, tmsg_t msgType) {
+  return code == TSDB_CODE_RPC_NETWORK_UNAVAIL || code == TSDB_CODE_RPC_BROKEN_LINK;
+}
+
+void *openLocalSockRpc(int8_t connType, int8_t localSock, void *parent) {
+  SRpcInit rpcInit = {0};
+  if (connType == TAOS_CONN_SERVER) {
+    tstrncpy(rpcInit.localFqdn, "localhost", sizeof(rpcInit.localFqdn));
+    rpcInit.localPort = localSockPort;
+    rpcInit.cfp = processLocalSockReq;
+  } else {
+    rpcInit.cfp = processLocalSockResp;
+    rpcInit.rfp = retryOnNetworkErr;
+    rpcInit.retryMinInterval = 100;
+    rpcInit.retryStepFactor = 2;
+    rpcInit.retryMaxInterval = 1000;
+    rpcInit.retryMaxTimeout = 10000;
+    rpcInit.shareConnLimit = 16;
+  }
+  rpcInit.label = (char *)"LOCAL";
+  rpcInit.numOfThreads = 1;
+  rpcInit.user = (char *)"user";
+  rpcInit.parent = parent;
+  rpcInit.connType = connType;
+  rpcInit.localSock = localSock;
+  (void)taosVersionStrToInt(td_version, &rpcInit.compatibilityVer);
+  return rpcOpen(&rpcInit);
+}
+
+int32_t sendAndWait(void *pCli, SLocalSockResp *pResp) {
+  SEpSet epSet = {0};
+  addEpIntoEpSet(&epSet, "localhost", localSockPort);
+
+  SRpcMsg req = {0};
+  req.msgType = 1;
+  req.pCont = rpcMallocCont(16);
+  req.contLen = 16;
+  pResp->code = -1;
+  if (rpcSendRequest(pCli, &epSet, &req, NULL) != 0) {
+    return -1;
+  }
+  (void)tsem_wait(&pResp->sem);
+  return pResp->code;
+}
+
+#ifndef WINDOWS
+// leave a socket file behind as a killed server would do
+bool makeStaleSocket(const char *path) {
+  struct sockaddr_un addr = {0};
+  addr.sun_family = AF_UNIX;
+  tstrncpy(addr.sun_path, path, sizeof(addr.sun_path));
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return false;
+  (void)unlink(path);
+  bool ok = bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+  (void)close(fd);
+  return ok;
+}
+#endif
+
+}  // namespace
+
+TEST(transLocalSockTest, staleSocketFallbackToTcp) {
+#ifdef WINDOWS
+  GTEST_SKIP() << "no unix domain socket";
+#else
+  char    path[PATH_MAX] = {0};
+  int64_t owner = 0;
+  if (!transGetLocalSockPath(tsLocalFqdn, localSockPort, path, sizeof(path)) || !transCheckLocalSockDir(true, &owner)) {
+    GTEST_SKIP() << "no access to " << TRANS_LOCAL_SOCK_DIR;
+  }
+
+  // the server listens on tcp only, so the socket file left with its name refuses connections
+  void *pSrv = openLocalSockRpc(TAOS_CONN_SERVER, 0, NULL);
+  ASSERT_NE(pSrv, nullptr);
+  ASSERT_TRUE(makeStaleSocket(path));
+
+  SLocalSockResp resp;
+  ASSERT_EQ(tsem_init(&resp.sem, 0, 0), 0);
+  void *pCli = openLocalSockRpc(TAOS_CONN_CLIENT, 1, &resp);
+  ASSERT_NE(pCli, nullptr);
+
+  // the first request fails on the stale socket and is retried through tcp, later ones go to tcp directly
+  for (int32_t i = 0; i < 3; i++) {
+    EXPECT_EQ(sendAndWait(pCli, &resp), 0);
+  }
+
+  rpcClose(pCli);
+  rpcClose(pSrv);
+  (void)tsem_destroy(&resp.sem);
+  (void)unlink(path);
+#endif
+}
+
+TEST(transLocalSockTest, localSocketServed) {
+#ifdef WINDOWS
+  GTEST_SKIP() << "no unix domain socket";
+#else
+  char    path[PATH_MAX] = {0};
+  int64_t owner = 0;
+  if (!transGetLocalSockPath(tsLocalFqdn, localSockPort, path, sizeof(path)) || !transCheckLocalSockDir(true, &owner)) {
+    GTEST_SKIP() << "no access to " << TRANS_LOCAL_SOCK_DIR;
+  }
+
+  void *pSrv = openLocalSockRpc(TAOS_CONN_SERVER, 1, NULL);
+  ASSERT_NE(pSrv, nullptr);
+  taosMsleep(500);
+  EXPECT_TRUE(taosCheckAccessFile(path, TD_FILE_ACCESS_EXIST_OK));
+
+  SLocalSockResp resp;
+  ASSERT_EQ(tsem_init(&resp.sem, 0, 0), 0);
+  void *pCli = openLocalSockRpc(TAOS_CONN_CLIENT, 1, &resp);
+  ASSERT_NE(pCli, nullptr);
+  for (int32_t i = 0; i < 3; i++) {
+    EXPECT_EQ(sendAndWait(pCli, &resp), 0);
+  }
+
+  rpcClose(pCli);
+  rpcClose(pSrv);
+  (void)tsem_destroy(&resp.sem);
+#endif
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3 * or later ("AGPL"), as published by the Free
+ * Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+#include <cstring>
+#include "tglobal.h"
+#include "tmisce.h"
+#include "transComm.h"
+#include "trpc.h"
+#include "tversion.h"
+
+namespace {
+
+const int32_t sendPort = 7012;
+const int32_t msgSize = 1024;
+const int32_t numOfMsgs = 512;
+
+typedef struct {
+  tsem_t  sem;
+  int32_t recv;
+  int32_t failed;
+} SSendResp;
+
+void processSendReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  SRpcMsg rpcMsg = {0};
+  rpcMsg.pCont = rpcMallocCont(16);
+  rpcMsg.contLen = 16;
+  rpcMsg.info = pMsg->info;
+  rpcFreeCont(pMsg->pCont);
+  rpcSendResponse(&rpcMsg);
+}
+
+void processSendResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  SSendResp *pResp = (SSendResp *)parent;
+  if (pMsg->code != 0) {
+    (void)atomic_add_fetch_32(&pResp->failed, 1);
+  }
+  rpcFreeCont(pMsg->pCont);
+  if (atomic_add_fetch_32(&pResp->recv, 1) == numOfMsgs) {
+    tsem_post(&pResp->sem);
+  }
+}
+
+void *openSendRpc(int8_t connType, void *parent) {
+  SRpcInit rpcInit = {0};
+  if (connType == TAOS_CONN_SERVER) {
+    tstrncpy(rpcInit.localFqdn, "localhost", sizeof(rpcInit.localFqdn));
+    rpcInit.localPort = sendPort;
+    rpcInit.cfp = processSendReq;
+  } else {
+    rpcInit.cfp = processSendResp;
+    rpcInit.shareConnLimit = 16;
+  }
+  rpcInit.label = (char *)"SEND";
+  rpcInit.numOfThreads = 1;
+  rpcInit.user = (char *)"user";
+  rpcInit.parent = parent;
+  rpcInit.connType = connType;
+  rpcInit.compressSize = -1;
+  (void)taosVersionStrToInt(td_version, &rpcInit.compatibilityVer);
+  return rpcOpen(&rpcInit);
+}
+
+}  // namespace
+
+class TransSendTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { ASSERT_EQ(rpcInit(), 0); }
+};
+
+TEST_F(TransSendTest, deferWhileWriting) {
+  STransSendStat stat = {0};
+
+  // nothing in flight, the queue is written at once however shallow it is
+  EXPECT_FALSE(transSendMayDefer(&stat, 1));
+  EXPECT_NE(stat.pendingTs, 0);
+
+  transSendStatOnWrite(&stat, 3, 300, 0);
+  EXPECT_EQ(stat.writes, 1);
+  EXPECT_EQ(stat.msgs, 3);
+  EXPECT_EQ(stat.bytes, 300);
+  EXPECT_EQ(stat.maxMsgs, 3);
+  EXPECT_EQ(stat.inflight, 1);
+  EXPECT_EQ(stat.pendingTs, 0);
+
+  // a shallow queue waits for the write in flight, a deep one does not
+  EXPECT_TRUE(transSendMayDefer(&stat, 1));
+  EXPECT_TRUE(transSendMayDefer(&stat, TRANS_BATCH_SEND_MIN_MSGS - 1));
+  EXPECT_FALSE(transSendMayDefer(&stat, TRANS_BATCH_SEND_MIN_MSGS));
+
+  // nor once its oldest msg has waited longer than the latency budget
+  stat.pendingTs = taosGetTimestampUs() - TRANS_BATCH_SEND_LATENCY_US;
+  EXPECT_FALSE(transSendMayDefer(&stat, 1));
+
+  // the msgs left over start to wait again
+  transSendStatOnWrite(&stat, 1, 100, 2);
+  EXPECT_EQ(stat.writes, 2);
+  EXPECT_EQ(stat.maxMsgs, 3);
+  EXPECT_EQ(stat.inflight, 2);
+  EXPECT_NE(stat.pendingTs, 0);
+
+  transSendStatOnWriteDone(&stat);
+  transSendStatOnWriteDone(&stat);
+  transSendStatOnWriteDone(&stat);
+  EXPECT_EQ(stat.inflight, 0);
+  EXPECT_FALSE(transSendMayDefer(&stat, 1));
+}
+
+TEST_F(TransSendTest, totalsOfAllConns) {
+  STransSendStat stat1 = {0}, stat2 = {0};
+  SRpcStat       before = {0};
+  rpcGetStat(&before);
+
+  transSendStatOnWrite(&stat1, 4, 400, 0);
+  transSendStatOnWrite(&stat2, 2, 50, 0);
+
+  SRpcStat after = {0};
+  rpcGetStat(&after);
+  EXPECT_EQ(after.sendWrites - before.sendWrites, 2);
+  EXPECT_EQ(after.sendMsgs - before.sendMsgs, 6);
+  EXPECT_EQ(after.sendBytes - before.sendBytes, 450);
+}
+
+TEST_F(TransSendTest, rpcCoalesced) {
+  void *pSrv = openSendRpc(TAOS_CONN_SERVER, NULL);
+  ASSERT_NE(pSrv, nullptr);
+
+  SSendResp resp = {0};
+  ASSERT_EQ(tsem_init(&resp.sem, 0, 0), 0);
+  void *pCli = openSendRpc(TAOS_CONN_CLIENT, &resp);
+  ASSERT_NE(pCli, nullptr);
+
+  SEpSet epSet = {0};
+  addEpIntoEpSet(&epSet, "localhost", sendPort);
+
+  SRpcStat before = {0};
+  rpcGetStat(&before);
+
+  // the requests are queued without waiting for the responses, so a write may carry several of them
+  for (int32_t i = 0; i < numOfMsgs; i++) {
+    SRpcMsg req = {0};
+    req.msgType = 1;
+    req.pCont = rpcMallocCont(msgSize);
+    ASSERT_NE(req.pCont, nullptr);
+    req.contLen = msgSize;
+    memset(req.pCont, i, msgSize);
+    ASSERT_EQ(rpcSendRequest(pCli, &epSet, &req, NULL), 0);
+  }
+  (void)tsem_wait(&resp.sem);
+  EXPECT_EQ(resp.failed, 0);
+
+  // both the requests of the client and the responses of the server are counted in the process
+  SRpcStat after = {0};
+  rpcGetStat(&after);
+  int64_t writes = after.sendWrites - before.sendWrites;
+  int64_t msgs = after.sendMsgs - before.sendMsgs;
+  EXPECT_GE(msgs, 2 * numOfMsgs);
+  EXPECT_GT(writes, 0);
+  EXPECT_LE(writes, msgs);
+  EXPECT_GE(after.sendBytes - before.sendBytes, (int64_t)numOfMsgs * msgSize);
+
+  rpcClose(pCli);
+  rpcClose(pSrv);
+  (void)tsem_destroy(&resp.sem);
+}
@@ -170,6 +170,7 @@ int32_t walRollFileInfo(SWal* pWal);
 int32_t walScanLogGetLastVer(SWal* pWal, int32_t fileIdx, int64_t* lastVer);
 int32_t walCheckAndRepairMeta(SWal* pWal);
 int64_t walChangeWrite(SWal* pWal, int64_t ver);
+void    walReleasePrealloc(SWal* pWal);
 
 int32_t walCheckAndRepairIdx(SWal* pWal);
 
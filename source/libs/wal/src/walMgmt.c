@@ -233,6 +233,7 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
   }
 
   pWal->stopDnode = tsWal.stopDnode;
+  pWal->group.syncedVer = pWal->vers.lastVer;
 
   wDebug("vgId:%d, wal:%p is opened, level:%d fsyncPeriod:%d", pWal->cfg.vgId, pWal, pWal->cfg.level,
          pWal->cfg.fsyncPeriod);
@@ -293,11 +294,36 @@ int32_t walPersist(SWal *pWal) {
   TAOS_RETURN(code);
 }
 
+// only non-empty buckets, as "lower bound:count"
+static void walFormatHist(const int64_t *hist, char *buf, int32_t size) {
+  int32_t len = 0;
+  for (int32_t i = 0; i < WAL_GROUP_COMMIT_HIST_SIZE && len < size; i++) {
+    if (hist[i] == 0) continue;
+    len += tsnprintf(buf + len, size - len, "%s%" PRId64 ":%" PRId64, len > 0 ? " " : "", (int64_t)1 << i, hist[i]);
+  }
+}
+
 void walClose(SWal *pWal) {
+  int32_t code = walGroupCommit(pWal);
+  if (code != 0) {
+    wError("vgId:%d, failed to fsync pending entries since %s", pWal->cfg.vgId, tstrerror(code));
+  }
+
+  SWalGroupCommitStat *pStat = &pWal->group.stat;
+  char                 batch[512] = {0}, latency[512] = {0};
+  walFormatHist(pStat->batchHist, batch, sizeof(batch));
+  if (batch[0] != 0) {
+    walFormatHist(pStat->latencyHist, latency, sizeof(latency));
+    wInfo("vgId:%d, group commit batch hist:%s, latency(us) hist:%s", pWal->cfg.vgId, batch, latency);
+  }
+
   TAOS_UNUSED(taosThreadRwlockWrlock(&pWal->mutex));
   if (walSaveMeta(pWal) < 0) {
     wError("vgId:%d, failed to save meta since %s", pWal->cfg.vgId, tstrerror(terrno));
   }
+  if (pWal->pLogFile != NULL) {
+    walReleasePrealloc(pWal);
+  }
   TAOS_UNUSED(taosCloseFile(&pWal->pLogFile));
   pWal->pLogFile = NULL;
   (void)taosCloseFile(&pWal->pIdxFile);
@@ -364,7 +390,7 @@ static void walFsyncAll() {
     if (walNeedFsync(pWal)) {
       wTrace("vgId:%d, do fsync, level:%d seq:%d rseq:%d", pWal->cfg.vgId, pWal->cfg.level, pWal->fsyncSeq,
              atomic_load_32((volatile int32_t *)&tsWal.seq));
-      int32_t code = taosFsyncFile(pWal->pLogFile);
+      int32_t code = taosFdatasyncFile(pWal->pLogFile);
       if (code != 0) {
         wError("vgId:%d, file:%" PRId64 ".log, failed to fsync since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
                strerror(ERRNO));
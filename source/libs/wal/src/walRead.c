@@ -18,6 +18,111 @@
 #include "wal.h"
 #include "walInt.h"
 
+// extra length mapped beyond the end of the active files, so that appends don't require a remap
+#define WAL_READ_MAP_LOG_SLACK (64 * 1024 * 1024L)
+#define WAL_READ_MAP_IDX_SLACK (1024 * 1024L)
+
+static void walReadUnmap(SWalReader *pReader) {
+  TAOS_UNUSED(taosMunmapFile(pReader->map.pLog, pReader->map.logMapSize));
+  TAOS_UNUSED(taosMunmapFile(pReader->map.pIdx, pReader->map.idxMapSize));
+  (void)memset(&pReader->map, 0, sizeof(pReader->map));
+  pReader->map.bodyOffset = -1;
+}
+
+static int32_t walReadMapFile(TdFilePtr pFile, int64_t slack, uint8_t **ppMap, int64_t *pMapSize, int64_t *pSize) {
+  int64_t size = 0;
+  if (taosFStatFile(pFile, &size, NULL) != 0) {
+    TAOS_RETURN(terrno);
+  }
+  if (size + slack <= 0) {
+    TAOS_RETURN(TSDB_CODE_WAL_LOG_NOT_EXIST);
+  }
+
+  uint8_t *ptr = taosMmapReadOnlyFile(pFile, size + slack);
+  if (ptr == NULL) {
+    TAOS_RETURN(terrno);
+  }
+
+  *ppMap = ptr;
+  *pMapSize = size + slack;
+  *pSize = size;
+  TAOS_RETURN(TSDB_CODE_SUCCESS);
+}
+
+static void walReadMap(SWalReader *pReader, bool active) {
+  int32_t code = 0;
+
+  walReadUnmap(pReader);
+  code = walReadMapFile(pReader->pLogFile, active ? WAL_READ_MAP_LOG_SLACK : 0, &pReader->map.pLog,
+                        &pReader->map.logMapSize, &pReader->map.logSize);
+  if (code == 0) {
+    code = walReadMapFile(pReader->pIdxFile, active ? WAL_READ_MAP_IDX_SLACK : 0, &pReader->map.pIdx,
+                          &pReader->map.idxMapSize, &pReader->map.idxSize);
+  }
+  if (code != 0) {
+    wDebug("vgId:%d, file:%" PRId64 ".log, read without mapping since %s", pReader->pWal->cfg.vgId,
+           pReader->curFileFirstVer, tstrerror(code));
+    walReadUnmap(pReader);
+  }
+}
+
+// whether [0, end) of the mapped file can be accessed, the file may have grown since it was mapped
+static bool walReadMapCover(TdFilePtr pFile, int64_t end, int64_t mapSize, int64_t *pSize) {
+  if (end <= *pSize) return true;
+  if (end > mapSize) return false;
+
+  int64_t size = 0;
+  if (taosFStatFile(pFile, &size, NULL) != 0) return false;
+  *pSize = size;
+  return end <= size;
+}
+
+// copy the head of a committed entry of the current file out of the mapping, false to read the file instead.
+// uncommitted entries are left to the file path, since a rollback may truncate them under the mapping.
+static bool walReadMapHead(SWalReader *pReader, int64_t ver) {
+  pReader->map.bodyOffset = -1;
+  if (pReader->map.pLog == NULL || ver < pReader->curFileFirstVer || ver > pReader->pWal->vers.commitVer) {
+    return false;
+  }
+
+  int64_t idxOffset = (ver - pReader->curFileFirstVer) * sizeof(SWalIdxEntry);
+  if (!walReadMapCover(pReader->pIdxFile, idxOffset + sizeof(SWalIdxEntry), pReader->map.idxMapSize,
+                       &pReader->map.idxSize)) {
+    return false;
+  }
+
+  SWalIdxEntry entry;
+  (void)memcpy(&entry, pReader->map.pIdx + idxOffset, sizeof(SWalIdxEntry));
+  if (entry.ver != ver || entry.offset < 0 ||
+      !walReadMapCover(pReader->pLogFile, entry.offset + sizeof(SWalCkHead), pReader->map.logMapSize,
+                       &pReader->map.logSize)) {
+    return false;
+  }
+
+  SWalCkHead head;
+  (void)memcpy(&head, pReader->map.pLog + entry.offset, sizeof(SWalCkHead));
+  int32_t cryptedBodyLen = head.head.bodyLen;
+  // TODO: dmchen emun
+  if (pReader->pWal->cfg.encryptAlgorithm == 1) {
+    cryptedBodyLen = ENCRYPTED_LEN(cryptedBodyLen);
+  }
+  if (head.head.version != ver || cryptedBodyLen < 0 ||
+      !walReadMapCover(pReader->pLogFile, entry.offset + sizeof(SWalCkHead) + cryptedBodyLen,
+                       pReader->map.logMapSize, &pReader->map.logSize)) {
+    return false;
+  }
+
+  (void)memcpy(pReader->pHead, &head, sizeof(SWalCkHead));
+  pReader->map.bodyOffset = entry.offset + sizeof(SWalCkHead);
+  pReader->map.posStale = true;
+  return true;
+}
+
+static void walReadMapBody(SWalReader *pReader, int32_t cryptedBodyLen) {
+  (void)memcpy(pReader->pHead->head.body, pReader->map.pLog + pReader->map.bodyOffset, cryptedBodyLen);
+  pReader->map.bodyOffset = -1;
+}
+
 SWalReader *walOpenReader(SWal *pWal, int64_t id) {
   SWalReader *pReader = taosMemoryCalloc(1, sizeof(SWalReader));
   if (pReader == NULL) {
@@ -32,6 +137,7 @@ SWalReader *walOpenReader(SWal *pWal, int64_t id) {
   pReader->curVersion = -1;
   pReader->curFileFirstVer = -1;
   pReader->capacity = 0;
+  pReader->map.bodyOffset = -1;
 
   terrno = taosThreadMutexInit(&pReader->mutex, NULL);
   if (terrno) {
@@ -56,6 +162,7 @@ SWalReader *walOpenReader(SWal *pWal, int64_t id) {
 void walCloseReader(SWalReader *pReader) {
   if (pReader == NULL) return;
 
+  walReadUnmap(pReader);
   TAOS_UNUSED(taosCloseFile(&pReader->pIdxFile));
   TAOS_UNUSED(taosCloseFile(&pReader->pLogFile));
   taosMemoryFreeClear(pReader->pHead);
@@ -147,9 +254,10 @@ static int32_t walReadSeekFilePos(SWalReader *pReader, int64_t fileFirstVer, int
   TAOS_RETURN(TSDB_CODE_SUCCESS);
 }
 
-static int32_t walReadChangeFile(SWalReader *pReader, int64_t fileFirstVer) {
+static int32_t walReadChangeFile(SWalReader *pReader, int64_t fileFirstVer, bool active) {
   char fnameStr[WAL_FILE_LEN] = {0};
 
+  walReadUnmap(pReader);
   TAOS_UNUSED(taosCloseFile(&pReader->pIdxFile));
   TAOS_UNUSED(taosCloseFile(&pReader->pLogFile));
 
@@ -173,6 +281,8 @@ static int32_t walReadChangeFile(SWalReader *pReader, int64_t fileFirstVer) {
 
   pReader->curFileFirstVer = fileFirstVer;
 
+  walReadMap(pReader, active);
+
   TAOS_RETURN(TSDB_CODE_SUCCESS);
 }
 
@@ -191,14 +301,21 @@ static int32_t walReadSeekVerImpl(SWalReader *pReader, int64_t ver) {
   }
   SWalFileInfo ret;
   TAOS_MEMCPY(&ret, globalRet, sizeof(SWalFileInfo));
+  bool active = (globalRet == taosArrayGetLast(pWal->fileInfoSet));
   TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
   if (pReader->curFileFirstVer != ret.firstVer) {
     // error code was set inner
-    TAOS_CHECK_RETURN(walReadChangeFile(pReader, ret.firstVer));
+    TAOS_CHECK_RETURN(walReadChangeFile(pReader, ret.firstVer, active));
+  } else if (active && pReader->map.pLog != NULL &&
+             (ret.fileSize > pReader->map.logMapSize ||
+              (ret.lastVer - ret.firstVer + 1) * (int64_t)sizeof(SWalIdxEntry) > pReader->map.idxMapSize)) {
+    // the active file has grown out of the mapped window
+    walReadMap(pReader, true);
   }
 
   // error code was set inner
   TAOS_CHECK_RETURN(walReadSeekFilePos(pReader, ret.firstVer, ver));
+  pReader->map.posStale = false;
   wDebug("vgId:%d, wal version reset from %" PRId64 " to %" PRId64, pReader->pWal->cfg.vgId, pReader->curVersion, ver);
 
   pReader->curVersion = ver;
@@ -242,6 +359,16 @@ int32_t walFetchHead(SWalReader *pRead, int64_t ver) {
     seeked = true;
   }
 
+  if (walReadMapHead(pRead, ver)) {
+    TAOS_RETURN(TSDB_CODE_SUCCESS);
+  }
+
+  if (pRead->map.posStale) {
+    TAOS_CHECK_RETURN(walReadSeekVerImpl(pRead, ver));
+
+    seeked = true;
+  }
+
   while (1) {
     contLen = taosReadFile(pRead->pLogFile, pRead->pHead, sizeof(SWalCkHead));
     if (contLen == sizeof(SWalCkHead)) {
@@ -284,9 +411,13 @@ int32_t walSkipFetchBody(SWalReader *pRead) {
   if (pRead->pWal->cfg.encryptAlgorithm == 1) {
     cryptedBodyLen = ENCRYPTED_LEN(cryptedBodyLen);
   }
-  int64_t ret = taosLSeekFile(pRead->pLogFile, cryptedBodyLen, SEEK_CUR);
-  if (ret < 0) {
-    TAOS_RETURN(terrno);
+  if (pRead->map.bodyOffset >= 0) {
+    pRead->map.bodyOffset = -1;
+  } else {
+    int64_t ret = taosLSeekFile(pRead->pLogFile, cryptedBodyLen, SEEK_CUR);
+    if (ret < 0) {
+      TAOS_RETURN(terrno);
+    }
   }
 
   pRead->curVersion++;
@@ -324,7 +455,9 @@ int32_t walFetchBody(SWalReader *pRead) {
     pRead->capacity = cryptedBodyLen;
   }
 
-  if (cryptedBodyLen != taosReadFile(pRead->pLogFile, pReadHead->body, cryptedBodyLen)) {
+  if (pRead->map.bodyOffset >= 0) {
+    walReadMapBody(pRead, cryptedBodyLen);
+  } else if (cryptedBodyLen != taosReadFile(pRead->pLogFile, pReadHead->body, cryptedBodyLen)) {
     if (plainBodyLen < 0) {
       wError("vgId:%d, wal fetch body error:%" PRId64 ", read request index:%" PRId64 ", since %s, reader:0x%" PRIx64,
              vgId, pReadHead->version, ver, tstrerror(terrno), id);
@@ -390,7 +523,18 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
     seeked = true;
   }
 
-  while (1) {
+  bool mapped = walReadMapHead(pReader, ver);
+  if (!mapped && pReader->map.posStale) {
+    code = walReadSeekVerImpl(pReader, ver);
+    if (code) {
+      TAOS_UNUSED(taosThreadMutexUnlock(&pReader->mutex));
+
+      TAOS_RETURN(code);
+    }
+    seeked = true;
+  }
+
+  while (!mapped) {
     contLen = taosReadFile(pReader->pLogFile, pReader->pHead, sizeof(SWalCkHead));
     if (contLen == sizeof(SWalCkHead)) {
       break;
@@ -448,7 +592,10 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
     pReader->capacity = cryptedBodyLen;
   }
 
-  if ((contLen = taosReadFile(pReader->pLogFile, pReader->pHead->head.body, cryptedBodyLen)) != cryptedBodyLen) {
+  if (mapped) {
+    walReadMapBody(pReader, cryptedBodyLen);
+  } else if ((contLen = taosReadFile(pReader->pLogFile, pReader->pHead->head.body, cryptedBodyLen)) !=
+             cryptedBodyLen) {
     if (contLen < 0) {
       code = terrno;
     } else {
@@ -529,6 +676,7 @@ void walReadReset(SWalReader *pReader) {
     wError("vgId:%d, failed to lock mutex", pReader->pWal->cfg.vgId);
   }
 
+  walReadUnmap(pReader);
   TAOS_UNUSED(taosCloseFile(&pReader->pIdxFile));
   TAOS_UNUSED(taosCloseFile(&pReader->pLogFile));
   pReader->curFileFirstVer = -1;
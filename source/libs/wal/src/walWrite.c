@@ -150,6 +150,7 @@ int64_t walChangeWrite(SWal *pWal, int64_t ver) {
   pWal->pLogFile = pLogTFile;
   pWal->pIdxFile = pIdxTFile;
   pWal->writeCur = idx;
+  pWal->preallocEnd = 0;
 
   return fileFirstVer;
 }
@@ -233,6 +234,7 @@ int32_t walRollback(SWal *pWal, int64_t ver) {
 
   // truncate old files
   if ((code = taosFtruncateFile(pLogFile, entry.offset)) < 0) goto _exit;
+  pWal->preallocEnd = 0;  // truncation releases the reserved blocks
 
   if ((code = taosFtruncateFile(pIdxFile, idxOff)) < 0) goto _exit;
 
@@ -253,6 +255,18 @@ _exit:
   TAOS_RETURN(code);
 }
 
+// give back the blocks reserved beyond the end of a log file that will not be appended any more
+void walReleasePrealloc(SWal *pWal) {
+  if (pWal->preallocEnd == 0 || pWal->preallocEnd == INT64_MAX) return;
+
+  int64_t size = 0;
+  if (taosFStatFile(pWal->pLogFile, &size, NULL) != 0 || taosFtruncateFile(pWal->pLogFile, size) != 0) {
+    wWarn("vgId:%d, file:%" PRId64 ".log, failed to release preallocated space since %s", pWal->cfg.vgId,
+          walGetLastFileFirstVer(pWal), tstrerror(terrno));
+  }
+  pWal->preallocEnd = 0;
+}
+
 int32_t walRollImpl(SWal *pWal) {
   int32_t code = 0, lino = 0;
 
@@ -270,6 +284,7 @@ int32_t walRollImpl(SWal *pWal) {
   }
 
   if (pWal->pLogFile != NULL) {
+    walReleasePrealloc(pWal);
     if ((code = taosFsyncFile(pWal->pLogFile)) != 0) {
       TAOS_CHECK_GOTO(terrno, &lino, _exit);
     }
@@ -298,6 +313,7 @@ int32_t walRollImpl(SWal *pWal) {
   pWal->pIdxFile = pIdxFile;
   pWal->pLogFile = pLogFile;
   pWal->writeCur = taosArrayGetSize(pWal->fileInfoSet) - 1;
+  pWal->preallocEnd = 0;
 
   pWal->lastRollSeq = walGetSeq();
 
@@ -525,6 +541,31 @@ static int32_t walWriteIndex(SWal *pWal, int64_t ver, int64_t offset, const STra
   TAOS_RETURN(TSDB_CODE_SUCCESS);
 }
 
+// reserve blocks ahead of the log end in chunks, so that appends and their fsyncs don't allocate extents.
+// the log is still written through the page cache rather than with O_DIRECT, since entries are unaligned and the
+// sync and tq readers read the recent ones back, and deleted segments are not recycled, since reusing a file means
+// truncating it, which frees the blocks again.
+static void walPreallocLogFile(SWal *pWal, int64_t offset, int64_t end) {
+  int64_t chunk = (int64_t)tsWalPreallocSize * 1024 * 1024;
+  if (chunk <= 0 || end <= pWal->preallocEnd) return;
+
+  int64_t target = end + chunk;
+  if (pWal->cfg.segSize > 0) {
+    // the file is rolled soon after it exceeds segSize
+    target = TMIN(target, pWal->cfg.segSize + chunk / 4);
+  }
+  if (target <= end) return;
+
+  offset = TMAX(pWal->preallocEnd, offset);
+  if (taosFallocateFile(pWal->pLogFile, offset, target - offset) != 0) {
+    wWarn("vgId:%d, file:%" PRId64 ".log, failed to preallocate since %s, offset:%" PRId64 ", size:%" PRId64,
+          pWal->cfg.vgId, walGetLastFileFirstVer(pWal), tstrerror(terrno), offset, target - offset);
+    pWal->preallocEnd = INT64_MAX;  // not supported by the file system, don't retry for this file
+    return;
+  }
+  pWal->preallocEnd = target;
+}
+
 static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta,
                                          const void *body, int32_t bodyLen, const STraceId *trace) {
   int32_t code = 0, lino = 0;
@@ -546,19 +587,6 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   wGDebug(trace, "vgId:%d, index:%" PRId64 ", write log, type:%s, cksum head:%u, cksum body:%u", pWal->cfg.vgId, index,
           TMSG_INFO(msgType), pWal->writeHead.cksumHead, pWal->writeHead.cksumBody);
 
-  if (pWal->cfg.level != TAOS_WAL_SKIP) {
-    TAOS_CHECK_GOTO(walWriteIndex(pWal, index, offset, trace), &lino, _exit);
-  }
-
-  if (pWal->cfg.level != TAOS_WAL_SKIP &&
-      taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
-    code = terrno;
-    wGError(trace, "vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId,
-            walGetLastFileFirstVer(pWal), strerror(ERRNO));
-    walStopDnode(pWal);
-    TAOS_CHECK_GOTO(code, &lino, _exit);
-  }
-
   int32_t cyptedBodyLen = plainBodyLen;
   char   *buf = (char *)body;
   char   *newBody = NULL;
@@ -598,26 +626,36 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     buf = newBodyEncrypted;
   }
 
-  if (pWal->cfg.level != TAOS_WAL_SKIP && taosWriteFile(pWal->pLogFile, (char *)buf, cyptedBodyLen) != cyptedBodyLen) {
-    code = terrno;
-    wGError(trace, "vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId,
-            walGetLastFileFirstVer(pWal), strerror(ERRNO));
-
-    if (pWal->cfg.encryptAlgorithm == DND_CA_SM4) {
+  if (pWal->cfg.level != TAOS_WAL_SKIP) {
+    code = walWriteIndex(pWal, index, offset, trace);
+    if (code != 0) {
       taosMemoryFreeClear(newBody);
       taosMemoryFreeClear(newBodyEncrypted);
+      TAOS_CHECK_GOTO(code, &lino, _exit);
     }
 
-    walStopDnode(pWal);
+    walPreallocLogFile(pWal, offset, offset + sizeof(SWalCkHead) + cyptedBodyLen);
 
-    TAOS_CHECK_GOTO(code, &lino, _exit);
-  }
+    // head and body go down in one vectored write
+    TaosIOVec iov[2] = {{.iov_base = &pWal->writeHead, .iov_len = sizeof(SWalCkHead)},
+                        {.iov_base = buf, .iov_len = cyptedBodyLen}};
+    if (taosWritevFile(pWal->pLogFile, iov, 2) != sizeof(SWalCkHead) + cyptedBodyLen) {
+      code = terrno;
+      wGError(trace, "vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId,
+              walGetLastFileFirstVer(pWal), strerror(ERRNO));
 
-  if (pWal->cfg.encryptAlgorithm == DND_CA_SM4) {
-    taosMemoryFreeClear(newBody);
-    taosMemoryFreeClear(newBodyEncrypted);
+      taosMemoryFreeClear(newBody);
+      taosMemoryFreeClear(newBodyEncrypted);
+
+      walStopDnode(pWal);
+
+      TAOS_CHECK_GOTO(code, &lino, _exit);
+    }
   }
 
+  taosMemoryFreeClear(newBody);
+  taosMemoryFreeClear(newBodyEncrypted);
+
   // set status
   if (pWal->vers.firstVer == -1) {
     pWal->vers.firstVer = index;
@@ -678,6 +716,7 @@ static int32_t walInitWriteFile(SWal *pWal) {
   // switch file
   pWal->pIdxFile = pIdxTFile;
   pWal->pLogFile = pLogTFile;
+  pWal->preallocEnd = 0;
   if (taosArrayGetSize(pWal->fileInfoSet) == 0) {
     code = walRollFileInfo(pWal);
     if (code < 0) {
@@ -717,6 +756,35 @@ _exit:
   return code;
 }
 
+static int32_t walHistIndex(int64_t val) {
+  int32_t i = 0;
+  while (val > 1 && i < WAL_GROUP_COMMIT_HIST_SIZE - 1) {
+    val >>= 1;
+    i++;
+  }
+  return i;
+}
+
+static int32_t walDoFsync(SWal *pWal) {
+  int32_t code = 0;
+
+  wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
+  if (taosFdatasyncFile(pWal->pLogFile) < 0) {
+    wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
+           strerror(ERRNO));
+    code = terrno;
+  } else {
+    pWal->group.syncedVer = pWal->vers.lastVer;
+    pWal->group.pendingTs = 0;
+  }
+
+  return code;
+}
+
+static void walMarkFsyncPending(SWal *pWal) {
+  if (pWal->group.pendingTs == 0) pWal->group.pendingTs = taosGetTimestampUs();
+}
+
 int32_t walFsync(SWal *pWal, bool forceFsync) {
   int32_t code = 0;
 
@@ -725,15 +793,84 @@ int32_t walFsync(SWal *pWal, bool forceFsync) {
   }
 
   TAOS_UNUSED(taosThreadRwlockWrlock(&pWal->mutex));
-  if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
-    wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
-    if (taosFsyncFile(pWal->pLogFile) < 0) {
-      wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
-             strerror(ERRNO));
-      code = terrno;
+  if (forceFsync) {
+    code = walDoFsync(pWal);
+  } else if (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0) {
+    if (tsWalGroupCommit) {
+      // deferred to walGroupCommit, which syncs all pending entries at once
+      walMarkFsyncPending(pWal);
+    } else {
+      code = walDoFsync(pWal);
     }
   }
   TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
 
   return code;
 }
+
+int32_t walDeferFsync(SWal *pWal, bool forceFsync) {
+  if (pWal->cfg.level == TAOS_WAL_SKIP) {
+    return 0;
+  }
+
+  if (forceFsync) {
+    return walFsync(pWal, forceFsync);
+  }
+
+  TAOS_UNUSED(taosThreadRwlockWrlock(&pWal->mutex));
+  if (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0) {
+    walMarkFsyncPending(pWal);
+  }
+  TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
+
+  return 0;
+}
+
+int32_t walGroupCommit(SWal *pWal) {
+  int32_t code = 0;
+
+  TAOS_UNUSED(taosThreadRwlockWrlock(&pWal->mutex));
+  if (pWal->group.pendingTs == 0) {
+    TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
+    return code;
+  }
+
+  int64_t startTs = pWal->group.pendingTs;
+  int64_t nEntries = TMAX(pWal->vers.lastVer - pWal->group.syncedVer, 1);
+  if (pWal->pLogFile != NULL) {
+    code = walDoFsync(pWal);
+  } else {
+    // the file was rolled or closed, which has synced it already
+    pWal->group.syncedVer = pWal->vers.lastVer;
+    pWal->group.pendingTs = 0;
+  }
+
+  if (code == 0) {
+    SWalGroupCommitStat *pStat = &pWal->group.stat;
+    int64_t              latency = taosGetTimestampUs() - startTs;
+    pStat->numOfSyncs++;
+    pStat->numOfEntries += nEntries;
+    pStat->latency += latency;
+    pStat->batchHist[walHistIndex(nEntries)]++;
+    pStat->latencyHist[walHistIndex(latency)]++;
+    wTrace("vgId:%d, group commit %" PRId64 " entries, synced ver:%" PRId64, pWal->cfg.vgId, nEntries,
+           pWal->group.syncedVer);
+  }
+  TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
+
+  return code;
+}
+
+void walGetGroupCommitStat(SWal *pWal, SWalGroupCommitStat *pStat) {
+  TAOS_UNUSED(taosThreadRwlockRdlock(&pWal->mutex));
+  *pStat = pWal->group.stat;
+  TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
+}
+
+void walResetGroupCommitStat(SWal *pWal, const SWalGroupCommitStat *pOldStat) {
+  TAOS_UNUSED(taosThreadRwlockWrlock(&pWal->mutex));
+  pWal->group.stat.numOfSyncs -= pOldStat->numOfSyncs;
+  pWal->group.stat.numOfEntries -= pOldStat->numOfEntries;
+  pWal->group.stat.latency -= pOldStat->latency;
+  TAOS_UNUSED(taosThreadRwlockUnlock(&pWal->mutex));
+}
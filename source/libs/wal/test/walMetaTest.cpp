@@ -1,8 +1,17 @@
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 #include <cstring>
 #include <iostream>
 #include <queue>
 
+// bytes allocated to a file, the blocks reserved beyond its end included
+static int64_t allocatedSize(const char* path) {
+  struct stat st;
+  if (stat(path, &st) != 0) return -1;
+  return (int64_t)st.st_blocks * 512;
+}
+
+#include "tglobal.h"
 #include "walInt.h"
 
 const char*  ranStr = "tvapq02tcp";
@@ -210,6 +219,7 @@ class WalEncrypted : public ::testing::Test {
     cfg.vgId = 0;
     cfg.level = TAOS_WAL_FSYNC;
     cfg.encryptAlgorithm = 1;
+    tstrncpy(cfg.encryptKey, "walEncryptedTest", sizeof(cfg.encryptKey));
     pWal = walOpen(pathName, &cfg);
     ASSERT(pWal != NULL);
   }
@@ -822,4 +832,262 @@ TEST_F(WalEncrypted, write) {
   }
   code = walSaveMeta(pWal);
   ASSERT_EQ(code, 0);
-}
\ No newline at end of file
+}
+TEST_F(WalCleanEnv, groupCommit) {
+  int  code;
+  bool groupCommit = tsWalGroupCommit;
+  tsWalGroupCommit = true;
+
+  // the entries of several proposals appended by the leader within a group commit
+  for (int i = 0; i < 10; i++) {
+    code = walAppendLog(pWal, i, i + 1, syncMeta, (void*)ranStr, ranStrLen, NULL);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(walDeferFsync(pWal, false), 0);
+  }
+  ASSERT_NE(pWal->group.pendingTs, 0);
+  ASSERT_EQ(pWal->group.stat.numOfSyncs, 0);
+
+  // share a single fsync
+  ASSERT_EQ(walGroupCommit(pWal), 0);
+  ASSERT_EQ(pWal->group.pendingTs, 0);
+  ASSERT_EQ(pWal->group.syncedVer, 9);
+  ASSERT_EQ(pWal->group.stat.numOfSyncs, 1);
+  ASSERT_EQ(pWal->group.stat.numOfEntries, 10);
+
+  // nothing is synced again without new entries
+  ASSERT_EQ(walGroupCommit(pWal), 0);
+  ASSERT_EQ(pWal->group.stat.numOfSyncs, 1);
+
+  // a forced fsync is not deferred
+  code = walAppendLog(pWal, 10, 11, syncMeta, (void*)ranStr, ranStrLen, NULL);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(walFsync(pWal, true), 0);
+  ASSERT_EQ(pWal->group.pendingTs, 0);
+  ASSERT_EQ(pWal->group.syncedVer, 10);
+
+  tsWalGroupCommit = groupCommit;
+}
+
+TEST_F(WalCleanEnv, preallocate) {
+  int     code;
+  int32_t preallocSize = tsWalPreallocSize;
+  int64_t chunk = 1024 * 1024;
+  tsWalPreallocSize = 1;
+
+  for (int i = 0; i < 10; i++) {
+    code = walAppendLog(pWal, i, i + 1, syncMeta, (void*)ranStr, ranStrLen, NULL);
+    ASSERT_EQ(code, 0);
+  }
+  if (pWal->preallocEnd == INT64_MAX) {
+    tsWalPreallocSize = preallocSize;
+    GTEST_SKIP() << "fallocate is not supported by the file system";
+  }
+
+  // blocks are reserved ahead of the log end, the file size is not changed
+  char    fnameStr[WAL_FILE_LEN];
+  int64_t size = 0;
+  walBuildLogName(pWal, walGetLastFileFirstVer(pWal), fnameStr);
+  ASSERT_EQ(taosStatFile(fnameStr, &size, NULL, NULL), 0);
+  ASSERT_GT(pWal->preallocEnd, size);
+  ASSERT_LT(size, chunk);
+  ASSERT_GE(allocatedSize(fnameStr), chunk);
+
+  // a refused rollback keeps the reservation
+  int64_t preallocEnd = pWal->preallocEnd;
+  ASSERT_EQ(walRollback(pWal, 20), TSDB_CODE_WAL_INVALID_VER);
+  ASSERT_EQ(pWal->preallocEnd, preallocEnd);
+
+  // the truncation of a rollback releases it
+  ASSERT_EQ(walRollback(pWal, 5), 0);
+  ASSERT_EQ(pWal->preallocEnd, 0);
+  ASSERT_LT(allocatedSize(fnameStr), chunk);
+
+  // appends reserve blocks again, and closing gives them back
+  for (int i = 5; i < 10; i++) {
+    code = walAppendLog(pWal, i, i + 1, syncMeta, (void*)ranStr, ranStrLen, NULL);
+    ASSERT_EQ(code, 0);
+  }
+  ASSERT_GT(pWal->preallocEnd, 0);
+  ASSERT_GE(allocatedSize(fnameStr), chunk);
+  ASSERT_EQ(taosStatFile(fnameStr, &size, NULL, NULL), 0);
+
+  TearDown();
+  int64_t closedSize = 0;
+  ASSERT_EQ(taosStatFile(fnameStr, &closedSize, NULL, NULL), 0);
+  ASSERT_EQ(closedSize, size);
+  ASSERT_LT(allocatedSize(fnameStr), chunk);
+  SetUp();
+
+  tsWalPreallocSize = preallocSize;
+}
+
+TEST_F(WalCleanEnv, deferForcedFsync) {
+  int code;
+
+  code = walAppendLog(pWal, 0, 1, syncMeta, (void*)ranStr, ranStrLen, NULL);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(walDeferFsync(pWal, false), 0);
+  ASSERT_NE(pWal->group.pendingTs, 0);
+  ASSERT_EQ(pWal->group.syncedVer, -1);
+
+  // the forced fsync of a vnode commit is not left to the group commit, it syncs the pending entries as well
+  code = walAppendLog(pWal, 1, 2, syncMeta, (void*)ranStr, ranStrLen, NULL);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(walDeferFsync(pWal, true), 0);
+  ASSERT_EQ(pWal->group.pendingTs, 0);
+  ASSERT_EQ(pWal->group.syncedVer, 1);
+}
+
+static void appendEntries(SWal* pWal, int64_t from, int64_t to, int64_t commitVer, const char* tag) {
+  for (int64_t i = from; i < to; i++) {
+    char body[100];
+    sprintf(body, "%s-%" PRId64, tag, i);
+    ASSERT_EQ(walAppendLog(pWal, i, i + 1, syncMeta, body, strlen(body), NULL), 0);
+  }
+  if (commitVer >= 0) {
+    ASSERT_EQ(walCommit(pWal, commitVer), 0);
+  }
+}
+
+// read the entry and check its body, and whether it was copied out of the mapped file
+static void readEntry(SWalReader* pRead, int64_t ver, const char* tag, bool mapped) {
+  char body[100];
+  sprintf(body, "%s-%" PRId64, tag, ver);
+  ASSERT_EQ(walReadVer(pRead, ver), 0);
+  ASSERT_EQ(pRead->pHead->head.version, ver);
+  ASSERT_EQ(pRead->curVersion, ver + 1);
+  ASSERT_EQ(pRead->pHead->head.bodyLen, (int32_t)strlen(body));
+  ASSERT_EQ(memcmp(pRead->pHead->head.body, body, strlen(body)), 0);
+  // only the reads out of the mapping leave the file position behind
+  ASSERT_EQ(pRead->map.posStale, mapped) << ver;
+}
+
+TEST_F(WalKeepEnv, readMappedSealed) {
+  walResetEnv();
+  appendEntries(pWal, 0, 50, 49, ranStr);
+  ASSERT_EQ(walRollImpl(pWal), 0);
+  appendEntries(pWal, 50, 100, 99, ranStr);
+  ASSERT_EQ(taosArrayGetSize(pWal->fileInfoSet), 2);
+
+  SWalReader* pRead = walOpenReader(pWal, 0);
+  ASSERT(pRead != NULL);
+
+  // the sealed file is mapped as it is
+  readEntry(pRead, 10, ranStr, true);
+  ASSERT_EQ(pRead->curFileFirstVer, 0);
+  ASSERT_EQ(pRead->map.logMapSize, pRead->map.logSize);
+  for (int64_t ver = 11; ver < 50; ver++) {
+    readEntry(pRead, ver, ranStr, true);
+  }
+
+  // the active one with room for the appends after it, the first entry is read from the file it switches to
+  readEntry(pRead, 50, ranStr, false);
+  ASSERT_EQ(pRead->curFileFirstVer, 50);
+  ASSERT_GT(pRead->map.logMapSize, pRead->map.logSize);
+  for (int i = 0; i < 200; i++) {
+    int64_t ver = taosRand() % 100;
+    readEntry(pRead, ver, ranStr, !(ver == 50 && pRead->curVersion == 50));
+  }
+
+  // the fetch api of the subscriptions reads the mapping as well
+  ASSERT_EQ(walFetchHead(pRead, 30), 0);
+  ASSERT_GE(pRead->map.bodyOffset, 0);
+  ASSERT_EQ(walFetchBody(pRead), 0);
+  ASSERT_EQ(pRead->pHead->head.version, 30);
+  ASSERT_EQ(pRead->map.bodyOffset, -1);
+  ASSERT_EQ(walFetchHead(pRead, 31), 0);
+  ASSERT_EQ(walSkipFetchBody(pRead), 0);
+  ASSERT_EQ(walFetchHead(pRead, 32), 0);
+  ASSERT_EQ(walFetchBody(pRead), 0);
+  ASSERT_EQ(pRead->pHead->head.version, 32);
+
+  walCloseReader(pRead);
+}
+
+TEST_F(WalKeepEnv, readMappedRemap) {
+  walResetEnv();
+  appendEntries(pWal, 0, 10, 9, ranStr);
+
+  SWalReader* pRead = walOpenReader(pWal, 0);
+  ASSERT(pRead != NULL);
+  readEntry(pRead, 0, ranStr, true);
+  int64_t idxMapSize = pRead->map.idxMapSize;
+
+  // the appends within the mapped window are read without a remap, the idx entries of the later ones are out of it
+  int64_t lastVer = idxMapSize / (int64_t)sizeof(SWalIdxEntry) + 1000;
+  appendEntries(pWal, 10, lastVer + 1, lastVer, ranStr);
+  for (int64_t ver = 1; ver < 1000; ver++) {
+    readEntry(pRead, ver, ranStr, true);
+  }
+  ASSERT_EQ(pRead->map.idxMapSize, idxMapSize);
+
+  // a seek remaps the grown file
+  readEntry(pRead, lastVer, ranStr, true);
+  ASSERT_GT(pRead->map.idxMapSize, idxMapSize);
+
+  // and so does a sequential read running out of the window, the entry out of it is read from the file
+  walCloseReader(pRead);
+  pRead = walOpenReader(pWal, 0);
+  ASSERT(pRead != NULL);
+  readEntry(pRead, 0, ranStr, true);
+  idxMapSize = pRead->map.idxMapSize;
+  int64_t firstVer = lastVer + 1;
+  lastVer = idxMapSize / (int64_t)sizeof(SWalIdxEntry) + 1000;
+  appendEntries(pWal, firstVer, lastVer + 1, lastVer, ranStr);
+
+  int64_t outOfWindow = -1;
+  for (int64_t ver = 1; ver <= lastVer; ver++) {
+    ASSERT_EQ(walReadVer(pRead, ver), 0);
+    ASSERT_EQ(pRead->pHead->head.version, ver);
+    if (outOfWindow < 0 && !pRead->map.posStale) {
+      outOfWindow = ver;
+    }
+  }
+  ASSERT_EQ(outOfWindow, idxMapSize / (int64_t)sizeof(SWalIdxEntry));
+  ASSERT_GT(pRead->map.idxMapSize, idxMapSize);
+  readEntry(pRead, outOfWindow + 1, ranStr, true);
+
+  walCloseReader(pRead);
+}
+
+TEST_F(WalKeepEnv, readMappedUncommitted) {
+  walResetEnv();
+  appendEntries(pWal, 0, 20, 9, ranStr);
+
+  SWalReader* pRead = walOpenReader(pWal, 0);
+  ASSERT(pRead != NULL);
+
+  // the uncommitted entries are read from the file, since a rollback may truncate them
+  readEntry(pRead, 5, ranStr, true);
+  readEntry(pRead, 15, ranStr, false);
+  readEntry(pRead, 16, ranStr, false);
+  readEntry(pRead, 9, ranStr, true);
+
+  // the entries rewritten after a rollback are read, not the stale ones
+  ASSERT_EQ(walRollback(pWal, 15), 0);
+  appendEntries(pWal, 15, 20, -1, "rewritten");
+  readEntry(pRead, 15, "rewritten", false);
+  ASSERT_EQ(walCommit(pWal, 19), 0);
+  readEntry(pRead, 17, "rewritten", true);
+  readEntry(pRead, 18, "rewritten", true);
+
+  walCloseReader(pRead);
+}
+
+TEST_F(WalEncrypted, readMapped) {
+  walResetEnv();
+  appendEntries(pWal, 0, 100, 99, ranStr);
+
+  SWalReader* pRead = walOpenReader(pWal, 0);
+  ASSERT(pRead != NULL);
+
+  // the crypted bodies are copied out of the mapping and decrypted
+  for (int64_t ver = 0; ver < 100; ver++) {
+    readEntry(pRead, ver, ranStr, true);
+  }
+  for (int i = 0; i < 100; i++) {
+    readEntry(pRead, taosRand() % 100, ranStr, true);
+  }
+
+  walCloseReader(pRead);
+}
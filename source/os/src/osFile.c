@@ -307,6 +307,31 @@ int32_t taosStatFile(const char *path, int64_t *size, int64_t *mtime, int64_t *a
   return 0;
 }
 
+int32_t taosLStatFileOwner(const char *path, uint32_t *mode, int64_t *uid) {
+  OS_PARAM_CHECK(path);
+#if defined(WINDOWS)
+  terrno = TSDB_CODE_OPS_NOT_SUPPORT;
+  return terrno;
+#else
+  struct stat fileStat;
+  int32_t     code = lstat(path, &fileStat);
+  if (-1 == code) {
+    terrno = TAOS_SYSTEM_ERROR(ERRNO);
+    return terrno;
+  }
+
+  if (mode != NULL) {
+    *mode = fileStat.st_mode;
+  }
+
+  if (uid != NULL) {
+    *uid = fileStat.st_uid;
+  }
+
+  return 0;
+#endif
+}
+
 int32_t taosGetFileDiskID(const char *path, int64_t *diskid) {
   OS_PARAM_CHECK(path);
 #ifdef WINDOWS
@@ -1390,6 +1415,142 @@ int32_t taosFsyncFile(TdFilePtr pFile) {
   return 0;
 }
 
+// Hint the kernel to start reading [offset, offset + count) into the page cache asynchronously, so that a
+// following taosPReadFile on the range does not block on the disk. It is only a hint, and it is a no-op on
+// platforms without posix_fadvise.
+int32_t taosPrefetchFile(TdFilePtr pFile, int64_t offset, int64_t count) {
+  if (pFile == NULL || offset < 0 || count < 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+#if defined(WINDOWS) || defined(_TD_DARWIN_64) || defined(TD_ASTRA)
+  return 0;
+#else
+  if (pFile->fd < 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  int32_t code = posix_fadvise(pFile->fd, offset, count, POSIX_FADV_WILLNEED);
+  if (code != 0) {
+    terrno = TAOS_SYSTEM_ERROR(code);
+    return terrno;
+  }
+  return 0;
+#endif
+}
+
+// Hint the kernel that [offset, offset + count) will not be accessed again, so that its pages can be evicted from
+// the page cache before the pages of other readers. It is a no-op on platforms without posix_fadvise.
+int32_t taosDropFileCache(TdFilePtr pFile, int64_t offset, int64_t count) {
+  if (pFile == NULL || offset < 0 || count < 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+#if defined(WINDOWS) || defined(_TD_DARWIN_64) || defined(TD_ASTRA)
+  return 0;
+#else
+  if (pFile->fd < 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  int32_t code = posix_fadvise(pFile->fd, offset, count, POSIX_FADV_DONTNEED);
+  if (code != 0) {
+    terrno = TAOS_SYSTEM_ERROR(code);
+    return terrno;
+  }
+  return 0;
+#endif
+}
+
+// reserve blocks in [offset, offset + len) without changing the file size
+int32_t taosFallocateFile(TdFilePtr pFile, int64_t offset, int64_t len) {
+  if (pFile == NULL || offset < 0 || len <= 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+#if !defined(__linux__) || defined(TD_ASTRA)
+  return 0;
+#else
+  if (pFile->fd < 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  if (fallocate(pFile->fd, FALLOC_FL_KEEP_SIZE, offset, len) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(ERRNO);
+    return terrno;
+  }
+  return 0;
+#endif
+}
+
+// like taosFsyncFile, but skips metadata not needed to read the data back
+int32_t taosFdatasyncFile(TdFilePtr pFile) {
+#if !defined(__linux__) || defined(TD_ASTRA)
+  return taosFsyncFile(pFile);
+#else
+  if (pFile == NULL) {
+    return 0;
+  }
+
+  if (pFile->fp != NULL || pFile->fd < 0) {
+    return taosFsyncFile(pFile);
+  }
+
+  if (fdatasync(pFile->fd) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(ERRNO);
+    return terrno;
+  }
+  return 0;
+#endif
+}
+
+// map the first size bytes of the file read only, NULL with terrno set if not supported
+void *taosMmapReadOnlyFile(TdFilePtr pFile, int64_t size) {
+  if (pFile == NULL || size <= 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return NULL;
+  }
+
+#if defined(WINDOWS) || defined(TD_ASTRA)
+  terrno = TSDB_CODE_OPS_NOT_SUPPORT;
+  return NULL;
+#else
+  if (pFile->fd < 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return NULL;
+  }
+
+  void *ptr = mmap(NULL, size, PROT_READ, MAP_SHARED, pFile->fd, 0);
+  if (ptr == MAP_FAILED) {
+    terrno = TAOS_SYSTEM_ERROR(ERRNO);
+    return NULL;
+  }
+  return ptr;
+#endif
+}
+
+int32_t taosMunmapFile(void *ptr, int64_t size) {
+  if (ptr == NULL) {
+    return 0;
+  }
+
+#if defined(WINDOWS) || defined(TD_ASTRA)
+  return 0;
+#else
+  if (munmap(ptr, size) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(ERRNO);
+    return terrno;
+  }
+  return 0;
+#endif
+}
+
 void taosFprintfFile(TdFilePtr pFile, const char *format, ...) {
   if (pFile == NULL || pFile->fp == NULL) {
     return;
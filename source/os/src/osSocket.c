@@ -14,6 +14,9 @@
  */
 
 #define _DEFAULT_SOURCE
+#if defined(LINUX) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // struct ucred
+#endif
 #define ALLOW_FORBID_FUNC
 #include "os.h"
 
@@ -758,6 +761,31 @@ int32_t taosSetSockOpt2(int32_t fd) {
   return 0;
 }
 
+int32_t taosGetPeerUid(int32_t fd, int64_t *uid) {
+#if defined(WINDOWS) || defined(TD_ASTRA)
+  terrno = TSDB_CODE_OPS_NOT_SUPPORT;
+  return terrno;
+#elif defined(DARWIN)
+  uid_t euid = 0;
+  gid_t egid = 0;
+  if (getpeereid(fd, &euid, &egid) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(ERRNO);
+    return terrno;
+  }
+  *uid = euid;
+  return 0;
+#else
+  struct ucred cred;
+  socklen_t    len = sizeof(cred);
+  if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(ERRNO);
+    return terrno;
+  }
+  *uid = cred.uid;
+  return 0;
+#endif
+}
+
 int32_t taosValidFqdn(int8_t enableIpv6, char *fqdn) {
   int32_t code = 0;
   SIpAddr addr = {0};
@@ -89,6 +89,13 @@ TEST(osFileTests, taosCopyFile) {
   ret64 = taosPReadFile(NULL, NULL, 0, 0);
   EXPECT_EQ(ret64, -1);
 
+  int32_t ret32 = taosPrefetchFile(NULL, 0, 0);
+  EXPECT_NE(ret32, 0);
+  ret32 = taosPrefetchFile(testFilePtr, -1, 0);
+  EXPECT_NE(ret32, 0);
+  ret32 = taosPrefetchFile(testFilePtr, 0, 9);
+  EXPECT_EQ(ret32, 0);
+
   bool retb = taosValidFile(testFilePtr);
   EXPECT_TRUE(retb);
   retb = taosValidFile(NULL);
@@ -97,7 +104,7 @@ TEST(osFileTests, taosCopyFile) {
   retb = taosCheckAccessFile(NULL, 0);
   EXPECT_FALSE(retb);
 
-  int32_t ret32 = taosFStatFile(NULL, NULL, NULL);
+  ret32 = taosFStatFile(NULL, NULL, NULL);
   EXPECT_NE(ret32, 0);
 
   ret32 = taosLockFile(NULL);
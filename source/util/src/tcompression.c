@@ -56,6 +56,7 @@
 
 #if defined(WINDOWS) || defined(_TD_DARWIN_64)
 #else
+#include "dictBuilder/zdict.h"
 #include "fast-lzma2.h"
 #include "zlib.h"
 #include "zstd.h"
@@ -2083,10 +2084,13 @@ int32_t zlibDecompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSi
 }
 
 int32_t zstdCompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize) {
+  return zstdCompressLevelImpl(src, srcSize, dst, dstSize, 9);
+}
+int32_t zstdCompressLevelImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize, int32_t level) {
 #if defined(WINDOWS) || defined(DARWIN)
   return TSDB_CODE_INVALID_CFG;
 #else
-  size_t len = ZSTD_compress(dst, *dstSize, src, srcSize, 9);
+  size_t len = ZSTD_compress(dst, *dstSize, src, srcSize, level);
   if (ZSTD_isError(len)) {
     return -1;
   }
@@ -2113,6 +2117,84 @@ int32_t zstdDecompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSi
 #endif
 }
 
+// train a dictionary from the samples concatenated one after another, dictSize is the capacity of dict on input
+int32_t zstdTrainDictImpl(const void *samples, const size_t *sampleSizes, int32_t numOfSamples, void *dict,
+                          int32_t *dictSize) {
+#if defined(WINDOWS) || defined(DARWIN)
+  return TSDB_CODE_INVALID_CFG;
+#else
+  size_t len = ZDICT_trainFromBuffer(dict, *dictSize, samples, sampleSizes, numOfSamples);
+  if (ZDICT_isError(len)) {
+    return -1;
+  }
+
+  *dictSize = len;
+  return 0;
+#endif
+}
+void *zstdCreateCDictImpl(const void *dict, int32_t dictSize, int32_t level) {
+#if defined(WINDOWS) || defined(DARWIN)
+  return NULL;
+#else
+  return ZSTD_createCDict(dict, dictSize, level);
+#endif
+}
+void zstdFreeCDictImpl(void *cdict) {
+#if !defined(WINDOWS) && !defined(DARWIN)
+  (void)ZSTD_freeCDict(cdict);
+#endif
+}
+void *zstdCreateDDictImpl(const void *dict, int32_t dictSize) {
+#if defined(WINDOWS) || defined(DARWIN)
+  return NULL;
+#else
+  return ZSTD_createDDict(dict, dictSize);
+#endif
+}
+void zstdFreeDDictImpl(void *ddict) {
+#if !defined(WINDOWS) && !defined(DARWIN)
+  (void)ZSTD_freeDDict(ddict);
+#endif
+}
+int32_t zstdCompressDictImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize, void *cdict) {
+#if defined(WINDOWS) || defined(DARWIN)
+  return TSDB_CODE_INVALID_CFG;
+#else
+  ZSTD_CCtx *cctx = ZSTD_createCCtx();
+  if (cctx == NULL) {
+    return -1;
+  }
+
+  size_t len = ZSTD_compress_usingCDict(cctx, dst, *dstSize, src, srcSize, cdict);
+  (void)ZSTD_freeCCtx(cctx);
+  if (ZSTD_isError(len) || len > srcSize) {
+    return -1;
+  }
+
+  *dstSize = len;
+  return 0;
+#endif
+}
+int32_t zstdDecompressDictImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize, void *ddict) {
+#if defined(WINDOWS) || defined(DARWIN)
+  return TSDB_CODE_INVALID_CFG;
+#else
+  ZSTD_DCtx *dctx = ZSTD_createDCtx();
+  if (dctx == NULL) {
+    return -1;
+  }
+
+  size_t len = ZSTD_decompress_usingDDict(dctx, dst, *dstSize, src, srcSize, ddict);
+  (void)ZSTD_freeDCtx(dctx);
+  if (ZSTD_isError(len)) {
+    return -1;
+  }
+
+  *dstSize = len;
+  return 0;
+#endif
+}
+
 int32_t xzCompressImpl(void *src, int32_t srcSize, void *dst, int32_t *dstSize) {
 #if defined(WINDOWS) || defined(DARWIN)
   return TSDB_CODE_INVALID_CFG;
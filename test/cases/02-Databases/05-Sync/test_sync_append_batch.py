@@ -0,0 +1,148 @@
+import threading
+import time
+
+from new_test_framework.utils import tdLog, tdSql, tdCom, sc, clusterComCheck
+
+
+class TestSyncAppendBatch:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "syncbatch"
+        cls.ctbNum = 16
+        cls.writers = 4
+        cls.insertsPerTable = 20
+        cls.rowsPerInsert = 50
+        cls.startTs = 1700000000000
+        cls.written = 0
+
+    def prepare(self):
+        clusterComCheck.checkDnodes(3)
+        tdSql.execute("create mnode on dnode 2")
+        tdSql.execute("create mnode on dnode 3")
+        clusterComCheck.checkMnodeStatus(3)
+
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} replica 3 vgroups 1")
+        clusterComCheck.checkDbReady(self.dbName)
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create stable stb (ts timestamp, v bigint, s varchar(64)) tags (t1 int)")
+        tdSql.execute("create table " + " ".join(f"ctb{i} using stb tags({i})" for i in range(self.ctbNum)))
+
+    def setBatchSize(self, kb):
+        tdSql.execute(f"alter all dnodes 'syncAppendBatchSize' '{kb}'")
+
+    def write(self, idx, base, errors):
+        try:
+            tsql = tdCom.newTdSql()
+            tsql.execute(f"use {self.dbName}")
+            for n in range(self.insertsPerTable):
+                for tb in range(idx, self.ctbNum, self.writers):
+                    rows = []
+                    for j in range(self.rowsPerInsert):
+                        k = base + n * self.rowsPerInsert + j
+                        rows.append(f"({self.startTs + k}, {k}, 'v_{tb}_{k}')")
+                    tsql.execute(f"insert into ctb{tb} values " + " ".join(rows))
+        except Exception as e:
+            errors.append(e)
+
+    def writeRound(self, step):
+        # several writers keep the leader's log buffer ahead of the followers, so consecutive entries are packed
+        base = self.written
+        errors = []
+        threads = [threading.Thread(target=self.write, args=(i, base, errors)) for i in range(self.writers)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        if errors:
+            tdLog.exit(f"{step}: write failed: {errors[0]}")
+        self.written += self.insertsPerTable * self.rowsPerInsert
+        tdLog.info(f"{step}: {self.written} rows written to every table")
+
+    def check(self, step):
+        n = self.written
+        tdSql.query(f"select count(*), sum(v), min(v), max(v) from {self.dbName}.stb")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, self.ctbNum * n)
+        tdSql.checkData(0, 1, self.ctbNum * n * (n - 1) // 2)
+        tdSql.checkData(0, 2, 0)
+        tdSql.checkData(0, 3, n - 1)
+
+        tdSql.query(f"select tbname, count(*), last(s) from {self.dbName}.stb partition by tbname")
+        tdSql.checkRows(self.ctbNum)
+        for row in tdSql.queryResult:
+            tb = int(row[0][3:])
+            if row[1] != n or row[2] != f"v_{tb}_{n - 1}":
+                tdLog.exit(f"{step}: {row[0]} got count:{row[1]}, last:{row[2]}, expect count:{n}")
+        tdLog.info(f"{step}: {self.ctbNum * n} rows match")
+
+    def leader(self):
+        tdSql.query(f"show {self.dbName}.vgroups")
+        row = tdSql.queryResult[0]
+        for dnodeCol, statusCol in [(3, 4), (6, 7), (9, 10)]:
+            if row[statusCol] == "leader":
+                return row[dnodeCol]
+        tdLog.exit(f"no leader of {self.dbName}: {row}")
+
+    def follower(self):
+        leader = self.leader()
+        return next(d for d in [1, 2, 3] if d != leader)
+
+    def switchLeader(self, step):
+        # the new leader was a follower and holds only what it got through append entries
+        leader = self.leader()
+        sc.dnodeStop(leader)
+        clusterComCheck.checkDnodes(2)
+        clusterComCheck.checkDbReady(self.dbName)
+        tdLog.info(f"{step}: leader moved from dnode {leader} to dnode {self.leader()}")
+        self.check(step)
+        sc.dnodeStart(leader)
+        clusterComCheck.checkDnodes(3)
+        clusterComCheck.checkDbReady(self.dbName)
+
+    def test_sync_append_batch(self):
+        """Followers apply append entries msgs packed with several raft entries
+
+        1. Start a 3-node cluster and create a 3-replica database
+        2. Write from several connections with the default batch size, with 1KB and with batching off
+        3. Stop a follower, keep writing, then start it so that it catches up from the leader
+        4. Check the rows on the leader
+        5. Stop the leader twice so that the followers become the leader in turn, and check the rows again
+
+        Catalog:
+            - DataBase:Sync
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for packing raft entries into one append entries msg
+
+        """
+
+        self.prepare()
+
+        for kb in [256, 1, 0]:
+            self.setBatchSize(kb)
+            self.writeRound(f"batch size {kb}KB")
+            self.check(f"batch size {kb}KB")
+
+        self.setBatchSize(256)
+        follower = self.follower()
+        sc.dnodeStop(follower)
+        clusterComCheck.checkDnodes(2)
+        self.writeRound(f"dnode {follower} stopped")
+        sc.dnodeStart(follower)
+        clusterComCheck.checkDnodes(3)
+        clusterComCheck.checkDbReady(self.dbName)
+        self.writeRound(f"dnode {follower} restarted")
+        self.check("leader")
+
+        self.switchLeader("first switch")
+        self.switchLeader("second switch")
+
+        tdSql.execute(f"drop database {self.dbName}")
@@ -0,0 +1,90 @@
+from new_test_framework.utils import tdLog, tdSql
+
+
+class TestWriteBatchAppend:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "batchappend"
+        cls.startTs = 1700000000000
+        cls.expect = {}
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} vgroups 1")
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create stable stb (ts timestamp, v int, s varchar(16)) tags (t1 int)")
+        # the rows of a batch are appended to the memtable of tb_batch at once, tb_row gets them one by one
+        tdSql.execute("create table tb_batch using stb tags(0) tb_row using stb tags(1)")
+
+    def write(self, keys, base):
+        rows = [(self.startTs + k, base + k, f"'s_{base + k}'") for k in keys]
+        tdSql.execute("insert into tb_batch values " + " ".join(f"({ts}, {v}, {s})" for ts, v, s in rows))
+        for ts, v, s in rows:
+            tdSql.execute(f"insert into tb_row values ({ts}, {v}, {s})")
+        for k in keys:
+            self.expect[k] = base + k
+
+    def check(self, step):
+        keys = sorted(self.expect)
+        for order, expect in (("asc", keys), ("desc", keys[::-1])):
+            expect = [(self.startTs + k, self.expect[k], f"s_{self.expect[k]}") for k in expect]
+            for tb in ("tb_batch", "tb_row"):
+                tdSql.query(f"select cast(ts as bigint), v, s from {tb} order by ts {order}")
+                got = [tuple(row) for row in tdSql.queryResult]
+                if got != expect:
+                    tdLog.exit(f"{step}: {tb} {order} got {len(got)} rows, expect {len(expect)}")
+
+        # the skiplist of the batch is walked from the middle as well
+        mid = self.startTs + keys[len(keys) // 2]
+        for tb in ("tb_batch", "tb_row"):
+            tdSql.query(f"select count(*), sum(v), last(v) from {tb} where ts >= {mid}")
+            values = [self.expect[k] for k in keys if self.startTs + k >= mid]
+            tdSql.checkData(0, 0, len(values))
+            tdSql.checkData(0, 1, sum(values))
+            tdSql.checkData(0, 2, values[-1])
+        tdLog.info(f"{step}: {len(keys)} rows match")
+
+    def test_write_batch_append(self):
+        """Write: in-order batches appended to the memory table
+
+        1. Write the same rows to one table in batches and to another one row by row
+        2. Write an in-order batch, a batch starting at the last key, a batch overlapping the written rows and an
+           in-order batch after a gap
+        3. Check that both tables hold the same rows in asc and desc order, before and after a flush
+
+        Catalog:
+            - DataIngestion
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for appending in-order batches to the memory table at once
+
+        """
+
+        self.prepare()
+
+        self.write(range(0, 1000), 0)
+        self.check("in order")
+        # the first row updates the last one written
+        self.write(range(999, 1500), 10000)
+        self.check("from the last key")
+        # rows before the last key are put one by one in both tables
+        self.write(range(500, 2000, 3), 20000)
+        self.check("overlapping")
+        self.write(range(5000, 6000, 2), 30000)
+        self.check("after a gap")
+
+        tdSql.execute(f"flush database {self.dbName}")
+        self.check("flushed")
+        # on top of the flushed rows, into a new memory table
+        self.write(range(6000, 6500), 40000)
+        self.write(range(5999, 6100), 50000)
+        self.check("after flush")
+
+        tdSql.execute(f"drop database {self.dbName}")
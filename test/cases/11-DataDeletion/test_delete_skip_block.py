@@ -0,0 +1,101 @@
+import time
+
+from new_test_framework.utils import tdLog, tdSql
+
+
+class TestDeleteSkipBlock:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "delskip"
+        # with maxrows 200 the table gets 10 blocks in the data file
+        cls.rows = 2000
+        cls.startTs = 1700000000000
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create table t1 (ts timestamp, v int)")
+        for start in range(0, self.rows, 500):
+            rows = " ".join(f"({self.startTs + j}, {j})" for j in range(start, start + 500))
+            tdSql.execute(f"insert into t1 values {rows}")
+        tdSql.execute(f"flush database {self.dbName}")
+        self.expect = {j: j for j in range(self.rows)}
+
+    def delete(self, first, last):
+        tdSql.execute(f"delete from t1 where ts >= {self.startTs + first} and ts <= {self.startTs + last}")
+        for j in range(first, last + 1):
+            self.expect.pop(j, None)
+
+    def insert(self, keys, base):
+        rows = " ".join(f"({self.startTs + j}, {base + j})" for j in keys)
+        tdSql.execute(f"insert into t1 values {rows}")
+        for j in keys:
+            self.expect[j] = base + j
+
+    def check(self, step):
+        keys = sorted(self.expect)
+        values = [self.expect[j] for j in keys]
+        for order, rows in (("asc", values), ("desc", values[::-1])):
+            tdSql.query(f"select v from t1 order by ts {order}")
+            got = [row[0] for row in tdSql.queryResult]
+            if got != rows:
+                tdLog.exit(f"{step}: {order} scan got {len(got)} rows, expect {len(rows)}")
+
+        tdSql.query("select count(*), sum(v), min(v), max(v) from t1")
+        tdSql.checkData(0, 0, len(values))
+        tdSql.checkData(0, 1, sum(values))
+        tdSql.checkData(0, 2, min(values))
+        tdSql.checkData(0, 3, max(values))
+        tdLog.info(f"{step}: {len(values)} rows match")
+
+    def test_delete_skip_block(self):
+        """Skip file blocks covered by deletes
+
+        1. Write 2000 rows and flush them into blocks of 200 rows
+        2. Delete the rows of whole blocks, and a range ending inside a block
+        3. Write rows into the deleted range after the delete, kept in the memory table first and then in the stt
+        4. Delete the rewritten range again, then compact the database
+        5. Check the rows in asc and desc order and the aggregates after every step
+
+        Catalog:
+            - DataDeletion
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for skipping file blocks covered by deletes
+
+        """
+
+        self.prepare()
+        self.check("written")
+
+        # the 2nd and 3rd blocks are deleted as a whole, the 6th one partly from its first row
+        self.delete(200, 599)
+        self.delete(1000, 1099)
+        self.check("deleted")
+
+        # newer rows in the deleted range keep the blocks from being skipped, in the buffer first
+        self.insert([250, 300, 1050], 100000)
+        self.check("rewritten in buffer")
+        # and in the stt after the flush
+        tdSql.execute(f"flush database {self.dbName}")
+        self.check("rewritten in stt")
+
+        # the rewritten rows are newer than the first delete, a later one covers them too
+        self.delete(200, 399)
+        self.check("deleted again")
+        tdSql.execute(f"flush database {self.dbName}")
+        self.check("flushed")
+
+        tdSql.execute(f"compact database {self.dbName}")
+        while tdSql.query("show compacts") != 0:
+            time.sleep(1)
+        self.check("compacted")
+        tdSql.execute(f"drop database {self.dbName}")
@@ -0,0 +1,99 @@
+import time
+
+from new_test_framework.utils import tdLog, tdSql
+
+
+class TestFilterBloom:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "fbloom"
+        cls.ctbNum = 10
+        cls.rowsPerTable = 1000
+        cls.day = 86400000
+        # the two batches go to file sets 10 days apart, so the one written without bloom filters is kept as it is
+        cls.oldTs = 1700000000000
+        cls.newTs = cls.oldTs + 10 * cls.day
+
+    def setOption(self, on):
+        tdSql.execute(f"alter dnode 1 'tsdbBlockBloomFilter' '{1 if on else 0}'")
+
+    def insert(self, startTs, base):
+        for i in range(self.ctbNum):
+            rows = []
+            for j in range(self.rowsPerTable):
+                k = base + i * self.rowsPerTable + j
+                rows.append(f"({startTs + j}, {k}, 'key_{k}', {j})")
+            tdSql.execute(f"insert into ctb{i} values " + " ".join(rows))
+        tdSql.execute(f"flush database {self.dbName}")
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} vgroups 1 duration 1d minrows 10 maxrows 200")
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create stable stb (ts timestamp, k bigint, s varchar(24), v int) tags (t1 int)")
+        tdSql.execute("create table " + " ".join(f"ctb{i} using stb tags({i})" for i in range(self.ctbNum)))
+
+        # blocks of the old file set carry the column sma only
+        self.setOption(False)
+        self.insert(self.oldTs, 0)
+        # blocks of the new file set carry bloom filters after the column sma
+        self.setOption(True)
+        self.insert(self.newTs, 100000)
+
+    def check(self, step):
+        oldKey = 3 * self.rowsPerTable + 17
+        newKey = 100000 + 5 * self.rowsPerTable + 42
+        cases = [
+            (f"select count(*), sum(v) from stb where k = {oldKey}", [(1, 17)]),
+            (f"select count(*), sum(v) from stb where k = {newKey}", [(1, 42)]),
+            (f"select count(*), sum(v) from stb where k in ({oldKey}, {newKey}, 99999)", [(2, 59)]),
+            (f"select count(*), sum(v) from stb where s = 'key_{newKey}'", [(1, 42)]),
+            (f"select count(*) from stb where s = 'key_{oldKey}' or s = 'key_{newKey}'", [(2,)]),
+            ("select count(*) from stb where k = 99999", [(0,)]),
+            ("select count(*) from stb where s = 'no_such_key'", [(0,)]),
+            # the sma of the blocks is still read right with the filters after it
+            ("select count(*), sum(v), min(v), max(v) from stb", [(2 * self.ctbNum * self.rowsPerTable,
+                                                                  2 * self.ctbNum * sum(range(self.rowsPerTable)),
+                                                                  0, self.rowsPerTable - 1)]),
+        ]
+
+        for sql, expect in cases:
+            tdSql.query(sql)
+            if [tuple(row) for row in tdSql.queryResult] != expect:
+                tdLog.exit(f"{step}: {sql} got {tdSql.queryResult}, expect {expect}")
+        tdLog.info(f"{step}: {len(cases)} queries match")
+
+    def test_filter_bloom(self):
+        """Skip file blocks by column bloom filters
+
+        1. Write one file set with the bloom filters off and another one with them on
+        2. Query equality and in filters on int and varchar columns hitting either file set, or none
+        3. Check the results and the block sma of both kinds of blocks
+        4. Turn the option off and check again, then compact the database with it on and check again
+
+        Catalog:
+            - Query:Filter
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for the bloom filters of file blocks
+
+        """
+
+        self.prepare()
+        self.check("mixed files")
+        self.setOption(False)
+        self.check("option off")
+        self.setOption(True)
+        tdSql.execute(f"compact database {self.dbName}")
+        while tdSql.query("show compacts") != 0:
+            time.sleep(1)
+        self.check("compacted")
+        self.setOption(False)
+        tdSql.execute(f"drop database {self.dbName}")
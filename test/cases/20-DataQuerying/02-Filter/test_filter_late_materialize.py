@@ -0,0 +1,96 @@
+from new_test_framework.utils import tdLog, tdSql
+
+
+class TestFilterLateMaterialize:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "latemat"
+        cls.ctbNum = 40
+        # with maxrows 200 every table gets 10 blocks in the data file, 400 in total, several times the blocks probed
+        # before the scan decides whether to go on loading the filter columns ahead
+        cls.rowsPerTable = 2000
+        cls.startTs = 1700000000000
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create stable stb (ts timestamp, c int, v bigint, d double, s varchar(32)) tags (t1 int)")
+
+        tdSql.execute("create table " + " ".join(f"ctb{i} using stb tags({i})" for i in range(self.ctbNum)))
+        for i in range(self.ctbNum):
+            for start in range(0, self.rowsPerTable, 500):
+                rows = []
+                for j in range(start, start + 500):
+                    v = i * self.rowsPerTable + j
+                    rows.append(f"({self.startTs + j}, {self.cval(v)}, {v}, {v * 2}, 'str_{v}')")
+                tdSql.execute(f"insert into ctb{i} values " + " ".join(rows))
+        tdSql.execute(f"flush database {self.dbName}")
+
+    def cval(self, v):
+        return v % 997
+
+    def checkRows(self, sql, expect):
+        tdSql.query(sql)
+        if tdSql.queryRows != len(expect):
+            tdLog.exit(f"{sql}: rows:{tdSql.queryRows}, expect rows:{len(expect)}")
+
+        # the columns out of the filter are decoded after the filter columns, they must belong to the same rows
+        got = sorted(row[0] for row in tdSql.queryResult)
+        for row in tdSql.queryResult:
+            v = row[0]
+            if row[1] != v * 2 or row[2] != f"str_{v}":
+                tdLog.exit(f"{sql}: row of v:{v} got d:{row[1]}, s:{row[2]}")
+        if got != sorted(expect):
+            tdLog.exit(f"{sql}: rows differ from the expected ones")
+        tdLog.info(f"{len(expect)} rows match for: {sql}")
+
+    def check(self):
+        values = range(self.ctbNum * self.rowsPerTable)
+
+        # a selective filter, most of the blocks are skipped after decoding the filter column only
+        self.checkRows("select v, d, s from stb where c = 7", [v for v in values if self.cval(v) == 7])
+
+        # nearly all the rows are qualified, the filter columns are no longer loaded ahead after the first blocks
+        self.checkRows("select v, d, s from stb where c > 1", [v for v in values if self.cval(v) > 1])
+
+        # qualified in the later blocks of every table only, the scan switches between the two ways
+        mid = self.startTs + self.rowsPerTable // 2
+        self.checkRows(f"select v, d, s from stb where c = 7 or ts >= {mid}",
+                       [v for v in values if self.cval(v) == 7 or v % self.rowsPerTable >= self.rowsPerTable // 2])
+
+        # the filter columns are output columns too
+        tdSql.query("select c, v, s from stb where c = 996 and v < 100000")
+        expect = [v for v in values if self.cval(v) == 996 and v < 100000]
+        tdSql.checkRows(len(expect))
+        for row in tdSql.queryResult:
+            if row[0] != 996 or row[2] != f"str_{row[1]}":
+                tdLog.exit(f"row of v:{row[1]} got c:{row[0]}, s:{row[2]}")
+
+    def test_filter_late_materialize(self):
+        """Filter columns loaded ahead of the other columns
+
+        1. Write 40 child tables of 2000 rows and flush them into blocks of 200 rows
+        2. Query with a selective filter, so that most blocks are skipped after decoding the filter column
+        3. Query with a filter qualifying nearly all rows, so that the whole blocks are loaded directly
+        4. Query with a filter qualifying the later blocks of every table only
+        5. Check the rows and that the other columns belong to the qualified rows
+
+        Catalog:
+            - Query:Filter
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for loading the filter columns ahead of the other columns
+
+        """
+
+        self.prepare()
+        self.check()
+        tdSql.execute(f"drop database {self.dbName}")
@@ -0,0 +1,115 @@
+from new_test_framework.utils import tdLog, tdSql
+
+
+class TestFilterTimeWindowBlocks:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "twblocks"
+        # with maxrows 200 every table gets 5 blocks a day, and the head file of a day holds several brin blocks
+        cls.ctbNum = 100
+        cls.rowsPerDay = 1000
+        cls.day = 86400000
+        cls.startTs = 1700006400000 - 1700006400000 % cls.day
+        # the tables of odd index are created after the first day is flushed, so they are missing in its file set
+        cls.days = {i: ([0, 1] if i % 2 == 0 else [1]) for i in range(cls.ctbNum)}
+
+    def ts(self, d, j):
+        # the rows of a day are 10 seconds apart from the start of the day
+        return self.startTs + d * self.day + j * 10000
+
+    def value(self, i, d, j):
+        return i * 10000 + d * self.rowsPerDay + j
+
+    def insert(self, tables, d):
+        for i in tables:
+            for start in range(0, self.rowsPerDay, 500):
+                rows = " ".join(f"({self.ts(d, j)}, {self.value(i, d, j)})" for j in range(start, start + 500))
+                tdSql.execute(f"insert into ctb{i} values {rows}")
+        tdSql.execute(f"flush database {self.dbName}")
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} vgroups 1 duration 1d minrows 10 maxrows 200")
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create stable stb (ts timestamp, v bigint) tags (t1 int)")
+
+        even = [i for i in range(self.ctbNum) if i % 2 == 0]
+        odd = [i for i in range(self.ctbNum) if i % 2 == 1]
+        tdSql.execute("create table " + " ".join(f"ctb{i} using stb tags({i})" for i in even))
+        self.insert(even, 0)
+        tdSql.execute("create table " + " ".join(f"ctb{i} using stb tags({i})" for i in odd))
+        self.insert(range(self.ctbNum), 1)
+
+    def expectRows(self, tables, skey, ekey):
+        rows = {}
+        for i in tables:
+            rows[i] = [self.value(i, d, j) for d in self.days[i] for j in range(self.rowsPerDay)
+                       if skey <= self.ts(d, j) <= ekey]
+        return rows
+
+    def checkPartition(self, tables, skey, ekey):
+        cond = f"t1 in ({', '.join(str(i) for i in tables)}) and ts >= {skey} and ts <= {ekey}"
+        tdSql.query(f"select t1, count(*), sum(v), first(v), last(v) from stb where {cond} partition by t1")
+        got = {row[0]: tuple(row[1:]) for row in tdSql.queryResult}
+        expect = {i: (len(r), sum(r), r[0], r[-1]) for i, r in self.expectRows(tables, skey, ekey).items() if r}
+        if got != expect:
+            tdLog.exit(f"{cond}: got {len(got)} tables {sorted(got.items())[:3]}, expect {len(expect)} tables "
+                       f"{sorted(expect.items())[:3]}")
+
+    def checkOrder(self, i, skey, ekey):
+        rows = self.expectRows([i], skey, ekey)[i]
+        for order, expect in (("asc", rows), ("desc", rows[::-1])):
+            tdSql.query(f"select v from ctb{i} where ts >= {skey} and ts <= {ekey} order by ts {order}")
+            got = [row[0] for row in tdSql.queryResult]
+            if got != expect:
+                tdLog.exit(f"ctb{i} [{skey}, {ekey}] {order}: got {len(got)} rows, expect {len(expect)}")
+
+    def check(self):
+        every3rd = list(range(0, self.ctbNum, 3))
+        oddOnly = list(range(1, self.ctbNum, 2))
+        windows = [
+            # the first blocks of every table, the later ones start after the window
+            (self.ts(0, 0), self.ts(0, 250)),
+            # the blocks in the middle of a day, the first ones end before the window
+            (self.ts(0, 450), self.ts(0, 620)),
+            (self.ts(1, 199), self.ts(1, 201)),
+            # across the two file sets
+            (self.ts(0, 900), self.ts(1, 100)),
+            # the whole time range
+            (self.ts(0, 0), self.ts(1, self.rowsPerDay)),
+        ]
+
+        for skey, ekey in windows:
+            # the uids queried are sparse, or all missing in the file set of the first day
+            for tables in (every3rd, oddOnly, list(range(self.ctbNum))):
+                self.checkPartition(tables, skey, ekey)
+            for i in (0, 1, self.ctbNum - 1):
+                self.checkOrder(i, skey, ekey)
+        tdLog.info(f"{len(windows)} time windows match")
+
+    def test_filter_time_window_blocks(self):
+        """Locate the file blocks of the queried tables in the time window
+
+        1. Write 100 child tables into two file sets of 5 blocks per table, half of the tables into the later one only
+        2. Query time windows at the start, in the middle and across the file sets, on sparse tables and on the
+           tables missing in the first file set
+        3. Check the aggregates of every table, and the rows of a table in asc and desc order
+
+        Catalog:
+            - Query:Filter
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for searching the brin records by table uid and time
+
+        """
+
+        self.prepare()
+        self.check()
+        tdSql.execute(f"drop database {self.dbName}")
@@ -0,0 +1,112 @@
+from new_test_framework.utils import tdLog, tdSql
+
+
+class TestGroupByScatteredKeys:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "gbscatter"
+        cls.rows = 20000
+        cls.keys = 997
+        cls.startTs = 1700000000000
+
+    def keyOf(self, i):
+        # every 50th row has a NULL key, the others jump over the key space so that adjacent rows rarely share a group
+        if i % 50 == 0:
+            return None
+        return (i * 7919) % self.keys
+
+    def insertRows(self, table, rows):
+        for start in range(0, len(rows), 1000):
+            values = []
+            for ts, k, v in rows[start:start + 1000]:
+                kv = "NULL" if k is None else str(k)
+                sv = "NULL" if k is None else f"'key_{k}'"
+                values.append(f"({ts}, {kv}, {sv}, {v}, 'v{v}')")
+            tdSql.execute(f"insert into {table} values " + " ".join(values))
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} vgroups 1")
+        tdSql.execute(f"use {self.dbName}")
+        for tb in ["scattered", "clustered"]:
+            tdSql.execute(f"create table {tb} (ts timestamp, k int, s varchar(16), v int, c varchar(16))")
+
+        # the same (k, v) pairs, in row order for one table and grouped by key for the other, values grow with ts
+        # within each key in both tables, so first, last and the selection functions pick the same rows
+        pairs = [(self.keyOf(i), i) for i in range(self.rows)]
+        self.insertRows("scattered", [(self.startTs + i, k, v) for i, (k, v) in enumerate(pairs)])
+        ordered = sorted(pairs, key=lambda p: (-1 if p[0] is None else p[0], p[1]))
+        self.insertRows("clustered", [(self.startTs + i, k, v) for i, (k, v) in enumerate(ordered)])
+
+        self.expected = {}
+        for k, v in pairs:
+            e = self.expected.setdefault(k, [0, 0, v, v])
+            e[0] += 1
+            e[1] += v
+            e[3] = v
+
+    def checkExpected(self, table, keyCol):
+        tdSql.query(f"select {keyCol}, count(*), sum(v), first(v), last(v) from {table} group by {keyCol} order by {keyCol}")
+        tdSql.checkRows(len(self.expected))
+        for row in tdSql.queryResult:
+            k = row[0]
+            if k is not None and keyCol == "s":
+                k = int(k[len("key_"):])
+            cnt, total, first, last = self.expected[k]
+            if row[1] != cnt or row[2] != total or row[3] != first or row[4] != last:
+                tdLog.exit(f"{table} group {row[0]} got {row[1:]}, expect {[cnt, total, first, last]}")
+
+    def compareTables(self, sql):
+        tdSql.query(sql.format(tb="scattered"))
+        scattered = tdSql.queryResult
+        tdSql.query(sql.format(tb="clustered"))
+        clustered = tdSql.queryResult
+        if scattered != clustered:
+            tdLog.exit(f"scattered and clustered keys differ for: {sql}")
+        tdLog.info(f"{len(scattered)} groups match for: {sql}")
+
+    def check(self):
+        for keyCol in ["k", "s"]:
+            self.checkExpected("scattered", keyCol)
+            self.checkExpected("clustered", keyCol)
+
+        # the batch path aggregates the scattered table, the row path the clustered one
+        for sql in [
+            "select k, count(*), count(k), sum(v), min(v), max(v), avg(v), spread(v) from {tb} group by k order by k",
+            "select s, count(*), first(v), last(v), first(c), last(c) from {tb} group by s order by s",
+            "select k, s, count(*), max(v), c from {tb} group by k, s order by k, s",
+            "select k, min(v), c from {tb} group by k order by k",
+            "select k, last_row(v), last_row(c) from {tb} group by k order by k",
+            "select k % 10, s, count(*), sum(v) from {tb} group by k % 10, s order by 1, 2",
+            "select k, count(*) from {tb} where v % 3 = 0 group by k having count(*) > 5 order by k",
+        ]:
+            self.compareTables(sql)
+
+    def test_groupby_scattered_keys(self):
+        """Group by on scattered keys
+
+        1. Insert the same rows into two tables, with keys scattered over the rows in one and grouped in the other
+        2. Check count, sum, first and last of each int and varchar key against the values written, NULL keys included
+        3. Compare aggregate and selection functions over single and multiple keys between the two tables
+        4. Flush the database and check again
+
+        Catalog:
+            - Query:GroupBy
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for the batch aggregation of scattered group keys
+
+        """
+
+        self.prepare()
+        self.check()
+        tdSql.execute(f"flush database {self.dbName}")
+        self.check()
+        tdSql.execute(f"drop database {self.dbName}")
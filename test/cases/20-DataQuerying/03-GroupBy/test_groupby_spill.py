@@ -0,0 +1,122 @@
+from new_test_framework.utils import tdLog, tdSql
+
+
+class TestGroupBySpill:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "gbspill"
+        cls.ctbNum = 2000
+        cls.rowsPerTable = 10
+        cls.keys = 5000
+        cls.startTs = 1700000000000
+        # a few hundred groups fit into the budget, so the groups of every query below are spilled, and the partitions
+        # of the single column keys are spilled again into the next level
+        cls.tinyThreshold = 32
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        # with minrows 10 every table gets its own block in the data file after the flush, so blocks have sma
+        tdSql.execute(f"create database {self.dbName} vgroups 1 minrows 10")
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create stable stb (ts timestamp, k int, s varchar(24), v int) tags (t1 int, jt json)")
+
+        for start in range(0, self.ctbNum, 200):
+            tables = []
+            for i in range(start, min(start + 200, self.ctbNum)):
+                # every 10th table has no json key g, so the json group key is NULL
+                jt = '{"h": 1}' if i % 10 == 0 else f'{{"g": {i % 7}}}'
+                tables.append(f"ctb{i} using stb tags({i}, '{jt}')")
+            tdSql.execute("create table " + " ".join(tables))
+
+        for start in range(0, self.ctbNum, 100):
+            values = []
+            for i in range(start, min(start + 100, self.ctbNum)):
+                rows = []
+                for j in range(self.rowsPerTable):
+                    n = i * self.rowsPerTable + j
+                    k = (n * 7919) % self.keys
+                    rows.append(f"({self.startTs + j}, {k}, 'key_{k}', {n})")
+                values.append(f"ctb{i} values " + " ".join(rows))
+            tdSql.execute("insert into " + " ".join(values))
+
+    def setThreshold(self, threshold):
+        tdSql.execute(f"alter dnode 1 'groupSpillMemThreshold' '{threshold}'")
+
+    def queryAll(self, sqls):
+        results = []
+        for sql in sqls:
+            tdSql.query(sql)
+            results.append(sorted(tdSql.queryResult, key=repr))
+        return results
+
+    def check(self):
+        sqls = [
+            # scattered int keys, on the batch path before spilling
+            "select k, count(*), sum(v), min(v), max(v), first(v), last(v) from stb group by k",
+            # varchar keys
+            "select s, count(*), sum(v), last(v) from stb group by s",
+            # the scan assigns a group id to each table
+            "select tbname, count(*), sum(v), first(v), last(v) from stb group by tbname",
+            "select t1, k % 50, count(*), sum(v) from stb group by t1, k % 50",
+            # json keys are serialized row by row
+            "select jt->'g', k, count(*), sum(v), last(v) from stb group by jt->'g', k",
+            "select k, count(*) from stb where v % 3 = 0 group by k having count(*) > 1",
+            # after the flush the scan returns blocks with sma only or not loaded for tag keys, those of the tables
+            # read after the budget is exceeded must be loaded and spilled
+            "select tbname, count(*), sum(v), min(v), max(v) from stb group by tbname",
+            "select tbname, count(*) from stb group by tbname",
+            "select t1, count(*), sum(v) from stb group by t1",
+        ]
+
+        self.setThreshold(0)
+        inMemory = self.queryAll(sqls)
+        self.setThreshold(self.tinyThreshold)
+        spilled = self.queryAll(sqls)
+        self.setThreshold(0)
+
+        for sql, expect, actual in zip(sqls, inMemory, spilled):
+            if expect != actual:
+                tdLog.exit(f"spilled result differs from the in memory one for: {sql}, "
+                           f"rows:{len(actual)}, expect rows:{len(expect)}")
+            tdLog.info(f"{len(actual)} groups match for: {sql}")
+
+        tdSql.query("select k, count(*) from stb group by k")
+        tdSql.checkRows(self.keys)
+
+        self.setThreshold(self.tinyThreshold)
+        tdSql.query("select tbname, count(*) from stb group by tbname")
+        tdSql.checkRows(self.ctbNum)
+        for row in tdSql.queryResult:
+            if row[1] != self.rowsPerTable:
+                tdLog.exit(f"table {row[0]} got {row[1]} rows, expect {self.rowsPerTable}")
+        self.setThreshold(0)
+
+    def test_groupby_spill(self):
+        """Group by spilling to disk
+
+        1. Write rows of 2000 child tables with scattered int and varchar keys and json tags
+        2. Run group by over int, varchar, tbname, mixed tag and column, and json keys in memory
+        3. Run them again with a memory threshold of a few hundred groups, so that groups spill over several levels
+        4. Check that the spilled results equal the in memory ones
+        5. Flush the database and check again, tag keys on blocks with sma only or not loaded included
+
+        Catalog:
+            - Query:GroupBy
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for spilling the groups of group by to disk
+
+        """
+
+        self.prepare()
+        self.check()
+        tdSql.execute(f"flush database {self.dbName}")
+        self.check()
+        tdSql.execute(f"drop database {self.dbName}")
@@ -0,0 +1,107 @@
+import threading
+
+from new_test_framework.utils import tdLog, tdSql, tdCom
+
+
+class TestSelectLastCacheEvict:
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "lcevict"
+        cls.ctbNum = 200
+        cls.colNum = 32
+        cls.rounds = 20
+        cls.writers = 4
+        cls.readers = 2
+        cls.startTs = 1700000000000
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        # a 1MB last cache holds far fewer entries than the tables below, so updates keep evicting dirty entries
+        tdSql.execute(f"create database {self.dbName} vgroups 1 cachemodel 'both' cachesize 1")
+        tdSql.execute(f"use {self.dbName}")
+        cols = ", ".join([f"c{i} int, b{i} binary(128)" for i in range(self.colNum)])
+        tdSql.execute(f"create stable stb (ts timestamp, {cols}) tags (t0 int)")
+        for i in range(self.ctbNum):
+            tdSql.execute(f"create table ctb{i} using stb tags({i})")
+
+    def rowValues(self, tb, rnd):
+        vals = ", ".join([f"{rnd * 1000 + tb}, 'r{rnd}_{'x' * 100}'" for _ in range(self.colNum)])
+        return f"({self.startTs + rnd}, {vals})"
+
+    def write(self, idx, errors):
+        try:
+            tsql = tdCom.newTdSql()
+            tsql.execute(f"use {self.dbName}")
+            for rnd in range(self.rounds):
+                for tb in range(idx, self.ctbNum, self.writers):
+                    tsql.execute(f"insert into ctb{tb} values {self.rowValues(tb, rnd)}")
+        except Exception as e:
+            errors.append(e)
+
+    def read(self, stop, errors):
+        try:
+            tsql = tdCom.newTdSql()
+            tsql.execute(f"use {self.dbName}")
+            tb = 0
+            while not stop.is_set():
+                tsql.query(f"select last_row(*) from ctb{tb}")
+                tsql.query(f"select last(*) from ctb{tb}")
+                tb = (tb + 7) % self.ctbNum
+        except Exception as e:
+            errors.append(e)
+
+    def check(self):
+        rnd = self.rounds - 1
+        for tb in range(self.ctbNum):
+            for func in ["last_row", "last"]:
+                tdSql.query(f"select {func}(ts), {func}(c0), {func}(c{self.colNum - 1}), {func}(b0) from ctb{tb}")
+                tdSql.checkRows(1)
+                tdSql.checkData(0, 0, self.startTs + rnd)
+                tdSql.checkData(0, 1, rnd * 1000 + tb)
+                tdSql.checkData(0, 2, rnd * 1000 + tb)
+                tdSql.checkData(0, 3, f"r{rnd}_{'x' * 100}")
+
+    def test_select_last_cache_evict(self):
+        """Last cache under concurrent update and eviction
+
+        1. Create a database with a last cache far smaller than its last/last_row entries
+        2. Update different tables from several writers while readers reload evicted entries
+        3. Check last and last_row of every table return its newest row
+        4. Flush the database and check again
+
+        Catalog:
+            - Function:Selection
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for updates racing with last cache eviction
+
+        """
+
+        self.prepare()
+
+        errors = []
+        stop = threading.Event()
+        writers = [threading.Thread(target=self.write, args=(i, errors)) for i in range(self.writers)]
+        readers = [threading.Thread(target=self.read, args=(stop, errors)) for _ in range(self.readers)]
+        for t in writers + readers:
+            t.start()
+        for t in writers:
+            t.join()
+        stop.set()
+        for t in readers:
+            t.join()
+        if errors:
+            tdLog.exit(f"concurrent update and query failed: {errors[0]}")
+
+        self.check()
+        tdSql.execute(f"flush database {self.dbName}")
+        self.check()
+
+        tdSql.execute(f"drop database {self.dbName}")
@@ -0,0 +1,118 @@
+import time
+
+from new_test_framework.utils import tdLog, tdSql, sc, clusterComCheck
+
+
+class TestSelectLastCacheWarmup:
+    updatecfgDict = {"cacheLastWarmup": "1"}
+
+    def setup_class(cls):
+        tdLog.debug(f"start to execute {__file__}")
+        cls.dbName = "lcwarmup"
+        cls.ctbNum = 10
+        cls.rowsPerTable = 100
+        cls.startTs = 1700000000000
+        # the newest rows are deleted and flushed, so the tombs are in the newest file set next to the rows
+        cls.delTail = {0: 95, 1: 95, 2: 60}
+        # deleted after the last flush
+        cls.lateDelTail = {3: 50, 4: 50}
+        # a delete that leaves the newest rows as they are
+        cls.delMid = {5: (10, 20)}
+
+    def value(self, tb, j):
+        return tb * 1000 + j
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbName}")
+        tdSql.execute(f"create database {self.dbName} vgroups 1 cachemodel 'both'")
+        tdSql.execute(f"use {self.dbName}")
+        tdSql.execute("create stable stb (ts timestamp, c int, v int) tags (t1 int)")
+        tdSql.execute("create table " + " ".join(f"ctb{i} using stb tags({i})" for i in range(self.ctbNum)))
+
+        # every tenth row has a null v, so last(v) and last_row(v) differ on it
+        for tb in range(self.ctbNum):
+            rows = []
+            for j in range(self.rowsPerTable):
+                v = "NULL" if j % 10 == 9 else self.value(tb, j)
+                rows.append(f"({self.startTs + j}, {self.value(tb, j)}, {v})")
+            tdSql.execute(f"insert into ctb{tb} values " + " ".join(rows))
+        tdSql.execute(f"flush database {self.dbName}")
+
+        for tb, start in self.delTail.items():
+            tdSql.execute(f"delete from ctb{tb} where ts >= {self.startTs + start}")
+        for tb, (start, end) in self.delMid.items():
+            tdSql.execute(f"delete from ctb{tb} where ts >= {self.startTs + start} and ts < {self.startTs + end}")
+        tdSql.execute(f"flush database {self.dbName}")
+
+        for tb, start in self.lateDelTail.items():
+            tdSql.execute(f"delete from ctb{tb} where ts >= {self.startTs + start}")
+
+    def kept(self, tb):
+        end = self.delTail.get(tb, self.lateDelTail.get(tb, self.rowsPerTable))
+        mid = self.delMid.get(tb, (0, 0))
+        return [j for j in range(end) if not mid[0] <= j < mid[1]]
+
+    def restart(self):
+        sc.dnodeStop(1)
+        sc.dnodeStart(1)
+        clusterComCheck.checkDnodes(1)
+        tdSql.execute(f"use {self.dbName}")
+        # give the background warmup time to go through the newest file set before the first query
+        time.sleep(3)
+
+    def check(self, step):
+        for tb in range(self.ctbNum):
+            kept = self.kept(tb)
+            lastRow = kept[-1]
+            lastV = [j for j in kept if j % 10 != 9][-1]
+
+            tdSql.query(f"select last_row(ts), last_row(c), last_row(v) from ctb{tb}")
+            tdSql.checkRows(1)
+            tdSql.checkData(0, 0, self.startTs + lastRow)
+            tdSql.checkData(0, 1, self.value(tb, lastRow))
+            tdSql.checkData(0, 2, None if lastRow % 10 == 9 else self.value(tb, lastRow))
+
+            tdSql.query(f"select last(ts), last(c), last(v) from ctb{tb}")
+            tdSql.checkRows(1)
+            tdSql.checkData(0, 0, self.startTs + lastRow)
+            tdSql.checkData(0, 1, self.value(tb, lastRow))
+            tdSql.checkData(0, 2, self.value(tb, lastV))
+        tdLog.info(f"{step}: last and last_row of {self.ctbNum} tables match")
+
+    def test_select_last_cache_warmup(self):
+        """Last cache warmed up on vnode open
+
+        1. Write child tables with a null column every ten rows and flush them
+        2. Delete the newest rows of some tables, and a range in the middle of another one, then flush
+        3. Delete the newest rows of two more tables without flushing
+        4. Restart the dnode with the warmup on, so that the last cache is loaded from the newest file set
+        5. Check last and last_row of every table, the tables with deletes must not get the deleted rows
+        6. Compact the database, so that the tombs move into the data file, restart and check again
+
+        Catalog:
+            - Function:Selection
+
+        Since: v3.3.7.0
+
+        Labels: common,ci
+
+        Jira: None
+
+        History:
+            - 2026-10-18 Added for the last cache warmup skipping tables with deletes
+
+        """
+
+        self.prepare()
+        self.check("before restart")
+
+        self.restart()
+        self.check("warmed up")
+
+        tdSql.execute(f"compact database {self.dbName}")
+        while tdSql.query("show compacts") != 0:
+            time.sleep(1)
+        self.restart()
+        self.check("compacted and warmed up")
+
+        tdSql.execute(f"drop database {self.dbName}")